@@ -39,6 +39,7 @@ struct SearchStats {
     int depth_reached = 0;
     int time_elapsed_ms = 0;
     double nodes_per_second = 0.0;
+    int score = 0;  ///< Root score for the side to move (engine units; 0 if not searched)
     
     virtual ~SearchStats() = default;
     
@@ -47,6 +48,7 @@ struct SearchStats {
         depth_reached = 0;
         time_elapsed_ms = 0;
         nodes_per_second = 0.0;
+        score = 0;
     }
 };
 
@@ -83,6 +85,23 @@ public:
      * @brief Reset internal state (transposition table, etc.)
      */
     virtual void reset() = 0;
+    
+    /**
+     * @brief Create an independent instance with the same configuration
+     * 
+     * Used by parallel match runners to give each worker thread its own
+     * engine. Search state (TT, trees) is not copied.
+     * 
+     * @return New instance, or nullptr if the strategy cannot be cloned
+     */
+    virtual std::unique_ptr<AIStrategy> clone() const { return nullptr; }
+    
+    /**
+     * @brief Reseed any internal random number generator
+     * 
+     * Deterministic strategies ignore this.
+     */
+    virtual void set_seed(uint64_t seed) { (void)seed; }
 };
 
 /**
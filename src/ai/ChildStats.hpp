@@ -0,0 +1,277 @@
+/*
+ * ChildStats.hpp - Structure-of-arrays MCTS child statistics and UCB argmax
+ * COMP390 Honours Year Project
+ *
+ * A node keeps its children's visit, win and AMAF counts in one float
+ * buffer, one array per statistic, each padded to a multiple of 8 lanes.
+ * Selection then scores 8 children per step with AVX2 (a max/argmax
+ * reduction over the lanes) instead of chasing a pointer per child; the
+ * parent's log term is computed once per node, not once per child.
+ *
+ * A fifth array holds each child's backed-up evaluator value (implicit
+ * minimax, used by hybrid MCTS-alpha-beta).
+ *
+ * Without AVX2 the same loops run scalar. Both paths pick the first child
+ * (lowest index) among equal best values, so they agree on ties.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+namespace reversi::ai {
+
+namespace ucb {
+
+namespace detail {
+
+/// Index of the largest value(i) over non-excluded i < count (-1 if none)
+template <typename Value>
+inline int argmax_scalar(int count, uint64_t excluded, Value&& value) {
+    int best = -1;
+    float best_value = -std::numeric_limits<float>::infinity();
+    for (int i = 0; i < count; ++i) {
+        if ((excluded >> i) & 1ULL) continue;
+        const float v = value(i);
+        if (v > best_value) {
+            best_value = v;
+            best = i;
+        }
+    }
+    return best;
+}
+
+#if defined(__AVX2__)
+/// Same as argmax_scalar; value(i) scores lanes i..i+7
+template <typename Value8>
+inline int argmax_avx2(int count, uint64_t excluded, Value8&& value) {
+    const __m256 neg_inf = _mm256_set1_ps(-std::numeric_limits<float>::infinity());
+    const __m256i lane_bit = _mm256_setr_epi32(1, 2, 4, 8, 16, 32, 64, 128);
+    const __m256i lanes = _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7);
+    const __m256i valid_below = _mm256_set1_epi32(count);
+    __m256 best = neg_inf;
+    __m256i best_index = _mm256_set1_epi32(-1);
+
+    for (int i = 0; i < count; i += 8) {
+        const __m256i index = _mm256_add_epi32(lanes, _mm256_set1_epi32(i));
+        const __m256i bits = _mm256_set1_epi32(static_cast<int>((excluded >> i) & 0xFF));
+        const __m256i skip = _mm256_or_si256(
+            _mm256_cmpeq_epi32(_mm256_and_si256(bits, lane_bit), lane_bit),
+            _mm256_xor_si256(_mm256_cmpgt_epi32(valid_below, index), _mm256_set1_epi32(-1)));
+        const __m256 v = _mm256_blendv_ps(value(i), neg_inf, _mm256_castsi256_ps(skip));
+        const __m256 better = _mm256_cmp_ps(v, best, _CMP_GT_OQ);
+        best = _mm256_blendv_ps(best, v, better);
+        best_index = _mm256_blendv_epi8(best_index, index, _mm256_castps_si256(better));
+    }
+
+    // Each lane kept its first maximum; across lanes take the overall
+    // maximum, then the lowest index holding it
+    __m256 top = _mm256_max_ps(best, _mm256_permute2f128_ps(best, best, 1));
+    top = _mm256_max_ps(top, _mm256_shuffle_ps(top, top, _MM_SHUFFLE(1, 0, 3, 2)));
+    top = _mm256_max_ps(top, _mm256_shuffle_ps(top, top, _MM_SHUFFLE(2, 3, 0, 1)));
+    const __m256i found = _mm256_cmpgt_epi32(best_index, _mm256_set1_epi32(-1));
+    const __m256i at_top = _mm256_and_si256(_mm256_castps_si256(_mm256_cmp_ps(best, top, _CMP_EQ_OQ)), found);
+    __m256i low = _mm256_blendv_epi8(_mm256_set1_epi32(std::numeric_limits<int>::max()), best_index, at_top);
+    low = _mm256_min_epi32(low, _mm256_permute2x128_si256(low, low, 1));
+    low = _mm256_min_epi32(low, _mm256_shuffle_epi32(low, _MM_SHUFFLE(1, 0, 3, 2)));
+    low = _mm256_min_epi32(low, _mm256_shuffle_epi32(low, _MM_SHUFFLE(2, 3, 0, 1)));
+    const int result = _mm256_cvtsi256_si32(low);
+    return result == std::numeric_limits<int>::max() ? -1 : result;
+}
+#endif
+
+} // namespace detail
+
+/**
+ * @brief Child maximising UCB1 = wins / visits + c * sqrt(log_parent / visits)
+ *
+ * Unvisited children score +infinity. Arrays must be readable up to count
+ * rounded up to a multiple of 8.
+ * @param excluded Bit i set: never pick child i (count <= 64)
+ * @return Child index, -1 if every child is excluded
+ */
+inline int argmax_ucb1_scalar(const float* visits, const float* wins, int count,
+                              float log_parent, float c, uint64_t excluded) {
+    return detail::argmax_scalar(count, excluded, [&](int i) {
+        if (visits[i] == 0.0f) return std::numeric_limits<float>::infinity();
+        return wins[i] / visits[i] + c * std::sqrt(log_parent / visits[i]);
+    });
+}
+
+/**
+ * @brief Child maximising the RAVE value: the win rate blended towards the
+ *        AMAF win rate with beta = sqrt(k / (3 visits + k)), plus the UCB1
+ *        exploration term; children without AMAF samples score plain UCB1
+ */
+inline int argmax_rave_scalar(const float* visits, const float* wins, const float* amaf_visits,
+                              const float* amaf_wins, int count, float log_parent, float c,
+                              float rave_k, uint64_t excluded) {
+    return detail::argmax_scalar(count, excluded, [&](int i) {
+        if (amaf_visits[i] == 0.0f) {
+            if (visits[i] == 0.0f) return std::numeric_limits<float>::infinity();
+            return wins[i] / visits[i] + c * std::sqrt(log_parent / visits[i]);
+        }
+        const float n = std::max(visits[i], 1.0f);
+        const float beta = std::sqrt(rave_k / (3.0f * visits[i] + rave_k));
+        const float blended = (1.0f - beta) * (wins[i] / n) + beta * (amaf_wins[i] / amaf_visits[i]);
+        return blended + c * std::sqrt(log_parent / n);
+    });
+}
+
+/**
+ * @brief Child maximising (1 - alpha) * mean + alpha * value + c * sqrt(log_parent / n)
+ *        (implicit minimax backups)
+ *
+ * value is the child's backed-up evaluator value. An unvisited child is
+ * not forced first: its mean is its value and n counts as 1.
+ */
+inline int argmax_minimax_scalar(const float* visits, const float* wins, const float* values, int count,
+                                 float log_parent, float c, float alpha, uint64_t excluded) {
+    return detail::argmax_scalar(count, excluded, [&](int i) {
+        const float n = std::max(visits[i], 1.0f);
+        const float mean = visits[i] == 0.0f ? values[i] : wins[i] / n;
+        return (1.0f - alpha) * mean + alpha * values[i] + c * std::sqrt(log_parent / n);
+    });
+}
+
+/** @brief argmax_ucb1_scalar, 8 children per step with AVX2 when available */
+inline int argmax_ucb1(const float* visits, const float* wins, int count,
+                       float log_parent, float c, uint64_t excluded) {
+#if defined(__AVX2__)
+    const __m256 zero = _mm256_setzero_ps();
+    const __m256 inf = _mm256_set1_ps(std::numeric_limits<float>::infinity());
+    const __m256 one = _mm256_set1_ps(1.0f);
+    const __m256 c_sqrt_log = _mm256_set1_ps(c * std::sqrt(log_parent));
+    return detail::argmax_avx2(count, excluded, [&](int i) {
+        // One division per lane: mean = wins * (1/n), explore = c sqrt(log) sqrt(1/n)
+        const __m256 n = _mm256_loadu_ps(visits + i);
+        const __m256 inv_n = _mm256_div_ps(one, _mm256_max_ps(n, one));
+        const __m256 mean = _mm256_mul_ps(_mm256_loadu_ps(wins + i), inv_n);
+        const __m256 explore = _mm256_mul_ps(c_sqrt_log, _mm256_sqrt_ps(inv_n));
+        return _mm256_blendv_ps(_mm256_add_ps(mean, explore), inf, _mm256_cmp_ps(n, zero, _CMP_EQ_OQ));
+    });
+#else
+    return argmax_ucb1_scalar(visits, wins, count, log_parent, c, excluded);
+#endif
+}
+
+/** @brief argmax_rave_scalar, 8 children per step with AVX2 when available */
+inline int argmax_rave(const float* visits, const float* wins, const float* amaf_visits,
+                       const float* amaf_wins, int count, float log_parent, float c,
+                       float rave_k, uint64_t excluded) {
+#if defined(__AVX2__)
+    const __m256 zero = _mm256_setzero_ps();
+    const __m256 inf = _mm256_set1_ps(std::numeric_limits<float>::infinity());
+    const __m256 one = _mm256_set1_ps(1.0f);
+    const __m256 three = _mm256_set1_ps(3.0f);
+    const __m256 vlog = _mm256_set1_ps(log_parent);
+    const __m256 vc = _mm256_set1_ps(c);
+    const __m256 vk = _mm256_set1_ps(rave_k);
+    return detail::argmax_avx2(count, excluded, [&](int i) {
+        const __m256 n = _mm256_loadu_ps(visits + i);
+        const __m256 safe_n = _mm256_max_ps(n, one);
+        const __m256 amaf_n = _mm256_loadu_ps(amaf_visits + i);
+        const __m256 mean = _mm256_div_ps(_mm256_loadu_ps(wins + i), safe_n);
+        const __m256 explore = _mm256_mul_ps(vc, _mm256_sqrt_ps(_mm256_div_ps(vlog, safe_n)));
+        const __m256 ucb1 = _mm256_blendv_ps(_mm256_add_ps(mean, explore), inf,
+                                             _mm256_cmp_ps(n, zero, _CMP_EQ_OQ));
+        const __m256 beta = _mm256_sqrt_ps(_mm256_div_ps(vk, _mm256_add_ps(_mm256_mul_ps(three, n), vk)));
+        const __m256 amaf = _mm256_div_ps(_mm256_loadu_ps(amaf_wins + i), _mm256_max_ps(amaf_n, one));
+        const __m256 blended = _mm256_add_ps(_mm256_mul_ps(_mm256_sub_ps(one, beta), mean),
+                                             _mm256_mul_ps(beta, amaf));
+        return _mm256_blendv_ps(_mm256_add_ps(blended, explore), ucb1,
+                                _mm256_cmp_ps(amaf_n, zero, _CMP_EQ_OQ));
+    });
+#else
+    return argmax_rave_scalar(visits, wins, amaf_visits, amaf_wins, count, log_parent, c, rave_k, excluded);
+#endif
+}
+
+/** @brief argmax_minimax_scalar, 8 children per step with AVX2 when available */
+inline int argmax_minimax(const float* visits, const float* wins, const float* values, int count,
+                          float log_parent, float c, float alpha, uint64_t excluded) {
+#if defined(__AVX2__)
+    const __m256 zero = _mm256_setzero_ps();
+    const __m256 one = _mm256_set1_ps(1.0f);
+    const __m256 va = _mm256_set1_ps(alpha);
+    const __m256 keep = _mm256_set1_ps(1.0f - alpha);
+    const __m256 c_sqrt_log = _mm256_set1_ps(c * std::sqrt(log_parent));
+    return detail::argmax_avx2(count, excluded, [&](int i) {
+        const __m256 n = _mm256_loadu_ps(visits + i);
+        const __m256 value = _mm256_loadu_ps(values + i);
+        const __m256 inv_n = _mm256_div_ps(one, _mm256_max_ps(n, one));
+        const __m256 mean = _mm256_blendv_ps(_mm256_mul_ps(_mm256_loadu_ps(wins + i), inv_n), value,
+                                             _mm256_cmp_ps(n, zero, _CMP_EQ_OQ));
+        const __m256 blended = _mm256_add_ps(_mm256_mul_ps(keep, mean), _mm256_mul_ps(va, value));
+        return _mm256_add_ps(blended, _mm256_mul_ps(c_sqrt_log, _mm256_sqrt_ps(inv_n)));
+    });
+#else
+    return argmax_minimax_scalar(visits, wins, values, count, log_parent, c, alpha, excluded);
+#endif
+}
+
+} // namespace ucb
+
+/**
+ * @brief Visit, win, AMAF and backed-up value statistics of a node's children (SoA)
+ *
+ * One allocation holds five arrays of stride() floats (count rounded up
+ * to 8; padding lanes stay zero and are never selected).
+ */
+class ChildStats {
+public:
+    /** @brief Zeroed statistics for count children (count <= 64) */
+    void reset(int count) {
+        count_ = count;
+        stride_ = (count + 7) & ~7;
+        data_.assign(ARRAYS * static_cast<size_t>(stride_), 0.0f);
+    }
+
+    int size() const { return count_; }
+    int stride() const { return stride_; }
+    size_t bytes() const { return ARRAYS * static_cast<size_t>(stride_) * sizeof(float); }
+
+    float* visits() { return data_.data(); }
+    float* wins() { return data_.data() + stride_; }
+    float* amaf_visits() { return data_.data() + 2 * stride_; }
+    float* amaf_wins() { return data_.data() + 3 * stride_; }
+    float* values() { return data_.data() + 4 * stride_; }
+    const float* visits() const { return data_.data(); }
+    const float* wins() const { return data_.data() + stride_; }
+    const float* amaf_visits() const { return data_.data() + 2 * stride_; }
+    const float* amaf_wins() const { return data_.data() + 3 * stride_; }
+    const float* values() const { return data_.data() + 4 * stride_; }
+
+    /** @brief UCB1 argmax (see ucb::argmax_ucb1) */
+    int select_ucb1(float log_parent, float c, uint64_t excluded) const {
+        return ucb::argmax_ucb1(visits(), wins(), count_, log_parent, c, excluded);
+    }
+
+    /** @brief RAVE argmax (see ucb::argmax_rave) */
+    int select_rave(float log_parent, float c, float rave_k, uint64_t excluded) const {
+        return ucb::argmax_rave(visits(), wins(), amaf_visits(), amaf_wins(), count_, log_parent, c,
+                                rave_k, excluded);
+    }
+
+    /** @brief Implicit minimax argmax (see ucb::argmax_minimax) */
+    int select_minimax(float log_parent, float c, float alpha, uint64_t excluded) const {
+        return ucb::argmax_minimax(visits(), wins(), values(), count_, log_parent, c, alpha, excluded);
+    }
+
+private:
+    static constexpr int ARRAYS = 5;  ///< visits, wins, AMAF visits, AMAF wins, values
+
+    std::vector<float> data_;
+    int count_ = 0;
+    int stride_ = 0;
+};
+
+} // namespace reversi::ai
@@ -0,0 +1,172 @@
+/*
+ * EndgameSolver.cpp - Exact endgame solver
+ * COMP390 Honours Year Project
+ */
+
+#include "ai/EndgameSolver.hpp"
+#include "core/Trace.hpp"
+#include <algorithm>
+#include <bit>
+#include <chrono>
+
+namespace reversi::ai {
+
+namespace {
+
+constexpr uint64_t CORNERS = 0x8100000000000081ULL;
+
+struct OrderedMove {
+    int pos;
+    int key;  ///< Lower searches first
+};
+
+} // namespace
+
+EndgameSolver::EndgameSolver(int tt_bits) : tt_(tt_bits) {}
+
+int EndgameSolver::final_score(const core::Board& board) {
+    const int p = board.count_player();
+    const int o = board.count_opponent();
+    const int empties = 64 - p - o;
+    const int diff = p - o;
+    return diff > 0 ? diff + empties : diff < 0 ? diff - empties : 0;
+}
+
+EndgameSolver::Result EndgameSolver::solve(const core::Board& board, int alpha, int beta) {
+    REVERSI_TRACE("search", "endgame_solve");
+    auto start = std::chrono::steady_clock::now();
+    nodes_ = 0;
+    core::Board work = board.copy();
+    const int empties = 64 - std::popcount(board.player | board.opponent);
+
+    Result result;
+    result.score = search(work, alpha, beta, empties, &result.best_move);
+    result.nodes = nodes_;
+    result.time_ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    return result;
+}
+
+int EndgameSolver::solve_last(core::Board& board) {
+    // One empty square: whoever can play it does; no move generation needed
+    ++nodes_;
+    const int sq = std::countr_zero(~(board.player | board.opponent));
+    const int p = board.count_player();
+    uint64_t flips = board.calc_flip(sq);
+    if (flips) {
+        const int f = std::popcount(flips);
+        return 2 * (p + f) + 2 - 64;  // (p + f + 1) - (63 - p - f)
+    }
+    board.pass();
+    flips = board.calc_flip(sq);
+    board.pass();
+    if (flips) {
+        const int f = std::popcount(flips);
+        return 2 * (p - f) - 64;      // (p - f) - (64 - p + f)
+    }
+    const int diff = 2 * p - 63;      // Nobody can play: empty goes to the winner
+    return diff > 0 ? diff + 1 : diff - 1;
+}
+
+int EndgameSolver::search(core::Board& board, int alpha, int beta, int empties, int* best_move) {
+    if (empties == 1 && !best_move) return solve_last(board);
+    ++nodes_;
+
+    uint64_t moves = board.legal_moves();
+    if (moves == 0) {
+        board.pass();
+        if (board.legal_moves() == 0) {
+            board.pass();
+            return final_score(board);
+        }
+        int score = -search(board, -beta, -alpha, empties, nullptr);
+        board.pass();
+        return score;
+    }
+
+    const int alpha_orig = alpha;
+    const uint64_t hash = board.hash();
+    int tt_move = -1;
+    if (empties >= TT_MIN_EMPTIES) {
+        if (TTEntry* e = tt_.probe(hash)) {
+            tt_move = e->best_move;
+            const auto flag = static_cast<TTFlag>(e->flag);
+            if (!best_move || flag == TTFlag::EXACT) {
+                if (flag == TTFlag::EXACT) {
+                    if (best_move) *best_move = tt_move;
+                    return e->score;
+                }
+                if (flag == TTFlag::LOWER_BOUND) alpha = std::max(alpha, static_cast<int>(e->score));
+                else beta = std::min(beta, static_cast<int>(e->score));
+                if (alpha >= beta) return e->score;
+            }
+        }
+    }
+
+    // Move list: table move, then corners, then fewest opponent replies
+    OrderedMove list[32];
+    int count = 0;
+    const uint64_t p = board.player, o = board.opponent;
+    while (moves) {
+        const int pos = std::countr_zero(moves);
+        moves &= moves - 1;
+        int key = 0;
+        if (empties >= ORDER_MIN_EMPTIES) {
+            if (pos == tt_move) {
+                key = -1000;
+            } else {
+                board.apply_move_no_history(pos);
+                key = std::popcount(board.legal_moves()) * 16;
+                board.restore_state(p, o, hash);
+                if ((CORNERS >> pos) & 1) key -= 64;
+            }
+        }
+        list[count++] = {pos, key};
+    }
+    if (empties >= ORDER_MIN_EMPTIES) {
+        std::sort(list, list + count, [](const OrderedMove& a, const OrderedMove& b) { return a.key < b.key; });
+    }
+
+    int best = -65;
+    int best_pos = list[0].pos;
+    for (int i = 0; i < count; ++i) {
+        const int pos = list[i].pos;
+        board.apply_move_no_history(pos);
+        int score;
+        if (i == 0) {
+            score = -search(board, -beta, -alpha, empties - 1, nullptr);
+        } else {
+            // Null window first; re-search only if the move beats alpha
+            score = -search(board, -alpha - 1, -alpha, empties - 1, nullptr);
+            if (score > alpha && score < beta) {
+                score = -search(board, -beta, -score, empties - 1, nullptr);
+            }
+        }
+        board.restore_state(p, o, hash);
+
+        if (score > best) {
+            best = score;
+            best_pos = pos;
+            if (score > alpha) alpha = score;
+            if (alpha >= beta) break;
+        }
+    }
+
+    if (empties >= TT_MIN_EMPTIES) {
+        TTEntry entry{};
+        entry.hash = hash;
+        entry.hash_low = static_cast<uint32_t>(hash & 0xFFFFFFFFu);
+        entry.score = best;
+        entry.depth = static_cast<int8_t>(empties);
+        entry.flag = static_cast<uint8_t>(best <= alpha_orig ? TTFlag::UPPER_BOUND
+                                          : best >= beta     ? TTFlag::LOWER_BOUND
+                                                             : TTFlag::EXACT);
+        entry.best_move = static_cast<int8_t>(best_pos);
+        // Same position always has the same depth here, so refresh in place
+        if (TTEntry* existing = tt_.probe(hash)) *existing = entry;
+        else tt_.store(entry);
+    }
+    if (best_move) *best_move = best_pos;
+    return best;
+}
+
+} // namespace reversi::ai
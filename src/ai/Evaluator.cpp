@@ -4,11 +4,13 @@
  */
 
 #include "ai/Evaluator.hpp"
+#include "core/Trace.hpp"
 #include <bit>
 
 namespace reversi::ai {
 
 int Evaluator::evaluate(const reversi::core::Board& board) noexcept {
+    REVERSI_TRACE_HOT("eval", "evaluate");
     // Terminal state: return definitive score
     if (board.is_terminal()) {
         const int diff = board.count_player() - board.count_opponent();
@@ -64,12 +66,10 @@ int Evaluator::position_score(const reversi::core::Board& board) noexcept {
 
 int Evaluator::mobility_score(const reversi::core::Board& board) noexcept {
     // Current player's mobility
-    const int player_moves = static_cast<int>(board.get_legal_moves().size());
+    const int player_moves = std::popcount(board.legal_moves());
     
-    // Opponent's mobility (after pass)
-    reversi::core::Board opp_board = board;
-    opp_board.pass();
-    const int opp_moves = static_cast<int>(opp_board.get_legal_moves().size());
+    // Opponent's mobility (as if the current player passed)
+    const int opp_moves = std::popcount(board.opponent_legal_moves());
     
     return player_moves - opp_moves;
 }
@@ -42,6 +42,11 @@ public:
      */
     static int evaluate(const reversi::core::Board& board) noexcept;
     
+    /**
+     * @brief Identifier for reports (BoardEvaluator interface)
+     */
+    static constexpr const char* name() noexcept { return "Week3"; }
+    
 private:
     /**
      * @brief Position weight table
@@ -0,0 +1,42 @@
+/*
+ * EvaluatorConcept.hpp - Compile-time evaluator interface
+ * COMP390 Honours Year Project
+ *
+ * Evaluators are stateless types with static member functions rather
+ * than virtual classes, so a search instantiated with one can inline the
+ * evaluation into the node loop. Any type satisfying BoardEvaluator
+ * (Evaluator, EvaluatorWeek4, EvaluatorWeek4Fast, future pattern
+ * evaluators) can be plugged into MinimaxEngine via UseEvaluator<E>.
+ */
+
+#pragma once
+
+#include "core/Board.hpp"
+#include <concepts>
+#include <string_view>
+
+namespace reversi::ai {
+
+/**
+ * @brief Requirements for a position evaluator
+ *
+ * - E::evaluate(board): noexcept, score from the side to move's perspective
+ * - E::name(): short identifier used in engine names and reports
+ */
+template <typename E>
+concept BoardEvaluator = requires(const reversi::core::Board& board) {
+    { E::evaluate(board) } noexcept -> std::convertible_to<int>;
+    { E::name() } -> std::convertible_to<std::string_view>;
+};
+
+/**
+ * @brief Tag selecting an evaluator at engine construction
+ *
+ * Example: MinimaxEngine engine(config, UseEvaluator<EvaluatorWeek4>{});
+ */
+template <BoardEvaluator E>
+struct UseEvaluator {
+    using type = E;
+};
+
+} // namespace reversi::ai
@@ -4,11 +4,13 @@
  */
 
 #include "ai/Evaluator_Week4.hpp"
+#include "core/Trace.hpp"
 #include <bit>
 
 namespace reversi::ai {
 
 int EvaluatorWeek4::evaluate(const reversi::core::Board& board) noexcept {
+    REVERSI_TRACE_HOT("eval", "evaluate_week4");
     // Terminal state: return definitive score
     if (board.is_terminal()) {
         const int diff = board.count_player() - board.count_opponent();
@@ -54,6 +56,19 @@ int EvaluatorWeek4::evaluate(const reversi::core::Board& board) noexcept {
     return score;
 }
 
+EvaluatorWeek4::Features EvaluatorWeek4::extract_features(const reversi::core::Board& board) noexcept {
+    const auto stability = StabilityAnalyzer::analyze(board);
+    return {
+        piece_count_score(board),
+        mobility_score(board),
+        potential_mobility_score(board),
+        stability.stable_count,
+        stability.frontier_count,
+        position_score(board, 1),
+        corner_control_score(board)
+    };
+}
+
 int EvaluatorWeek4::evaluate_fast(const reversi::core::Board& board) noexcept {
     // Terminal state
     if (board.is_terminal()) {
@@ -81,12 +96,10 @@ int EvaluatorWeek4::evaluate_fast(const reversi::core::Board& board) noexcept {
 
 int EvaluatorWeek4::mobility_score(const reversi::core::Board& board) noexcept {
     // Current player's mobility
-    const int player_moves = static_cast<int>(board.get_legal_moves().size());
+    const int player_moves = std::popcount(board.legal_moves());
     
-    // Opponent's mobility (after pass)
-    reversi::core::Board opp_board = board;
-    opp_board.pass();
-    const int opp_moves = static_cast<int>(opp_board.get_legal_moves().size());
+    // Opponent's mobility (as if the current player passed)
+    const int opp_moves = std::popcount(board.opponent_legal_moves());
     
     return player_moves - opp_moves;
 }
@@ -16,6 +16,7 @@
 #include "core/Board.hpp"
 #include "ai/StabilityAnalyzer.hpp"
 #include "ai/PhaseWeights.hpp"
+#include <array>
 #include <cstdint>
 
 namespace reversi::ai {
@@ -53,6 +54,21 @@ public:
      */
     static int evaluate_fast(const reversi::core::Board& board) noexcept;
     
+    /**
+     * @brief Raw evaluation terms, in PhaseWeights::FIELDS order
+     * 
+     * For a non-terminal position evaluate() equals the sum of
+     * features[i] * (weights.*PhaseWeights::FIELDS[i]) with the weights of
+     * the position's phase. Used by the Texel tuner.
+     */
+    using Features = std::array<int, PhaseWeights::NUM_FIELDS>;
+    static Features extract_features(const reversi::core::Board& board) noexcept;
+    
+    /**
+     * @brief Identifier for reports (BoardEvaluator interface)
+     */
+    static constexpr const char* name() noexcept { return "Week4"; }
+    
 private:
     /**
      * @brief Calculate piece count score (material)
@@ -101,5 +117,15 @@ private:
     };
 };
 
+/**
+ * @brief EvaluatorWeek4::evaluate_fast as a standalone BoardEvaluator
+ */
+struct EvaluatorWeek4Fast {
+    static int evaluate(const reversi::core::Board& board) noexcept {
+        return EvaluatorWeek4::evaluate_fast(board);
+    }
+    static constexpr const char* name() noexcept { return "Week4Fast"; }
+};
+
 } // namespace reversi::ai
 
@@ -7,6 +7,9 @@
  */
 
 #include "ai/MCTSEngine.hpp"
+#include "ai/PlayoutKernel.hpp"
+#include "core/Trace.hpp"
+#include <bit>
 #include <chrono>
 #include <algorithm>
 #include <cmath>
@@ -20,6 +23,8 @@ MCTSEngine::MCTSEngine()
     : config_()
     , rng_(std::random_device{}())
 {
+    path_.reserve(128);
+    path_edges_.reserve(128);
     stats_.reset();
 }
 
@@ -27,6 +32,11 @@ MCTSEngine::MCTSEngine(const Config& config)
     : config_(config)
     , rng_(std::random_device{}())
 {
+    if (config_.seed != 0) {
+        set_seed(config_.seed);
+    }
+    path_.reserve(128);
+    path_edges_.reserve(128);
     stats_.reset();
 }
 
@@ -34,23 +44,32 @@ MCTSEngine::MCTSEngine(const Config& config)
 
 void MCTSEngine::reset() {
     stats_.reset();
-    root_.reset();
+    nodes_.clear();
+    free_nodes_.clear();
+    table_.clear();
+    tree_bytes_ = 0;
+    root_ = nullptr;
     total_playout_moves_ = 0;
 }
 
 core::Move MCTSEngine::find_best_move(const core::Board& board, 
                                       const SearchLimits& limits) {
+    REVERSI_TRACE("mcts", "find_best_move");
     stats_.reset();
     total_playout_moves_ = 0;
     auto start_time = std::chrono::steady_clock::now();
     
-    // Create root node
-    root_ = std::make_unique<Node>();
-    root_->board_state = board;
-    root_->expand(board);
-    
-    if (root_->is_terminal) {
-        // Terminal position - return pass move
+    // Create root node (pool and table keep their capacity between searches)
+    nodes_.clear();
+    free_nodes_.clear();
+    table_.clear();
+    tree_bytes_ = 0;
+    // Position only: tree and playout boards then copy without move history
+    root_ = get_node(board.copy());
+    expand(root_);
+    
+    if (root_->is_terminal || root_->children[0].move < 0) {
+        // Terminal position or forced pass - return pass move
         return core::Move(core::Move::PASS);
     }
     
@@ -73,38 +92,73 @@ core::Move MCTSEngine::find_best_move(const core::Board& board,
             }
         }
         
+        if (over_budget()) {
+            reclaim_memory();
+        }
+        
         // MCTS four phases
-        Node* leaf = selection(root_.get());        // 1. Selection
+        Node* leaf = selection(root_);              // 1. Selection
         Node* expanded = expansion(leaf);            // 2. Expansion
         double result = simulation(expanded);        // 3. Simulation
-        backpropagation(expanded, result);          // 4. Backpropagation
+        backpropagation(result);                    // 4. Backpropagation
+        if (config_.use_rave) {
+            update_amaf(result);
+        }
+        if (config_.use_solver) {
+            update_proofs();
+        }
+        stats_.max_tree_depth = std::max(stats_.max_tree_depth, static_cast<int>(path_.size()) - 1);
         
         simulations++;
         stats_.simulations_performed++;
+        
+        if (root_->proof != Proof::None) {
+            // Root decided: further simulations cannot change the move
+            stats_.root_solved = true;
+            break;
+        }
     }
     
     // Select best move (most visited child)
-    core::Move best_move = select_best_move(root_.get());
+    core::Move best_move = select_best_move(root_);
     
     // Update statistics
     auto elapsed = std::chrono::steady_clock::now() - start_time;
     stats_.time_elapsed_ms = std::chrono::duration_cast<std::chrono::milliseconds>(elapsed).count();
-    stats_.tree_nodes_created = count_tree_nodes(root_.get());
+    stats_.tree_nodes_created = static_cast<int>(nodes_.size());
+    stats_.tree_bytes = tree_bytes_;
     stats_.nodes_searched = stats_.tree_nodes_created;
     stats_.nodes_per_second = (stats_.time_elapsed_ms > 0) ?
         (stats_.simulations_performed * 1000.0 / stats_.time_elapsed_ms) : 0.0;
     stats_.average_playout_length = (stats_.simulations_performed > 0) ?
         (total_playout_moves_ / static_cast<double>(stats_.simulations_performed)) : 0.0;
-    stats_.max_tree_depth = calculate_max_depth(root_.get(), 0);
+    stats_.solved_nodes = count_solved_nodes();
+    // Root proof is for the player who moved into the root (the opponent)
+    if (root_->proof == Proof::Win) stats_.root_result = -1;
+    if (root_->proof == Proof::Loss) stats_.root_result = 1;
     
-    // Calculate win rate and move statistics
+    // Calculate win rate and move statistics (root wins count for the opponent)
     if (!root_->children.empty()) {
-        stats_.win_rate = (root_->visits > 0) ? (root_->wins / root_->visits) : 0.0;
-        for (const auto& child : root_->children) {
-            stats_.move_visit_counts.push_back(child->visits);
-            stats_.move_win_rates.push_back((child->visits > 0) ? 
-                (child->wins / child->visits) : 0.0);
+        const ChildStats& edges = root_->stats;
+        double total_visits = 0.0;
+        double total_wins = 0.0;
+        for (size_t i = 0; i < root_->children.size(); ++i) {
+            const Node* child = root_->children[i].node;
+            const double visits = edges.visits()[i];
+            total_visits += visits;
+            total_wins += edges.wins()[i];
+            stats_.move_visit_counts.push_back(static_cast<int>(visits));
+            stats_.move_win_rates.push_back((visits > 0) ? 
+                (edges.wins()[i] / visits) : 0.0);
+            if (root_->children[i].move == best_move.position) {
+                // Chosen child's value in per-mille: -1000 (loss) .. 1000 (win)
+                if (child->proof == Proof::Win) stats_.score = 1000;
+                else if (child->proof == Proof::Loss) stats_.score = -1000;
+                else if (child->proof == Proof::Draw) stats_.score = 0;
+                else stats_.score = static_cast<int>(std::lround(2000.0 * stats_.move_win_rates.back() - 1000.0));
+            }
         }
+        stats_.win_rate = (total_visits > 0) ? total_wins / total_visits : 0.0;
     }
     
     return best_move;
@@ -113,186 +167,330 @@ core::Move MCTSEngine::find_best_move(const core::Board& board,
 // ==================== MCTS Algorithm Phases ====================
 
 MCTSEngine::Node* MCTSEngine::selection(Node* root) {
+    REVERSI_TRACE_HOT("mcts", "selection");
     Node* current = root;
+    path_.clear();
+    path_edges_.clear();
+    path_.push_back(current);
+    const double rave_k = config_.use_rave ? config_.rave_k : 0.0;
     
-    // Traverse tree using UCB1 until we reach a leaf
+    // Traverse tree using UCB1 until we reach a leaf (or a proven node)
     while (!current->is_leaf()) {
-        current = current->select_best_child(config_.ucb1_c);
-        if (current == nullptr) {
-            // Should not happen, but handle gracefully
+        if (config_.use_solver && current->proof != Proof::None) break;
+        const int index = current->select_child(config_.ucb1_c, config_.use_solver, rave_k, minimax_weight());
+        if (index < 0) {
+            // All children proven, some through another parent (transpositions):
+            // prove this node now and let the simulation return its value
+            update_proofs();
             break;
         }
+        current = current->children[index].node;
+        path_edges_.push_back(index);
+        path_.push_back(current);
     }
     
     return current;
 }
 
 MCTSEngine::Node* MCTSEngine::expansion(Node* leaf) {
-    if (leaf->is_terminal) {
-        return leaf; // Cannot expand terminal nodes
+    REVERSI_TRACE_HOT("mcts", "expansion");
+    if (leaf->is_terminal || (config_.use_solver && leaf->proof != Proof::None)) {
+        return leaf; // Cannot expand terminal nodes (or solved ones)
     }
     
     if (!leaf->is_expanded) {
-        leaf->expand(leaf->board_state);
+        if (over_budget()) {
+            return leaf; // Nothing left to reclaim: simulate from the leaf
+        }
+        expand(leaf);
+    }
+    
+    if (leaf->children.empty()) {
+        return leaf;
+    }
+    
+    // First unvisited child (UCB1 scores it +infinity), else the best by
+    // UCB1 / RAVE / implicit minimax skipping proven children, else a random child
+    int index = leaf->select_child(config_.ucb1_c, config_.use_solver, config_.use_rave ? config_.rave_k : 0.0,
+                                   minimax_weight());
+    if (index < 0) {
+        index = static_cast<int>(rng_.below(static_cast<uint32_t>(leaf->children.size())));
+    }
+    Node* child = leaf->children[index].node;
+    path_edges_.push_back(index);
+    path_.push_back(child);
+    return child;
+}
+
+void MCTSEngine::expand(Node* node) {
+    if (node->is_expanded || node->is_terminal) return;
+    
+    const core::Board& board = node->board_state;
+    uint64_t legal = board.legal_moves();
+    if (legal == 0) {
+        if (board.opponent_legal_moves() == 0) {
+            node->is_terminal = true;
+            node->proof = Node::final_proof(board);
+            return;
+        }
+        core::Board next = board;
+        next.pass();
+        node->children.push_back(Edge{-1, get_node(next)});
+        node->stats.reset(1);
+    } else {
+        node->children.reserve(std::popcount(legal));
+        for (; legal != 0; legal &= legal - 1) {
+            const int move = std::countr_zero(legal);
+            core::Board next = board;
+            next.apply_move_no_history(move);
+            node->children.push_back(Edge{move, get_node(next)});
+        }
+        node->stats.reset(static_cast<int>(node->children.size()));
     }
     
-    // Return first unvisited child, or random child if all visited
-    if (!leaf->children.empty()) {
-        // Find unvisited child
-        for (auto& child : leaf->children) {
-            if (child->visits == 0) {
-                return child.get();
+    if (minimax_weight() > 0.0) {
+        // Implicit minimax: every child starts with its evaluator value (for the mover)
+        float* values = node->stats.values();
+        for (size_t i = 0; i < node->children.size(); ++i) {
+            values[i] = static_cast<float>(1.0 - evaluate_leaf(node->children[i].node->board_state));
+        }
+    }
+    
+    node->is_expanded = true;
+    tree_bytes_ += node->children.capacity() * sizeof(Edge) + node->stats.bytes();
+}
+
+MCTSEngine::Node* MCTSEngine::get_node(const core::Board& board) {
+    Node** slot = nullptr;
+    if (config_.use_transpositions) {
+        auto [it, inserted] = table_.try_emplace(board.hash(), nullptr);
+        if (!inserted) {
+            Node* existing = it->second;
+            if (existing->board_state.player == board.player &&
+                existing->board_state.opponent == board.opponent) {
+                stats_.transpositions++;
+                return existing;
             }
+            // Hash collision: this position gets a node of its own, outside the table
+        } else {
+            slot = &it->second;
+            tree_bytes_ += TABLE_ENTRY_BYTES;
         }
-        // All children visited, return random child
-        std::uniform_int_distribution<size_t> dist(0, leaf->children.size() - 1);
-        return leaf->children[dist(rng_)].get();
     }
     
-    return leaf;
+    if (free_nodes_.empty()) {
+        nodes_.push_back(std::make_unique<Node>(board));
+    } else {
+        // Recycle a reclaimed node (no allocation)
+        nodes_.push_back(std::move(free_nodes_.back()));
+        free_nodes_.pop_back();
+        *nodes_.back() = Node(board);
+    }
+    tree_bytes_ += sizeof(Node);
+    Node* node = nodes_.back().get();
+    node->is_terminal = board.is_terminal();
+    if (node->is_terminal) {
+        node->proof = Node::final_proof(board);
+    }
+    if (slot != nullptr) {
+        *slot = node;
+    }
+    return node;
 }
 
 double MCTSEngine::simulation(Node* node) {
+    REVERSI_TRACE_HOT("mcts", "playout");
+    playout_moves_[0] = playout_moves_[1] = 0;
     if (node->is_terminal) {
         // Terminal node - return actual game result
-        int winner = node->board_state.get_winner();
-        if (winner == 1) return 1.0;      // Current player wins
-        if (winner == -1) return 0.0;     // Opponent wins
-        return 0.0; // Draw treated as loss (conservative)
+        return node->proof == Proof::Win ? 1.0 : 0.0; // Draw treated as loss (conservative)
+    }
+    if (config_.use_solver) {
+        if (node->proof != Proof::None) {
+            return node->proof == Proof::Win ? 1.0 : 0.0;
+        }
+        if (config_.solve_empties > 0 &&
+            std::popcount(~(node->board_state.player | node->board_state.opponent)) <= config_.solve_empties) {
+            // Exact mini-solve: a null window around 0 decides win / draw / loss
+            if (!endgame_) {
+                endgame_ = std::make_unique<EndgameSolver>(ENDGAME_TT_BITS);
+            }
+            const int score = endgame_->solve(node->board_state, -1, 1).score;  // Side to move
+            node->proof = score < 0 ? Proof::Win : (score > 0 ? Proof::Loss : Proof::Draw);
+            return node->proof == Proof::Win ? 1.0 : 0.0;
+        }
     }
     
-    // Run playout
-    int result;
+    double leaf_value = 0.0;
+    if (config_.use_leaf_eval) {
+        // Hybrid: the evaluator's view, for the player who moved into node
+        // (with implicit minimax, already on the edge from the parent)
+        if (minimax_weight() > 0.0 && path_.size() > 1) {
+            leaf_value = path_[path_.size() - 2]->stats.values()[path_edges_.back()];
+        } else {
+            leaf_value = 1.0 - evaluate_leaf(node->board_state);
+        }
+        if (config_.leaf_eval_weight >= 1.0) {
+            return leaf_value;
+        }
+    }
+    
+    // Run playout (disc difference for the side to move at node)
+    int diff;
     if (config_.use_heuristic_playout) {
-        result = heuristic_playout(node->board_state);
+        diff = heuristic_playout(node->board_state);
     } else {
-        result = random_playout(node->board_state);
+        diff = random_playout(node->board_state);
     }
     
-    return static_cast<double>(result);
+    // The player who moved into node wins when the side to move loses
+    const double result = diff < 0 ? 1.0 : 0.0; // Draw treated as loss (conservative)
+    if (config_.use_leaf_eval) {
+        return config_.leaf_eval_weight * leaf_value + (1.0 - config_.leaf_eval_weight) * result;
+    }
+    return result;
 }
 
-void MCTSEngine::backpropagation(Node* node, double result) {
-    node->backpropagate(result);
+double MCTSEngine::evaluate_leaf(const core::Board& board) {
+    REVERSI_TRACE_HOT("mcts", "leaf_eval");
+    stats_.leaf_evaluations++;
+    core::Board position = board;
+    bool flipped = false;   // Side to move at position differs from board's
+    for (;;) {
+        const uint64_t legal = position.legal_moves();
+        if (legal == 0) {
+            if (position.opponent_legal_moves() == 0) {
+                // Finished game (draw treated as loss, like playouts)
+                return position.get_winner() > 0 ? (flipped ? 0.0 : 1.0) : (flipped ? 1.0 : 0.0);
+            }
+            position.pass();
+        } else if (config_.leaf_search_depth > 0 && (legal & (legal - 1)) == 0) {
+            // MinimaxEngine does not search a single legal move: play it
+            position.apply_move_no_history(std::countr_zero(legal));
+        } else {
+            break;
+        }
+        flipped = !flipped;
+    }
+    
+    int score;
+    if (config_.leaf_search_depth > 0) {
+        if (!leaf_search_) {
+            leaf_search_ = make_leaf_search_();
+        }
+        if (leaf_search_->config().max_depth != config_.leaf_search_depth) {
+            MinimaxEngine::Config search_config = leaf_search_->config();
+            search_config.max_depth = config_.leaf_search_depth;
+            leaf_search_->set_config(search_config);
+        }
+        score = leaf_search_->find_best_move(position).score;
+    } else {
+        score = leaf_eval_(position);
+    }
+    const double p = 1.0 / (1.0 + std::exp(-score / config_.leaf_eval_scale));
+    return flipped ? 1.0 - p : p;
 }
 
-// ==================== Playout Methods ====================
-
-int MCTSEngine::random_playout(const core::Board& board) {
-    core::Board current = board;
-    int move_count = 0;
-    
-    while (!current.is_terminal()) {
-        std::vector<int> legal_moves;
-        current.get_legal_moves(legal_moves);
+void MCTSEngine::backpropagation(double result) {
+    REVERSI_TRACE_HOT("mcts", "backpropagation");
+    // The path actually taken: a shared node's other parents are not touched
+    // Edge statistics live in the parent: path_[i] credits the edge to path_[i + 1]
+    const size_t last = path_.size() - 1;
+    const bool implicit_minimax = minimax_weight() > 0.0;
+    path_[last]->visits++;
+    for (size_t i = last; i-- > 0;) {
+        Node* node = path_[i];
+        const int edge = path_edges_[i];
+        node->visits++;
+        node->stats.visits()[edge] += 1.0f;
+        node->stats.wins()[edge] += static_cast<float>(result);
+        result = 1.0 - result; // Invert for opponent's perspective
         
-        if (legal_moves.empty()) {
-            current.pass();
-            continue;
+        const Node* child = path_[i + 1];
+        if (implicit_minimax && !child->children.empty()) {
+            const float* values = child->stats.values();
+            const float best = *std::max_element(values, values + child->children.size());
+            node->stats.values()[edge] = 1.0f - best;
         }
-        
-        // Random selection
-        std::uniform_int_distribution<size_t> dist(0, legal_moves.size() - 1);
-        int random_idx = dist(rng_);
-        current.make_move(legal_moves[random_idx]);
-        move_count++;
     }
-    
-    total_playout_moves_ += move_count;
-    
-    // Return result from original player's perspective
-    int player_count = current.count_player();
-    int opponent_count = current.count_opponent();
-    
-    if (player_count > opponent_count) return 1;
-    if (player_count < opponent_count) return 0;
-    return 0; // Draw treated as loss (conservative)
 }
 
-int MCTSEngine::heuristic_playout(const core::Board& board) {
-    core::Board current = board;
-    int move_count = 0;
-    
-    while (!current.is_terminal()) {
-        std::vector<int> legal_moves;
-        current.get_legal_moves(legal_moves);
-        
-        if (legal_moves.empty()) {
-            current.pass();
-            continue;
+void MCTSEngine::update_amaf(double result) {
+    // Moves by the side to move at the last node (index 0) and by the other side
+    uint64_t played[2] = {playout_moves_[0], playout_moves_[1]};
+    const size_t last = path_.size() - 1;
+    for (size_t i = last + 1; i-- > 0;) {
+        Node* node = path_[i];
+        const size_t side = (last - i) & 1;   // Every edge, passes included, changes the side
+        if (i < last) {
+            // Move from node to the next path node (none for a pass)
+            const int move = node->children[path_edges_[i]].move;
+            if (move >= 0) played[side] |= 1ULL << move;
         }
         
-        // Score all legal moves
-        std::vector<std::pair<int, int>> scored_moves; // (score, move)
-        scored_moves.reserve(legal_moves.size());
-        
-        for (int move : legal_moves) {
-            int score = evaluate_move_heuristic(current, move);
-            scored_moves.push_back({score, move});
+        // Result for the side to move at node (who moved into its children)
+        const float mover_result = static_cast<float>((side == 0) ? 1.0 - result : result);
+        float* amaf_visits = node->stats.amaf_visits();
+        float* amaf_wins = node->stats.amaf_wins();
+        for (size_t e = 0; e < node->children.size(); ++e) {
+            const int move = node->children[e].move;
+            if (move >= 0 && ((played[side] >> move) & 1ULL)) {
+                amaf_visits[e] += 1.0f;
+                amaf_wins[e] += mover_result;
+            }
         }
-        
-        // Sort by score (descending)
-        std::sort(scored_moves.rbegin(), scored_moves.rend());
-        
-        // Select from top N% moves (with randomness)
-        int top_n = std::max(1, static_cast<int>(scored_moves.size() * 
-            config_.playout_heuristic_weight));
-        std::uniform_int_distribution<size_t> dist(0, top_n - 1);
-        int random_idx = dist(rng_);
-        
-        current.make_move(scored_moves[random_idx].second);
-        move_count++;
     }
-    
-    total_playout_moves_ += move_count;
-    
-    // Return result from original player's perspective
-    int player_count = current.count_player();
-    int opponent_count = current.count_opponent();
-    
-    if (player_count > opponent_count) return 1;
-    if (player_count < opponent_count) return 0;
-    return 0; // Draw treated as loss (conservative)
 }
 
-int MCTSEngine::evaluate_move_heuristic(const core::Board& board, int move) {
-    int score = 0;
-    
-    // Position-based heuristics
-    static constexpr int CORNER_BONUS = 100;
-    static constexpr int EDGE_BONUS = 10;
-    static constexpr int X_SQUARE_PENALTY = -50; // Dangerous X-square
-    static constexpr int C_SQUARE_PENALTY = -20; // Risky C-square
-    
-    int row = move / 8;
-    int col = move % 8;
-    
-    // Corner positions (A1, H1, A8, H8)
-    if ((row == 0 || row == 7) && (col == 0 || col == 7)) {
-        score += CORNER_BONUS;
-    }
-    // X-squares (B2, G2, B7, G7) - dangerous
-    else if ((row == 1 || row == 6) && (col == 1 || col == 6)) {
-        score += X_SQUARE_PENALTY;
-    }
-    // C-squares (A2, B1, etc.) - risky
-    else if ((row == 0 || row == 7) || (col == 0 || col == 7)) {
-        if ((row <= 1 || row >= 6) && (col <= 1 || col >= 6)) {
-            score += C_SQUARE_PENALTY;
+void MCTSEngine::update_proofs() {
+    for (auto it = path_.rbegin(); it != path_.rend(); ++it) {
+        Node* current = *it;
+        if (current->proof != Proof::None) continue;   // Proven already: try the parent
+        if (current->children.empty()) return;
+        
+        // Children are proven for the player to move here; the mask lets
+        // selection skip them without touching the child nodes
+        uint64_t proven = 0;
+        bool any_draw = false;
+        bool any_win = false;
+        float* values = current->stats.values();
+        for (size_t i = 0; i < current->children.size(); ++i) {
+            const Proof proof = current->children[i].node->proof;
+            if (proof == Proof::None) continue;
+            proven |= 1ULL << i;
+            values[i] = proof == Proof::Win ? 1.0f : 0.0f;   // Exact from now on (draw as loss)
+            any_win = any_win || proof == Proof::Win;
+            any_draw = any_draw || proof == Proof::Draw;
+        }
+        current->proven_children = proven;
+        const bool all_proven = proven == ~0ULL >> (64 - current->children.size());
+        if (any_win) {
+            current->proof = Proof::Loss;
+        } else if (all_proven) {
+            current->proof = any_draw ? Proof::Draw : Proof::Win;
         } else {
-            score += EDGE_BONUS;
+            return;
         }
     }
-    
-    // Mobility: prefer moves that give opponent fewer options
-    core::Board test_board = board;
-    test_board.make_move(move);
-    std::vector<int> opponent_moves;
-    test_board.get_legal_moves(opponent_moves);
-    int opponent_mobility = opponent_moves.size();
-    score -= opponent_mobility * 2; // Lower opponent mobility = better
-    
-    return score;
+}
+
+// ==================== Playout Methods ====================
+
+int MCTSEngine::random_playout(const core::Board& board) {
+    int move_count = 0;
+    const int diff = playout::random_game(board.get_player_bb(), board.get_opponent_bb(), rng_, move_count,
+                                          config_.use_rave ? playout_moves_ : nullptr);
+    total_playout_moves_ += move_count;
+    return diff;
+}
+
+int MCTSEngine::heuristic_playout(const core::Board& board) {
+    int move_count = 0;
+    const int diff = playout::heuristic_game(board.get_player_bb(), board.get_opponent_bb(),
+                                             config_.playout_heuristic_weight, rng_, move_count,
+                                             config_.use_rave ? playout_moves_ : nullptr);
+    total_playout_moves_ += move_count;
+    return diff;
 }
 
 // ==================== Helper Methods ====================
@@ -302,14 +500,23 @@ core::Move MCTSEngine::select_best_move(Node* root) {
         return core::Move(core::Move::PASS);
     }
     
-    // Select most visited child
-    Node* best = nullptr;
-    int max_visits = -1;
-    
-    for (const auto& child : root->children) {
-        if (child->visits > max_visits) {
-            max_visits = child->visits;
-            best = child.get();
+    // Select most visited child, ranking proven wins first and proven losses last
+    auto rank = [](const Node* child) {
+        if (child->proof == Proof::Win) return 2;
+        return child->proof == Proof::Loss ? 0 : 1;
+    };
+    const Edge* best = nullptr;
+    int best_rank = -1;
+    float max_visits = -1.0f;
+    
+    for (size_t i = 0; i < root->children.size(); ++i) {
+        const Edge& edge = root->children[i];
+        const float visits = root->stats.visits()[i];
+        const int r = rank(edge.node);
+        if (r > best_rank || (r == best_rank && visits > max_visits)) {
+            best_rank = r;
+            max_visits = visits;
+            best = &edge;
         }
     }
     
@@ -320,30 +527,110 @@ core::Move MCTSEngine::select_best_move(Node* root) {
     return core::Move(best->move);
 }
 
-int MCTSEngine::count_tree_nodes(Node* node) const {
-    if (node == nullptr) return 0;
-    
-    int count = 1; // Count this node
-    for (const auto& child : node->children) {
-        count += count_tree_nodes(child.get());
+int MCTSEngine::count_solved_nodes() const {
+    int count = 0;
+    for (const auto& node : nodes_) {
+        count += node->proof != Proof::None ? 1 : 0;
     }
-    
     return count;
 }
 
-int MCTSEngine::calculate_max_depth(Node* node, int depth) const {
-    if (node == nullptr) return depth;
-    
-    int max_depth = depth;
-    for (const auto& child : node->children) {
-        int child_depth = calculate_max_depth(child.get(), depth + 1);
-        if (child_depth > max_depth) {
-            max_depth = child_depth;
+MCTSEngine::NodeView MCTSEngine::view_node(const std::vector<int>& moves) const {
+    NodeView view;
+    const Node* node = root_;
+    for (int move : moves) {
+        if (!node) return view;
+        const Node* next = nullptr;
+        for (const Edge& edge : node->children) {
+            if (edge.move == move) {
+                next = edge.node;
+                break;
+            }
+        }
+        node = next;
+    }
+    if (!node) return view;
+    view.id = node;
+    view.hash = node->board_state.hash();
+    view.visits = node->visits;
+    view.proven = node->proof != Proof::None;
+    view.proof = node->proof == Proof::Win ? 1 : node->proof == Proof::Loss ? -1 : 0;
+    for (const Edge& edge : node->children) view.moves.push_back(edge.move);
+    view.stats = &node->stats;
+    return view;
+}
+
+// ==================== Memory Budget ====================
+
+void MCTSEngine::reclaim_memory() {
+    REVERSI_TRACE("mcts", "reclaim_memory");
+    const size_t target = (config_.memory_budget_mb << 20) / 4 * 3;
+    while (tree_bytes_ > target) {
+        // Expanded nodes, least visited first: their subtrees carry the least information
+        scratch_.clear();
+        for (const auto& node : nodes_) {
+            if (node->is_expanded && !node->children.empty() && node.get() != root_) {
+                scratch_.push_back(node.get());
+            }
+        }
+        if (scratch_.empty()) return;
+        std::sort(scratch_.begin(), scratch_.end(),
+                  [](const Node* a, const Node* b) { return a->visits < b->visits; });
+        
+        // Collapse until the children released would cover the excess; shared
+        // children (transpositions) stay alive, so re-check after the sweep
+        const size_t excess = tree_bytes_ - target;
+        size_t released = 0;
+        for (Node* node : scratch_) {
+            if (released >= excess) break;
+            released += node_bytes(*node) - sizeof(Node) + node->children.size() * sizeof(Node);
+            std::vector<Edge>().swap(node->children);
+            node->stats = ChildStats();
+            node->proven_children = 0;
+            node->is_expanded = false;   // Proof kept: it is still the node's value
+        }
+        sweep_unreachable();
+    }
+}
+
+void MCTSEngine::sweep_unreachable() {
+    // Mark everything the root reaches (the tree may be a DAG: visit once)
+    ++mark_;
+    scratch_.clear();
+    scratch_.push_back(root_);
+    root_->mark = mark_;
+    while (!scratch_.empty()) {
+        const Node* node = scratch_.back();
+        scratch_.pop_back();
+        for (const Edge& edge : node->children) {
+            if (edge.node->mark != mark_) {
+                edge.node->mark = mark_;
+                scratch_.push_back(edge.node);
+            }
         }
     }
     
-    return max_depth;
+    size_t live = 0;
+    tree_bytes_ = 0;
+    for (size_t i = 0; i < nodes_.size(); ++i) {
+        Node* node = nodes_[i].get();
+        if (node->mark == mark_) {
+            tree_bytes_ += node_bytes(*node);
+            if (live != i) nodes_[live] = std::move(nodes_[i]);
+            ++live;
+            continue;
+        }
+        if (config_.use_transpositions) {
+            auto it = table_.find(node->board_state.hash());
+            if (it != table_.end() && it->second == node) table_.erase(it);
+        }
+        std::vector<Edge>().swap(node->children);
+        node->stats = ChildStats();
+        free_nodes_.push_back(std::move(nodes_[i]));
+        stats_.nodes_reclaimed++;
+    }
+    nodes_.resize(live);
+    tree_bytes_ += table_.size() * TABLE_ENTRY_BYTES;
 }
 
 } // namespace reversi::ai
-
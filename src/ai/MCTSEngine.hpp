@@ -3,10 +3,21 @@
  * COMP390 Honours Year Project
  * 
  * Monte Carlo Tree Search implementation with:
- * - UCB1 selection strategy
+ * - UCB1 selection over structure-of-arrays child statistics (AVX2 argmax)
  * - Tree expansion and simulation
  * - Heuristic playout policy
  * - Backpropagation and statistics
+ * - MCTS-Solver: proven wins/losses propagate up the tree, selection
+ *   skips decided branches, optional exact solve near the end
+ * - Optional transposition table: positions reached by different move
+ *   orders share one node (the tree becomes a DAG)
+ * - Optional RAVE: all-moves-as-first statistics blended into selection
+ * - Optional memory budget: least-visited subtrees are pruned and their
+ *   nodes recycled, so long analysis searches keep a fixed footprint
+ * - Optional hybrid MCTS-alpha-beta: leaves scored by the evaluator or a
+ *   shallow MinimaxEngine search (sigmoid to a win probability) instead
+ *   of playouts, with implicit minimax backups of those values in
+ *   selection; combined with solve_empties, exact near the end
  * 
  * Performance target: ~200K simulations/second
  */
@@ -16,6 +27,10 @@
 #include "core/Board.hpp"
 #include "core/Move.hpp"
 #include "ai/AIStrategy.hpp"
+#include "ai/ChildStats.hpp"
+#include "ai/EndgameSolver.hpp"
+#include "ai/FastRng.hpp"
+#include "ai/MinimaxEngine.hpp"
 #include <limits>
 #include <chrono>
 #include <cstdint>
@@ -23,6 +38,7 @@
 #include <memory>
 #include <random>
 #include <string>
+#include <unordered_map>
 #include <algorithm>
 
 namespace reversi::ai {
@@ -40,7 +56,8 @@ namespace reversi::ai {
  * 4. Backpropagation: Update statistics up the tree
  * 
  * @performance Target: ~200K simulations/second
- * @memory Efficient node management with std::unique_ptr
+ * @memory Nodes live in an engine-owned pool; children are plain pointers.
+ *         Config::memory_budget_mb bounds the pool (see reclaim_memory)
  */
 class MCTSEngine : public AIStrategy {
 public:
@@ -52,11 +69,44 @@ public:
         int max_time_ms = 5000;           ///< Maximum time limit (milliseconds)
         double ucb1_c = 1.414213562;      ///< UCB1 exploration constant (√2)
         bool use_heuristic_playout = true; ///< Use heuristic instead of pure random
-        double playout_heuristic_weight = 0.3; ///< Top 30% moves in playout
+        double playout_heuristic_weight = 0.3; ///< Top 30% moves (by square class) in playout
+        uint64_t seed = 0;                ///< RNG seed (0 = seed from std::random_device)
+        bool use_solver = true;           ///< MCTS-Solver: prove nodes won/lost/drawn and skip them
+        int solve_empties = 0;            ///< Solve leaves with at most this many empties exactly (0 = off; needs use_solver)
+        bool use_transpositions = false;  ///< Share nodes between move orders reaching the same position (DAG)
+        bool use_rave = false;            ///< Blend AMAF (all-moves-as-first) statistics into selection
+        double rave_k = 100.0;            ///< RAVE equivalence: beta = sqrt(k / (3 n + k)) at n visits
+        size_t memory_budget_mb = 0;      ///< Tree memory limit in MiB (0 = unlimited)
+        bool use_leaf_eval = false;       ///< Hybrid MCTS-alpha-beta: score leaves with the evaluator, not a playout
+        int leaf_search_depth = 0;        ///< Minimax depth at leaves (0 = direct evaluator call)
+        double leaf_eval_scale = 80.0;    ///< Win probability 1 / (1 + exp(-score / scale)); suits Evaluator (EvaluatorWeek4: ~4x)
+        double leaf_eval_weight = 1.0;    ///< Evaluator share of the leaf value (the rest from a playout)
+        double minimax_weight = 0.0;      ///< Implicit minimax: share of the children's backed-up values in selection (use_leaf_eval)
         
         Config() = default;
         Config(int sims, int time_ms, double c = 1.414)
             : max_simulations(sims), max_time_ms(time_ms), ucb1_c(c) {}
+        
+        // Preset: RAVE with a small exploration constant (AMAF already spreads
+        // visits); at 500-1000 sims it matches plain MCTS with twice the budget
+        static Config preset_rave() {
+            Config c;
+            c.use_rave = true;
+            c.ucb1_c = 0.2;
+            return c;
+        }
+        
+        // Preset: hybrid MCTS-alpha-beta with the default Evaluator. Values
+        // are deterministic, so exploration is small; at ~10 ms per move
+        // it beats MinimaxEngine given the same time, and plain MCTS
+        static Config preset_hybrid() {
+            Config c;
+            c.use_leaf_eval = true;
+            c.minimax_weight = 0.8;
+            c.ucb1_c = 0.1;
+            c.solve_empties = 8;
+            return c;
+        }
     };
     
     /**
@@ -68,6 +118,13 @@ public:
         int max_tree_depth = 0;             ///< Maximum depth reached
         double average_playout_length = 0.0; ///< Average moves per playout
         double win_rate = 0.0;              ///< Win rate from current player's perspective
+        int solved_nodes = 0;               ///< Tree nodes proven won, lost or drawn
+        int root_result = 0;                ///< Proven root outcome: 1 win, -1 loss, 0 draw or unproven
+        bool root_solved = false;           ///< Search stopped because the root was proven
+        int transpositions = 0;             ///< Children linked to an existing node (use_transpositions)
+        int nodes_reclaimed = 0;            ///< Nodes pruned to stay within memory_budget_mb (recycled)
+        int leaf_evaluations = 0;           ///< Leaves scored by the evaluator or a leaf search (use_leaf_eval)
+        size_t tree_bytes = 0;              ///< Estimated tree memory at the end of the search
         std::vector<int> move_visit_counts;   ///< Visit counts for each legal move
         std::vector<double> move_win_rates;   ///< Win rates for each legal move
         
@@ -78,6 +135,13 @@ public:
             max_tree_depth = 0;
             average_playout_length = 0.0;
             win_rate = 0.0;
+            solved_nodes = 0;
+            root_result = 0;
+            root_solved = false;
+            transpositions = 0;
+            nodes_reclaimed = 0;
+            leaf_evaluations = 0;
+            tree_bytes = 0;
             move_visit_counts.clear();
             move_win_rates.clear();
         }
@@ -91,6 +155,18 @@ public:
     /** @brief Constructor with custom configuration */
     explicit MCTSEngine(const Config& config);
     
+    /**
+     * @brief Constructor scoring leaves (use_leaf_eval) with a specific evaluator
+     * 
+     * Example: MCTSEngine engine(Config::preset_hybrid(), UseEvaluator<EvaluatorWeek4>{});
+     */
+    template <BoardEvaluator Eval>
+    MCTSEngine(const Config& config, UseEvaluator<Eval>) : MCTSEngine(config) {
+        leaf_eval_ = &Eval::evaluate;
+        make_leaf_search_ = &make_leaf_search<Eval>;
+        evaluator_name_ = Eval::name();
+    }
+    
     // ==================== AIStrategy Interface ====================
     
     /** @brief Find best move using MCTS */
@@ -98,7 +174,10 @@ public:
                               const SearchLimits& limits) override;
     
     /** @brief Get engine name */
-    std::string get_name() const override { return "MCTS"; }
+    std::string get_name() const override {
+        if (!config_.use_leaf_eval) return "MCTS";
+        return "MCTS-AB [" + std::string(evaluator_name_) + "]";
+    }
     
     /** @brief Get search statistics */
     const SearchStats& get_stats() const override {
@@ -108,6 +187,24 @@ public:
     /** @brief Reset internal state */
     void reset() override;
     
+    /**
+     * @brief Fresh engine with the same Config (no tree)
+     */
+    std::unique_ptr<AIStrategy> clone() const override {
+        auto copy = std::make_unique<MCTSEngine>(config_);
+        copy->leaf_eval_ = leaf_eval_;
+        copy->make_leaf_search_ = make_leaf_search_;
+        copy->evaluator_name_ = evaluator_name_;
+        return copy;
+    }
+    
+    /**
+     * @brief Reseed the playout/expansion RNG
+     */
+    void set_seed(uint64_t seed) override {
+        rng_.seed(seed);
+    }
+    
     // ==================== MCTS-Specific Methods ====================
     
     /** @brief Get detailed MCTS statistics */
@@ -118,113 +215,99 @@ public:
     
     /** @brief Get current configuration */
     const Config& get_config() const { return config_; }
+    
+    /**
+     * @brief Read-only view of one node of the last search (tests, analysis)
+     */
+    struct NodeView {
+        const void* id = nullptr;     ///< Node identity (nullptr: not in the tree); shared DAG nodes compare equal
+        uint64_t hash = 0;            ///< Board::hash() of the position
+        int visits = 0;               ///< Simulations through the node (from any parent)
+        bool proven = false;          ///< Solver proved the node
+        int proof = 0;                ///< If proven, for the player who moved into it: 1 won, -1 lost, 0 drawn
+        std::vector<int> moves;       ///< Child moves in edge order (-1 for a pass); empty if not expanded
+        const ChildStats* stats = nullptr; ///< Per-edge statistics, same order as moves
+    };
+    
+    /**
+     * @brief Node reached from the root of the last search by playing moves (-1 = pass)
+     * 
+     * Valid until the next search or reset().
+     */
+    NodeView view_node(const std::vector<int>& moves) const;
 
 private:
     // ==================== MCTS Tree Node ====================
     
+    /// Proven game value of a node, for the player who moved into it
+    enum class Proof : int8_t { None, Win, Loss, Draw };
+    
     /**
      * @brief MCTS search tree node
      * 
      * Each node represents a game position and stores:
      * - Board state
-     * - Visit count and win statistics
-     * - Child nodes (legal moves)
-     * - Parent reference for backpropagation
+     * - Its visit count and, per outgoing edge, the child's visit/win/AMAF
+     *   statistics and backed-up value as contiguous arrays (ChildStats)
+     *   for SIMD selection
+     * - Outgoing edges (legal moves); with use_transpositions a node may
+     *   be the child of several parents, so there is no parent pointer and
+     *   backpropagation follows the path recorded during selection
      */
+    struct Node;
+    
+    /// Move from a node to one of its children
+    struct Edge {
+        int move;                     ///< Square played (-1 for a pass)
+        Node* node;                   ///< Child position (owned by the engine's node pool)
+    };
+    
     struct Node {
-        core::Board board_state;      ///< Board position at this node
-        int visits = 0;               ///< Number of times this node was visited
-        double wins = 0.0;            ///< Cumulative wins (from current player's perspective)
-        std::vector<std::unique_ptr<Node>> children; ///< Child nodes (legal moves)
-        Node* parent = nullptr;       ///< Parent node (for backpropagation)
-        int move = -1;                ///< Move that led to this node (-1 for root)
+        core::Board board_state;      ///< Board position at this node (no move history)
+        int visits = 0;               ///< Simulations through this node (from any parent)
+        uint32_t mark = 0;            ///< Last reclaim pass that reached this node from the root
+        std::vector<Edge> children;   ///< Child edges (legal moves, at most 64)
+        ChildStats stats;             ///< Per-edge statistics, same order as children (wins for the mover)
+        uint64_t proven_children = 0; ///< Bit i: children[i] is proven (refreshed by update_proofs)
         bool is_terminal = false;      ///< Whether this is a terminal position
         bool is_expanded = false;      ///< Whether children have been generated
+        Proof proof = Proof::None;     ///< Solver result (terminal, solved or proven from children)
         
-        // ==================== Node Operations ====================
+        explicit Node(const core::Board& board) : board_state(board) {}
         
-        /**
-         * @brief Calculate UCB1 value for this node
-         * @param exploration_c UCB1 exploration constant
-         * @param parent_visits Total visits of parent node
-         * @return UCB1 value (exploitation + exploration)
-         */
-        double ucb1_value(double exploration_c, int parent_visits) const {
-            if (visits == 0) {
-                return std::numeric_limits<double>::max(); // Unvisited nodes prioritized
-            }
-            
-            double exploitation = wins / visits;  // Average win rate
-            double exploration = exploration_c * 
-                std::sqrt(std::log(parent_visits + 1) / visits);
-            
-            return exploitation + exploration;
-        }
+        // ==================== Node Operations ====================
         
         /**
-         * @brief Select best child using UCB1
+         * @brief Select best child using UCB1 (or RAVE)
          * @param exploration_c UCB1 exploration constant
-         * @return Best child node according to UCB1
-         */
-        Node* select_best_child(double exploration_c) const {
-            if (children.empty()) return nullptr;
-            
-            Node* best = nullptr;
-            double best_value = std::numeric_limits<double>::lowest();
-            
-            for (const auto& child : children) {
-                double value = child->ucb1_value(exploration_c, visits);
-                if (value > best_value) {
-                    best_value = value;
-                    best = child.get();
-                }
-            }
-            
-            return best;
-        }
-        
-        /**
-         * @brief Expand node by creating children for all legal moves
-         * @param board Current board state
+         * @param skip_proven Ignore children with a proven value (MCTS-Solver)
+         * @param rave_k RAVE equivalence parameter (0 = plain UCB1)
+         * @param minimax_weight Implicit minimax weight (0 = off; takes precedence over RAVE)
+         * @return Index of the best child (-1 if none qualifies)
          */
-        void expand(const core::Board& board) {
-            if (is_expanded || is_terminal) return;
-            
-            std::vector<int> legal_moves;
-            board.get_legal_moves(legal_moves);
-            
-            if (legal_moves.empty()) {
-                is_terminal = true;
-                return;
+        int select_child(double exploration_c, bool skip_proven = false, double rave_k = 0.0,
+                         double minimax_weight = 0.0) const {
+            const uint64_t excluded = skip_proven ? proven_children : 0;
+            const float log_parent = std::log(static_cast<float>(visits + 1));  // Once per node
+            if (minimax_weight > 0.0) {
+                return stats.select_minimax(log_parent, static_cast<float>(exploration_c),
+                                            static_cast<float>(minimax_weight), excluded);
             }
-            
-            children.reserve(legal_moves.size());
-            for (int move : legal_moves) {
-                auto child = std::make_unique<Node>();
-                child->board_state = board;
-                child->board_state.make_move(move);
-                child->parent = this;
-                child->move = move;
-                child->is_terminal = child->board_state.is_terminal();
-                
-                children.push_back(std::move(child));
+            if (rave_k > 0.0) {
+                return stats.select_rave(log_parent, static_cast<float>(exploration_c),
+                                         static_cast<float>(rave_k), excluded);
             }
-            
-            is_expanded = true;
+            return stats.select_ucb1(log_parent, static_cast<float>(exploration_c), excluded);
         }
         
         /**
-         * @brief Update node statistics (backpropagation)
-         * @param result Simulation result (1.0 = win, 0.0 = loss, 0.5 = draw)
+         * @brief Outcome of a finished game for the player who just moved
          */
-        void backpropagate(double result) {
-            visits++;
-            wins += result;
-            
-            // Update parent recursively
-            if (parent != nullptr) {
-                parent->backpropagate(1.0 - result); // Invert for opponent's perspective
-            }
+        static Proof final_proof(const core::Board& board) {
+            const int winner = board.get_winner();  // For the side to move
+            if (winner > 0) return Proof::Loss;
+            if (winner < 0) return Proof::Win;
+            return Proof::Draw;
         }
         
         /**
@@ -240,83 +323,180 @@ private:
     /**
      * @brief Phase 1: Selection - Traverse tree using UCB1
      * @param root Root node of search tree
-     * @return Leaf node reached by UCB1 selection
+     * @return Leaf node reached by UCB1 selection (path_ holds root..leaf,
+     *         path_edges_ the child index taken at each step)
      */
     Node* selection(Node* root);
     
     /**
      * @brief Phase 2: Expansion - Add new child node
      * @param leaf Leaf node to expand
-     * @return Newly expanded node (or leaf if terminal)
+     * @return Newly expanded node (or leaf if terminal), appended to path_
      */
     Node* expansion(Node* leaf);
     
+    /**
+     * @brief Create children for all legal moves of node
+     *        (a single pass child, move -1, when only the opponent can move)
+     * 
+     * With use_transpositions, a child position already in the table is
+     * linked instead of created.
+     */
+    void expand(Node* node);
+    
+    /**
+     * @brief Node for board from the pool (or the table's existing node)
+     */
+    Node* get_node(const core::Board& board);
+    
     /**
      * @brief Phase 3: Simulation - Play heuristic game to terminal
+     *        (proven nodes return their value; with solve_empties, small
+     *        endgames are solved exactly and the node becomes proven)
      * @param node Node to start simulation from
-     * @return Result from current player's perspective (1.0 = win, 0.0 = loss)
+     * @return Result for the player who moved into node (1.0 = win, 0.0 = loss or draw)
      */
     double simulation(Node* node);
     
     /**
-     * @brief Phase 4: Backpropagation - Update statistics up the tree
-     * @param node Node to start backpropagation from
-     * @param result Simulation result
+     * @brief Phase 4: Backpropagation - Update statistics along path_
+     *        (the path actually taken, from its last node back to the root)
+     * 
+     * With implicit minimax, each edge's value becomes one minus the best
+     * value among the child's own edges (negamax over evaluator values).
+     * @param result Simulation result for the last node on the path
+     */
+    void backpropagation(double result);
+    
+    /**
+     * @brief RAVE: credit AMAF statistics along path_
+     * 
+     * At every node on the path, each child whose move the side to move
+     * there played later in the simulation (in the tree or the playout)
+     * gets an AMAF visit. Each square is played at most once per game, so
+     * the moves of each side fit in one bitboard.
+     * @param result Simulation result for the last node on the path
      */
-    void backpropagation(Node* node, double result);
+    void update_amaf(double result);
+    
+    /**
+     * @brief MCTS-Solver: prove nodes from their children, walking back along path_
+     * 
+     * A node is lost for the player who moved into it if any child is won
+     * for the player to move, and decided once all children are proven.
+     */
+    void update_proofs();
     
     // ==================== Helper Methods ====================
     
     /**
      * @brief Random playout from given board position
      * @param board Starting board position
-     * @return Result from current player's perspective (1 = win, 0 = loss)
+     * @return Final disc difference for the side to move
      */
     int random_playout(const core::Board& board);
     
     /**
-     * @brief Heuristic playout (improved over pure random)
+     * @brief Heuristic playout: random among the best square classes
+     *        (playout_heuristic_weight of the moves, see PlayoutKernel.hpp)
      * @param board Starting board position
-     * @return Result from current player's perspective (1 = win, 0 = loss)
+     * @return Final disc difference for the side to move
      */
     int heuristic_playout(const core::Board& board);
     
     /**
-     * @brief Evaluate move using lightweight heuristics
-     * @param board Current board state
-     * @param move Move to evaluate
-     * @return Heuristic score (higher = better)
+     * @brief Hybrid leaf value: win probability for the side to move
+     * 
+     * Forced passes (and, for a leaf search, single legal moves) are played
+     * first; then the evaluator or a leaf_search_depth MinimaxEngine search
+     * scores the position and 1 / (1 + exp(-score / leaf_eval_scale))
+     * maps it to a probability. Finished games count a draw as a loss,
+     * like playouts.
+     */
+    double evaluate_leaf(const core::Board& board);
+    
+    /**
+     * @brief Implicit minimax weight in effect (0 unless use_leaf_eval)
      */
-    int evaluate_move_heuristic(const core::Board& board, int move);
+    double minimax_weight() const {
+        return config_.use_leaf_eval ? config_.minimax_weight : 0.0;
+    }
+    
+    /// MinimaxEngine for leaf searches with evaluator Eval (bound to make_leaf_search_)
+    template <BoardEvaluator Eval>
+    static std::unique_ptr<MinimaxEngine> make_leaf_search() {
+        return std::make_unique<MinimaxEngine>(MinimaxEngine::Config(1, true, true, LEAF_TT_BITS),
+                                               UseEvaluator<Eval>{});
+    }
     
     /**
-     * @brief Select best move (most visited child)
+     * @brief Select best move: a proven win, else the most visited child
+     *        that is not a proven loss
      * @param root Root node of search tree
      * @return Best move found
      */
     core::Move select_best_move(Node* root);
     
     /**
-     * @brief Count total nodes in tree
-     * @param node Root node
-     * @return Total node count
+     * @brief Count proven nodes in the pool
+     */
+    int count_solved_nodes() const;
+    
+    // ==================== Memory Budget ====================
+    
+    /**
+     * @brief Estimated heap footprint of one node (itself, edges, statistics)
      */
-    int count_tree_nodes(Node* node) const;
+    static size_t node_bytes(const Node& node) {
+        return sizeof(Node) + node.children.capacity() * sizeof(Edge) + node.stats.bytes();
+    }
+    
+    /**
+     * @brief Bring the tree back to 3/4 of memory_budget_mb
+     * 
+     * Collapses expanded nodes back to leaves, least visited first (the
+     * root stays expanded), then frees whatever the root no longer reaches.
+     * Only runs between simulations, so path_ holds no pruned node.
+     */
+    void reclaim_memory();
     
     /**
-     * @brief Calculate maximum tree depth
-     * @param node Current node
-     * @param depth Current depth
-     * @return Maximum depth
+     * @brief Move nodes unreachable from the root to the free list
+     *        (dropping their table entries) and recount tree_bytes_
      */
-    int calculate_max_depth(Node* node, int depth) const;
+    void sweep_unreachable();
+    
+    /**
+     * @brief Whether the tree has reached memory_budget_mb
+     */
+    bool over_budget() const {
+        return config_.memory_budget_mb > 0 && tree_bytes_ >= (config_.memory_budget_mb << 20);
+    }
     
     // ==================== Member Variables ====================
     
     Config config_;                    ///< MCTS configuration
     MCTSStats stats_;                 ///< Search statistics
-    std::unique_ptr<Node> root_;       ///< Root of search tree
-    std::mt19937 rng_;                 ///< Random number generator
+    std::vector<std::unique_ptr<Node>> nodes_; ///< Node pool: every node of the current search
+    std::unordered_map<uint64_t, Node*> table_; ///< Board::hash() -> node (use_transpositions)
+    std::vector<Node*> path_;          ///< Nodes visited by the current simulation, root first
+    std::vector<int> path_edges_;      ///< path_edges_[i]: index of path_[i + 1] among path_[i]'s children
+    uint64_t playout_moves_[2] = {};   ///< Squares played in the last playout: side to move at its start, other side
+    Node* root_ = nullptr;             ///< Root of search tree (in nodes_)
+    FastRng rng_;                      ///< Random number generator (expansion and playouts)
+    std::unique_ptr<EndgameSolver> endgame_; ///< Exact leaf solver (created on first use)
+    int (*leaf_eval_)(const core::Board&) noexcept = &Evaluator::evaluate; ///< Leaf evaluator (use_leaf_eval)
+    std::unique_ptr<MinimaxEngine> (*make_leaf_search_)() = &make_leaf_search<Evaluator>; ///< Leaf searcher factory
+    std::string_view evaluator_name_ = Evaluator::name();
+    std::unique_ptr<MinimaxEngine> leaf_search_; ///< Leaf searcher (created on first use)
+    std::vector<std::unique_ptr<Node>> free_nodes_; ///< Reclaimed nodes, reused before allocating
+    std::vector<Node*> scratch_;       ///< Reclaim work list (collapse candidates, then the sweep stack)
+    size_t tree_bytes_ = 0;            ///< Estimated memory of nodes_ and table_
+    uint32_t mark_ = 0;                ///< Current reclaim pass (Node::mark)
+    
+    static constexpr int ENDGAME_TT_BITS = 16; ///< Leaf solver table: 2^16 entries
+    static constexpr int LEAF_TT_BITS = 16;    ///< Leaf search table: 2^16 entries
+    static constexpr size_t TABLE_ENTRY_BYTES = 48; ///< Hash node plus bucket slot per table_ entry
     
     // Performance optimization
     static constexpr int TIME_CHECK_INTERVAL = 100; ///< Check time every N simulations
@@ -18,13 +18,20 @@
 #include "ai/Evaluator.hpp"
 #include "ai/TranspositionTable.hpp"
 #include "ai/AIStrategy.hpp"
+#include "ai/SearchFeatures.hpp"
+#include "ai/EvaluatorConcept.hpp"
+#include "ai/PerfCounters.hpp"
+#include "ai/SearchRecorder.hpp"
 #include <limits>
 #include <chrono>
 #include <cstdint>
 #include <array>
 #include <vector>
 #include <algorithm>
+#include <memory>
 #include <string>
+#include <string_view>
+#include <thread>
 
 namespace reversi::ai {
 
@@ -42,6 +49,11 @@ namespace reversi::ai {
  * - Aspiration windows
  * - Killer move heuristics
  * 
+ * The node loop (negamax/pvs) is a template over a feature policy and an
+ * evaluator type; find_best_move selects the instantiation once per
+ * search so feature checks are resolved at compile time. The evaluator is
+ * bound at construction (default: Evaluator; see UseEvaluator).
+ * 
  * Implements AIStrategy interface for integration with game system.
  */
 class MinimaxEngine : public AIStrategy {
@@ -64,21 +76,20 @@ public:
         int aspiration_window = 50;  ///< Aspiration window size (centipawns)
         // Tunable parameters (runtime)
         int pvs_research_margin = 4; ///< Margin to trigger full re-search after zero-window
-        int tt_weight = 10583;        ///< Weight for TT best-move in ordering
-        int killer_weight = 195;      ///< Weight multiplier for killer bonus
-        int pos_weight_mul = 8;       ///< Multiplier for positional weights in ordering
+        int tt_weight = 10000;        ///< Ordering bonus for the TT best move
+        int killer_weight = 1000;     ///< Ordering bonus for the first killer (second gets half)
+        int pos_weight_mul = 1;       ///< Multiplier for positional weights in ordering
         int flip_mul = 4;             ///< Multiplier for flip count in ordering
-        int history_weight = 0;       ///< Weight for history heuristic
+        int history_weight = 0;       ///< Multiplier for the history-table score in ordering
         int top_k_root = 1;           ///< Number of top candidates to refine at root
         int pvs_failure_threshold = 4; ///< Per-ply threshold to disable PVS at that ply
+        bool use_specialized_search = true; ///< Compile-time specialized node loop (false = runtime flag checks)
+        bool use_perf_counters = false; ///< Fill SearchResult::perf (Linux perf_event_open; no-op elsewhere)
         // Preset: optimized candidate from param_opt
         static Config preset_optimized() {
             Config c;
             c.pvs_research_margin = 1;
             c.aspiration_window = 64;
-            c.killer_weight = 25;
-            c.tt_weight = 3708;
-            c.history_weight = 0;
             return c;
         }
         
@@ -86,9 +97,6 @@ public:
             Config c;
             c.pvs_research_margin = 20;
             c.aspiration_window = 50;
-            c.killer_weight = 0;
-            c.tt_weight = 6000;
-            c.history_weight = 0;
             return c;
         }
         
@@ -97,6 +105,18 @@ public:
             : max_depth(depth), use_alpha_beta(ab), use_transposition(tt), tt_size_bits(tt_bits) {}
     };
     
+    /**
+     * @brief AIStrategy statistics plus the hardware counters of the last search
+     */
+    struct MinimaxStats : public SearchStats {
+        PerfSample perf;            ///< Hardware counters (only with Config::use_perf_counters)
+
+        void reset() override {
+            SearchStats::reset();
+            perf = PerfSample{};
+        }
+    };
+
     /**
      * @brief Search result with complete statistics
      */
@@ -106,6 +126,7 @@ public:
         int nodes_searched = 0;     ///< Total nodes explored
         int depth_reached = 0;      ///< Actual depth searched
         double time_ms = 0.0;       ///< Search time in milliseconds
+        PerfSample perf;            ///< Hardware counters (only with Config::use_perf_counters)
         
         /**
          * @brief Calculate search speed
@@ -115,6 +136,15 @@ public:
             return time_ms > 0 ? (nodes_searched * 1000.0 / time_ms) : 0.0;
         }
         
+        /// Instructions per cycle over the search (0 if not counted)
+        double ipc() const { return perf.ipc(); }
+        /// Fraction of mispredicted branches (0 if not counted)
+        double branch_miss_rate() const { return perf.branch_miss_rate(); }
+        /// Last-level cache misses per searched node (0 if not counted)
+        double cache_misses_per_node() const {
+            return perf.per(PerfSample::LLC_MISSES, static_cast<uint64_t>(nodes_searched));
+        }
+        
         /**
          * @brief Print search statistics
          */
@@ -131,6 +161,19 @@ public:
      */
     explicit MinimaxEngine(const Config& config);
     
+    /**
+     * @brief Construct engine searching with a specific evaluator
+     * 
+     * Example: MinimaxEngine engine(config, UseEvaluator<EvaluatorWeek4>{});
+     * The evaluator is a template argument of the node loop, so calls to
+     * Eval::evaluate are direct (no virtual or function-pointer dispatch).
+     */
+    template <BoardEvaluator Eval>
+    MinimaxEngine(const Config& config, UseEvaluator<Eval>) : MinimaxEngine(config) {
+        search_entry_ = &MinimaxEngine::search_with<Eval>;
+        evaluator_name_ = Eval::name();
+    }
+    
     /**
      * @brief Find best move for current board position
      * 
@@ -161,15 +204,28 @@ public:
      * @brief Get the name of this AI strategy
      */
     std::string get_name() const override {
-        return "Minimax (Negamax + Alpha-Beta)";
+        if (evaluator_name_ == Evaluator::name()) {
+            return "Minimax (Negamax + Alpha-Beta)";
+        }
+        return "Minimax (Negamax + Alpha-Beta) [" + std::string(evaluator_name_) + "]";
     }
     
+    /**
+     * @brief Name of the evaluator this engine was instantiated with
+     */
+    std::string_view evaluator_name() const { return evaluator_name_; }
+    
     /**
      * @brief Get search statistics from last move
      */
     const SearchStats& get_stats() const override {
         return last_stats_;
     }
+
+    /**
+     * @brief Statistics from the last AIStrategy search, with its counters
+     */
+    const MinimaxStats& get_minimax_stats() const { return last_stats_; }
     
     /**
      * @brief Reset internal state (transposition table, etc.)
@@ -180,6 +236,11 @@ public:
         last_stats_.reset();
     }
     
+    /**
+     * @brief Fresh engine with the same Config and evaluator (empty TT)
+     */
+    std::unique_ptr<AIStrategy> clone() const override;
+    
     /**
      * @brief Get current configuration
      */
@@ -221,10 +282,41 @@ public:
      */
     PVSDiagnostics get_pvs_diagnostics() const;
     
+    /**
+     * @brief Attach a per-node recorder (not owned; nullptr detaches)
+     * 
+     * Records every negamax/PVS node and TT cutoff for offline analysis
+     * of move ordering (see SearchRecorder).
+     */
+    void set_recorder(SearchRecorder* recorder) { recorder_ = recorder; }
+    
 private:
     // Constants
     static constexpr int MAX_DEPTH = 64;  ///< Maximum search depth (game has 64 squares)
     static constexpr int TIME_CHECK_INTERVAL = 1000;  ///< Check time every N nodes
+    static constexpr int INF = std::numeric_limits<int>::max() / 2;  ///< Avoids overflow in negation
+    
+    // Lightweight static positional weights to support fast move ordering.
+    // Values chosen to prefer corners and edges and penalize squares adjacent to corners.
+    static constexpr int POSITION_WEIGHTS[64] = {
+        1000, -250,  50,  50,  50,  50, -250, 1000,
+       -250, -500,  10,  10,  10,  10, -500, -250,
+         50,   10,  20,  20,  20,  20,   10,   50,
+         50,   10,  20,  20,  20,  20,   10,   50,
+         50,   10,  20,  20,  20,  20,   10,   50,
+         50,   10,  20,  20,  20,  20,   10,   50,
+       -250, -500,  10,  10,  10,  10, -500, -250,
+       1000, -250,  50,  50,  50,  50, -250, 1000
+    };
+    
+    /**
+     * @brief find_best_move without the optional counter bracket
+     */
+    SearchResult search_root(const reversi::core::Board& board);
+    
+    /// Search entry bound at construction (selects the evaluator instantiation)
+    SearchResult (MinimaxEngine::*search_entry_)(const reversi::core::Board&) = nullptr;
+    std::string_view evaluator_name_ = Evaluator::name();
     
     Config config_;           ///< Search configuration
     TranspositionTable tt_;   ///< Transposition table
@@ -232,10 +324,17 @@ private:
     
     // Reusable scratch vectors to avoid repeated allocations in hot paths
     mutable std::vector<int> moves_scratch_;
+    /// Searched position without the caller's move history, so node copies never allocate
+    reversi::core::Board root_board_;
     mutable std::vector<std::pair<int,int>> move_scores_scratch_;
     
     // AIStrategy interface: last search statistics
-    mutable SearchStats last_stats_;  ///< Statistics from last search
+    mutable MinimaxStats last_stats_;  ///< Statistics from last search
+    
+    /// Opened with Config::use_perf_counters; counters follow one thread, so they
+    /// are reopened when a search runs on a different thread than the last one
+    std::unique_ptr<PerfCounters> perf_;
+    std::thread::id perf_thread_;
     
     // Week 6: Time management
     std::chrono::high_resolution_clock::time_point search_start_;
@@ -260,6 +359,19 @@ private:
     std::array<int, MAX_DEPTH> pvs_researches_per_ply_;
     std::array<int, MAX_DEPTH> pvs_zero_window_beta_cutoffs_per_ply_;
     
+    // Search tree recording (optional)
+    SearchRecorder* recorder_ = nullptr;
+    /// order_moves heuristics that flagged each square, per ply (filled only while recording)
+    mutable std::array<std::array<uint8_t, 64>, MAX_DEPTH> order_sources_{};
+    
+    /**
+     * @brief Append one NodeRecord for the current ply (recorder_ must be set)
+     * 
+     * @param key_move Cutoff move (or best move) whose order_moves sources are stored
+     */
+    void record_node(int depth, size_t moves, int cutoff_index, int best_index,
+                     int bound, uint8_t flags, int key_move);
+    
     /**
      * @brief Negamax search with alpha-beta pruning
      * 
@@ -272,7 +384,11 @@ private:
      * Pruning condition: if alpha >= beta, opponent won't allow this path
      * 
      * Performance: inline-able hot path, noexcept for performance
+     * 
+     * @tparam Features Feature policy (SearchFeatures or RuntimeSearchFeatures)
+     * @tparam Eval Evaluator type providing static evaluate(const Board&)
      */
+    template <typename Features, typename Eval>
     int negamax(reversi::core::Board& board, int depth, int alpha, int beta);
     
     /**
@@ -288,8 +404,34 @@ private:
      * @param is_pv Whether this is a principal variation node
      * @return Best score for current player
      */
+    template <typename Features, typename Eval>
     int pvs(reversi::core::Board& board, int depth, int alpha, int beta, bool is_pv);
     
+    /**
+     * @brief Search entry for a given evaluator (bound to search_entry_)
+     * 
+     * Chooses the runtime-flag path or dispatch_search from the Config.
+     */
+    template <BoardEvaluator Eval>
+    SearchResult search_with(const reversi::core::Board& board);
+    
+    /**
+     * @brief Select the feature instantiation for the current Config
+     * 
+     * Called once per search. Recurses over the four feature flags,
+     * appending one bool per level, and ends in run_search.
+     */
+    template <typename Eval, bool... Flags>
+    SearchResult dispatch_search(const reversi::core::Board& board);
+    
+    /**
+     * @brief Root search (fixed depth or iterative deepening)
+     * 
+     * @param board Board position with at least two legal moves
+     */
+    template <typename Features, typename Eval>
+    SearchResult run_search(const reversi::core::Board& board);
+    
     /**
      * @brief Iterative deepening search
      * 
@@ -299,6 +441,7 @@ private:
      * @param board Board position to search
      * @return SearchResult with best move found
      */
+    template <typename Features, typename Eval>
     SearchResult iterative_deepening_search(const reversi::core::Board& board);
     
     /**
@@ -312,6 +455,7 @@ private:
      * @param predicted_score Predicted score from transposition table
      * @return SearchResult with best move
      */
+    template <typename Features, typename Eval>
     SearchResult aspiration_search(const reversi::core::Board& board, int depth, int predicted_score);
     
     /**
@@ -374,10 +518,14 @@ private:
      * 
      * @param board Current board position
      * @param moves Legal moves to order
-     * @return Ordered moves (best first)
+     * @param ordered Receives the moves best first (room for 64)
+     * @return Number of moves written
      */
-    std::vector<int> order_moves(const reversi::core::Board& board, const std::vector<int>& moves) const;
+    template <typename Features, typename Eval>
+    size_t order_moves(const reversi::core::Board& board, const std::vector<int>& moves, int* ordered) const;
 };
 
 } // namespace reversi::ai
 
+// Member template definitions (templated search core)
+#include "ai/MinimaxSearch.hpp"
@@ -0,0 +1,946 @@
+/*
+ * MinimaxSearch.hpp - Templated search core for MinimaxEngine
+ * COMP390 Honours Year Project
+ *
+ * Definitions of the MinimaxEngine member templates (root search, negamax,
+ * PVS, aspiration windows, move ordering) and the small helpers they call
+ * per node. Kept in a header so the engine can be instantiated with any
+ * BoardEvaluator; included at the end of MinimaxEngine.hpp, do not include
+ * directly.
+ */
+
+#pragma once
+
+#include "ai/MinimaxEngine.hpp"
+#include "core/Trace.hpp"
+#include <bit>
+#include <span>
+
+namespace reversi::ai {
+
+template <BoardEvaluator Eval>
+MinimaxEngine::SearchResult MinimaxEngine::search_with(const reversi::core::Board& board) {
+    if (!config_.use_specialized_search) {
+        return run_search<RuntimeSearchFeatures, Eval>(board);
+    }
+    return dispatch_search<Eval>(board);
+}
+
+template <typename Eval, bool... Flags>
+MinimaxEngine::SearchResult MinimaxEngine::dispatch_search(const reversi::core::Board& board) {
+    if constexpr (sizeof...(Flags) == 4) {
+        return run_search<SearchFeatures<Flags...>, Eval>(board);
+    } else {
+        // Flag order matches SearchFeatures: alpha-beta, TT, killers, PVS
+        const bool flags[4] = {
+            config_.use_alpha_beta, config_.use_transposition,
+            config_.use_killer_moves, config_.use_pvs
+        };
+        if (flags[sizeof...(Flags)]) {
+            return dispatch_search<Eval, Flags..., true>(board);
+        }
+        return dispatch_search<Eval, Flags..., false>(board);
+    }
+}
+
+template <typename Features, typename Eval>
+MinimaxEngine::SearchResult MinimaxEngine::run_search(const reversi::core::Board& board) {
+    using Clock = std::chrono::high_resolution_clock;
+    
+    // Use iterative deepening if enabled
+    if (config_.use_iterative_deepening) {
+        return iterative_deepening_search<Features, Eval>(board);
+    }
+    
+    // Root moves on the stack: moves_scratch_ is reused by the node loop
+    moves_scratch_.clear();
+    board.get_legal_moves(moves_scratch_);
+    int moves_ptr[64];
+    const size_t moves_n = moves_scratch_.size();
+    std::copy(moves_scratch_.begin(), moves_scratch_.end(), moves_ptr);
+    
+    // Standard fixed-depth search
+    int best_move = moves_ptr[0];
+    int best_score = -INF;
+    int alpha = -INF;
+    int beta = INF;
+    
+    // Root level: search all legal moves (use one mutable tmp board to avoid per-move copies)
+    reversi::core::Board tmp_root = board;
+    for (size_t _mi = 0; _mi < moves_n; ++_mi) {
+        int move = moves_ptr[_mi];
+        if (time_exceeded()) break;
+
+        uint64_t prev_p = tmp_root.get_player_bb();
+        uint64_t prev_o = tmp_root.get_opponent_bb();
+        uint64_t prev_hash = tmp_root.hash();
+        tmp_root.apply_move_no_history(move);
+
+        // Search opponent's response
+        int score;
+        if (Features::pvs(config_)) {
+            score = -pvs<Features, Eval>(tmp_root, config_.max_depth - 1, -beta, -alpha, false);
+        } else {
+            score = -negamax<Features, Eval>(tmp_root, config_.max_depth - 1, -beta, -alpha);
+        }
+        tmp_root.restore_state(prev_p, prev_o, prev_hash);
+        
+        // Update best move
+        if (score > best_score) {
+            best_score = score;
+            best_move = move;
+        }
+        
+        // Update alpha for alpha-beta pruning
+        if (Features::alpha_beta(config_)) {
+            alpha = std::max(alpha, score);
+            // No pruning at root level (we want to explore all moves)
+        }
+    }
+    
+    // Calculate elapsed time
+    auto end = Clock::now();
+    double time_ms = std::chrono::duration<double, std::milli>(end - search_start_).count();
+    
+    // Print lightweight PVS diagnostics for tuning (only when PVS enabled)
+    if (Features::pvs(config_)) {
+        // Reset counters for next search (diagnostics retained internally; no console IO)
+        pvs_zero_window_failures_ = 0;
+        pvs_researches_ = 0;
+        pvs_zero_window_beta_cutoffs_ = 0;
+        pvs_zero_window_failures_per_ply_.fill(0);
+        pvs_researches_per_ply_.fill(0);
+        pvs_zero_window_beta_cutoffs_per_ply_.fill(0);
+    }
+
+    return {
+        best_move,
+        best_score,
+        nodes_searched_,
+        config_.max_depth,
+        time_ms,
+        {}
+    };
+}
+
+template <typename Features, typename Eval>
+inline int MinimaxEngine::negamax(
+    reversi::core::Board& board, 
+    int depth, 
+    int alpha, 
+    int beta) 
+{
+    ++nodes_searched_;
+    ++current_ply_;
+    
+    // Periodic time check
+    if (time_limit_ms_ > 0 && nodes_searched_ % TIME_CHECK_INTERVAL == 0) {
+        if (time_exceeded()) {
+            --current_ply_;
+            // Return a very negative score to indicate timeout
+            // This will be pruned by alpha-beta, but won't mislead the search
+            return -INF + 1;
+        }
+    }
+    
+    // Query transposition table (if enabled)
+    uint8_t record_flags = 0;
+    if (Features::transposition(config_)) {
+        uint64_t hash = board.hash();
+        TTEntry* entry = tt_.probe(hash);
+        if (entry) record_flags |= NodeRecord::TT_HIT;
+        
+        if (entry && entry->depth >= depth) {
+            // Found cached entry with sufficient depth
+            int score = entry->score;
+            
+            // Adjust score for current depth (if needed)
+            // Note: In practice, we store scores relative to current position
+            
+            // Use cached result based on entry type
+            // TTFlag values: EXACT=0, LOWER_BOUND=1, UPPER_BOUND=2
+            const bool cutoff = entry->flag == 0 ||                  // EXACT
+                                (entry->flag == 1 && score >= beta) ||  // LOWER_BOUND: beta cutoff
+                                (entry->flag == 2 && score <= alpha);   // UPPER_BOUND: alpha cutoff
+            if (cutoff) {
+                if (recorder_) {
+                    record_node(depth, 0, NodeRecord::NO_CUTOFF, 0, entry->flag,
+                                record_flags | NodeRecord::TT_CUTOFF, -1);
+                }
+                --current_ply_;
+                return score;
+            }
+        }
+    }
+    
+    // Leaf node: evaluate position
+    if (depth == 0) {
+        int score = Eval::evaluate(board);
+        --current_ply_;
+        return score;
+    }
+    
+    // Terminal node: game over
+    if (board.is_terminal()) {
+        const int diff = board.count_player() - board.count_opponent();
+        // Large score to indicate definitive outcome
+        // Multiply by (depth + 1) to prefer faster wins
+        int score = diff * 10000 * (depth + 1);
+        --current_ply_;
+        return score;
+    }
+    
+    // Get legal moves for current player (reuse member buffer to avoid allocations)
+    moves_scratch_.clear();
+    moves_scratch_.reserve(32);
+    board.get_legal_moves(moves_scratch_);
+    const auto& moves = moves_scratch_;
+    
+    // No legal moves: must pass
+    if (moves.empty()) {
+        reversi::core::Board next = board;
+        next.pass();
+        // Opponent's turn, negate score and swap alpha-beta
+        int score = -negamax<Features, Eval>(next, depth - 1, -beta, -alpha);
+        --current_ply_;
+        return score;
+    }
+    
+    // Feature flags: compile-time constants for specialized policies
+    const bool use_alpha = Features::alpha_beta(config_);
+    const bool use_killer = Features::killer_moves(config_);
+    const bool use_trans = Features::transposition(config_);
+
+    // Move ordering: use comprehensive ordering if enabled. The list lives on
+    // this frame because child nodes overwrite moves_scratch_.
+    int ordered_moves[64];
+    size_t move_count = moves.size();
+    if (use_killer || use_trans) {
+        move_count = order_moves<Features, Eval>(board, moves, ordered_moves);
+        record_flags |= NodeRecord::ORDERED;
+    } else {
+        std::copy(moves.begin(), moves.end(), ordered_moves);
+    }
+    
+    // Negamax recursion
+    int best_score = -INF;
+    int best_move = ordered_moves[0];
+    int original_alpha = alpha;
+    size_t best_index = 0;
+    size_t cutoff_index = NodeRecord::NO_CUTOFF;
+    
+    for (size_t index = 0; index < move_count; ++index) {
+        int move = ordered_moves[index];
+        // Apply move in-place (fast path) and restore after recursion
+        uint64_t prev_p = board.get_player_bb();
+        uint64_t prev_o = board.get_opponent_bb();
+        uint64_t prev_hash = board.hash();
+        board.apply_move_no_history(move);
+        // Recursive search (opponent's turn, negate score)
+        int score = -negamax<Features, Eval>(board, depth - 1, -beta, -alpha);
+        // Restore board
+        board.restore_state(prev_p, prev_o, prev_hash);
+        
+        // Update best score and move (branch predicted)
+        if (score > best_score) {
+            best_score = score;
+            best_move = move;
+            best_index = index;
+        }
+
+        // Alpha-Beta pruning (use local flag)
+        if (use_alpha) {
+            if (score > alpha) alpha = score;
+            if (alpha >= beta) {
+                // Beta cutoff: opponent won't allow this position
+                cutoff_index = index;
+                // Update killer move (use local flag to avoid member access)
+                if (use_killer) {
+                    update_killer(move, current_ply_);
+                }
+                    // Update history heuristic for this move
+                    update_history(move, depth);
+                break;
+            }
+        }
+    }
+    
+    if (recorder_) {
+        const int bound = best_score <= original_alpha ? 2 : (best_score >= beta ? 1 : 0);
+        record_node(depth, move_count, static_cast<int>(cutoff_index), static_cast<int>(best_index),
+                    bound, record_flags, best_move);
+    }
+    
+    // Store result in transposition table (if enabled)
+    if (use_trans) {
+        uint64_t hash = board.hash();
+        TTEntry new_entry;
+        new_entry.hash = hash;
+        new_entry.score = best_score;
+        new_entry.depth = depth;
+        new_entry.best_move = best_move;
+        
+        // Determine entry type based on alpha-beta bounds
+        // TTFlag values: EXACT=0, LOWER_BOUND=1, UPPER_BOUND=2
+        if (best_score <= original_alpha) {
+            new_entry.flag = 2;  // UPPER_BOUND
+        } else if (best_score >= beta) {
+            new_entry.flag = 1;  // LOWER_BOUND
+        } else {
+            new_entry.flag = 0;  // EXACT
+        }
+        
+        tt_.store(new_entry);
+    }
+    
+    --current_ply_;
+    return best_score;
+}
+
+// Week 6: Iterative deepening search
+template <typename Features, typename Eval>
+MinimaxEngine::SearchResult MinimaxEngine::iterative_deepening_search(
+    const reversi::core::Board& board) 
+{
+    using Clock = std::chrono::high_resolution_clock;
+    
+    SearchResult best_result;
+    best_result.best_move = -1;
+    best_result.score = -INF;
+    best_result.depth_reached = 0;
+    
+    // Get predicted score from transposition table (if available)
+    int predicted_score = 0;
+    if (Features::transposition(config_)) {
+        uint64_t hash = board.hash();
+        TTEntry* entry = tt_.probe(hash);
+        if (entry && entry->is_valid()) {
+            predicted_score = entry->score;
+        }
+    }
+    
+    // Iterative deepening: search from depth 1 to max_depth
+    for (int depth = 1; depth <= config_.max_depth; ++depth) {
+        if (time_exceeded()) {
+            // Use result from previous depth
+            break;
+        }
+        REVERSI_TRACE("search", "iteration");
+        
+        SearchResult result;
+        
+        // Use aspiration windows if enabled and we have a predicted score.
+        // Avoid using aspiration at very shallow depths during iterative deepening to reduce noisy re-searches.
+        if (config_.use_aspiration && depth > 2 && predicted_score != 0) {
+            result = aspiration_search<Features, Eval>(board, depth, predicted_score);
+        } else {
+            // Standard search
+            int alpha = -INF;
+            int beta = INF;
+            
+            // Compute root ordering per-depth when doing iterative deepening so TT and previous searches
+            // can update move ordering; for non-ID callers this will just run once.
+            moves_scratch_.clear();
+            board.get_legal_moves(moves_scratch_);
+            int moves_ptr[64];
+            const size_t moves_n = order_moves<Features, Eval>(board, moves_scratch_, moves_ptr);
+            if (moves_n == 0) {
+                break;
+            }
+            
+            int best_move = moves_ptr[0];
+            int best_score = -INF;
+            
+            for (size_t _mi = 0; _mi < moves_n; ++_mi) {
+                int move = moves_ptr[_mi];
+                if (time_exceeded()) break;
+
+                reversi::core::Board tmp = board;
+                tmp.apply_move_no_history(move);
+
+                int score;
+                if (Features::pvs(config_)) {
+                    score = -pvs<Features, Eval>(tmp, depth - 1, -beta, -alpha, false);
+                } else {
+                    score = -negamax<Features, Eval>(tmp, depth - 1, -beta, -alpha);
+                }
+                
+                if (score > best_score) {
+                    best_score = score;
+                    best_move = move;
+                }
+                
+                if (Features::alpha_beta(config_)) {
+                    alpha = std::max(alpha, score);
+                }
+            }
+            
+            auto end = Clock::now();
+            double time_ms = std::chrono::duration<double, std::milli>(end - search_start_).count();
+            
+            result.best_move = best_move;
+            result.score = best_score;
+            result.nodes_searched = nodes_searched_;
+            result.depth_reached = depth;
+            result.time_ms = time_ms;
+        }
+        
+        // Update best result
+        if (result.best_move >= 0) {
+            best_result = result;
+            predicted_score = result.score;  // Update prediction for next depth
+        }
+        
+        // If we found a definitive win/loss, we can stop early
+        if (std::abs(result.score) > 10000) {
+            break;
+        }
+    }
+    
+    return best_result;
+}
+
+// Week 6: Aspiration window search
+template <typename Features, typename Eval>
+MinimaxEngine::SearchResult MinimaxEngine::aspiration_search(
+    const reversi::core::Board& board, 
+    int depth, 
+    int predicted_score) 
+{
+    using Clock = std::chrono::high_resolution_clock;
+    
+    // For shallow depths aspiration windows can be too narrow and cause noisy re-searches.
+    int window = config_.aspiration_window;
+    if (depth <= 5) {
+        // widen window at shallow depths to reduce re-search noise
+        window = std::max(window, 200);
+    }
+    int alpha = predicted_score - window;
+    int beta = predicted_score + window;
+    
+    // Root moves on the stack: moves_scratch_ is reused by the node loop
+    moves_scratch_.clear();
+    board.get_legal_moves(moves_scratch_);
+    int moves_buf[64];
+    const size_t moves_n = moves_scratch_.size();
+    std::copy(moves_scratch_.begin(), moves_scratch_.end(), moves_buf);
+    const std::span<const int> moves(moves_buf, moves_n);
+    if (moves.empty()) {
+        auto end = Clock::now();
+        double time_ms = std::chrono::duration<double, std::milli>(end - search_start_).count();
+        return {-1, 0, nodes_searched_, depth, time_ms, {}};
+    }
+    
+    int best_move = moves[0];
+    int best_score = -INF;
+    
+    // First search with aspiration window
+    for (int move : moves) {
+        if (time_exceeded()) break;
+        
+        reversi::core::Board next = board;
+        next.apply_move_no_history(move);
+        
+        int score;
+        if (Features::pvs(config_)) {
+            score = -pvs<Features, Eval>(next, depth - 1, -beta, -alpha, false);
+        } else {
+            score = -negamax<Features, Eval>(next, depth - 1, -beta, -alpha);
+        }
+        
+        if (score > best_score) {
+            best_score = score;
+            best_move = move;
+        }
+        
+        if (Features::alpha_beta(config_)) {
+            alpha = std::max(alpha, score);
+        }
+    }
+    
+    // If aspiration window failed, re-search with full window
+    if (best_score <= predicted_score - window) {
+        // Failed low: re-search with full window below
+        alpha = -INF;
+        beta = predicted_score;
+        best_score = -INF;
+        
+        for (int move : moves) {
+            if (time_exceeded()) break;
+            
+            reversi::core::Board next = board;
+            next.apply_move_no_history(move);
+            
+            int score;
+            if (Features::pvs(config_)) {
+                score = -pvs<Features, Eval>(next, depth - 1, -beta, -alpha, false);
+            } else {
+                score = -negamax<Features, Eval>(next, depth - 1, -beta, -alpha);
+            }
+            
+            if (score > best_score) {
+                best_score = score;
+                best_move = move;
+            }
+            
+            if (Features::alpha_beta(config_)) {
+                alpha = std::max(alpha, score);
+            }
+        }
+    } else if (best_score >= predicted_score + window) {
+        // Failed high: re-search with full window above
+        alpha = predicted_score;
+        beta = INF;
+        best_score = -INF;
+        
+        for (int move : moves) {
+            if (time_exceeded()) break;
+            
+            reversi::core::Board next = board;
+            next.apply_move_no_history(move);
+            
+            int score;
+            if (Features::pvs(config_)) {
+                score = -pvs<Features, Eval>(next, depth - 1, -beta, -alpha, false);
+            } else {
+                score = -negamax<Features, Eval>(next, depth - 1, -beta, -alpha);
+            }
+            
+            if (score > best_score) {
+                best_score = score;
+                best_move = move;
+            }
+            
+            if (Features::alpha_beta(config_)) {
+                alpha = std::max(alpha, score);
+            }
+        }
+    }
+    
+    auto end = Clock::now();
+    double time_ms = std::chrono::duration<double, std::milli>(end - search_start_).count();
+    
+    return {best_move, best_score, nodes_searched_, depth, time_ms, {}};
+}
+
+// Week 6: Principal Variation Search (PVS) / NegaScout
+template <typename Features, typename Eval>
+inline int MinimaxEngine::pvs(
+    reversi::core::Board& board, 
+    int depth, 
+    int alpha, 
+    int beta, 
+    bool is_pv) 
+{
+    ++nodes_searched_;
+    ++current_ply_;
+    
+    // Periodic time check
+    if (time_limit_ms_ > 0 && nodes_searched_ % TIME_CHECK_INTERVAL == 0) {
+        if (time_exceeded()) {
+            --current_ply_;
+            // Return a very negative score to indicate timeout
+            // This will be pruned by alpha-beta, but won't mislead the search
+            return -INF + 1;
+        }
+    }
+    
+    // Query transposition table
+    uint8_t record_flags = NodeRecord::PVS_NODE;
+    if (Features::transposition(config_)) {
+        uint64_t hash = board.hash();
+        TTEntry* entry = tt_.probe(hash);
+        if (entry) record_flags |= NodeRecord::TT_HIT;
+        
+        if (entry && entry->depth >= depth) {
+            int score = entry->score;
+            
+            if (entry->flag == 0 ||                      // EXACT
+                (entry->flag == 1 && score >= beta) ||   // LOWER_BOUND
+                (entry->flag == 2 && score <= alpha)) {  // UPPER_BOUND
+                if (recorder_) {
+                    record_node(depth, 0, NodeRecord::NO_CUTOFF, 0, entry->flag,
+                                record_flags | NodeRecord::TT_CUTOFF, -1);
+                }
+                --current_ply_;
+                return score;
+            }
+        }
+    }
+    
+    // Leaf node
+    if (depth == 0) {
+        int score = Eval::evaluate(board);
+        --current_ply_;
+        return score;
+    }
+    
+    // Terminal node
+    if (board.is_terminal()) {
+        const int diff = board.count_player() - board.count_opponent();
+        int score = diff * 10000 * (depth + 1);
+        --current_ply_;
+        return score;
+    }
+
+    // Fallback: if this ply has shown many zero-window failures, skip PVS here
+    // Use configurable per-ply threshold to fall back to negamax when PVS shows many failures.
+    const int PVS_FAILURE_THRESHOLD = config_.pvs_failure_threshold;
+    if (Features::pvs(config_) && pvs_zero_window_failures_per_ply_[current_ply_] > PVS_FAILURE_THRESHOLD) {
+        // Use standard negamax (full-window) at this node to avoid repeated zero-window re-searches
+        int fallback_score = negamax<Features, Eval>(board, depth, alpha, beta);
+        --current_ply_;
+        return fallback_score;
+    }
+    
+    // Get legal moves (reuse buffer to avoid allocations)
+    moves_scratch_.clear();
+    board.get_legal_moves(moves_scratch_);
+    const auto& moves = moves_scratch_;
+
+    // No legal moves: must pass
+    if (moves.empty()) {
+        reversi::core::Board next = board;
+        next.pass();
+        int score = -pvs<Features, Eval>(next, depth - 1, -beta, -alpha, is_pv);
+        --current_ply_;
+        return score;
+    }
+    
+    // Order moves (on this frame: child nodes overwrite moves_scratch_)
+    int ordered_moves[64];
+    const size_t move_count = order_moves<Features, Eval>(board, moves, ordered_moves);
+    record_flags |= NodeRecord::ORDERED;
+    
+    int best_score = -INF;
+    int best_move = ordered_moves[0];
+    int original_alpha = alpha;
+    size_t best_index = 0;
+    size_t cutoff_index = NodeRecord::NO_CUTOFF;
+    
+    // Feature flags: compile-time constants for specialized policies
+    const bool use_alpha = Features::alpha_beta(config_);
+    const bool use_killer = Features::killer_moves(config_);
+
+    // First move: full window search
+    {
+        // Apply first move in-place (fast path) and restore after search
+        uint64_t prev_p = board.get_player_bb();
+        uint64_t prev_o = board.get_opponent_bb();
+        uint64_t prev_hash = board.hash();
+        board.apply_move_no_history(ordered_moves[0]);
+        best_score = -pvs<Features, Eval>(board, depth - 1, -beta, -alpha, true);
+        best_move = ordered_moves[0];
+        // Restore board
+        board.restore_state(prev_p, prev_o, prev_hash);
+        
+        if (use_alpha) {
+            if (best_score > alpha) alpha = best_score;
+            if (alpha >= beta) {
+                // Beta cutoff
+                if (use_killer) {
+                    update_killer(ordered_moves[0], current_ply_);
+                }
+                    update_history(ordered_moves[0], depth);
+                if (recorder_) {
+                    record_node(depth, move_count, 0, 0, 1, record_flags, ordered_moves[0]);
+                }
+                --current_ply_;
+                return best_score;
+            }
+        }
+    }
+    
+    // Subsequent moves: zero window search (null window)
+    for (size_t i = 1; i < move_count; ++i) {
+        if (time_exceeded()) break;
+        
+        // Apply move in-place and restore after
+        uint64_t prev_p = board.get_player_bb();
+        uint64_t prev_o = board.get_opponent_bb();
+        uint64_t prev_hash = board.hash();
+        board.apply_move_no_history(ordered_moves[i]);
+        // Zero window search: assume this move is not better
+        // Search with window [alpha, alpha+1] to test if score > alpha
+        int score = -pvs<Features, Eval>(board, depth - 1, -alpha - 1, -alpha, false);
+        
+        // If zero window fails, decide whether to re-search.
+    // Use runtime-configurable PVS research margin
+    const int PVS_RESEARCH_MARGIN = config_.pvs_research_margin;
+            if (score >= beta) {
+            // Zero-window exceeded beta: immediate beta-cut
+            ++pvs_zero_window_failures_;
+            if (current_ply_ >= 0 && current_ply_ < MAX_DEPTH) {
+                ++pvs_zero_window_failures_per_ply_[current_ply_];
+                ++pvs_zero_window_beta_cutoffs_per_ply_[current_ply_];
+            }
+            ++pvs_zero_window_beta_cutoffs_;
+            if (use_killer) {
+                update_killer(ordered_moves[i], current_ply_);
+            }
+                // Update history heuristic for this move causing beta cutoff
+                update_history(ordered_moves[i], depth);
+            best_score = score;
+            best_move = ordered_moves[i];
+            best_index = cutoff_index = i;
+            break;
+        } else if (score > alpha + PVS_RESEARCH_MARGIN) {
+            // Zero-window failed with sufficient margin: re-search with full window
+            ++pvs_zero_window_failures_;
+            if (current_ply_ >= 0 && current_ply_ < MAX_DEPTH) {
+                ++pvs_zero_window_failures_per_ply_[current_ply_];
+            }
+            ++pvs_researches_;
+            if (current_ply_ >= 0 && current_ply_ < MAX_DEPTH) {
+                ++pvs_researches_per_ply_[current_ply_];
+            }
+            score = -pvs<Features, Eval>(board, depth - 1, -beta, -alpha, true);
+        }
+        
+        if (score > best_score) {
+            best_score = score;
+            best_move = ordered_moves[i];
+            best_index = i;
+        }
+        // Restore board after recursive search
+        board.restore_state(prev_p, prev_o, prev_hash);
+        
+        if (use_alpha) {
+            if (score > alpha) alpha = score;
+            if (alpha >= beta) {
+                // Beta cutoff
+                cutoff_index = i;
+                if (use_killer) {
+                    update_killer(ordered_moves[i], current_ply_);
+                }
+                    update_history(ordered_moves[i], depth);
+                break;
+            }
+        }
+    }
+    
+    if (recorder_) {
+        const int bound = best_score <= original_alpha ? 2 : (best_score >= beta ? 1 : 0);
+        record_node(depth, move_count, static_cast<int>(cutoff_index), static_cast<int>(best_index),
+                    bound, record_flags, best_move);
+    }
+    
+    // Store in transposition table
+    if (Features::transposition(config_)) {
+        uint64_t hash = board.hash();
+        TTEntry new_entry;
+        new_entry.hash = hash;
+        new_entry.score = best_score;
+        new_entry.depth = depth;
+        new_entry.best_move = best_move;
+        
+        if (best_score <= original_alpha) {
+            new_entry.flag = 2;  // UPPER_BOUND
+        } else if (best_score >= beta) {
+            new_entry.flag = 1;  // LOWER_BOUND
+        } else {
+            new_entry.flag = 0;  // EXACT
+        }
+        
+        tt_.store(new_entry);
+    }
+    
+    --current_ply_;
+    return best_score;
+}
+
+inline void MinimaxEngine::record_node(int depth, size_t moves, int cutoff_index, int best_index,
+                                       int bound, uint8_t flags, int key_move) {
+    NodeRecord r;
+    r.ply = static_cast<uint8_t>(std::clamp(current_ply_, 0, 255));
+    r.depth = static_cast<uint8_t>(std::clamp(depth, 0, 255));
+    r.moves = static_cast<uint8_t>(moves);
+    r.cutoff_index = static_cast<uint8_t>(cutoff_index);
+    r.best_index = static_cast<uint8_t>(best_index);
+    r.bound = static_cast<uint8_t>(bound);
+    r.flags = flags;
+    if ((flags & NodeRecord::ORDERED) && key_move >= 0 && current_ply_ >= 0 && current_ply_ < MAX_DEPTH) {
+        r.sources = order_sources_[current_ply_][key_move];
+    }
+    recorder_->record(r);
+}
+
+inline bool MinimaxEngine::time_exceeded() const {
+    if (time_limit_ms_ <= 0) return false;
+    
+    using Clock = std::chrono::high_resolution_clock;
+    auto now = Clock::now();
+    auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(now - search_start_);
+    
+    return elapsed.count() >= time_limit_ms_;
+}
+
+// Week 6: Killer moves
+inline void MinimaxEngine::update_killer(int move, int ply) {
+    if (ply < 0 || ply >= MAX_DEPTH) return;
+    
+    // Don't update if move is already killer1
+    if (killer1_[ply] == move) return;
+    
+    // Shift: killer2 becomes killer1, new move becomes killer1
+    killer2_[ply] = killer1_[ply];
+    killer1_[ply] = move;
+}
+
+inline int MinimaxEngine::get_killer_bonus(int move, int ply) const {
+    if (ply < 0 || ply >= MAX_DEPTH) return 0;
+    
+    if (killer1_[ply] == move) return config_.killer_weight;
+    if (killer2_[ply] == move) return config_.killer_weight / 2;
+    return 0;
+}
+
+// Update history heuristic for a move that caused a beta-cutoff.
+inline void MinimaxEngine::update_history(int move, int depth) {
+    if (move < 0 || move >= 64) return;
+    // Heuristic: bigger depth increments history more (prefer moves that cause deep cutoffs)
+    history_table_[move] += (depth * depth + 1);
+}
+
+// Week 6: Move ordering
+template <typename Features, typename Eval>
+size_t MinimaxEngine::order_moves(
+    const reversi::core::Board& board, 
+    const std::vector<int>& moves,
+    int* ordered) const 
+{
+    REVERSI_TRACE_HOT("search", "order_moves");
+    if (moves.empty()) return 0;
+    
+    // Create move-score pairs using reusable scratch vector to avoid allocations
+    move_scores_scratch_.clear();
+    move_scores_scratch_.reserve(moves.size());
+    
+    // Get TT best move (if available)
+    int tt_best_move = -1;
+    if (Features::transposition(config_)) {
+        uint64_t hash = board.hash();
+        TTEntry* entry = tt_.probe(hash);
+        if (entry && entry->best_move >= 0 && entry->best_move < 64) {
+            tt_best_move = entry->best_move;
+        }
+    }
+    
+    // Pre-calculate flip counts to avoid repeated Board copies
+    // Use const reference and calc_flip which doesn't modify board
+    bool tt_move_used = false;
+    // Recording: note which heuristics flag each move (SearchRecorder sources)
+    const bool recording = recorder_ && current_ply_ >= 0 && current_ply_ < MAX_DEPTH;
+    uint8_t* sources = recording ? order_sources_[current_ply_].data() : nullptr;
+    int top_pos_weight = std::numeric_limits<int>::min();
+    int top_flips = 0;
+    // Simple conservative ordering: TT, killer, positional weight, flip count, history
+    // (weights from Config so they can be tuned).
+    move_scores_scratch_.clear();
+    move_scores_scratch_.reserve(moves.size());
+    for (int move : moves) {
+        int score = 0;
+        if (move == tt_best_move) {
+            score += config_.tt_weight;
+            tt_move_used = true;
+        }
+        if (Features::killer_moves(config_)) {
+            score += get_killer_bonus(move, current_ply_);
+        }
+        int pos_weight = POSITION_WEIGHTS[move];
+        score += pos_weight * config_.pos_weight_mul;
+        uint64_t flip_mask = board.calc_flip(move);
+        int flip_count = static_cast<int>(std::popcount(flip_mask));
+        score += flip_count * config_.flip_mul;
+        if (config_.history_weight != 0) {
+            // 64-bit product, clamped below the TT bonus range so it cannot overflow
+            int64_t history = static_cast<int64_t>(history_table_[move]) * config_.history_weight;
+            score += static_cast<int>(std::min<int64_t>(history, 1 << 20));
+        }
+        move_scores_scratch_.emplace_back(move, score);
+        if (recording) {
+            sources[move] = 0;
+            if (move == tt_best_move) sources[move] |= NodeRecord::SRC_TT;
+            if (Features::killer_moves(config_) &&
+                (killer1_[current_ply_] == move || killer2_[current_ply_] == move)) {
+                sources[move] |= NodeRecord::SRC_KILLER;
+            }
+            top_pos_weight = std::max(top_pos_weight, pos_weight);
+            top_flips = std::max(top_flips, flip_count);
+        }
+    }
+    if (recording) {
+        for (int move : moves) {
+            if (POSITION_WEIGHTS[move] == top_pos_weight) sources[move] |= NodeRecord::SRC_POSITIONAL;
+            if (std::popcount(board.calc_flip(move)) == top_flips) sources[move] |= NodeRecord::SRC_FLIPS;
+        }
+    }
+    
+    // Do a very cheap partial refinement on a small number of top candidates to improve PVS ordering.
+    // At root we refine more candidates (higher potential benefit); in deeper plies keep it minimal.
+    int top_k = 0;
+    if (current_ply_ == 0) {
+        // Be conservative at root: only refine top-1 to avoid noisy re-ordering.
+        top_k = static_cast<int>(std::min<size_t>(1, move_scores_scratch_.size()));
+    } else if (current_ply_ >= 3) {
+        top_k = 1;
+    } else {
+        top_k = 2;
+    }
+    if (top_k > 0 && move_scores_scratch_.size() > 1) {
+        if (top_k < static_cast<int>(move_scores_scratch_.size())) {
+            std::partial_sort(move_scores_scratch_.begin(), move_scores_scratch_.begin() + top_k, move_scores_scratch_.end(),
+                [](const auto& a, const auto& b){ return a.second > b.second; });
+        } else {
+            // small set: full sort is fine
+            std::sort(move_scores_scratch_.begin(), move_scores_scratch_.end(),
+                [](const auto& a, const auto& b){ return a.second > b.second; });
+        }
+
+        // Evaluate the top_k candidates with a lightweight evaluation to improve ordering.
+        for (int i = 0; i < top_k; ++i) {
+            int mv = move_scores_scratch_[i].first;
+            if (recording) sources[mv] |= NodeRecord::SRC_REFINED;
+            // quick deepening: evaluate resulting position to improve ordering
+            reversi::core::Board next = board;
+            next.apply_move_no_history(mv);
+            int eval_score = Eval::evaluate(next);
+            // amplify evaluation to influence ordering but keep cost low (use shift instead of mul)
+            move_scores_scratch_[i].second += (eval_score << 3); // *8
+        }
+    }
+
+    // Final sort by updated score (descending)
+    // Sort move_scores_scratch_ descending by score.
+    // Use insertion sort for small sizes to avoid allocation/call overhead of std::sort.
+    size_t n = move_scores_scratch_.size();
+    if (n <= 16) {
+        for (size_t i = 1; i < n; ++i) {
+            auto key = move_scores_scratch_[i];
+            size_t j = i;
+            while (j > 0 && move_scores_scratch_[j - 1].second < key.second) {
+                move_scores_scratch_[j] = move_scores_scratch_[j - 1];
+                --j;
+            }
+            move_scores_scratch_[j] = key;
+        }
+    } else {
+        std::sort(move_scores_scratch_.begin(), move_scores_scratch_.end(),
+                  [](const auto& a, const auto& b) { return a.second > b.second; });
+    }
+
+    // Extract ordered moves, ensuring TT best move is placed first if present
+    size_t count = 0;
+    if (tt_best_move >= 0 && tt_move_used) {
+        ordered[count++] = tt_best_move;
+    }
+    for (const auto& ms : move_scores_scratch_) {
+        int mv = ms.first;
+        if (mv == tt_best_move) continue;
+        ordered[count++] = mv;
+    }
+
+    return count;
+}
+
+} // namespace reversi::ai
@@ -0,0 +1,157 @@
+/*
+ * PerfCounters.cpp - Hardware performance counters around search regions
+ * COMP390 Honours Year Project
+ */
+
+#include "ai/PerfCounters.hpp"
+#include <cstdio>
+
+#if defined(REVERSI_PERF_COUNTERS) && defined(__linux__)
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <cstring>
+#define REVERSI_HAVE_PERF 1
+#endif
+
+namespace reversi::ai {
+
+namespace {
+
+#ifdef REVERSI_HAVE_PERF
+struct CounterSpec {
+    uint32_t type;
+    uint64_t config;
+};
+
+constexpr uint64_t cache_event(uint64_t cache, uint64_t op, uint64_t result) {
+    return cache | (op << 8) | (result << 16);
+}
+
+// Same order as PerfSample::Counter
+constexpr CounterSpec SPECS[PerfSample::NUM_COUNTERS] = {
+    {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES},
+    {PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS},
+    {PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_INSTRUCTIONS},
+    {PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES},
+    {PERF_TYPE_HW_CACHE, cache_event(PERF_COUNT_HW_CACHE_L1D, PERF_COUNT_HW_CACHE_OP_READ,
+                                     PERF_COUNT_HW_CACHE_RESULT_MISS)},
+    {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES},
+};
+
+int open_counter(const CounterSpec& spec) {
+    perf_event_attr attr;
+    std::memset(&attr, 0, sizeof(attr));
+    attr.size = sizeof(attr);
+    attr.type = spec.type;
+    attr.config = spec.config;
+    attr.disabled = 1;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    // Scale for multiplexing when more events than hardware slots are open
+    attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+    // Calling thread, any CPU; counters are independent so an unsupported
+    // event only loses itself
+    return static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0));
+}
+#endif
+
+} // namespace
+
+std::string PerfSample::summary(uint64_t ops) const {
+    if (!valid()) return "";
+    std::string s;
+    char buf[64];
+    auto append = [&](const char* text) {
+        if (!s.empty()) s += ", ";
+        s += text;
+    };
+    if (ipc() > 0) {
+        std::snprintf(buf, sizeof(buf), "IPC %.2f", ipc());
+        append(buf);
+    }
+    if (has(BRANCHES) && has(BRANCH_MISSES)) {
+        std::snprintf(buf, sizeof(buf), "branch-miss %.2f%%", 100.0 * branch_miss_rate());
+        append(buf);
+    }
+    if (has(L1D_MISSES)) {
+        std::snprintf(buf, sizeof(buf), "L1D %.3f/op", per(L1D_MISSES, ops));
+        append(buf);
+    }
+    if (has(LLC_MISSES)) {
+        std::snprintf(buf, sizeof(buf), "LLC %.4f/op", per(LLC_MISSES, ops));
+        append(buf);
+    }
+    return s;
+}
+
+const char* PerfSample::counter_name(Counter c) {
+    switch (c) {
+        case CYCLES: return "cycles";
+        case INSTRUCTIONS: return "instructions";
+        case BRANCHES: return "branches";
+        case BRANCH_MISSES: return "branch_misses";
+        case L1D_MISSES: return "l1d_misses";
+        case LLC_MISSES: return "llc_misses";
+        default: return "?";
+    }
+}
+
+PerfCounters::PerfCounters() {
+    for (int i = 0; i < PerfSample::NUM_COUNTERS; ++i) {
+        fds_[i] = -1;
+#ifdef REVERSI_HAVE_PERF
+        fds_[i] = open_counter(SPECS[i]);
+        if (fds_[i] >= 0) opened_ |= 1u << i;
+#endif
+    }
+}
+
+PerfCounters::~PerfCounters() {
+#ifdef REVERSI_HAVE_PERF
+    for (int fd : fds_) {
+        if (fd >= 0) close(fd);
+    }
+#endif
+}
+
+void PerfCounters::start() {
+#ifdef REVERSI_HAVE_PERF
+    for (int fd : fds_) {
+        if (fd < 0) continue;
+        ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+        ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+    }
+#endif
+}
+
+PerfSample PerfCounters::stop() {
+    PerfSample sample;
+#ifdef REVERSI_HAVE_PERF
+    for (int fd : fds_) {
+        if (fd >= 0) ioctl(fd, PERF_EVENT_IOC_DISABLE, 0);
+    }
+    for (int i = 0; i < PerfSample::NUM_COUNTERS; ++i) {
+        uint64_t data[3] = {};  // value, time enabled, time running
+        if (fds_[i] < 0 || read(fds_[i], data, sizeof(data)) != static_cast<ssize_t>(sizeof(data))) continue;
+        if (data[2] == 0) continue;  // Never scheduled
+        sample.values[i] = data[2] < data[1]
+                               ? static_cast<uint64_t>(static_cast<double>(data[0]) * data[1] / data[2])
+                               : data[0];
+        sample.counted |= 1u << i;
+    }
+#endif
+    return sample;
+}
+
+bool PerfCounters::supported() {
+#ifdef REVERSI_HAVE_PERF
+    static const bool ok = PerfCounters().available();
+    return ok;
+#else
+    return false;
+#endif
+}
+
+} // namespace reversi::ai
@@ -0,0 +1,108 @@
+/*
+ * PerfCounters.hpp - Hardware performance counters around search regions
+ * COMP390 Honours Year Project
+ *
+ * Thin wrapper over Linux perf_event_open: cycles, instructions,
+ * branches, branch misses, L1D read misses and LLC misses of the calling
+ * thread (user space only, so it works with perf_event_paranoid <= 2).
+ *
+ * Optional at two levels:
+ * - compile time: only built with REVERSI_PERF_COUNTERS (CMake option
+ *   ENABLE_PERF_COUNTERS, Linux only); otherwise every call is a no-op
+ * - run time: counters the kernel / VM refuses are simply missing
+ *   (PerfSample::has), and available() is false if none opened
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+namespace reversi::ai {
+
+/**
+ * @brief Counter deltas over one measured region (0 if not counted)
+ */
+struct PerfSample {
+    enum Counter { CYCLES, INSTRUCTIONS, BRANCHES, BRANCH_MISSES, L1D_MISSES, LLC_MISSES, NUM_COUNTERS };
+
+    uint64_t values[NUM_COUNTERS] = {};
+    uint32_t counted = 0;   ///< Bit i set if counter i was measured
+
+    bool valid() const { return counted != 0; }
+    bool has(Counter c) const { return (counted >> c) & 1u; }
+    uint64_t get(Counter c) const { return values[c]; }
+
+    /// Instructions per cycle (0 if either is missing)
+    double ipc() const {
+        return has(CYCLES) && has(INSTRUCTIONS) && values[CYCLES] > 0
+                   ? static_cast<double>(values[INSTRUCTIONS]) / values[CYCLES] : 0.0;
+    }
+    /// Fraction of branches mispredicted
+    double branch_miss_rate() const {
+        return has(BRANCHES) && has(BRANCH_MISSES) && values[BRANCHES] > 0
+                   ? static_cast<double>(values[BRANCH_MISSES]) / values[BRANCHES] : 0.0;
+    }
+    /// Counter value per unit of work (e.g. LLC misses per node)
+    double per(Counter c, uint64_t ops) const {
+        return has(c) && ops > 0 ? static_cast<double>(values[c]) / ops : 0.0;
+    }
+
+    PerfSample& operator+=(const PerfSample& other) {
+        for (int i = 0; i < NUM_COUNTERS; ++i) values[i] += other.values[i];
+        counted |= other.counted;
+        return *this;
+    }
+
+    /// "IPC 2.31, branch-miss 4.2%, L1D 0.8/op, LLC 0.02/op" (empty if nothing counted)
+    std::string summary(uint64_t ops) const;
+
+    static const char* counter_name(Counter c);
+};
+
+/**
+ * @brief Counter set for the calling thread
+ *
+ * Open once, then bracket regions with start()/stop(). Not thread-safe:
+ * use one instance per thread (counters follow the thread that opened them).
+ */
+class PerfCounters {
+public:
+    PerfCounters();
+    ~PerfCounters();
+    PerfCounters(const PerfCounters&) = delete;
+    PerfCounters& operator=(const PerfCounters&) = delete;
+
+    /** @brief At least one counter opened */
+    bool available() const { return opened_ != 0; }
+
+    /** @brief Reset and enable all counters */
+    void start();
+
+    /** @brief Disable and read; deltas since start() */
+    PerfSample stop();
+
+    /** @brief Built with perf support and at least one counter opens here */
+    static bool supported();
+
+private:
+    int fds_[PerfSample::NUM_COUNTERS];
+    uint32_t opened_ = 0;
+};
+
+/**
+ * @brief Adds the counters of a scope to a sample (no-op if unavailable)
+ */
+class ScopedPerf {
+public:
+    ScopedPerf(PerfCounters& counters, PerfSample& out) : counters_(counters), out_(out) { counters_.start(); }
+    ~ScopedPerf() { out_ += counters_.stop(); }
+    ScopedPerf(const ScopedPerf&) = delete;
+    ScopedPerf& operator=(const ScopedPerf&) = delete;
+
+private:
+    PerfCounters& counters_;
+    PerfSample& out_;
+};
+
+} // namespace reversi::ai
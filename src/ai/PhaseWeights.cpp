@@ -0,0 +1,66 @@
+/*
+ * PhaseWeights.cpp - Weight table file I/O
+ * COMP390 Honours Year Project
+ */
+
+#include "ai/PhaseWeights.hpp"
+#include <fstream>
+#include <sstream>
+
+namespace reversi::ai {
+
+namespace {
+constexpr const char* WEIGHTS_HEADER = "# reversi-phase-weights v1";
+constexpr GamePhase ALL_PHASES[4] = {
+    GamePhase::Opening, GamePhase::EarlyMid, GamePhase::LateMid, GamePhase::Endgame
+};
+} // namespace
+
+bool PhaseWeights::load_table(const std::string& path, PhaseWeightTable& table) {
+    std::ifstream in(path);
+    if (!in.is_open()) return false;
+
+    std::string line;
+    if (!std::getline(in, line) || line != WEIGHTS_HEADER) return false;
+
+    PhaseWeightTable loaded{};
+    bool seen[4] = {false, false, false, false};
+    while (std::getline(in, line)) {
+        std::istringstream fields(line);
+        std::string phase_name;
+        if (!(fields >> phase_name) || phase_name[0] == '#') continue;
+        int index = -1;
+        for (GamePhase phase : ALL_PHASES) {
+            if (phase_name == PhaseWeights::phase_name(phase)) index = static_cast<int>(phase);
+        }
+        if (index < 0) return false;
+        for (int f = 0; f < NUM_FIELDS; ++f) {
+            if (!(fields >> (loaded[index].*FIELDS[f]))) return false;
+        }
+        seen[index] = true;
+    }
+    for (bool s : seen) {
+        if (!s) return false;
+    }
+    table = loaded;
+    return true;
+}
+
+bool PhaseWeights::save_table(const std::string& path, const PhaseWeightTable& table) {
+    std::ofstream out(path);
+    if (!out.is_open()) return false;
+
+    out << WEIGHTS_HEADER << "\n# phase";
+    for (const char* name : FIELD_NAMES) out << " " << name;
+    out << "\n";
+    for (GamePhase phase : ALL_PHASES) {
+        out << phase_name(phase);
+        for (int f = 0; f < NUM_FIELDS; ++f) {
+            out << " " << table[static_cast<int>(phase)].*FIELDS[f];
+        }
+        out << "\n";
+    }
+    return static_cast<bool>(out);
+}
+
+} // namespace reversi::ai
@@ -12,7 +12,9 @@
 #pragma once
 
 #include "core/Board.hpp"
+#include <array>
 #include <cstdint>
+#include <string>
 
 namespace reversi::ai {
 
@@ -37,13 +39,63 @@ struct PhaseWeightConfig {
     int frontier_penalty;        // Penalty for frontier discs
     int position_weight_scale;   // Scaling for position weight table
     int corner_bonus;            // Extra bonus for corners (beyond position weights)
+    
+    bool operator==(const PhaseWeightConfig&) const = default;
 };
 
+/**
+ * @brief One PhaseWeightConfig per GamePhase (indexed by the enum value)
+ */
+using PhaseWeightTable = std::array<PhaseWeightConfig, 4>;
+
 /**
  * @brief Phase detection and weight management
+ * 
+ * get_weights() reads the table active on the calling thread: a
+ * ScopedTable if one is installed, else the process-wide table set by
+ * set_default_table() (e.g. tuned weights loaded from a file), else the
+ * built-in constants. Tuners use the scoped form to give each engine its
+ * own weights without touching the evaluator.
  */
 class PhaseWeights {
 public:
+    /**
+     * @brief PhaseWeightConfig fields in declaration order
+     * 
+     * Feature i of EvaluatorWeek4::extract_features() is multiplied by
+     * field FIELDS[i]; FIELD_NAMES are used in weight files.
+     */
+    static constexpr int NUM_FIELDS = 7;
+    static constexpr int PhaseWeightConfig::* FIELDS[NUM_FIELDS] = {
+        &PhaseWeightConfig::piece_count_weight,
+        &PhaseWeightConfig::mobility_weight,
+        &PhaseWeightConfig::potential_mobility_weight,
+        &PhaseWeightConfig::stability_weight,
+        &PhaseWeightConfig::frontier_penalty,
+        &PhaseWeightConfig::position_weight_scale,
+        &PhaseWeightConfig::corner_bonus
+    };
+    static constexpr const char* FIELD_NAMES[NUM_FIELDS] = {
+        "piece_count_weight", "mobility_weight", "potential_mobility_weight",
+        "stability_weight", "frontier_penalty", "position_weight_scale", "corner_bonus"
+    };
+    
+    /**
+     * @brief Installs a weight table for the current thread (RAII)
+     * 
+     * The table must outlive the scope. Scopes nest.
+     */
+    class ScopedTable {
+    public:
+        explicit ScopedTable(const PhaseWeightTable& table) noexcept
+            : previous_(current_) { current_ = &table; }
+        ~ScopedTable() { current_ = previous_; }
+        ScopedTable(const ScopedTable&) = delete;
+        ScopedTable& operator=(const ScopedTable&) = delete;
+    private:
+        const PhaseWeightTable* previous_;
+    };
+    
     /**
      * @brief Detect current game phase
      * 
@@ -66,7 +118,54 @@ public:
      * @return Weight configuration
      */
     static const PhaseWeightConfig& get_weights(GamePhase phase) noexcept {
-        static const PhaseWeightConfig configs[4] = {
+        return active_table()[static_cast<int>(phase)];
+    }
+    
+    /**
+     * @brief Table used by get_weights() on this thread
+     */
+    static const PhaseWeightTable& active_table() noexcept {
+        if (current_) return *current_;
+        return installed_ ? *installed_ : default_table();
+    }
+    
+    /**
+     * @brief Replace the built-in weights for every thread
+     * 
+     * Not synchronised with running searches: call at startup, before
+     * any engine evaluates.
+     */
+    static void set_default_table(const PhaseWeightTable& table) noexcept {
+        static PhaseWeightTable storage;
+        storage = table;
+        installed_ = &storage;
+    }
+    
+    /**
+     * @brief Return to the built-in weights
+     */
+    static void reset_default_table() noexcept { installed_ = nullptr; }
+    
+    /**
+     * @brief Read a weights file written by save_table()
+     * 
+     * Format: "# reversi-phase-weights v1", then one line per phase:
+     * "<PhaseName> <7 integers in FIELDS order>".
+     * 
+     * @return false (table untouched) if the file is missing or malformed
+     */
+    static bool load_table(const std::string& path, PhaseWeightTable& table);
+    
+    /**
+     * @brief Write a table in the load_table() format
+     */
+    static bool save_table(const std::string& path, const PhaseWeightTable& table);
+    
+    /**
+     * @brief Hand-tuned built-in weights
+     */
+    static const PhaseWeightTable& default_table() noexcept {
+        static const PhaseWeightTable configs = {{
             // Opening: Mobility > Stability > Material
             {
                 .piece_count_weight = 1,        // Material doesn't matter much
@@ -110,9 +209,9 @@ public:
                 .position_weight_scale = 1,     // Position weights minimal
                 .corner_bonus = 40              // Corners for stability
             }
-        };
+        }};
         
-        return configs[static_cast<int>(phase)];
+        return configs;
     }
     
     /**
@@ -167,6 +266,10 @@ public:
             default: return "Unknown";
         }
     }
+    
+private:
+    static inline thread_local const PhaseWeightTable* current_ = nullptr;
+    static inline const PhaseWeightTable* installed_ = nullptr;
 };
 
 } // namespace reversi::ai
@@ -0,0 +1,170 @@
+/*
+ * PlayoutKernel.hpp - Allocation-free MCTS playouts on raw bitboards
+ * COMP390 Honours Year Project
+ *
+ * Plays a game to the end from (player, opponent) bitboards:
+ * - inline Kogge-Stone move generation and flip scans (no Board, no
+ *   hashing, no move history)
+ * - moves picked straight from the legal mask by popcount / bit index
+ * - heuristic policy ranks moves by precomputed square classes
+ *   (corner > edge > interior > C-square > X-square) instead of
+ *   scoring and sorting a move list
+ *
+ * Everything lives in registers and on the stack; a playout never
+ * touches the heap.
+ */
+
+#pragma once
+
+#include "ai/FastRng.hpp"
+#include <algorithm>
+#include <bit>
+#include <cstdint>
+#include <utility>
+
+namespace reversi::ai::playout {
+
+// Square classes (bit 0 = A1, bit 7 = H1); together they cover the board
+constexpr uint64_t CORNERS = 0x8100000000000081ULL;
+constexpr uint64_t X_SQUARES = 0x0042000000004200ULL;   ///< B2, G2, B7, G7
+constexpr uint64_t C_SQUARES = 0x4281000000008142ULL;   ///< Edge squares next to a corner
+constexpr uint64_t EDGE_RING = 0xFF818181818181FFULL;
+constexpr uint64_t EDGES = EDGE_RING & ~CORNERS & ~C_SQUARES;
+constexpr uint64_t INTERIOR = ~EDGE_RING & ~X_SQUARES;
+
+/// Heuristic policy preference, best first
+constexpr uint64_t SQUARE_TIERS[5] = {CORNERS, EDGES, INTERIOR, C_SQUARES, X_SQUARES};
+
+namespace detail {
+
+constexpr uint64_t NOT_EDGE_FILES = 0x7E7E7E7E7E7E7E7EULL;
+
+template <int S>
+constexpr uint64_t shift(uint64_t bb) {
+    if constexpr (S > 0) return bb << S;
+    else return bb >> -S;
+}
+
+/// Legal moves along one direction (mask = opponent discs that may be crossed)
+template <int S>
+inline uint64_t moves_dir(uint64_t player, uint64_t mask, uint64_t empty) {
+    uint64_t t = mask & shift<S>(player);
+    t |= mask & shift<S>(t);
+    t |= mask & shift<S>(t);
+    t |= mask & shift<S>(t);
+    t |= mask & shift<S>(t);
+    t |= mask & shift<S>(t);
+    return empty & shift<S>(t);
+}
+
+/// Discs flipped along one direction by a disc placed at bit
+template <int S>
+inline uint64_t flips_dir(uint64_t bit, uint64_t player, uint64_t mask) {
+    uint64_t flipped = 0;
+    uint64_t t = shift<S>(bit);
+    while (t & mask) {
+        flipped |= t;
+        t = shift<S>(t);
+    }
+    return (t & player) ? flipped : 0;
+}
+
+} // namespace detail
+
+/** @brief Legal moves for player (same result as Board::legal_moves) */
+inline uint64_t legal_moves(uint64_t player, uint64_t opponent) {
+    using namespace detail;
+    const uint64_t empty = ~(player | opponent);
+    const uint64_t inner = opponent & NOT_EDGE_FILES;  // No wrap across the A/H files
+    return moves_dir<1>(player, inner, empty) | moves_dir<-1>(player, inner, empty) |
+           moves_dir<8>(player, opponent, empty) | moves_dir<-8>(player, opponent, empty) |
+           moves_dir<7>(player, inner, empty) | moves_dir<-7>(player, inner, empty) |
+           moves_dir<9>(player, inner, empty) | moves_dir<-9>(player, inner, empty);
+}
+
+/** @brief Discs flipped by player moving at sq (0 if the move is illegal) */
+inline uint64_t flips(int sq, uint64_t player, uint64_t opponent) {
+    using namespace detail;
+    const uint64_t bit = 1ULL << sq;
+    const uint64_t inner = opponent & NOT_EDGE_FILES;
+    return flips_dir<1>(bit, player, inner) | flips_dir<-1>(bit, player, inner) |
+           flips_dir<8>(bit, player, opponent) | flips_dir<-8>(bit, player, opponent) |
+           flips_dir<7>(bit, player, inner) | flips_dir<-7>(bit, player, inner) |
+           flips_dir<9>(bit, player, inner) | flips_dir<-9>(bit, player, inner);
+}
+
+/** @brief Square index of the n-th set bit of mask (n < popcount(mask)) */
+inline int nth_square(uint64_t mask, uint32_t n) {
+    for (; n > 0; --n) mask &= mask - 1;
+    return std::countr_zero(mask);
+}
+
+/** @brief Uniformly random legal move */
+inline int pick_random(uint64_t legal, FastRng& rng) {
+    return nth_square(legal, rng.below(static_cast<uint32_t>(std::popcount(legal))));
+}
+
+/**
+ * @brief Random move among the best square classes
+ *
+ * Takes whole tiers of SQUARE_TIERS until they hold at least
+ * max(1, top_fraction * moves) moves, then picks uniformly among them.
+ */
+inline int pick_heuristic(uint64_t legal, double top_fraction, FastRng& rng) {
+    const int wanted = std::max(1, static_cast<int>(std::popcount(legal) * top_fraction));
+    uint64_t candidates = 0;
+    for (uint64_t tier : SQUARE_TIERS) {
+        candidates |= legal & tier;
+        if (std::popcount(candidates) >= wanted) break;
+    }
+    return pick_random(candidates, rng);
+}
+
+/**
+ * @brief Play to the end of the game
+ *
+ * @param pick Move policy: int(uint64_t legal) returning a square in legal
+ * @param plies Incremented once per move played (passes excluded)
+ * @param played Optional: squares played are OR-ed into played[0] (side to
+ *        move at the start) and played[1] (the other side), for AMAF
+ * @return Final disc difference for the side to move at the start
+ */
+template <typename Pick>
+inline int run(uint64_t player, uint64_t opponent, Pick&& pick, int& plies, uint64_t* played = nullptr) {
+    bool swapped = false;
+    for (;;) {
+        uint64_t legal = legal_moves(player, opponent);
+        if (legal == 0) {
+            legal = legal_moves(opponent, player);
+            if (legal == 0) break;
+            std::swap(player, opponent);
+            swapped = !swapped;
+        }
+        const int sq = pick(legal);
+        if (played != nullptr) played[swapped] |= 1ULL << sq;
+        const uint64_t flipped = flips(sq, player, opponent);
+        player |= flipped | (1ULL << sq);
+        opponent &= ~flipped;
+        std::swap(player, opponent);
+        swapped = !swapped;
+        ++plies;
+    }
+    const int diff = std::popcount(player) - std::popcount(opponent);
+    return swapped ? -diff : diff;
+}
+
+/** @brief Uniformly random playout */
+inline int random_game(uint64_t player, uint64_t opponent, FastRng& rng, int& plies,
+                       uint64_t* played = nullptr) {
+    return run(player, opponent, [&rng](uint64_t legal) { return pick_random(legal, rng); }, plies, played);
+}
+
+/** @brief Square-class heuristic playout (see pick_heuristic) */
+inline int heuristic_game(uint64_t player, uint64_t opponent, double top_fraction, FastRng& rng, int& plies,
+                          uint64_t* played = nullptr) {
+    return run(player, opponent,
+               [&rng, top_fraction](uint64_t legal) { return pick_heuristic(legal, top_fraction, rng); }, plies,
+               played);
+}
+
+} // namespace reversi::ai::playout
@@ -0,0 +1,58 @@
+/*
+ * SearchFeatures.hpp - Feature policies for the templated search core
+ * COMP390 Honours Year Project
+ *
+ * MinimaxEngine's negamax/pvs are templates over a feature policy. Each
+ * policy answers "is feature X enabled?" given the engine Config:
+ * - SearchFeatures<...> answers with compile-time constants, so disabled
+ *   features (and their branches) vanish from the node loop
+ * - RuntimeSearchFeatures reads the Config flags on every call, which is
+ *   the original behaviour, kept for A/B benchmarking
+ *
+ * MinimaxEngine picks the instantiation once per search (see
+ * Config::use_specialized_search).
+ */
+
+#pragma once
+
+namespace reversi::ai {
+
+/**
+ * @brief Compile-time feature policy
+ *
+ * @tparam AlphaBeta     Alpha-beta pruning
+ * @tparam Transposition Transposition table probe/store and TT move ordering
+ * @tparam KillerMoves   Killer move updates and ordering bonus
+ * @tparam PVS           Principal Variation Search at interior nodes
+ */
+template <bool AlphaBeta, bool Transposition, bool KillerMoves, bool PVS>
+struct SearchFeatures {
+    static constexpr bool is_specialized = true;
+
+    template <typename Config>
+    static constexpr bool alpha_beta(const Config&) noexcept { return AlphaBeta; }
+    template <typename Config>
+    static constexpr bool transposition(const Config&) noexcept { return Transposition; }
+    template <typename Config>
+    static constexpr bool killer_moves(const Config&) noexcept { return KillerMoves; }
+    template <typename Config>
+    static constexpr bool pvs(const Config&) noexcept { return PVS; }
+};
+
+/**
+ * @brief Runtime feature policy (flags re-read from Config at every node)
+ */
+struct RuntimeSearchFeatures {
+    static constexpr bool is_specialized = false;
+
+    template <typename Config>
+    static bool alpha_beta(const Config& c) noexcept { return c.use_alpha_beta; }
+    template <typename Config>
+    static bool transposition(const Config& c) noexcept { return c.use_transposition; }
+    template <typename Config>
+    static bool killer_moves(const Config& c) noexcept { return c.use_killer_moves; }
+    template <typename Config>
+    static bool pvs(const Config& c) noexcept { return c.use_pvs; }
+};
+
+} // namespace reversi::ai
@@ -0,0 +1,147 @@
+/*
+ * SearchRecorder.cpp - Per-node search records and move-ordering analysis
+ * COMP390 Honours Year Project
+ */
+
+#include "ai/SearchRecorder.hpp"
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+
+namespace reversi::ai {
+
+namespace {
+
+constexpr char MAGIC[4] = {'R', 'V', 'S', 'R'};
+constexpr uint32_t VERSION = 1;
+
+} // namespace
+
+bool SearchRecorder::save(const std::string& path) const {
+    std::ofstream out(path, std::ios::binary);
+    if (!out.is_open()) {
+        std::cerr << "Error: Cannot open file " << path << " for writing" << std::endl;
+        return false;
+    }
+    const uint64_t count = records_.size();
+    out.write(MAGIC, sizeof(MAGIC));
+    out.write(reinterpret_cast<const char*>(&VERSION), sizeof(VERSION));
+    out.write(reinterpret_cast<const char*>(&count), sizeof(count));
+    out.write(reinterpret_cast<const char*>(records_.data()), static_cast<std::streamsize>(count * sizeof(NodeRecord)));
+    return static_cast<bool>(out);
+}
+
+bool SearchRecorder::load(const std::string& path, std::vector<NodeRecord>& out) {
+    std::ifstream in(path, std::ios::binary);
+    if (!in.is_open()) {
+        std::cerr << "Error: Cannot open file " << path << std::endl;
+        return false;
+    }
+    char magic[4] = {};
+    uint32_t version = 0;
+    uint64_t count = 0;
+    in.read(magic, sizeof(magic));
+    in.read(reinterpret_cast<char*>(&version), sizeof(version));
+    in.read(reinterpret_cast<char*>(&count), sizeof(count));
+    if (!in || std::memcmp(magic, MAGIC, sizeof(MAGIC)) != 0 || version != VERSION) {
+        std::cerr << "Error: " << path << " is not a search record file" << std::endl;
+        return false;
+    }
+    out.resize(count);
+    in.read(reinterpret_cast<char*>(out.data()), static_cast<std::streamsize>(count * sizeof(NodeRecord)));
+    if (!in) {
+        std::cerr << "Error: " << path << " is truncated" << std::endl;
+        out.clear();
+        return false;
+    }
+    return true;
+}
+
+SearchRecorder::Analysis SearchRecorder::analyze(const std::vector<NodeRecord>& records) {
+    Analysis a;
+    a.records = records.size();
+    for (const NodeRecord& r : records) {
+        if (r.has(NodeRecord::TT_HIT)) ++a.tt_hits;
+        if (r.bound < 3) ++a.bounds[r.bound];
+        if (r.has(NodeRecord::TT_CUTOFF)) {
+            ++a.tt_cutoffs;
+            continue;
+        }
+        ++a.interior_nodes;
+        PlyStats& ply = a.per_ply[r.ply < MAX_PLY ? r.ply : MAX_PLY - 1];
+        ++ply.nodes;
+        if (!r.cutoff()) continue;
+
+        ++a.cutoffs;
+        ++ply.cutoffs;
+        ply.cutoff_index_sum += r.cutoff_index;
+        if (r.cutoff_index == 0) {
+            ++a.first_move_cutoffs;
+            ++ply.first_move_cutoffs;
+        }
+        if (!r.has(NodeRecord::ORDERED)) continue;
+        ++a.ordered_cutoffs;
+        if (r.sources == 0) ++a.unattributed_cutoffs;
+        for (int s = 0; s < NodeRecord::NUM_SOURCES; ++s) {
+            const uint8_t bit = static_cast<uint8_t>(1u << s);
+            if (!(r.sources & bit)) continue;
+            SourceStats& src = a.per_source[s];
+            ++src.cutoffs;
+            if (r.cutoff_index == 0) ++src.first_move;
+            if (r.sources == bit) ++src.sole;
+        }
+    }
+    return a;
+}
+
+double SearchRecorder::Analysis::average_cutoff_index() const {
+    uint64_t sum = 0;
+    for (const auto& p : per_ply) sum += p.cutoff_index_sum;
+    return cutoffs ? static_cast<double>(sum) / cutoffs : 0.0;
+}
+
+void SearchRecorder::Analysis::print() const {
+    auto pct = [](uint64_t part, uint64_t whole) { return whole ? 100.0 * part / whole : 0.0; };
+
+    std::cout << std::fixed << std::setprecision(1);
+    std::cout << "Records: " << records << " (" << interior_nodes << " searched nodes, " << tt_cutoffs
+              << " TT cutoffs, TT hit rate " << pct(tt_hits, records) << "%)\n";
+    std::cout << "Bounds: exact " << bounds[0] << ", lower " << bounds[1] << ", upper " << bounds[2] << "\n";
+    std::cout << "Beta cutoffs: " << cutoffs << " (" << pct(cutoffs, interior_nodes) << "% of nodes), first move "
+              << 100.0 * first_move_cutoff_rate() << "%, average index " << std::setprecision(2)
+              << average_cutoff_index() << "\n\n";
+
+    std::cout << "  Ply     Nodes   Cutoffs  First%  AvgIdx\n";
+    for (int p = 0; p < MAX_PLY; ++p) {
+        const PlyStats& s = per_ply[p];
+        if (s.nodes == 0) continue;
+        std::cout << std::setw(5) << p << std::setw(10) << s.nodes << std::setw(10) << s.cutoffs << std::setw(8)
+                  << std::setprecision(1) << 100.0 * s.first_move_rate() << std::setw(8) << std::setprecision(2)
+                  << s.average_cutoff_index() << "\n";
+    }
+
+    std::cout << std::setprecision(1) << "\nCutoff move flagged by (" << ordered_cutoffs << " ordered cutoffs, "
+              << pct(unattributed_cutoffs, ordered_cutoffs) << "% by none):\n";
+    std::cout << "  Heuristic     Cutoffs  Share%  First%   Sole%\n";
+    for (int s = 0; s < NodeRecord::NUM_SOURCES; ++s) {
+        const SourceStats& src = per_source[s];
+        std::cout << "  " << std::left << std::setw(12) << source_name(s) << std::right << std::setw(9)
+                  << src.cutoffs << std::setprecision(1) << std::setw(8) << pct(src.cutoffs, ordered_cutoffs)
+                  << std::setw(8) << pct(src.first_move, src.cutoffs) << std::setw(8) << pct(src.sole, src.cutoffs)
+                  << "\n";
+    }
+}
+
+const char* SearchRecorder::source_name(int bit) {
+    switch (bit) {
+        case 0: return "tt_move";
+        case 1: return "killer";
+        case 2: return "positional";
+        case 3: return "flip_count";
+        case 4: return "eval_refine";
+        default: return "?";
+    }
+}
+
+} // namespace reversi::ai
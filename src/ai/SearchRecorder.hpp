@@ -0,0 +1,144 @@
+/*
+ * SearchRecorder.hpp - Per-node search records and move-ordering analysis
+ * COMP390 Honours Year Project
+ *
+ * Optional hook for MinimaxEngine (set_recorder): every interior
+ * negamax/PVS node and every TT cutoff appends one 8-byte NodeRecord.
+ * Records are saved as a small binary file and analysed offline:
+ *
+ * - first-move cutoff rate (how often the first ordered move refutes)
+ * - average cutoff index per ply
+ * - which order_moves heuristic (TT move, killer, positional weight,
+ *   flip count, eval refinement) had flagged the move that cut off
+ *
+ * With no recorder attached the engine pays one null check per node.
+ */
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace reversi::ai {
+
+/**
+ * @brief One searched node (8 bytes, written to disk as is)
+ */
+struct NodeRecord {
+    static constexpr uint8_t NO_CUTOFF = 0xFF;
+
+    /// flags
+    enum Flag : uint8_t {
+        TT_HIT = 1,          ///< Probe found an entry for this position
+        TT_CUTOFF = 2,       ///< Entry was deep enough to return immediately
+        PVS_NODE = 4,        ///< Searched by pvs (else negamax)
+        ORDERED = 8,         ///< order_moves ran (sources are meaningful)
+    };
+
+    /// sources: order_moves heuristics that favoured the cutoff (or best) move
+    enum Source : uint8_t {
+        SRC_TT = 1,          ///< TT best move
+        SRC_KILLER = 2,      ///< Killer move at this ply
+        SRC_POSITIONAL = 4,  ///< Highest positional weight among the legal moves
+        SRC_FLIPS = 8,       ///< Most flips among the legal moves
+        SRC_REFINED = 16,    ///< Among the candidates re-scored by evaluation
+        NUM_SOURCES = 5
+    };
+
+    uint8_t ply = 0;
+    uint8_t depth = 0;           ///< Remaining depth
+    uint8_t moves = 0;           ///< Legal moves (0 for TT cutoffs)
+    uint8_t cutoff_index = NO_CUTOFF;  ///< Ordered index of the beta-cutoff move
+    uint8_t best_index = 0;      ///< Ordered index of the best move
+    uint8_t bound = 0;           ///< TTFlag of the result (EXACT / LOWER / UPPER)
+    uint8_t flags = 0;
+    uint8_t sources = 0;
+
+    bool has(Flag f) const { return (flags & f) != 0; }
+    bool cutoff() const { return cutoff_index != NO_CUTOFF; }
+};
+
+static_assert(sizeof(NodeRecord) == 8, "NodeRecord is a fixed 8-byte on-disk format");
+
+class SearchRecorder {
+public:
+    static constexpr int MAX_PLY = 64;
+
+    /**
+     * @param max_records Stop recording after this many (0 = unbounded)
+     */
+    explicit SearchRecorder(size_t max_records = 0) : max_records_(max_records) {}
+
+    void record(const NodeRecord& r) {
+        if (max_records_ == 0 || records_.size() < max_records_) records_.push_back(r);
+        else ++dropped_;
+    }
+
+    const std::vector<NodeRecord>& records() const { return records_; }
+    uint64_t dropped() const { return dropped_; }
+    void clear() {
+        records_.clear();
+        dropped_ = 0;
+    }
+
+    /**
+     * @brief Write records as "RVSR", version, count, then the raw records
+     */
+    bool save(const std::string& path) const;
+
+    /**
+     * @brief Read a file written by save()
+     */
+    static bool load(const std::string& path, std::vector<NodeRecord>& out);
+
+    struct PlyStats {
+        uint64_t nodes = 0;          ///< Interior (searched) nodes
+        uint64_t cutoffs = 0;
+        uint64_t first_move_cutoffs = 0;
+        uint64_t cutoff_index_sum = 0;
+
+        double first_move_rate() const { return cutoffs ? static_cast<double>(first_move_cutoffs) / cutoffs : 0.0; }
+        double average_cutoff_index() const { return cutoffs ? static_cast<double>(cutoff_index_sum) / cutoffs : 0.0; }
+    };
+
+    struct SourceStats {
+        uint64_t cutoffs = 0;        ///< Cutoffs whose move this heuristic flagged
+        uint64_t first_move = 0;     ///< ... of which at ordered index 0
+        uint64_t sole = 0;           ///< ... flagged by no other heuristic
+    };
+
+    struct Analysis {
+        uint64_t records = 0;
+        uint64_t interior_nodes = 0;
+        uint64_t tt_hits = 0;
+        uint64_t tt_cutoffs = 0;
+        uint64_t cutoffs = 0;
+        uint64_t first_move_cutoffs = 0;
+        uint64_t ordered_cutoffs = 0;          ///< Cutoffs at nodes where order_moves ran
+        uint64_t unattributed_cutoffs = 0;     ///< Ordered cutoffs no heuristic had flagged
+        uint64_t bounds[3] = {};               ///< EXACT, LOWER_BOUND, UPPER_BOUND
+        std::array<PlyStats, MAX_PLY> per_ply{};
+        std::array<SourceStats, NodeRecord::NUM_SOURCES> per_source{};
+
+        double first_move_cutoff_rate() const {
+            return cutoffs ? static_cast<double>(first_move_cutoffs) / cutoffs : 0.0;
+        }
+        double average_cutoff_index() const;
+
+        /** @brief Report per ply and per heuristic */
+        void print() const;
+    };
+
+    static Analysis analyze(const std::vector<NodeRecord>& records);
+
+    static const char* source_name(int bit);
+
+private:
+    std::vector<NodeRecord> records_;
+    size_t max_records_;
+    uint64_t dropped_ = 0;
+};
+
+} // namespace reversi::ai
@@ -4,6 +4,7 @@
  */
 
 #include "ai/TranspositionTable.hpp"
+#include "core/Trace.hpp"
 #include <cassert>
 #include <algorithm>
 
@@ -29,6 +30,7 @@ TranspositionTable::TranspositionTable(int size_bits) {
 }
 
 TTEntry* TranspositionTable::probe(uint64_t hash) const {
+    REVERSI_TRACE_HOT("search", "tt_probe");
     // Calculate index: hash & mask (fast modulo)
     size_t index = hash & size_mask_;
     const TTEntry& entry = table_[index];
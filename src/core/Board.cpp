@@ -9,7 +9,7 @@
  * 
  * OPTIMIZATION NOTES:
  * - Kogge-Stone parallel prefix algorithm for move generation
- * - Zobrist hashing for transposition tables
+ * - Zobrist hashing for transposition tables (colour-absolute keys, O(1) pass)
  * - Eliminated nested loops: O(512) → O(8)
  * - Memory-efficient move generation with pre-allocation support
  * 
@@ -19,6 +19,8 @@
  */
 
 #include "Board.hpp"
+#include "Trace.hpp"
+#include <array>
 #include <bit>
 #include <iostream>
 #include <sstream>
@@ -56,8 +58,9 @@ static const int ALL_DIRECTIONS[8] = {
 
 // ==================== Zobrist Hashing ====================
 
-uint64_t Board::zobrist_player[64];
-uint64_t Board::zobrist_opponent[64];
+uint64_t Board::zobrist_disc[2][64];
+uint64_t Board::zobrist_flip[64];
+uint64_t Board::zobrist_side = 0;
 bool Board::zobrist_initialized = false;
 
 void Board::init_zobrist() {
@@ -66,10 +69,15 @@ void Board::init_zobrist() {
     // Use fixed seed for reproducibility in research context
     std::mt19937_64 rng(0x1234567890ABCDEFULL);
     
+    // Bit 0 is reserved for the side to move: square keys keep it clear and
+    // the side key sets it, so side_to_move() can be read straight from the hash
+    // and restore_state()/undo_move() restore the side together with the hash.
     for (int i = 0; i < 64; ++i) {
-        zobrist_player[i] = rng();
-        zobrist_opponent[i] = rng();
+        zobrist_disc[0][i] = rng() & ~1ULL;
+        zobrist_disc[1][i] = rng() & ~1ULL;
+        zobrist_flip[i] = zobrist_disc[0][i] ^ zobrist_disc[1][i];
     }
+    zobrist_side = rng() | 1ULL;
     
     zobrist_initialized = true;
 }
@@ -79,36 +87,42 @@ void Board::init_zobrist() {
 Board::Board() 
     : player(INITIAL_PLAYER), opponent(INITIAL_OPPONENT) {
     init_zobrist();
-    hash_cache_ = recompute_hash(player, opponent);
+    hash_cache_ = recompute_hash(player, opponent, 0);
     history_.reserve(128);
 }
 
 Board::Board(uint64_t p, uint64_t o) 
     : player(p), opponent(o) {
     init_zobrist();
-    hash_cache_ = recompute_hash(player, opponent);
+    hash_cache_ = recompute_hash(player, opponent, 0);
     history_.reserve(128);
 }
 
-Board::Board(const std::string& board_str) {
-    // TODO: Parse string representation (Week 2)
-    (void)board_str;  // Suppress unused parameter warning until implemented
-    player = INITIAL_PLAYER;
-    opponent = INITIAL_OPPONENT;
+Board::Board(const std::string& board_str)
+    : player(INITIAL_PLAYER), opponent(INITIAL_OPPONENT) {
     init_zobrist();
-    hash_cache_ = recompute_hash(player, opponent);
+    int side = 0;
+    uint64_t p = 0, o = 0;
+    if (parse_obf(board_str.data(), board_str.size(), p, o, side)) {
+        player = p;
+        opponent = o;
+    }
+    hash_cache_ = recompute_hash(player, opponent, side);
+    history_.reserve(128);
 }
 
 // ==================== Copy Operations ====================
 
 Board Board::copy() const {
-    return Board(player, opponent);
+    Board b(player, opponent);
+    b.hash_cache_ = hash_cache_;  // Keep side to move
+    return b;
 }
 
 void Board::copy(Board* dest) const {
     dest->player = player;
     dest->opponent = opponent;
-    dest->hash_cache_ = recompute_hash(dest->player, dest->opponent);
+    dest->hash_cache_ = hash_cache_;
 }
 
 // ==================== Board State Queries ====================
@@ -122,15 +136,14 @@ int Board::count_opponent() const {
 }
 
 bool Board::is_terminal() const {
+    REVERSI_TRACE_HOT("core", "is_terminal");
     // Game is over if neither player has legal moves
     if (legal_moves() != 0) {
         return false; // Current player has moves
     }
     
-    // Check if opponent has moves (swap and check)
-    Board temp = *this;
-    temp.pass();
-    return temp.legal_moves() == 0;
+    // Check if opponent has moves (swapped bitboards, no Board copy)
+    return calc_legal(opponent, player) == 0;
 }
 
 int Board::get_winner() const {
@@ -173,20 +186,81 @@ void Board::print() const {
     std::cout << to_string();
 }
 
+namespace {
+
+// OBF square classes: bit 0 black, bit 1 white, bit 2 empty, 0 = invalid
+constexpr std::array<uint8_t, 256> make_obf_table() {
+    std::array<uint8_t, 256> t{};
+    t['X'] = t['x'] = t['*'] = 1;
+    t['O'] = t['o'] = 2;
+    t['-'] = t['.'] = 4;
+    return t;
+}
+constexpr std::array<uint8_t, 256> OBF_SQUARE = make_obf_table();
+
+} // namespace
+
+bool Board::parse_obf(const char* text, size_t length, uint64_t& player_bb, uint64_t& opponent_bb,
+                      int& side, size_t* consumed) {
+    size_t i = 0;
+    while (i < length && (text[i] == ' ' || text[i] == '\t')) ++i;
+    if (length - i < 65) return false;
+
+    // Branch-free over the squares; validity is checked once at the end
+    const unsigned char* sq = reinterpret_cast<const unsigned char*>(text + i);
+    uint64_t black = 0, white = 0;
+    uint8_t invalid = 0;
+    for (int pos = 0; pos < 64; ++pos) {
+        const uint8_t c = OBF_SQUARE[sq[pos]];
+        black |= static_cast<uint64_t>(c & 1) << pos;
+        white |= static_cast<uint64_t>((c >> 1) & 1) << pos;
+        invalid |= static_cast<uint8_t>(c == 0);
+    }
+    if (invalid) return false;
+
+    i += 64;
+    while (i < length && (text[i] == ' ' || text[i] == '\t')) ++i;
+    if (i >= length) return false;
+    const uint8_t s = OBF_SQUARE[static_cast<unsigned char>(text[i])];
+    if (s != 1 && s != 2) return false;
+
+    side = s == 1 ? 0 : 1;
+    player_bb = side == 0 ? black : white;
+    opponent_bb = side == 0 ? white : black;
+    if (consumed) *consumed = i + 1;
+    return true;
+}
+
+std::string Board::to_obf() const {
+    const uint64_t black = side_to_move() == 0 ? player : opponent;
+    const uint64_t white = side_to_move() == 0 ? opponent : player;
+    std::string s(67, '-');
+    for (int pos = 0; pos < 64; ++pos) {
+        if ((black >> pos) & 1) s[pos] = 'X';
+        else if ((white >> pos) & 1) s[pos] = 'O';
+    }
+    s[64] = ' ';
+    s[65] = side_to_move() == 0 ? 'X' : 'O';
+    s[66] = ';';
+    return s;
+}
+
 uint64_t Board::hash() const {
     return hash_cache_;
 }
 
-uint64_t Board::recompute_hash(uint64_t p, uint64_t o) {
-    uint64_t h = 0;
+uint64_t Board::recompute_hash(uint64_t p, uint64_t o, int side) {
+    const uint64_t* zp = zobrist_disc[side & 1];
+    const uint64_t* zo = zobrist_disc[(side & 1) ^ 1];
+    uint64_t h = (side & 1) ? zobrist_side : 0;
     while (p) {
         int pos = std::countr_zero(p);
-        h ^= zobrist_player[pos];
+        h ^= zp[pos];
         p &= p - 1;
     }
     while (o) {
         int pos = std::countr_zero(o);
-        h ^= zobrist_opponent[pos];
+        h ^= zo[pos];
         o &= o - 1;
     }
     return h;
@@ -240,6 +314,14 @@ uint64_t Board::gen_moves_direction(uint64_t player_bb, uint64_t opponent_bb, in
     return shift_bb(candidates, dir) & empty;
 }
 
+uint64_t Board::calc_legal(uint64_t player_bb, uint64_t opponent_bb) {
+    uint64_t moves = 0;
+    for (int dir : ALL_DIRECTIONS) {
+        moves |= gen_moves_direction(player_bb, opponent_bb, dir);
+    }
+    return moves;
+}
+
 uint64_t Board::calc_legal_impl() const {
     /**
      * OPTIMIZED LEGAL MOVE GENERATION
@@ -250,20 +332,18 @@ uint64_t Board::calc_legal_impl() const {
      * Performance gain: ~50-100x faster
      */
     
-    uint64_t moves = 0;
-    
     // Generate moves in all 8 directions and combine
-    for (int dir : ALL_DIRECTIONS) {
-        moves |= gen_moves_direction(player, opponent, dir);
-    }
-    
-    return moves;
+    return calc_legal(player, opponent);
 }
 
 uint64_t Board::legal_moves() const {
     return calc_legal_impl();
 }
 
+uint64_t Board::opponent_legal_moves() const {
+    return calc_legal(opponent, player);
+}
+
 // ==================== Move List Generation ====================
 
 void Board::get_legal_moves(std::vector<int>& out_moves) const {
@@ -378,22 +458,7 @@ void Board::make_move(int pos) {
     std::swap(player, opponent);
 
     // Incremental Zobrist update instead of full recompute
-    uint64_t prev_player = history_.back().prev_player;
-    uint64_t prev_opponent = history_.back().prev_opponent;
-    // compute delta masks similar to apply_move_no_history
-    uint64_t delta_mask1 = prev_player;
-    uint64_t delta_mask2 = prev_opponent & ~flipped;
-    uint64_t delta_mask = delta_mask1 | delta_mask2;
-    const uint64_t* zplayer = zobrist_player;
-    const uint64_t* zopponent = zobrist_opponent;
-    uint64_t delta_xor = 0;
-    while (delta_mask) {
-        int b = std::countr_zero(delta_mask);
-        delta_xor ^= zplayer[b] ^ zopponent[b];
-        delta_mask &= delta_mask - 1;
-    }
-    uint64_t new_hash = history_.back().prev_hash ^ delta_xor ^ zopponent[pos];
-    hash_cache_ = new_hash;
+    hash_cache_ ^= move_hash_delta(pos, flipped);
 }
 
 void Board::undo_move(int pos) {
@@ -408,9 +473,9 @@ void Board::undo_move(int pos) {
 }
 
 void Board::pass() {
-    // Swap player and opponent
+    // Swap player and opponent; disc keys are colour-absolute so only the side changes
     std::swap(player, opponent);
-    hash_cache_ = recompute_hash(player, opponent);
+    hash_cache_ ^= zobrist_side;
 }
 
 } // namespace core
@@ -33,14 +33,19 @@ public:
     uint64_t opponent;  ///< Bitboard for opponent's pieces
     
     /**
-     * @brief Cached Zobrist hash of current state (player/opponent orientation)
+     * @brief Cached Zobrist hash of current state (colour-absolute keys + side key)
      * Maintained by make_move/undo_move/pass and constructors.
+     * Bit 0 holds the colour of the side to move (see zobrist_side).
      */
     uint64_t hash_cache_ = 0;
 
     // Zobrist hashing tables (initialized once)
-    static uint64_t zobrist_player[64];
-    static uint64_t zobrist_opponent[64];
+    // Keys are indexed by absolute disc colour (0 = colour that moves first
+    // from a constructed position, 1 = the other colour), so swapping sides
+    // never touches the per-square keys.
+    static uint64_t zobrist_disc[2][64];  ///< Per-colour square keys (bit 0 always clear)
+    static uint64_t zobrist_flip[64];     ///< zobrist_disc[0][sq] ^ zobrist_disc[1][sq]
+    static uint64_t zobrist_side;         ///< Side-to-move key (bit 0 always set)
     static bool zobrist_initialized;
     
 public:
@@ -55,7 +60,9 @@ public:
      */
     Board(uint64_t p, uint64_t o);
     
-    /** @brief Parse board from string representation (future) */
+    /** @brief Parse an OBF / FFO position (see parse_obf)
+     *  @note A malformed string yields the standard starting position
+     */
     Board(const std::string& board_str);
     
     // ==================== Copy Operations ====================
@@ -75,6 +82,11 @@ public:
      */
     uint64_t legal_moves() const;
     
+    /** @brief Legal moves the opponent would have if the current player passed
+     *  @return Bitboard with 1s at the opponent's legal move positions
+     */
+    uint64_t opponent_legal_moves() const;
+    
     /** @brief Get legal moves as vector of position indices
      *  @param out_moves Output vector to populate (avoids allocation if pre-reserved)
      *  @complexity O(8 + m) where m = number of legal moves
@@ -98,7 +110,9 @@ public:
     /** @brief Undo previous move (with move history - Week 3) */
     void undo_move(int pos);
     
-    /** @brief Pass turn (swap player and opponent) */
+    /** @brief Pass turn (swap player and opponent)
+     *  @complexity O(1) - a single XOR with the side-to-move key
+     */
     void pass();
     
     // ==================== Board State Queries ====================
@@ -123,19 +137,41 @@ public:
     /** @brief Print board to stdout */
     void print() const;
     
+    /** @brief Parse an OBF / FFO position: 64 squares a1, b1, ..., h8 followed
+     *  by the side to move, e.g. "---------------------------OX------XO--------------------------- X;"
+     *  ('X'/'x'/'*' black, 'O'/'o' white, '-'/'.' empty; leading blanks and
+     *  blanks before the side are skipped, anything after it is ignored)
+     *  @param player_bb,opponent_bb Discs of the side to move and of the other side
+     *  @param side 0 if black is to move, 1 if white is
+     *  @param consumed Characters read up to and including the side (optional)
+     *  @return false if the text is not an OBF position (outputs untouched)
+     *  @complexity O(64) table lookups, no allocation
+     */
+    static bool parse_obf(const char* text, size_t length, uint64_t& player_bb, uint64_t& opponent_bb,
+                          int& side, size_t* consumed = nullptr);
+    
+    /** @brief Serialize as OBF ("<64 squares> <side>;"), the inverse of parse_obf */
+    std::string to_obf() const;
+    
     /** @brief Compute Zobrist hash for transposition table
      *  @return 64-bit hash value
      *  @note Zobrist hashing provides near-perfect hash distribution
      */
     uint64_t hash() const;
     
+    /** @brief Colour of the side to move (0 or 1), stored in bit 0 of the hash */
+    int side_to_move() const { return static_cast<int>(hash_cache_ & 1ULL); }
+    
+    /** @brief Recompute hash from scratch (reference for tests and tools) */
+    uint64_t compute_hash() const { return recompute_hash(player, opponent, side_to_move()); }
+    
     // ==================== Fast mutation helpers (no history, low-level)
     /** @brief Get raw player bitboard (for performance-critical code) */
     uint64_t get_player_bb() const { return player; }
     /** @brief Get raw opponent bitboard (for performance-critical code) */
     uint64_t get_opponent_bb() const { return opponent; }
     /** @brief Set raw player/opponent bitboards (for fast restore) */
-    void set_player_opponent(uint64_t p, uint64_t o) { player = p; opponent = o; hash_cache_ = recompute_hash(player, opponent); }
+    void set_player_opponent(uint64_t p, uint64_t o) { player = p; opponent = o; hash_cache_ = recompute_hash(player, opponent, side_to_move()); }
     /** @brief Apply move without recording history (fast path for search) */
     inline void apply_move_no_history(int pos) {
         if (pos < 0 || pos >= 64) return;
@@ -143,27 +179,13 @@ public:
         uint64_t flipped = calc_flip(pos);
         if (flipped == 0) return;
 
-        uint64_t prev_player = player;
-        uint64_t prev_opponent = opponent;
-
         player |= pos_mask | flipped;
         opponent &= ~flipped;
         std::swap(player, opponent);
 
-        // Incremental Zobrist update using local pointers
-        const uint64_t* zplayer = zobrist_player;
-        const uint64_t* zopponent = zobrist_opponent;
-        uint64_t delta_mask1 = prev_player;
-        uint64_t delta_mask2 = prev_opponent & ~flipped;
-        uint64_t delta_mask = delta_mask1 | delta_mask2;
-        uint64_t delta_xor = 0;
-        while (delta_mask) {
-            int b = std::countr_zero(delta_mask);
-            delta_xor ^= zplayer[b] ^ zopponent[b];
-            delta_mask &= delta_mask - 1;
-        }
-        uint64_t new_hash = hash_cache_ ^ delta_xor ^ zopponent[pos];
-        hash_cache_ = new_hash;
+        // Incremental Zobrist update: only the placed disc, the flipped discs
+        // and the side key change under colour-absolute hashing.
+        hash_cache_ ^= move_hash_delta(pos, flipped);
     }
     /** @brief Restore previous player/opponent/hash state */
     void restore_state(uint64_t prev_player, uint64_t prev_opponent, uint64_t prev_hash) {
@@ -192,8 +214,23 @@ private:
     /** @brief Initialize Zobrist hashing tables (called once) */
     static void init_zobrist();
     
-    /** @brief Recompute Zobrist hash from given bitboards (utility) */
-    static uint64_t recompute_hash(uint64_t p, uint64_t o);
+    /** @brief Recompute Zobrist hash from given bitboards (utility)
+     *  @param side Colour of the side owning @p p (0 or 1)
+     */
+    static uint64_t recompute_hash(uint64_t p, uint64_t o, int side);
+    
+    /** @brief Hash delta for placing a disc at pos and flipping the given discs */
+    inline uint64_t move_hash_delta(int pos, uint64_t flipped) const {
+        uint64_t delta = zobrist_disc[hash_cache_ & 1ULL][pos] ^ zobrist_side;
+        while (flipped) {
+            delta ^= zobrist_flip[std::countr_zero(flipped)];
+            flipped &= flipped - 1;
+        }
+        return delta;
+    }
+    
+    /** @brief Legal moves for arbitrary bitboards (shared by legal_moves/is_terminal) */
+    static uint64_t calc_legal(uint64_t player_bb, uint64_t opponent_bb);
     
     /** @brief Shift bitboard in given direction with edge masking
      *  @param bb Bitboard to shift
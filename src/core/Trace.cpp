@@ -0,0 +1,185 @@
+/*
+ * Reversi AI Algorithm Benchmarking and Optimisation Research
+ * COMP390 Honours Year Project (2025–26)
+ *
+ * Author: Tianqixing
+ * Student ID: 201821852
+ *
+ * Trace Implementation - Per-thread ring buffers and Chrome JSON export
+ */
+
+#include "Trace.hpp"
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <mutex>
+
+namespace reversi {
+namespace core {
+
+namespace {
+
+/**
+ * Written only by its owning thread; head is published with release so
+ * snapshot() sees complete events up to the head it reads.
+ */
+struct ThreadBuffer {
+    explicit ThreadBuffer(uint32_t id) : events(Tracer::BUFFER_EVENTS), thread(id) {}
+
+    std::vector<TraceEvent> events;
+    std::atomic<uint64_t> head{0};
+    uint32_t thread;
+};
+
+/**
+ * Buffers outlive their threads so finished workers still export. A
+ * finished thread's buffer goes on the free list and the next new thread
+ * records into it (events kept until overwritten), so memory follows the
+ * number of live threads rather than every thread ever traced.
+ */
+struct Registry {
+    std::mutex mutex;
+    std::vector<std::unique_ptr<ThreadBuffer>> buffers;
+    std::vector<ThreadBuffer*> free;
+    uint32_t next_thread = 0;
+};
+
+Registry& registry() {
+    static Registry instance;
+    return instance;
+}
+
+/// Returns the thread's buffer to the free list when the thread exits
+struct BufferLease {
+    ThreadBuffer* buffer = nullptr;
+
+    ~BufferLease() {
+        if (!buffer) return;
+        Registry& reg = registry();
+        std::lock_guard<std::mutex> lock(reg.mutex);
+        reg.free.push_back(buffer);
+    }
+};
+
+ThreadBuffer& local_buffer() {
+    thread_local BufferLease lease;
+    if (!lease.buffer) {
+        Registry& reg = registry();
+        std::lock_guard<std::mutex> lock(reg.mutex);
+        const uint32_t id = reg.next_thread++;
+        if (!reg.free.empty()) {
+            lease.buffer = reg.free.back();
+            reg.free.pop_back();
+            lease.buffer->thread = id;  // Older events keep the id they were recorded with
+        } else {
+            reg.buffers.push_back(std::make_unique<ThreadBuffer>(id));
+            lease.buffer = reg.buffers.back().get();
+        }
+    }
+    return *lease.buffer;
+}
+
+void write_json_string(std::ostream& out, const char* text) {
+    out << '"';
+    for (const char* p = text; *p; ++p) {
+        if (*p == '"' || *p == '\\') out << '\\';
+        out << *p;
+    }
+    out << '"';
+}
+
+} // namespace
+
+std::atomic<bool> Tracer::enabled_{false};
+std::atomic<uint32_t> Tracer::hot_interval_{64};
+const std::chrono::steady_clock::time_point Tracer::epoch_ = std::chrono::steady_clock::now();
+
+void Tracer::record(const char* category, const char* name, int64_t start_ns, int64_t end_ns,
+                    uint32_t weight) {
+    ThreadBuffer& buffer = local_buffer();
+    const uint64_t head = buffer.head.load(std::memory_order_relaxed);
+    TraceEvent& e = buffer.events[head & (BUFFER_EVENTS - 1)];
+    e.category = category;
+    e.name = name;
+    e.start_ns = start_ns;
+    e.duration_ns = end_ns - start_ns;
+    e.thread = buffer.thread;
+    e.weight = weight;
+    buffer.head.store(head + 1, std::memory_order_release);
+}
+
+std::vector<TraceEvent> Tracer::snapshot() {
+    std::vector<TraceEvent> events;
+    Registry& reg = registry();
+    std::lock_guard<std::mutex> lock(reg.mutex);
+    for (const auto& buffer : reg.buffers) {
+        const uint64_t head = buffer->head.load(std::memory_order_acquire);
+        const uint64_t count = std::min<uint64_t>(head, BUFFER_EVENTS);
+        for (uint64_t i = head - count; i < head; ++i) {
+            events.push_back(buffer->events[i & (BUFFER_EVENTS - 1)]);
+        }
+    }
+    std::stable_sort(events.begin(), events.end(),
+                     [](const TraceEvent& a, const TraceEvent& b) { return a.start_ns < b.start_ns; });
+    return events;
+}
+
+uint64_t Tracer::recorded() {
+    uint64_t total = 0;
+    Registry& reg = registry();
+    std::lock_guard<std::mutex> lock(reg.mutex);
+    for (const auto& buffer : reg.buffers) total += buffer->head.load(std::memory_order_acquire);
+    return total;
+}
+
+void Tracer::clear() {
+    Registry& reg = registry();
+    std::lock_guard<std::mutex> lock(reg.mutex);
+    for (const auto& buffer : reg.buffers) buffer->head.store(0, std::memory_order_release);
+}
+
+size_t Tracer::buffer_count() {
+    Registry& reg = registry();
+    std::lock_guard<std::mutex> lock(reg.mutex);
+    return reg.buffers.size();
+}
+
+bool Tracer::write_chrome_json(const std::string& path) {
+    std::ofstream out(path);
+    if (!out.is_open()) {
+        std::cerr << "Error: Cannot open file " << path << " for writing" << std::endl;
+        return false;
+    }
+
+    const auto events = snapshot();
+    uint32_t threads = 0;
+    for (const auto& e : events) threads = std::max(threads, e.thread + 1);
+
+    // Timestamps are microseconds; fractional part keeps nanosecond scopes visible
+    out << "{\"displayTimeUnit\": \"ns\", \"traceEvents\": [";
+    bool first = true;
+    for (uint32_t t = 0; t < threads; ++t) {
+        out << (first ? "\n" : ",\n") << "{\"name\": \"thread_name\", \"ph\": \"M\", \"pid\": 1, \"tid\": " << t
+            << ", \"args\": {\"name\": \"thread " << t << "\"}}";
+        first = false;
+    }
+    out.setf(std::ios::fixed);
+    out.precision(3);
+    for (const auto& e : events) {
+        out << (first ? "\n" : ",\n") << "{\"name\": ";
+        write_json_string(out, e.name);
+        out << ", \"cat\": ";
+        write_json_string(out, e.category);
+        out << ", \"ph\": \"X\", \"ts\": " << e.start_ns / 1000.0 << ", \"dur\": " << e.duration_ns / 1000.0
+            << ", \"pid\": 1, \"tid\": " << e.thread;
+        if (e.weight > 1) out << ", \"args\": {\"weight\": " << e.weight << "}";
+        out << "}";
+        first = false;
+    }
+    out << "\n]}\n";
+    return static_cast<bool>(out);
+}
+
+} // namespace core
+} // namespace reversi
@@ -0,0 +1,165 @@
+/*
+ * Reversi AI Algorithm Benchmarking and Optimisation Research
+ * COMP390 Honours Year Project (2025–26)
+ *
+ * Author: Tianqixing
+ * Student ID: 201821852
+ *
+ * Trace - Scoped trace points with Chrome trace-event export
+ *
+ * Trace points are macros so they can be compiled out entirely:
+ *
+ *   REVERSI_TRACE("search", "iteration");   // coarse: per search / game / message
+ *   REVERSI_TRACE_HOT("search", "evaluate"); // per node: TT probe, evaluate, playout
+ *
+ * REVERSI_TRACE_LEVEL (CMake option, default 0) selects what is built:
+ *   0 = nothing (both macros expand to no code)
+ *   1 = coarse scopes only
+ *   2 = coarse and per-node scopes
+ *
+ * Per-node scopes are too frequent to time every call within a few
+ * percent of overhead, so each thread records one in every
+ * hot_sample_interval() of them (default 64, 1 = all); such events
+ * carry the number of calls they stand for in TraceEvent::weight.
+ *
+ * At run time recording is off until Tracer::set_enabled(true). Each
+ * thread writes to its own fixed-size ring buffer (single producer, no
+ * locks; the oldest events are overwritten), allocated on the first
+ * recorded event and handed on to a later thread once its owner exits,
+ * so short-lived workers do not each leave one behind. write_chrome_json() merges all buffers into a file
+ * that chrome://tracing and Perfetto open directly; call it once the
+ * traced threads are idle.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#ifndef REVERSI_TRACE_LEVEL
+#define REVERSI_TRACE_LEVEL 0
+#endif
+
+namespace reversi {
+namespace core {
+
+/**
+ * @brief One completed scope ("X" event in the Chrome format)
+ */
+struct TraceEvent {
+    const char* category = "";  ///< String literal ("search", "mcts", "match", "net")
+    const char* name = "";      ///< String literal
+    int64_t start_ns = 0;       ///< Since the tracer epoch
+    int64_t duration_ns = 0;
+    uint32_t thread = 0;        ///< Tracer-assigned thread id (registration order)
+    uint32_t weight = 1;        ///< Calls this event stands for (hot scope sampling)
+};
+
+class Tracer {
+public:
+    /// Events kept per thread (power of two)
+    static constexpr size_t BUFFER_EVENTS = size_t(1) << 18;
+
+    static bool enabled() { return enabled_.load(std::memory_order_relaxed); }
+    static void set_enabled(bool on) { enabled_.store(on, std::memory_order_relaxed); }
+
+    static uint32_t hot_sample_interval() { return hot_interval_.load(std::memory_order_relaxed); }
+    static void set_hot_sample_interval(uint32_t every) {
+        hot_interval_.store(every > 0 ? every : 1, std::memory_order_relaxed);
+    }
+
+    /** @brief True for one in hot_sample_interval() calls on this thread */
+    static bool sample_hot() {
+        if (hot_countdown_ > 1) {
+            --hot_countdown_;
+            return false;
+        }
+        hot_countdown_ = hot_sample_interval();
+        return true;
+    }
+
+    /** @brief Nanoseconds since the tracer epoch (first use) */
+    static int64_t now_ns() {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+                   std::chrono::steady_clock::now() - epoch_).count();
+    }
+
+    /** @brief Append a completed scope to the calling thread's buffer */
+    static void record(const char* category, const char* name, int64_t start_ns, int64_t end_ns,
+                       uint32_t weight = 1);
+
+    /** @brief Retained events of all threads, ordered by start time */
+    static std::vector<TraceEvent> snapshot();
+
+    /** @brief Events recorded since the last clear() (including overwritten ones) */
+    static uint64_t recorded();
+
+    /** @brief Drop all buffered events (threads keep their buffers) */
+    static void clear();
+
+    /** @brief Ring buffers allocated so far (at most one per concurrently traced thread) */
+    static size_t buffer_count();
+
+    /**
+     * @brief Write retained events as Chrome trace-event JSON
+     * @return false if the file cannot be written
+     */
+    static bool write_chrome_json(const std::string& path);
+
+private:
+    static std::atomic<bool> enabled_;
+    static std::atomic<uint32_t> hot_interval_;
+    static inline thread_local uint32_t hot_countdown_ = 0;
+    static const std::chrono::steady_clock::time_point epoch_;
+};
+
+/**
+ * @brief Records its lifetime as one event (if tracing is enabled at entry)
+ */
+class TraceScope {
+public:
+    /// Tag for per-node scopes (sampled, see Tracer::hot_sample_interval)
+    struct Hot {};
+
+    TraceScope(const char* category, const char* name)
+        : category_(category), name_(name), start_ns_(Tracer::enabled() ? Tracer::now_ns() : -1) {}
+    TraceScope(const char* category, const char* name, Hot)
+        : category_(category), name_(name),
+          start_ns_(Tracer::enabled() && Tracer::sample_hot() ? Tracer::now_ns() : -1),
+          weight_(Tracer::hot_sample_interval()) {}
+    ~TraceScope() {
+        if (start_ns_ >= 0) Tracer::record(category_, name_, start_ns_, Tracer::now_ns(), weight_);
+    }
+    TraceScope(const TraceScope&) = delete;
+    TraceScope& operator=(const TraceScope&) = delete;
+
+private:
+    const char* category_;
+    const char* name_;
+    int64_t start_ns_;
+    uint32_t weight_ = 1;
+};
+
+} // namespace core
+} // namespace reversi
+
+#define REVERSI_TRACE_CONCAT_(a, b) a##b
+#define REVERSI_TRACE_CONCAT(a, b) REVERSI_TRACE_CONCAT_(a, b)
+
+#if REVERSI_TRACE_LEVEL >= 1
+#define REVERSI_TRACE(category, name) \
+    ::reversi::core::TraceScope REVERSI_TRACE_CONCAT(reversi_trace_, __LINE__)(category, name)
+#else
+#define REVERSI_TRACE(category, name) ((void)0)
+#endif
+
+#if REVERSI_TRACE_LEVEL >= 2
+#define REVERSI_TRACE_HOT(category, name) \
+    ::reversi::core::TraceScope REVERSI_TRACE_CONCAT(reversi_trace_, __LINE__)( \
+        category, name, ::reversi::core::TraceScope::Hot{})
+#else
+#define REVERSI_TRACE_HOT(category, name) ((void)0)
+#endif
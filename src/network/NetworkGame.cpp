@@ -10,6 +10,7 @@
 
 #include "NetworkGame.hpp"
 #include "RoomManager.hpp"
+#include "core/Trace.hpp"
 #include <SFML/Network.hpp>
 #include <iostream>
 #include <algorithm>
@@ -331,6 +332,7 @@ void NetworkGame::handle_connect_message(const NetworkMessage& msg) {
 }
 
 void NetworkGame::handle_move_message(const NetworkMessage& msg) {
+    REVERSI_TRACE("net", "handle_move");
     if (state_ != NetworkGameState::PLAYING) {
         return;
     }
@@ -10,6 +10,7 @@
 
 #include "TCPSocket.hpp"
 #include "NetworkProtocol.hpp"
+#include "core/Trace.hpp"
 #include <sstream>
 
 namespace reversi {
@@ -149,6 +150,7 @@ void TCPSocket::disconnect() {
 }
 
 bool TCPSocket::send_message(const NetworkMessage& msg) {
+    REVERSI_TRACE("net", "send_message");
     std::lock_guard<std::mutex> lock(socket_mutex_);
     
     if (state_ != State::CONNECTED) {
@@ -206,6 +208,8 @@ bool TCPSocket::receive_message(NetworkMessage& msg) {
     sf::Socket::Status status = active_socket->receive(buffer.data(), 82, received);
     
     if (status == sf::Socket::Done && received == 82) {
+        // Traced only when a message arrived (this is polled every frame)
+        REVERSI_TRACE("net", "receive_message");
         // Deserialize message
         if (NetworkProtocol::deserialize(buffer, msg)) {
             // Verify checksum
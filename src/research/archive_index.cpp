@@ -0,0 +1,184 @@
+/*
+ * archive_index.cpp - WTHOR / GGF importer and position index queries
+ * COMP390 Honours Year Project
+ *
+ * Builds a memory-mapped index from position hash to the games that
+ * reach it, then answers "which games reach this position and how did
+ * they end" without re-reading the archives.
+ *
+ * Usage:
+ *   reversi_archive build <index> <file.wtb|file.ggf> ...
+ *   reversi_archive query <index> [--moves f5d6c3...] [--list N]
+ *   reversi_archive bench <index> [--queries N]
+ *   reversi_archive export-wthor <selfplay_dir> <file.wtb>
+ */
+
+#include "data/PositionIndex.hpp"
+#include "data/GameShards.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace reversi::research;
+using reversi::core::Board;
+
+namespace {
+
+void print_usage() {
+    std::cout << "Usage:\n"
+              << "  reversi_archive build <index> <files...>    Import WTHOR (.wtb) / GGF files\n"
+              << "  reversi_archive query <index> [--moves <seq>] [--list <n>]\n"
+              << "                                              Games reaching the position after <seq>\n"
+              << "  reversi_archive bench <index> [--queries <n>]\n"
+              << "                                              Lookup latency on indexed positions\n"
+              << "  reversi_archive export-wthor <selfplay_dir> <file.wtb>\n"
+              << "                                              Convert reversi_selfplay data to WTHOR\n";
+}
+
+/// "f5d6c3" -> board after those moves (passes inserted automatically)
+bool play_sequence(const std::string& seq, Board& board) {
+    board = Board();
+    for (size_t i = 0; i + 1 < seq.size(); i += 2) {
+        int sq = GameArchive::parse_square(seq[i], seq[i + 1]);
+        if (board.legal_moves() == 0) board.pass();
+        if (sq < 0 || !((board.legal_moves() >> sq) & 1)) {
+            std::cerr << "Error: Illegal move " << seq.substr(i, 2) << "\n";
+            return false;
+        }
+        board.make_move(sq);
+    }
+    return true;
+}
+
+int build(const std::string& index, const std::vector<std::string>& files) {
+    std::cout << "Importing " << files.size() << " file(s)...\n";
+    auto stats = PositionIndex::build(files, index);
+    if (!stats.error.empty()) {
+        std::cerr << "Error: " << stats.error << "\n";
+        return 1;
+    }
+    std::cout << stats.games << " games (" << stats.skipped << " skipped), " << stats.positions
+              << " positions indexed in " << std::fixed << std::setprecision(2) << stats.seconds
+              << " s (" << std::setprecision(0)
+              << (stats.seconds > 0 ? stats.games / stats.seconds : 0.0) << " games/s)\n";
+    return 0;
+}
+
+int query(const std::string& index_path, const std::string& moves, int list) {
+    PositionIndex index;
+    if (!index.open(index_path)) return 1;
+    Board board;
+    if (!play_sequence(moves, board)) return 1;
+
+    auto t0 = std::chrono::steady_clock::now();
+    auto summary = index.summarize(board);
+    double us = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - t0).count();
+
+    board.print();
+    std::cout << "\nGames reaching this position: " << summary.games << "  (" << std::fixed
+              << std::setprecision(1) << us << " us)\n";
+    if (summary.games == 0) return 0;
+    std::cout << "  Black wins " << summary.black_wins << ", white wins " << summary.white_wins
+              << ", draws " << summary.draws;
+    if (summary.unknown) std::cout << ", no result " << summary.unknown;
+    std::cout << "\n  Mean black margin " << std::showpos << summary.mean_disc_diff << std::noshowpos << "\n";
+
+    auto [first, last] = index.find(board);
+    int shown = 0;
+    for (auto* e = first; e != last && shown < list; ++e, ++shown) {
+        const auto& g = index.game(e->game);
+        std::cout << "  game " << e->game << "  " << index.sources()[g.source] << " @" << g.offset
+                  << "  ply " << e->ply << "/" << static_cast<int>(g.num_moves) << "  result ";
+        if (g.has_result) std::cout << std::showpos << static_cast<int>(g.black_disc_diff) << std::noshowpos;
+        else std::cout << "?";
+        std::cout << "\n";
+    }
+    return 0;
+}
+
+int bench(const std::string& index_path, int queries) {
+    PositionIndex index;
+    if (!index.open(index_path) || index.num_entries() == 0) return 1;
+
+    // Look up hashes that are in the index (worst case: full bucket walk)
+    std::vector<uint64_t> probes(static_cast<size_t>(queries));
+    std::mt19937_64 rng(1);
+    for (auto& h : probes) {
+        Board board;
+        std::vector<int> moves;
+        int plies = static_cast<int>(rng() % 20);
+        for (int i = 0; i < plies && !board.is_terminal(); ++i) {
+            board.get_legal_moves(moves);
+            if (moves.empty()) { board.pass(); continue; }
+            board.make_move(moves[rng() % moves.size()]);
+        }
+        h = board.hash();
+    }
+
+    auto t0 = std::chrono::steady_clock::now();
+    uint64_t hits = 0;
+    for (uint64_t h : probes) {
+        auto [first, last] = index.find(h);
+        hits += static_cast<uint64_t>(last - first);
+    }
+    double us = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - t0).count();
+    std::cout << queries << " lookups over " << index.num_games() << " games / " << index.num_entries()
+              << " positions: " << std::fixed << std::setprecision(3) << us / queries
+              << " us/lookup (" << hits << " game hits)\n";
+    return 0;
+}
+
+int export_wthor(const std::string& dir, const std::string& file) {
+    ShardReader reader;
+    if (!reader.open(dir)) return 1;
+    std::vector<ArchiveGame> games;
+    games.reserve(reader.num_games());
+    reader.for_each_game([&](size_t, const GameRecord& g) {
+        ArchiveGame a;
+        a.moves = g.moves;
+        a.black_disc_diff = g.black_disc_diff;
+        a.has_result = true;
+        games.push_back(std::move(a));
+        return true;
+    });
+    if (!GameArchive::write_wthor(file, games)) return 1;
+    std::cout << "Wrote " << games.size() << " games to " << file << "\n";
+    return 0;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    if (argc < 3) {
+        print_usage();
+        return argc < 2 ? 1 : 0;
+    }
+    std::string command = argv[1];
+
+    if (command == "build" && argc >= 4) {
+        return build(argv[2], std::vector<std::string>(argv + 3, argv + argc));
+    } else if (command == "query") {
+        std::string moves;
+        int list = 10;
+        for (int i = 3; i < argc; ++i) {
+            std::string arg = argv[i];
+            if (arg == "--moves" && i + 1 < argc) moves = argv[++i];
+            else if (arg == "--list" && i + 1 < argc) list = std::atoi(argv[++i]);
+            else { print_usage(); return 1; }
+        }
+        return query(argv[2], moves, list);
+    } else if (command == "bench") {
+        int queries = 100000;
+        if (argc >= 5 && std::string(argv[3]) == "--queries") queries = std::max(1, std::atoi(argv[4]));
+        return bench(argv[2], queries);
+    } else if (command == "export-wthor" && argc >= 4) {
+        return export_wthor(argv[2], argv[3]);
+    }
+    print_usage();
+    return 1;
+}
@@ -0,0 +1,333 @@
+/*
+ * bench_main.cpp - Unified benchmark runner (reversi_bench)
+ * COMP390 Honours Year Project
+ *
+ * Registers the standard micro benchmarks (move generation, flips,
+ * evaluation, OBF parsing, MCTS playouts and UCB selection) and macro benchmarks
+ * (fixed-depth search, MCTS simulations, endgame solving, match
+ * throughput), runs the selected ones with warmup / repetition control
+ * and optional CPU pinning, writes JSON and compares against a saved
+ * baseline. --perf adds hardware counters (IPC, branch-miss rate,
+ * cache misses per op); --trace writes the trace points of the run as
+ * Chrome trace JSON (needs a build with REVERSI_TRACE_LEVEL >= 1).
+ *
+ * Usage:
+ *   reversi_bench [--list] [--filter micro,mcts] [--warmup N] [--reps N]
+ *                 [--pin CPU] [--json out.json] [--baseline base.json]
+ *                 [--threshold PCT] [--perf] [--trace trace.json]
+ *
+ * Exit code 3 when a benchmark regressed against the baseline.
+ */
+
+#include "benchmark/BenchRegistry.hpp"
+#include "benchmark/MatchEngine.hpp"
+#include "benchmark/PositionSuite.hpp"
+#include "../ai/ChildStats.hpp"
+#include "../ai/EndgameSolver.hpp"
+#include "../ai/Evaluator.hpp"
+#include "../ai/Evaluator_Week4.hpp"
+#include "../ai/MCTSEngine.hpp"
+#include "../ai/MinimaxEngine.hpp"
+#include "../ai/PlayoutKernel.hpp"
+#include "core/Trace.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace reversi;
+using namespace reversi::research;
+using core::Board;
+
+namespace {
+
+/// Fixed, reproducible positions for the micro benchmarks
+std::vector<Board> bench_positions() {
+    auto positions = PositionSuite::generate_random(512, 4, 56, 20251);
+    return positions;
+}
+
+/// Keeps results observable so the optimiser cannot drop the work
+volatile uint64_t g_sink = 0;
+
+void register_standard_benchmarks(BenchRegistry& registry) {
+    // ---------------- micro ----------------
+    registry.add("micro", "legal_moves", "positions", [] {
+        auto positions = std::make_shared<std::vector<Board>>(bench_positions());
+        return BenchRegistry::Body([positions] {
+            uint64_t acc = 0;
+            for (int rep = 0; rep < 400; ++rep) {
+                for (const Board& b : *positions) acc += b.legal_moves();
+            }
+            g_sink = g_sink + acc;
+            return static_cast<uint64_t>(400 * positions->size());
+        });
+    });
+
+    registry.add("micro", "flips", "moves", [] {
+        // Every legal move of every position, as (board, square) pairs
+        auto positions = std::make_shared<std::vector<Board>>(bench_positions());
+        auto squares = std::make_shared<std::vector<std::pair<uint32_t, int>>>();
+        for (uint32_t i = 0; i < positions->size(); ++i) {
+            for (int sq : (*positions)[i].get_legal_moves()) squares->push_back({i, sq});
+        }
+        return BenchRegistry::Body([positions, squares] {
+            uint64_t acc = 0;
+            for (int rep = 0; rep < 100; ++rep) {
+                for (const auto& [i, sq] : *squares) acc += (*positions)[i].calc_flip(sq);
+            }
+            g_sink = g_sink + acc;
+            return static_cast<uint64_t>(100 * squares->size());
+        });
+    });
+
+    registry.add("micro", "make_undo", "moves", [] {
+        auto positions = std::make_shared<std::vector<Board>>(bench_positions());
+        return BenchRegistry::Body([positions] {
+            uint64_t moves = 0;
+            std::vector<int> legal;
+            for (int rep = 0; rep < 20; ++rep) {
+                for (Board& b : *positions) {
+                    b.get_legal_moves(legal);
+                    for (int sq : legal) {
+                        b.make_move(sq);
+                        b.undo_move(sq);
+                    }
+                    moves += legal.size();
+                }
+            }
+            return moves;
+        });
+    });
+
+    registry.add("micro", "eval_basic", "positions", [] {
+        auto positions = std::make_shared<std::vector<Board>>(bench_positions());
+        return BenchRegistry::Body([positions] {
+            int64_t acc = 0;
+            for (int rep = 0; rep < 50; ++rep) {
+                for (const Board& b : *positions) acc += ai::Evaluator::evaluate(b);
+            }
+            g_sink = g_sink + static_cast<uint64_t>(acc);
+            return static_cast<uint64_t>(50 * positions->size());
+        });
+    });
+
+    registry.add("micro", "eval_week4", "positions", [] {
+        auto positions = std::make_shared<std::vector<Board>>(bench_positions());
+        return BenchRegistry::Body([positions] {
+            int64_t acc = 0;
+            for (int rep = 0; rep < 20; ++rep) {
+                for (const Board& b : *positions) acc += ai::EvaluatorWeek4::evaluate(b);
+            }
+            g_sink = g_sink + static_cast<uint64_t>(acc);
+            return static_cast<uint64_t>(20 * positions->size());
+        });
+    });
+
+    registry.add("micro", "obf_parse", "positions", [] {
+        auto lines = std::make_shared<std::vector<std::string>>();
+        for (const Board& b : bench_positions()) lines->push_back(b.to_obf());
+        return BenchRegistry::Body([lines] {
+            uint64_t acc = 0, p = 0, o = 0;
+            int side = 0;
+            for (int rep = 0; rep < 100; ++rep) {
+                for (const auto& line : *lines) {
+                    Board::parse_obf(line.data(), line.size(), p, o, side);
+                    acc += p ^ o;
+                }
+            }
+            g_sink = g_sink + acc;
+            return static_cast<uint64_t>(100 * lines->size());
+        });
+    });
+
+    registry.add("micro", "mcts_playout", "playouts", [] {
+        // Square-class heuristic playouts to the end of the game
+        auto positions = std::make_shared<std::vector<Board>>(bench_positions());
+        auto rng = std::make_shared<ai::FastRng>(1);
+        return BenchRegistry::Body([positions, rng] {
+            int64_t acc = 0;
+            int plies = 0;
+            for (int rep = 0; rep < 4; ++rep) {
+                for (const Board& b : *positions) {
+                    acc += ai::playout::heuristic_game(b.get_player_bb(), b.get_opponent_bb(), 0.3, *rng, plies);
+                }
+            }
+            g_sink = g_sink + static_cast<uint64_t>(acc + plies);
+            return static_cast<uint64_t>(4 * positions->size());
+        });
+    });
+
+    registry.add("micro", "ucb_select", "selections", [] {
+        // SoA UCB1 argmax over nodes with 4..35 children (one MCTS selection step each)
+        auto nodes = std::make_shared<std::vector<ai::ChildStats>>(64);
+        ai::FastRng rng(3);
+        for (size_t k = 0; k < nodes->size(); ++k) {
+            ai::ChildStats& stats = (*nodes)[k];
+            stats.reset(4 + static_cast<int>(k % 32));
+            for (int i = 0; i < stats.size(); ++i) {
+                stats.visits()[i] = static_cast<float>(1 + rng.below(200));
+                stats.wins()[i] = stats.visits()[i] * static_cast<float>(rng.below(100)) / 100.0f;
+            }
+        }
+        return BenchRegistry::Body([nodes] {
+            uint64_t acc = 0;
+            for (int rep = 0; rep < 1000; ++rep) {
+                const float log_parent = std::log(static_cast<float>(rep + 100));
+                for (const ai::ChildStats& stats : *nodes) {
+                    acc += static_cast<uint64_t>(stats.select_ucb1(log_parent, 1.414f, 0));
+                }
+            }
+            g_sink = g_sink + acc;
+            return static_cast<uint64_t>(1000 * nodes->size());
+        });
+    });
+
+    // ---------------- macro ----------------
+    registry.add("macro", "minimax_depth6", "nodes", [] {
+        auto positions = std::make_shared<std::vector<Board>>(PositionSuite::generate_midgame(8, 16, 30, 7));
+        auto engine = std::make_shared<ai::MinimaxEngine>();
+        return BenchRegistry::Body([positions, engine] {
+            uint64_t nodes = 0;
+            for (const Board& b : *positions) {
+                engine->reset();
+                engine->find_best_move(b, ai::SearchLimits(6, 600000));
+                nodes += engine->get_stats().nodes_searched;
+            }
+            return nodes;
+        });
+    });
+
+    registry.add("macro", "mcts_sims", "simulations", [] {
+        auto positions = std::make_shared<std::vector<Board>>(PositionSuite::generate_midgame(4, 10, 30, 11));
+        ai::MCTSEngine::Config config(2000, 600000);
+        config.seed = 1;
+        auto engine = std::make_shared<ai::MCTSEngine>(config);
+        return BenchRegistry::Body([positions, engine] {
+            uint64_t sims = 0;
+            for (const Board& b : *positions) {
+                engine->reset();
+                engine->set_seed(1);
+                engine->find_best_move(b, ai::SearchLimits(64, 600000));
+                sims += static_cast<uint64_t>(engine->get_mcts_stats().simulations_performed);
+            }
+            return sims;
+        });
+    });
+
+    registry.add("macro", "endgame_solve", "nodes", [] {
+        auto positions = std::make_shared<std::vector<Board>>(PositionSuite::generate_endgame(6, 48, 48, 13));
+        auto solver = std::make_shared<ai::EndgameSolver>(18);
+        return BenchRegistry::Body([positions, solver] {
+            uint64_t nodes = 0;
+            for (const Board& b : *positions) {
+                solver->clear();
+                nodes += solver->solve(b).nodes;
+            }
+            return nodes;
+        });
+    });
+
+    registry.add("macro", "match_depth2", "games", [] {
+        return BenchRegistry::Body([] {
+            MatchEngine::MatchConfig config(4);
+            config.random_seed = 3;
+            config.limits = ai::SearchLimits(2, 600000);
+            config.opening_plies = 6;
+            auto factory = [] { return std::unique_ptr<ai::AIStrategy>(std::make_unique<ai::MinimaxEngine>()); };
+            auto result = MatchEngine::play_match(factory, factory, config);
+            return static_cast<uint64_t>(result.total_games());
+        });
+    });
+}
+
+void print_usage() {
+    std::cout << "Usage: reversi_bench [options]\n"
+              << "  --list               List registered benchmarks\n"
+              << "  --filter <a,b>       Run benchmarks whose group/name contains a or b\n"
+              << "  --warmup <n>         Untimed repetitions (default 1)\n"
+              << "  --reps <n>           Timed repetitions (default 10)\n"
+              << "  --pin <cpu>          Pin to one CPU (Linux)\n"
+              << "  --json <file>        Write results as JSON\n"
+              << "  --baseline <file>    Compare with a saved JSON run\n"
+              << "  --threshold <pct>    Smallest change flagged (default 3)\n"
+              << "  --perf               Hardware counters per benchmark (IPC, branch/cache misses)\n"
+              << "  --trace <file>       Write a Chrome trace (chrome://tracing, Perfetto)\n";
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    BenchRegistry registry;
+    register_standard_benchmarks(registry);
+
+    BenchRegistry::Config config;
+    std::string json, baseline, trace;
+    double threshold = 3.0;
+    bool list = false;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        bool has_value = i + 1 < argc;
+        if (arg == "--list") list = true;
+        else if (arg == "--filter" && has_value) config.filter = argv[++i];
+        else if (arg == "--warmup" && has_value) config.warmup = std::max(0, std::atoi(argv[++i]));
+        else if (arg == "--reps" && has_value) config.repetitions = std::max(1, std::atoi(argv[++i]));
+        else if (arg == "--pin" && has_value) config.pin_cpu = std::atoi(argv[++i]);
+        else if (arg == "--json" && has_value) json = argv[++i];
+        else if (arg == "--baseline" && has_value) baseline = argv[++i];
+        else if (arg == "--threshold" && has_value) threshold = std::atof(argv[++i]);
+        else if (arg == "--perf") config.perf_counters = true;
+        else if (arg == "--trace" && has_value) trace = argv[++i];
+        else {
+            print_usage();
+            return arg == "--help" ? 0 : 1;
+        }
+    }
+
+    if (list) {
+        for (const auto* c : registry.select(config.filter)) {
+            std::cout << std::left << std::setw(28) << c->full_name() << c->unit << "/s\n";
+        }
+        return 0;
+    }
+
+    std::vector<BenchRegistry::Result> base;
+    if (!baseline.empty() && !BenchRegistry::read_json(baseline, base)) return 1;
+    // Benchmarks left out by --filter are not "missing"
+    auto selected = registry.select(config.filter);
+    base.erase(std::remove_if(base.begin(), base.end(), [&](const BenchRegistry::Result& r) {
+        return std::none_of(selected.begin(), selected.end(), [&](const auto* c) { return c->full_name() == r.name; });
+    }), base.end());
+
+    if (!trace.empty()) {
+        if (REVERSI_TRACE_LEVEL == 0) {
+            std::cerr << "Warning: Tracing compiled out (configure with -DREVERSI_TRACE_LEVEL=1 or 2)" << std::endl;
+        }
+        core::Tracer::set_enabled(true);
+    }
+    auto results = registry.run(config);
+    if (!trace.empty()) {
+        core::Tracer::set_enabled(false);
+        if (!core::Tracer::write_chrome_json(trace)) return 1;
+    }
+    if (!json.empty() && !BenchRegistry::write_json(json, results, config)) return 1;
+    if (baseline.empty()) return 0;
+
+    std::cout << "\nAgainst " << baseline << " (Welch t-test, 95%, threshold " << threshold << "%):\n";
+    int regressions = 0;
+    for (const auto& c : BenchRegistry::compare(base, results, threshold)) {
+        std::cout << std::left << std::setw(28) << c.name << std::right << std::fixed << std::setprecision(1)
+                  << std::showpos << std::setw(8) << c.change_pct << "%" << std::noshowpos << std::setprecision(2)
+                  << "  t=" << std::setw(7) << c.t << "  " << BenchRegistry::verdict_name(c.verdict) << "\n";
+        regressions += c.verdict == BenchRegistry::Verdict::REGRESSED;
+    }
+    if (regressions > 0) {
+        std::cout << regressions << " regression(s)\n";
+        return 3;
+    }
+    return 0;
+}
@@ -0,0 +1,284 @@
+/*
+ * BenchRegistry.cpp - Named benchmark registry with baseline comparison
+ * COMP390 Honours Year Project
+ *
+ * Author: Tianqixing
+ * Student ID: 201821852
+ */
+
+#include "BenchRegistry.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <ctime>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <stdexcept>
+
+#ifdef __linux__
+#include <sched.h>
+#endif
+
+namespace reversi {
+namespace research {
+
+namespace {
+
+std::vector<std::string> split_filter(const std::string& filter) {
+    std::vector<std::string> parts;
+    std::stringstream ss(filter);
+    std::string part;
+    while (std::getline(ss, part, ',')) {
+        if (!part.empty()) parts.push_back(part);
+    }
+    return parts;
+}
+
+/// Value of "key": "..." on a JSON line written by write_json
+bool json_string(const std::string& line, const std::string& key, std::string& out) {
+    size_t pos = line.find("\"" + key + "\": \"");
+    if (pos == std::string::npos) return false;
+    pos += key.size() + 5;
+    size_t end = line.find('"', pos);
+    if (end == std::string::npos) return false;
+    out = line.substr(pos, end - pos);
+    return true;
+}
+
+/// Numbers of "key": [a, b, ...] on a JSON line written by write_json
+bool json_numbers(const std::string& line, const std::string& key, std::vector<double>& out) {
+    size_t pos = line.find("\"" + key + "\": [");
+    if (pos == std::string::npos) return false;
+    pos += key.size() + 5;
+    size_t end = line.find(']', pos);
+    if (end == std::string::npos) return false;
+    out.clear();
+    const char* p = line.c_str() + pos;
+    const char* stop = line.c_str() + end;
+    while (p < stop) {
+        char* next = nullptr;
+        double v = std::strtod(p, &next);
+        if (next == p) {
+            ++p;
+            continue;
+        }
+        out.push_back(v);
+        p = next;
+    }
+    return true;
+}
+
+} // namespace
+
+void BenchRegistry::add(const std::string& group, const std::string& name, const std::string& unit, Setup setup) {
+    for (const Case& c : cases_) {
+        if (c.group == group && c.name == name) {
+            throw std::invalid_argument("duplicate benchmark " + group + "/" + name);
+        }
+    }
+    cases_.push_back({group, name, unit, std::move(setup)});
+}
+
+std::vector<const BenchRegistry::Case*> BenchRegistry::select(const std::string& filter) const {
+    const auto parts = split_filter(filter);
+    std::vector<const Case*> selected;
+    for (const Case& c : cases_) {
+        bool match = parts.empty();
+        for (const auto& part : parts) {
+            match = match || c.full_name().find(part) != std::string::npos;
+        }
+        if (match) selected.push_back(&c);
+    }
+    return selected;
+}
+
+bool BenchRegistry::pin_to_cpu(int cpu) {
+#ifdef __linux__
+    if (cpu < 0 || cpu >= CPU_SETSIZE) return false;
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(cpu, &set);
+    return sched_setaffinity(0, sizeof(set), &set) == 0;
+#else
+    (void)cpu;
+    return false;
+#endif
+}
+
+std::vector<BenchRegistry::Result> BenchRegistry::run(const Config& config) const {
+    if (config.pin_cpu >= 0 && !pin_to_cpu(config.pin_cpu)) {
+        std::cerr << "Warning: Cannot pin to CPU " << config.pin_cpu << ", running unpinned" << std::endl;
+    }
+
+    std::unique_ptr<ai::PerfCounters> counters;
+    if (config.perf_counters) {
+        counters = std::make_unique<ai::PerfCounters>();
+        if (!counters->available()) {
+            std::cerr << "Warning: Hardware counters unavailable, timing only" << std::endl;
+        }
+    }
+
+    std::vector<Result> results;
+    for (const Case* c : select(config.filter)) {
+        Body body = c->setup();
+        for (int i = 0; i < config.warmup; ++i) body();
+
+        Result result;
+        result.name = c->full_name();
+        result.unit = c->unit;
+        for (int i = 0; i < std::max(1, config.repetitions); ++i) {
+            if (counters) counters->start();
+            auto start = std::chrono::steady_clock::now();
+            uint64_t ops = body();
+            double secs = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+            if (counters) {
+                result.perf += counters->stop();
+                result.perf_ops += ops;
+            }
+            result.ops_per_rep = ops;
+            result.samples.push_back(secs > 0 ? static_cast<double>(ops) / secs : 0.0);
+        }
+        result.stats = Statistics::calculate(result.samples);
+
+        if (config.verbose) {
+            std::cout << std::left << std::setw(28) << result.name << std::right << std::fixed
+                      << std::setprecision(0) << std::setw(16) << result.stats.mean << " " << std::left
+                      << std::setw(10) << (result.unit + "/s") << std::right << " +/- " << std::setprecision(1)
+                      << (result.stats.mean > 0 ? 100.0 * result.stats.std_dev / result.stats.mean : 0.0)
+                      << "%  (" << result.samples.size() << " reps)" << std::endl;
+            if (result.perf.valid()) {
+                std::cout << "    " << result.perf.summary(result.perf_ops) << std::endl;
+            }
+        }
+        results.push_back(std::move(result));
+    }
+    return results;
+}
+
+bool BenchRegistry::write_json(const std::string& path, const std::vector<Result>& results, const Config& config) {
+    std::ofstream out(path);
+    if (!out.is_open()) {
+        std::cerr << "Error: Cannot open file " << path << " for writing" << std::endl;
+        return false;
+    }
+
+    char stamp[32] = {};
+    std::time_t now = std::time(nullptr);
+    std::strftime(stamp, sizeof(stamp), "%Y-%m-%dT%H:%M:%S", std::localtime(&now));
+#if defined(__VERSION__)
+    const char* compiler = __VERSION__;
+#else
+    const char* compiler = "unknown";
+#endif
+#ifdef NDEBUG
+    const char* build = "release";
+#else
+    const char* build = "debug";
+#endif
+
+    out << "{\n"
+        << "  \"version\": 1,\n"
+        << "  \"timestamp\": \"" << stamp << "\",\n"
+        << "  \"compiler\": \"" << compiler << "\",\n"
+        << "  \"build\": \"" << build << "\",\n"
+        << "  \"warmup\": " << config.warmup << ",\n"
+        << "  \"repetitions\": " << config.repetitions << ",\n"
+        << "  \"pin_cpu\": " << config.pin_cpu << ",\n"
+        << "  \"benchmarks\": [";
+    out << std::setprecision(10);
+    for (size_t i = 0; i < results.size(); ++i) {
+        const Result& r = results[i];
+        // One benchmark per line so read_json stays a line scanner
+        out << (i ? "," : "") << "\n    {\"name\": \"" << r.name << "\", \"unit\": \"" << r.unit
+            << "\", \"ops_per_rep\": " << r.ops_per_rep << ", \"mean\": " << r.stats.mean
+            << ", \"std_dev\": " << r.stats.std_dev << ", \"median\": " << r.stats.median
+            << ", \"ci95\": [" << r.stats.ci_95_lower << ", " << r.stats.ci_95_upper << "], \"samples\": [";
+        for (size_t s = 0; s < r.samples.size(); ++s) out << (s ? ", " : "") << r.samples[s];
+        out << "]";
+        if (r.perf.valid()) {
+            out << ", \"perf\": {\"ipc\": " << r.perf.ipc() << ", \"branch_miss_rate\": " << r.perf.branch_miss_rate();
+            for (int c = 0; c < ai::PerfSample::NUM_COUNTERS; ++c) {
+                auto counter = static_cast<ai::PerfSample::Counter>(c);
+                if (r.perf.has(counter)) {
+                    out << ", \"" << ai::PerfSample::counter_name(counter) << "_per_op\": " << r.perf.per(counter, r.perf_ops);
+                }
+            }
+            out << "}";
+        }
+        out << "}";
+    }
+    out << "\n  ]\n}\n";
+    return static_cast<bool>(out);
+}
+
+bool BenchRegistry::read_json(const std::string& path, std::vector<Result>& results) {
+    std::ifstream in(path);
+    if (!in.is_open()) {
+        std::cerr << "Error: Cannot open file " << path << std::endl;
+        return false;
+    }
+    results.clear();
+    std::string line;
+    while (std::getline(in, line)) {
+        Result r;
+        if (!json_string(line, "name", r.name) || !json_numbers(line, "samples", r.samples)) continue;
+        json_string(line, "unit", r.unit);
+        r.stats = Statistics::calculate(r.samples);
+        results.push_back(std::move(r));
+    }
+    return true;
+}
+
+std::vector<BenchRegistry::Comparison> BenchRegistry::compare(const std::vector<Result>& baseline,
+                                                              const std::vector<Result>& current,
+                                                              double threshold_pct,
+                                                              double confidence_level) {
+    std::vector<Comparison> out;
+    for (const Result& cur : current) {
+        Comparison c;
+        c.name = cur.name;
+        c.current_mean = cur.stats.mean;
+        auto base = std::find_if(baseline.begin(), baseline.end(), [&](const Result& b) { return b.name == cur.name; });
+        if (base == baseline.end()) {
+            c.verdict = Verdict::NEW;
+            out.push_back(c);
+            continue;
+        }
+        c.baseline_mean = base->stats.mean;
+        c.change_pct = c.baseline_mean > 0 ? 100.0 * (c.current_mean - c.baseline_mean) / c.baseline_mean : 0.0;
+        auto test = Statistics::welch_t_test(base->samples, cur.samples, confidence_level);
+        c.t = test.t;
+        c.significant = test.significant;
+        if (c.significant && c.change_pct <= -threshold_pct) c.verdict = Verdict::REGRESSED;
+        else if (c.significant && c.change_pct >= threshold_pct) c.verdict = Verdict::IMPROVED;
+        out.push_back(c);
+    }
+    for (const Result& base : baseline) {
+        bool present = std::any_of(current.begin(), current.end(), [&](const Result& r) { return r.name == base.name; });
+        if (!present) {
+            Comparison c;
+            c.name = base.name;
+            c.baseline_mean = base.stats.mean;
+            c.verdict = Verdict::MISSING;
+            out.push_back(c);
+        }
+    }
+    return out;
+}
+
+const char* BenchRegistry::verdict_name(Verdict v) {
+    switch (v) {
+        case Verdict::UNCHANGED: return "unchanged";
+        case Verdict::IMPROVED: return "IMPROVED";
+        case Verdict::REGRESSED: return "REGRESSED";
+        case Verdict::NEW: return "new";
+        case Verdict::MISSING: return "missing";
+    }
+    return "?";
+}
+
+} // namespace research
+} // namespace reversi
@@ -0,0 +1,132 @@
+/*
+ * BenchRegistry.hpp - Named benchmark registry with baseline comparison
+ * COMP390 Honours Year Project
+ *
+ * Every benchmark is a named case in a group ("micro", "macro", ...):
+ * a setup function, untimed, returns the body; each timed repetition
+ * calls the body once, which does a batch of work and returns how many
+ * operations it performed. One sample = operations per second of one
+ * repetition, so noise across repetitions is visible and testable.
+ *
+ * Results are written as JSON (one benchmark per line, samples
+ * included) and can be compared against a saved run: a change counts
+ * only if Welch's t-test finds it significant and it exceeds a
+ * relative threshold.
+ *
+ * With Config::perf_counters each timed repetition is also bracketed
+ * by hardware counters (Linux perf_event_open), reported per operation.
+ *
+ * Author: Tianqixing
+ * Student ID: 201821852
+ */
+
+#pragma once
+
+#include "Statistics.hpp"
+#include "ai/PerfCounters.hpp"
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace reversi {
+namespace research {
+
+class BenchRegistry {
+public:
+    /// One repetition; returns the number of operations performed
+    using Body = std::function<uint64_t()>;
+    /// Untimed preparation (positions, engines, ...) returning the body
+    using Setup = std::function<Body()>;
+
+    struct Case {
+        std::string group;    ///< "micro", "macro", ...
+        std::string name;     ///< Unique, e.g. "legal_moves"
+        std::string unit;     ///< What one operation is ("positions", "nodes", "games")
+        Setup setup;
+
+        std::string full_name() const { return group + "/" + name; }
+    };
+
+    struct Config {
+        std::string filter;       ///< Comma-separated substrings of group/name ("" = all)
+        int warmup = 1;           ///< Untimed repetitions before sampling
+        int repetitions = 10;     ///< Timed repetitions (samples)
+        int pin_cpu = -1;         ///< Pin the running thread to this CPU (-1 = no pinning)
+        bool verbose = true;      ///< Print one line per benchmark
+        bool perf_counters = false;  ///< Count cycles/instructions/branch and cache misses per repetition
+    };
+
+    struct Result {
+        std::string name;         ///< group/name
+        std::string unit;
+        uint64_t ops_per_rep = 0;
+        std::vector<double> samples;  ///< Operations per second, one per repetition
+        Statistics::StatsResult stats;
+        ai::PerfSample perf;      ///< Counters summed over the timed repetitions (perf_counters only)
+        uint64_t perf_ops = 0;    ///< Operations covered by perf
+    };
+
+    enum class Verdict { UNCHANGED, IMPROVED, REGRESSED, NEW, MISSING };
+
+    struct Comparison {
+        std::string name;
+        double baseline_mean = 0.0;
+        double current_mean = 0.0;
+        double change_pct = 0.0;  ///< Throughput change; negative = slower
+        double t = 0.0;
+        bool significant = false;
+        Verdict verdict = Verdict::UNCHANGED;
+    };
+
+    /**
+     * @brief Register a benchmark (names must be unique within a group)
+     */
+    void add(const std::string& group, const std::string& name, const std::string& unit, Setup setup);
+
+    const std::vector<Case>& cases() const { return cases_; }
+
+    /**
+     * @brief Cases matching a filter (see Config::filter)
+     */
+    std::vector<const Case*> select(const std::string& filter) const;
+
+    /**
+     * @brief Run the selected cases in registration order
+     */
+    std::vector<Result> run(const Config& config) const;
+
+    /**
+     * @brief Pin the calling thread to one CPU (Linux only; false elsewhere)
+     */
+    static bool pin_to_cpu(int cpu);
+
+    /**
+     * @brief Write results (and the run configuration) as JSON
+     */
+    static bool write_json(const std::string& path, const std::vector<Result>& results, const Config& config);
+
+    /**
+     * @brief Read results written by write_json
+     */
+    static bool read_json(const std::string& path, std::vector<Result>& results);
+
+    /**
+     * @brief Compare a run with a baseline, benchmark by benchmark
+     *
+     * @param threshold_pct Smallest relative change reported as a regression/improvement
+     * @param confidence_level Welch t-test confidence (0.90, 0.95 or 0.99)
+     */
+    static std::vector<Comparison> compare(const std::vector<Result>& baseline,
+                                           const std::vector<Result>& current,
+                                           double threshold_pct = 3.0,
+                                           double confidence_level = 0.95);
+
+    static const char* verdict_name(Verdict v);
+
+private:
+    std::vector<Case> cases_;
+};
+
+} // namespace research
+} // namespace reversi
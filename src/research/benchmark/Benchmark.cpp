@@ -9,6 +9,7 @@
 #include "Benchmark.hpp"
 #include "../../ai/MinimaxEngine.hpp"
 #include "../../ai/MCTSEngine.hpp"
+#include "../../ai/EndgameSolver.hpp"
 #include <iostream>
 #include <fstream>
 #include <iomanip>
@@ -19,6 +20,24 @@
 namespace reversi {
 namespace research {
 
+namespace {
+
+std::string square_name(int sq) {
+    if (sq < 0 || sq >= 64) return "PS";
+    return std::string{static_cast<char>('A' + sq % 8), static_cast<char>('1' + sq / 8)};
+}
+
+std::string json_escape(const std::string& s) {
+    std::string out;
+    for (char c : s) {
+        if (c == '"' || c == '\\') out += '\\';
+        out += c;
+    }
+    return out;
+}
+
+} // namespace
+
 BenchmarkResult Benchmark::run_single(
     std::shared_ptr<ai::AIStrategy> strategy,
     const BenchmarkConfig& config
@@ -112,6 +131,28 @@ MatchEngine::MatchResult Benchmark::compare_minimax_vs_mcts(
     return result;
 }
 
+MatchEngine::MatchResult Benchmark::compare_minimax_vs_mcts(
+    const ai::SearchLimits& minimax_limits,
+    const ai::SearchLimits& mcts_limits,
+    const Statistics::SPRTConfig& sprt,
+    int max_games,
+    int num_threads
+) {
+    MatchEngine::MatchConfig match_config;
+    match_config.num_games = max_games;
+    match_config.num_threads = num_threads;
+    match_config.limits = minimax_limits;
+    match_config.player2_limits = mcts_limits;
+    match_config.opening_plies = 8;
+    match_config.use_sprt = true;
+    match_config.sprt = sprt;
+    
+    return MatchEngine::play_match(
+        [] { return std::make_unique<ai::MinimaxEngine>(); },
+        [] { return std::make_unique<ai::MCTSEngine>(); },
+        match_config);
+}
+
 std::vector<BenchmarkResult> Benchmark::test_difficulty_levels(
     std::shared_ptr<ai::AIStrategy> strategy,
     const std::vector<ai::Difficulty>& levels,
@@ -137,6 +178,87 @@ std::vector<core::Board> Benchmark::generate_test_positions(int count) {
     return PositionSuite::generate_suite(PositionSuite::SuiteType::STANDARD_64, count);
 }
 
+BenchmarkResult Benchmark::run_endgame_suite(
+    const std::vector<PositionFile::Position>& suite,
+    const EndgameSuiteConfig& config
+) {
+    BenchmarkResult result;
+    result.algorithm_name = "EndgameSolver";
+    ai::EndgameSolver solver(config.tt_bits);
+    double total_ms = 0.0;
+    
+    if (config.verbose) {
+        std::cout << std::left << std::setw(10) << "Position" << std::right << std::setw(8) << "Empties"
+                  << std::setw(8) << "Move" << std::setw(8) << "Score" << std::setw(8) << "Ref"
+                  << std::setw(12) << "Time(ms)" << std::setw(14) << "Nodes" << std::setw(12) << "Nodes/s"
+                  << "\n";
+    }
+    
+    for (size_t i = 0; i < suite.size(); ++i) {
+        const PositionFile::Position& pos = suite[i];
+        if (pos.empties() > config.max_empties) continue;
+        
+        EndgameSolveResult solve;
+        solve.label = i < config.labels.size() && !config.labels[i].empty() ? config.labels[i]
+                                                                           : "line " + std::to_string(pos.line);
+        solve.empties = pos.empties();
+        solve.has_expected = pos.has_score != 0;
+        solve.expected_score = pos.score;
+        solve.expected_move = pos.best_move;
+        
+        solver.clear();
+        auto r = solver.solve(pos.board());
+        solve.score = r.score;
+        solve.best_move = r.best_move;
+        solve.correct = solve.has_expected && r.score == solve.expected_score;
+        solve.time_ms = r.time_ms;
+        solve.nodes = r.nodes;
+        solve.nodes_per_second = r.time_ms > 0 ? r.nodes * 1000.0 / r.time_ms : 0.0;
+        
+        if (config.verbose) {
+            std::cout << std::left << std::setw(10) << solve.label << std::right << std::setw(8) << solve.empties
+                      << std::setw(8) << square_name(solve.best_move) << std::setw(8) << std::showpos
+                      << solve.score << std::setw(8);
+            if (solve.has_expected) std::cout << solve.expected_score;
+            else std::cout << "?";
+            std::cout << std::noshowpos << std::fixed << std::setprecision(1) << std::setw(12) << solve.time_ms
+                      << std::setw(14) << solve.nodes << std::setprecision(0) << std::setw(12)
+                      << solve.nodes_per_second << (solve.has_expected && !solve.correct ? "  WRONG" : "")
+                      << std::endl;
+        }
+        
+        result.total_nodes += solve.nodes;
+        total_ms += solve.time_ms;
+        result.time_per_position.push_back(solve.time_ms);
+        result.nodes_per_position.push_back(solve.nodes);
+        result.depth_distribution.push_back(solve.empties);
+        result.positions_checked += solve.has_expected ? 1 : 0;
+        result.positions_correct += solve.correct ? 1 : 0;
+        result.solves.push_back(std::move(solve));
+    }
+    
+    result.positions_tested = static_cast<int>(result.solves.size());
+    result.total_time_ms = static_cast<int>(total_ms);
+    if (!result.solves.empty()) {
+        result.nodes_per_second = total_ms > 0 ? result.total_nodes * 1000.0 / total_ms : 0.0;
+        result.avg_depth_reached = std::accumulate(
+            result.depth_distribution.begin(),
+            result.depth_distribution.end(), 0
+        ) / result.positions_tested;
+        result.time_stats = Statistics::calculate(result.time_per_position);
+        result.nodes_stats = Statistics::calculate(result.nodes_per_position);
+        result.depth_stats = Statistics::calculate(result.depth_distribution);
+    }
+    
+    if (config.verbose) {
+        std::cout << "Total: " << result.positions_tested << " positions, " << std::fixed << std::setprecision(1)
+                  << total_ms << " ms, " << result.total_nodes << " nodes, " << std::setprecision(0)
+                  << result.nodes_per_second << " nodes/s, " << result.positions_correct << "/"
+                  << result.positions_checked << " correct" << std::endl;
+    }
+    return result;
+}
+
 std::vector<core::Board> Benchmark::load_standard_suite(const std::string& suite_name) {
     // For now, just generate standard suite
     // File loading can be added later if needed
@@ -156,7 +278,7 @@ void Benchmark::export_results_csv(
     // Write header
     file << "Algorithm,Positions,Repetitions,TotalNodes,TotalTimeMs,NodesPerSec,"
          << "AvgDepth,TimeMean,TimeStdDev,TimeCI95Lower,TimeCI95Upper,"
-         << "NodesMean,NodesStdDev,NodesCI95Lower,NodesCI95Upper\n";
+         << "NodesMean,NodesStdDev,NodesCI95Lower,NodesCI95Upper,Checked,Correct\n";
     
     // Write data
     for (const auto& result : results) {
@@ -175,12 +297,95 @@ void Benchmark::export_results_csv(
              << result.nodes_stats.mean << ","
              << result.nodes_stats.std_dev << ","
              << result.nodes_stats.ci_95_lower << ","
-             << result.nodes_stats.ci_95_upper << "\n";
+             << result.nodes_stats.ci_95_upper << ","
+             << result.positions_checked << ","
+             << result.positions_correct << "\n";
     }
     
     file.close();
 }
 
+void Benchmark::export_results_json(
+    const std::vector<BenchmarkResult>& results,
+    const std::string& filename
+) {
+    std::ofstream file(filename);
+    if (!file.is_open()) {
+        std::cerr << "Error: Cannot open file " << filename << " for writing" << std::endl;
+        return;
+    }
+    
+    file << std::fixed << std::setprecision(3);
+    file << "{\n  \"results\": [";
+    for (size_t r = 0; r < results.size(); ++r) {
+        const auto& result = results[r];
+        file << (r ? "," : "") << "\n    {\n"
+             << "      \"algorithm\": \"" << json_escape(result.algorithm_name) << "\",\n"
+             << "      \"positions\": " << result.positions_tested << ",\n"
+             << "      \"total_nodes\": " << result.total_nodes << ",\n"
+             << "      \"total_time_ms\": " << result.total_time_ms << ",\n"
+             << "      \"nodes_per_second\": " << result.nodes_per_second << ",\n"
+             << "      \"avg_depth\": " << result.avg_depth_reached << ",\n"
+             << "      \"time_ms\": {\"mean\": " << result.time_stats.mean
+             << ", \"std_dev\": " << result.time_stats.std_dev
+             << ", \"ci95\": [" << result.time_stats.ci_95_lower << ", " << result.time_stats.ci_95_upper << "]},\n"
+             << "      \"nodes\": {\"mean\": " << result.nodes_stats.mean
+             << ", \"std_dev\": " << result.nodes_stats.std_dev
+             << ", \"ci95\": [" << result.nodes_stats.ci_95_lower << ", " << result.nodes_stats.ci_95_upper << "]},\n"
+             << "      \"checked\": " << result.positions_checked << ",\n"
+             << "      \"correct\": " << result.positions_correct << ",\n"
+             << "      \"solves\": [";
+        for (size_t i = 0; i < result.solves.size(); ++i) {
+            const auto& s = result.solves[i];
+            file << (i ? "," : "") << "\n        {\"position\": \"" << json_escape(s.label) << "\""
+                 << ", \"empties\": " << s.empties
+                 << ", \"move\": \"" << square_name(s.best_move) << "\""
+                 << ", \"score\": " << s.score;
+            if (s.has_expected) {
+                file << ", \"expected_move\": \"" << square_name(s.expected_move) << "\""
+                     << ", \"expected_score\": " << s.expected_score
+                     << ", \"correct\": " << (s.correct ? "true" : "false");
+            }
+            file << ", \"time_ms\": " << s.time_ms
+                 << ", \"nodes\": " << s.nodes
+                 << ", \"nodes_per_second\": " << s.nodes_per_second << "}";
+        }
+        file << (result.solves.empty() ? "]\n" : "\n      ]\n") << "    }";
+    }
+    file << "\n  ]\n}\n";
+}
+
+void Benchmark::export_solves_csv(
+    const std::vector<BenchmarkResult>& results,
+    const std::string& filename
+) {
+    std::ofstream file(filename);
+    if (!file.is_open()) {
+        std::cerr << "Error: Cannot open file " << filename << " for writing" << std::endl;
+        return;
+    }
+    
+    file << "Algorithm,Position,Empties,Move,Score,ExpectedMove,ExpectedScore,Correct,TimeMs,Nodes,NodesPerSec\n";
+    file << std::fixed << std::setprecision(3);
+    for (const auto& result : results) {
+        for (const auto& s : result.solves) {
+            file << result.algorithm_name << ","
+                 << s.label << ","
+                 << s.empties << ","
+                 << square_name(s.best_move) << ","
+                 << s.score << ",";
+            if (s.has_expected) {
+                file << square_name(s.expected_move) << "," << s.expected_score << "," << (s.correct ? 1 : 0) << ",";
+            } else {
+                file << ",,,";
+            }
+            file << s.time_ms << ","
+                 << s.nodes << ","
+                 << s.nodes_per_second << "\n";
+        }
+    }
+}
+
 void Benchmark::export_match_csv(
     const std::vector<MatchEngine::MatchResult>& results,
     const std::string& filename
@@ -223,7 +428,12 @@ void Benchmark::export_results(
     const std::string& format,
     const std::string& filename
 ) {
-    if (format == "csv" || (format == "auto" && filename.find(".csv") != std::string::npos)) {
+    const bool json_name = filename.size() >= 5 && filename.compare(filename.size() - 5, 5, ".json") == 0;
+    if (format == "json" || (format == "auto" && json_name)) {
+        export_results_json(results, filename);
+    } else if (format == "solves_csv") {
+        export_solves_csv(results, filename);
+    } else if (format == "csv" || (format == "auto" && filename.find(".csv") != std::string::npos)) {
         export_results_csv(results, filename);
     } else {
         // Default to CSV
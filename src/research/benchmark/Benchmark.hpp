@@ -15,6 +15,7 @@
 #include "MatchEngine.hpp"
 #include "Statistics.hpp"
 #include "PositionSuite.hpp"
+#include "../data/PositionFile.hpp"
 #include <string>
 #include <vector>
 #include <memory>
@@ -23,6 +24,23 @@
 namespace reversi {
 namespace research {
 
+/**
+ * @brief Exact solve of one endgame suite position
+ */
+struct EndgameSolveResult {
+    std::string label;            ///< "#40" or "line 12"
+    int empties = 0;
+    bool has_expected = false;    ///< The suite line carried a reference score
+    int expected_score = 0;
+    int expected_move = -1;
+    int score = 0;
+    int best_move = -1;
+    bool correct = false;         ///< score == expected_score (false without a reference)
+    double time_ms = 0.0;
+    uint64_t nodes = 0;
+    double nodes_per_second = 0.0;
+};
+
 /**
  * @brief Result of a single benchmark run
  */
@@ -43,6 +61,11 @@ struct BenchmarkResult {
     Statistics::StatsResult time_stats;
     Statistics::StatsResult nodes_stats;
     Statistics::StatsResult depth_stats;
+    
+    // Endgame suite runs only
+    std::vector<EndgameSolveResult> solves;
+    int positions_checked = 0;    ///< Positions with a reference score
+    int positions_correct = 0;
 };
 
 /**
@@ -62,6 +85,16 @@ struct BenchmarkConfig {
     std::string output_file = "";      ///< Output filename
 };
 
+/**
+ * @brief Endgame suite configuration (e.g. FFO #40-#59)
+ */
+struct EndgameSuiteConfig {
+    std::vector<std::string> labels; ///< Label per position, e.g. PositionFile ids (missing/empty = "line N")
+    int max_empties = 64;         ///< Skip deeper positions
+    int tt_bits = 22;             ///< Solver transposition table size (2^bits entries)
+    bool verbose = true;          ///< Print one line per position
+};
+
 /**
  * @brief Benchmark framework for AI algorithm evaluation
  * 
@@ -105,6 +138,22 @@ public:
         bool alternate_colors = true
     );
     
+    /**
+     * @brief Minimax vs MCTS until an SPRT decision
+     * 
+     * Plays colour-swapped game pairs from random openings, each side with
+     * its own limits, and stops as soon as the pentanomial SPRT accepts
+     * H0 or H1 (or after max_games). Minimax is player1, so a positive
+     * Elo means Minimax is stronger.
+     */
+    static MatchEngine::MatchResult compare_minimax_vs_mcts(
+        const ai::SearchLimits& minimax_limits,
+        const ai::SearchLimits& mcts_limits,
+        const Statistics::SPRTConfig& sprt,
+        int max_games = 1000,
+        int num_threads = 0
+    );
+    
     /**
      * @brief Test different difficulty levels
      * 
@@ -116,6 +165,18 @@ public:
         const BenchmarkConfig& base_config
     );
     
+    /**
+     * @brief Solve every position of an endgame suite exactly
+     * 
+     * Positions are solved one by one with a fresh transposition table;
+     * positions annotated with a score ("...; G8:+38;") are checked
+     * against it. Per-position results are in BenchmarkResult::solves.
+     */
+    static BenchmarkResult run_endgame_suite(
+        const std::vector<PositionFile::Position>& suite,
+        const EndgameSuiteConfig& config = {}
+    );
+    
     /**
      * @brief Generate test positions
      * 
@@ -147,7 +208,26 @@ public:
     );
     
     /**
-     * @brief Export results to file (format auto-detected from extension)
+     * @brief Export results to JSON (summary and per-position detail)
+     */
+    static void export_results_json(
+        const std::vector<BenchmarkResult>& results,
+        const std::string& filename
+    );
+    
+    /**
+     * @brief Export one CSV row per solved endgame position
+     */
+    static void export_solves_csv(
+        const std::vector<BenchmarkResult>& results,
+        const std::string& filename
+    );
+    
+    /**
+     * @brief Export results to file
+     * 
+     * Formats: "csv" (summary), "json", "solves_csv" (per endgame
+     * position), or "auto" (from the extension: .json, else csv)
      */
     static void export_results(
         const std::vector<BenchmarkResult>& results,
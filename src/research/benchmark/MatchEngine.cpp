@@ -7,55 +7,257 @@
  */
 
 #include "MatchEngine.hpp"
+#include "core/Trace.hpp"
 #include <iostream>
 #include <random>
 #include <iomanip>
 #include <numeric>
 #include <algorithm>
 #include <chrono>
+#include <atomic>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <array>
 
 namespace reversi {
 namespace research {
 
+namespace {
+
+/**
+ * @brief Resolve MatchConfig::random_seed (0 = time-based)
+ */
+uint32_t resolve_seed(uint32_t seed) {
+    if (seed != 0) return seed;
+    uint64_t t = static_cast<uint64_t>(std::chrono::steady_clock::now().time_since_epoch().count());
+    uint32_t s = static_cast<uint32_t>(t ^ (t >> 32));
+    return s != 0 ? s : 1u;
+}
+
+int resolve_threads(int requested, int num_games) {
+    int n = requested;
+    if (n <= 0) {
+        n = static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+    }
+    return std::max(1, std::min(n, num_games));
+}
+
+} // namespace
+
+uint64_t MatchEngine::game_seed(uint32_t match_seed, int game, int player) {
+    // splitmix64 over (seed, game, player): independent streams per game
+    uint64_t z = (static_cast<uint64_t>(match_seed) << 32) ^
+                 (static_cast<uint64_t>(game) << 1) ^ static_cast<uint64_t>(player & 1);
+    z += 0x9E3779B97F4A7C15ULL;
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+core::Board MatchEngine::make_opening(uint32_t match_seed, int pair, int plies) {
+    core::Board board;
+    if (plies <= 0) return board;
+    
+    std::mt19937_64 rng(game_seed(match_seed, pair, 0) ^ 0xA5A5A5A5A5A5A5A5ULL);
+    std::vector<int> moves;
+    for (int ply = 0; ply < plies; ++ply) {
+        moves.clear();
+        board.get_legal_moves(moves);
+        if (moves.empty()) {
+            if (board.is_terminal()) break;
+            board.pass();
+            continue;
+        }
+        std::uniform_int_distribution<size_t> dist(0, moves.size() - 1);
+        board.make_move(moves[dist(rng)]);
+    }
+    // A finished game is useless as an opening; fall back to the start
+    return board.is_terminal() ? core::Board() : board;
+}
+
+int MatchEngine::pair_points(const GameResult& first, const GameResult& second) {
+    // winner: 1 = player1 (2 half-points), 0 = draw (1), -1 = player2 (0)
+    return (first.winner + 1) + (second.winner + 1);
+}
+
 MatchEngine::MatchResult MatchEngine::play_match(
     std::shared_ptr<ai::AIStrategy> player1,
     std::shared_ptr<ai::AIStrategy> player2,
     const MatchConfig& config
 ) {
-    MatchResult result;
-    result.player1_name = player1->get_name();
-    result.player2_name = player2->get_name();
+    // Parallel mode needs independent engines per worker
+    int num_threads = resolve_threads(config.num_threads, config.num_games);
+    if (num_threads > 1) {
+        // The probe clones are not thrown away: the first worker plays with them
+        std::shared_ptr<ai::AIStrategy> probe1(player1->clone());
+        std::shared_ptr<ai::AIStrategy> probe2(probe1 ? player2->clone() : nullptr);
+        if (probe1 && probe2) {
+            std::atomic<bool> probes_taken{false};
+            return run_match([&]() -> EnginePair {
+                if (!probes_taken.exchange(true)) {
+                    return {std::move(probe1), std::move(probe2)};
+                }
+                return {std::shared_ptr<ai::AIStrategy>(player1->clone()),
+                        std::shared_ptr<ai::AIStrategy>(player2->clone())};
+            }, num_threads, config);
+        }
+        if (config.verbose) {
+            std::cout << "[MatchEngine] Strategy does not support clone(); playing sequentially\n";
+        }
+    }
     
-    // Initialize random seed if needed
-    std::mt19937 rng(config.random_seed == 0 ? 
-                     std::chrono::steady_clock::now().time_since_epoch().count() : 
-                     config.random_seed);
+    return run_match([&]() -> EnginePair { return {player1, player2}; }, 1, config);
+}
+
+MatchEngine::MatchResult MatchEngine::play_match(
+    const StrategyFactory& player1_factory,
+    const StrategyFactory& player2_factory,
+    const MatchConfig& config
+) {
+    return run_match([&]() -> EnginePair {
+        return {std::shared_ptr<ai::AIStrategy>(player1_factory()),
+                std::shared_ptr<ai::AIStrategy>(player2_factory())};
+    }, resolve_threads(config.num_threads, config.num_games), config);
+}
+
+MatchEngine::MatchResult MatchEngine::run_match(
+    const std::function<EnginePair()>& make_engines,
+    int num_threads,
+    const MatchConfig& config
+) {
+    MatchResult result;
+    result.random_seed = resolve_seed(config.random_seed);
+    const int num_games = std::max(0, config.num_games);
+    result.games.resize(num_games);
     
-    // Default search limits (can be customized)
-    ai::SearchLimits limits;
-    limits.max_depth = 6;
-    limits.max_time_ms = 5000;
+    std::atomic<int> next_game{0};
+    std::mutex state_mutex;   // Guards the fields below and console output
+    std::vector<bool> done(num_games, false);
+    int frontier = 0;         // Games [0, frontier) are all complete
+    int completed = 0;
+    int stop_at = num_games;  // SPRT decision point (in game order)
+    std::exception_ptr failure;
+    std::array<int, 5> pentanomial{};
     
-    // Play games
-    for (int game = 0; game < config.num_games; ++game) {
-        // Determine who plays black
-        bool player1_is_black = true;
-        if (config.alternate_colors) {
-            player1_is_black = (game % 2 == 0);
+    // Called with state_mutex held after game `game` finishes
+    auto on_game_done = [&](int game) {
+        done[game] = true;
+        ++completed;
+        while (frontier < num_games && done[frontier]) {
+            ++frontier;
+            // A pair completes when its second game joins the prefix
+            if (!config.use_sprt || frontier % 2 != 0 || frontier > stop_at) continue;
+            pentanomial[pair_points(result.games[frontier - 2], result.games[frontier - 1])]++;
+            result.sprt = Statistics::sprt_pentanomial(pentanomial, config.sprt);
+            
+            const auto& t = result.sprt;
+            bool decided = t.decision != Statistics::SPRTDecision::CONTINUE;
+            if (config.sprt_report_every > 0 &&
+                (t.pairs % config.sprt_report_every == 0 || decided)) {
+                std::cout << "[SPRT] pairs " << t.pairs
+                          << "  LLR " << std::fixed << std::setprecision(2) << t.llr
+                          << " [" << t.lower_bound << ", " << t.upper_bound << "]"
+                          << "  Elo " << std::setprecision(1) << t.elo << " +/- " << t.elo_ci95
+                          << "  penta [" << t.pentanomial[0] << " " << t.pentanomial[1] << " "
+                          << t.pentanomial[2] << " " << t.pentanomial[3] << " " << t.pentanomial[4] << "]"
+                          << (decided ? std::string("  -> accept ") + t.decision_name() : std::string())
+                          << std::endl;
+            }
+            if (decided) {
+                stop_at = frontier;
+                next_game.store(num_games);  // Schedule nothing further
+            }
         }
-        
-        if (config.verbose) {
-            std::cout << "Game " << (game + 1) << "/" << config.num_games 
-                      << " - " << (player1_is_black ? result.player1_name : result.player2_name)
-                      << " as Black... " << std::flush;
+    };
+    
+    auto worker = [&](int worker_id) {
+        try {
+            EnginePair engines = make_engines();
+            if (worker_id == 0) {
+                std::lock_guard<std::mutex> lock(state_mutex);
+                result.player1_name = engines.first->get_name();
+                result.player2_name = engines.second->get_name();
+            }
+            
+            for (;;) {
+                int game = next_game.fetch_add(1);
+                if (game >= num_games) break;
+                
+                // Each slot is written by exactly one worker
+                GameResult g = play_indexed_game(engines.first, engines.second, game, result.random_seed, config);
+                
+                std::lock_guard<std::mutex> lock(state_mutex);
+                result.games[game] = std::move(g);
+                on_game_done(game);
+                
+                if (config.verbose) {
+                    const GameResult& r = result.games[game];
+                    std::cout << "Game " << (game + 1) << "/" << num_games
+                              << " (" << completed << " done";
+                    if (num_threads > 1) std::cout << ", worker " << worker_id;
+                    std::cout << ") - " << (r.player1_was_black ? result.player1_name : result.player2_name)
+                              << " as Black - Winner: "
+                              << (r.winner == 1 ? result.player1_name :
+                                  r.winner == -1 ? result.player2_name : "Draw")
+                              << " (" << r.move_count << " moves, "
+                              << std::fixed << std::setprecision(1) << r.duration_ms << "ms)"
+                              << std::endl;
+                }
+            }
+        } catch (...) {
+            std::lock_guard<std::mutex> lock(state_mutex);
+            if (!failure) failure = std::current_exception();
+            next_game.store(num_games);  // Stop other workers
         }
-        
-        // Play single game
-        core::Board initial_position; // Standard starting position
-        GameResult game_result = play_single_game(
-            player1, player2, initial_position, player1_is_black, limits, config
-        );
-        
+    };
+    
+    std::vector<std::thread> pool;
+    pool.reserve(num_threads - 1);
+    for (int i = 1; i < num_threads; ++i) {
+        pool.emplace_back(worker, i);
+    }
+    worker(0);
+    for (auto& t : pool) t.join();
+    
+    if (failure) std::rethrow_exception(failure);
+    
+    // Games scheduled past the SPRT decision are discarded (keeps results
+    // independent of thread count)
+    if (stop_at < num_games) {
+        result.games.resize(stop_at);
+        result.stopped_early = true;
+    }
+    
+    summarize(result);
+    return result;
+}
+
+MatchEngine::GameResult MatchEngine::play_indexed_game(
+    const std::shared_ptr<ai::AIStrategy>& player1,
+    const std::shared_ptr<ai::AIStrategy>& player2,
+    int game,
+    uint32_t match_seed,
+    const MatchConfig& config
+) {
+    bool alternate = config.alternate_colors || config.use_sprt;
+    bool player1_is_black = !alternate || (game % 2 == 0);
+    player1->set_seed(game_seed(match_seed, game, 1));
+    player2->set_seed(game_seed(match_seed, game, 2));
+    
+    core::Board initial_position = make_opening(match_seed, game / 2, config.opening_plies);
+    return play_single_game(player1, player2, initial_position, player1_is_black, config.limits, config);
+}
+
+void MatchEngine::summarize(MatchResult& result) {
+    result.player1_wins = result.player2_wins = result.draws = 0;
+    result.game_lengths.clear();
+    result.score_diffs.clear();
+    result.durations.clear();
+    result.avg_player1_nodes = result.avg_player2_nodes = 0.0;
+    result.avg_player1_time_ms = result.avg_player2_time_ms = 0.0;
+    
+    for (const GameResult& game_result : result.games) {
         // Update match statistics
         if (game_result.winner == 1) {
             result.player1_wins++;
@@ -68,21 +270,12 @@ MatchEngine::MatchResult MatchEngine::play_match(
         result.game_lengths.push_back(game_result.move_count);
         result.score_diffs.push_back(game_result.final_score_diff);
         result.durations.push_back(game_result.duration_ms);
-        result.games.push_back(game_result);
         
         // Accumulate performance metrics
         result.avg_player1_nodes += game_result.player1_nodes;
         result.avg_player2_nodes += game_result.player2_nodes;
         result.avg_player1_time_ms += game_result.player1_time_ms;
         result.avg_player2_time_ms += game_result.player2_time_ms;
-        
-        if (config.verbose) {
-            std::cout << "Winner: " << (game_result.winner == 1 ? result.player1_name :
-                                        game_result.winner == -1 ? result.player2_name : "Draw")
-                      << " (" << game_result.move_count << " moves, "
-                      << std::fixed << std::setprecision(1) << game_result.duration_ms << "ms)"
-                      << std::endl;
-        }
     }
     
     // Calculate averages
@@ -104,8 +297,6 @@ MatchEngine::MatchResult MatchEngine::play_match(
         result.avg_player1_time_ms /= total_games;
         result.avg_player2_time_ms /= total_games;
     }
-    
-    return result;
 }
 
 MatchEngine::GameResult MatchEngine::play_single_game(
@@ -116,6 +307,7 @@ MatchEngine::GameResult MatchEngine::play_single_game(
     const ai::SearchLimits& limits,
     const MatchConfig& config
 ) {
+    REVERSI_TRACE("match", "game");
     GameResult result;
     result.player1_was_black = player1_is_black;
     
@@ -140,16 +332,18 @@ MatchEngine::GameResult MatchEngine::play_single_game(
         }
         
         // Determine which AI to use
-        // In Reversi, black moves first, then white
-        // We track: if player1_is_black, then move_count % 2 == 0 means black's turn
-        bool is_black_turn = (move_count % 2 == 0);
+        // Side to move is tracked by the board (side 0 = black), so openings
+        // with either colour to move are handled
+        bool is_black_turn = (board.side_to_move() == 0);
         bool use_player1 = (player1_is_black == is_black_turn);
         
         std::shared_ptr<ai::AIStrategy> current_strategy = use_player1 ? player1 : player2;
         
         // Execute move
         auto move_start = std::chrono::high_resolution_clock::now();
-        int move_pos = execute_move(board, current_strategy, limits, config.collect_move_history);
+        const ai::SearchLimits& current_limits =
+            (use_player1 || !config.player2_limits) ? limits : *config.player2_limits;
+        int move_pos = execute_move(board, current_strategy, current_limits, config.collect_move_history);
         auto move_end = std::chrono::high_resolution_clock::now();
         double move_time_ms = std::chrono::duration<double, std::milli>(move_end - move_start).count();
         
@@ -192,38 +386,19 @@ MatchEngine::GameResult MatchEngine::play_single_game(
     int player_count = board.count_player();
     int opponent_count = board.count_opponent();
     
-    // Determine winner based on final counts and who was black
-    // At game end, we know:
-    // - player1_is_black tells us who started as black
-    // - move_count tells us who made the last move (even = black's turn, odd = white's turn)
-    // - player_count/opponent_count are the final piece counts
-    
-    // Determine which color (black/white) has more pieces
-    // If move_count is even, current player is the one who started (black if player1_is_black)
-    bool last_move_was_black = (move_count % 2 == 0);
-    bool last_player_was_player1 = (player1_is_black == last_move_was_black);
+    // The side to move at the end owns player_count (side 0 = black)
+    bool side_to_move_is_black = (board.side_to_move() == 0);
+    bool side_to_move_is_player1 = (player1_is_black == side_to_move_is_black);
     
     // Calculate score difference from player1's perspective
-    if (last_player_was_player1) {
-        // Last move was by player1, so player_count is player1's count
-        result.final_score_diff = player_count - opponent_count;
-        if (player_count > opponent_count) {
-            result.winner = 1; // player1 wins
-        } else if (player_count < opponent_count) {
-            result.winner = -1; // player2 wins
-        } else {
-            result.winner = 0; // draw
-        }
+    result.final_score_diff = side_to_move_is_player1 ? (player_count - opponent_count)
+                                                      : (opponent_count - player_count);
+    if (result.final_score_diff > 0) {
+        result.winner = 1; // player1 wins
+    } else if (result.final_score_diff < 0) {
+        result.winner = -1; // player2 wins
     } else {
-        // Last move was by player2, so opponent_count is player1's count
-        result.final_score_diff = opponent_count - player_count;
-        if (opponent_count > player_count) {
-            result.winner = 1; // player1 wins
-        } else if (opponent_count < player_count) {
-            result.winner = -1; // player2 wins
-        } else {
-            result.winner = 0; // draw
-        }
+        result.winner = 0; // draw
     }
     
     return result;
@@ -246,6 +421,7 @@ int MatchEngine::execute_move(
     const ai::SearchLimits& limits,
     bool collect_history
 ) {
+    REVERSI_TRACE("match", "move");
     std::vector<int> legal_moves;
     board.get_legal_moves(legal_moves);
     
@@ -4,6 +4,8 @@
  * 
  * High-quality match engine for AI vs AI comparisons
  * Supports color alternation, statistics collection, and best-of-N series
+ * Games can be spread over a thread pool; each worker owns its engines
+ * Optional SPRT early stopping over game pairs (same opening, colours swapped)
  * 
  * Author: Tianqixing
  * Student ID: 201821852
@@ -14,11 +16,14 @@
 #include "../../ai/AIStrategy.hpp"
 #include "../../core/Board.hpp"
 #include "../../core/Move.hpp"
+#include "Statistics.hpp"
 #include <string>
 #include <vector>
 #include <memory>
 #include <chrono>
 #include <cstdint>
+#include <functional>
+#include <optional>
 
 namespace reversi {
 namespace research {
@@ -31,9 +36,23 @@ namespace research {
  * - Color alternation (eliminates first-move advantage)
  * - Detailed statistics collection
  * - Performance metrics tracking
+ * - Parallel game scheduling (per-thread engine instances)
+ * 
+ * Game i always uses the same colours and engine seeds (derived from
+ * random_seed and i), so results are identical for any thread count as
+ * long as the search limits are deterministic (depth/node limits).
+ * 
+ * Games 2k and 2k+1 form a pair: same opening, colours swapped. With SPRT
+ * enabled the match stops at the first completed pair (in game order)
+ * where the test accepts H0 or H1; num_games is then the maximum.
  */
 class MatchEngine {
 public:
+    /**
+     * @brief Creates a fresh engine instance for one worker thread
+     */
+    using StrategyFactory = std::function<std::unique_ptr<ai::AIStrategy>()>;
+    
     /**
      * @brief Match configuration
      */
@@ -45,8 +64,17 @@ public:
         uint32_t random_seed = 0;        ///< Random seed (0 = use time)
         bool verbose = false;            ///< Verbose output
         bool collect_move_history = false; ///< Collect detailed move history
+        int num_threads = 1;             ///< Worker threads (0 = all cores, 1 = sequential)
+        ai::SearchLimits limits{6, 5000}; ///< Search limits for player1 (and player2 unless set)
+        std::optional<ai::SearchLimits> player2_limits; ///< Separate limits for player2
+        int opening_plies = 0;           ///< Random plies per pair opening (0 = standard start)
+        
+        // SPRT early stopping (forces alternating colours)
+        bool use_sprt = false;           ///< Stop when SPRT accepts H0 or H1
+        Statistics::SPRTConfig sprt;     ///< SPRT hypotheses (Elo bounds) and error rates
+        int sprt_report_every = 10;      ///< Print LLR every N pairs (0 = silent)
         
-        MatchConfig() = default;
+        MatchConfig() {}
         MatchConfig(int games, bool alt_colors = true)
             : num_games(games), alternate_colors(alt_colors) {}
     };
@@ -93,6 +121,7 @@ public:
     struct MatchResult {
         std::string player1_name;           ///< Name of player1 algorithm
         std::string player2_name;           ///< Name of player2 algorithm
+        uint32_t random_seed = 0;           ///< Seed actually used (reproduces the match)
         int player1_wins = 0;               ///< Number of wins for player1
         int player2_wins = 0;               ///< Number of wins for player2
         int draws = 0;                      ///< Number of draws
@@ -115,6 +144,10 @@ public:
         // Individual game results
         std::vector<GameResult> games;      ///< Detailed results for each game
         
+        // SPRT (valid when MatchConfig::use_sprt)
+        Statistics::SPRTResult sprt;        ///< Final SPRT state over completed pairs
+        bool stopped_early = false;         ///< SPRT decided before num_games
+        
         /**
          * @brief Calculate total games played
          */
@@ -137,6 +170,23 @@ public:
         const MatchConfig& config = MatchConfig()
     );
     
+    /**
+     * @brief Play a match with engines created per worker thread
+     * 
+     * Each worker calls the factories once and reuses its engines for all
+     * games it plays. Results are stored in game order.
+     * 
+     * @param player1_factory Creates player1 instances
+     * @param player2_factory Creates player2 instances
+     * @param config Match configuration (num_threads selects parallelism)
+     * @return Complete match result with statistics
+     */
+    static MatchResult play_match(
+        const StrategyFactory& player1_factory,
+        const StrategyFactory& player2_factory,
+        const MatchConfig& config = MatchConfig()
+    );
+    
     /**
      * @brief Play a single game between two AI strategies
      * 
@@ -144,7 +194,7 @@ public:
      * @param player2 Second AI strategy
      * @param initial_position Starting board position
      * @param player1_is_black Whether player1 plays as black
-     * @param limits Search limits for both players
+     * @param limits Search limits (player1; player2 too unless config.player2_limits)
      * @param config Match configuration
      * @return Game result
      */
@@ -168,7 +218,61 @@ public:
         const MatchConfig& config = MatchConfig()
     );
     
+    /**
+     * @brief Engine seed for one side of one game
+     * 
+     * @param match_seed MatchResult::random_seed
+     * @param game Game index (0-based)
+     * @param player 1 or 2
+     */
+    static uint64_t game_seed(uint32_t match_seed, int game, int player);
+    
+    /**
+     * @brief Opening position for a game pair
+     * 
+     * Plays `plies` uniformly random legal moves from the standard start,
+     * seeded by (match_seed, pair). Both games of a pair start here.
+     */
+    static core::Board make_opening(uint32_t match_seed, int pair, int plies);
+    
+    /**
+     * @brief Pentanomial index (0-4) of a pair: player1's points x 2
+     */
+    static int pair_points(const GameResult& first, const GameResult& second);
+    
 private:
+    /// Engines used by one worker (shared_ptr so callers may lend theirs)
+    using EnginePair = std::pair<std::shared_ptr<ai::AIStrategy>, std::shared_ptr<ai::AIStrategy>>;
+    
+    /**
+     * @brief Common match loop: schedules games over num_threads workers
+     * 
+     * @param make_engines Called once per worker for its engines
+     * @param num_threads Worker count (already resolved)
+     * @param config Match configuration
+     */
+    static MatchResult run_match(
+        const std::function<EnginePair()>& make_engines,
+        int num_threads,
+        const MatchConfig& config
+    );
+    
+    /**
+     * @brief Play game `game` of a match with the given engines
+     */
+    static GameResult play_indexed_game(
+        const std::shared_ptr<ai::AIStrategy>& player1,
+        const std::shared_ptr<ai::AIStrategy>& player2,
+        int game,
+        uint32_t match_seed,
+        const MatchConfig& config
+    );
+    
+    /**
+     * @brief Fill win counts and averages from result.games
+     */
+    static void summarize(MatchResult& result);
+    
     /**
      * @brief Execute one move in a game
      * 
@@ -7,6 +7,7 @@
  */
 
 #include "PositionSuite.hpp"
+#include "../data/PositionFile.hpp"
 #include <random>
 #include <chrono>
 #include <algorithm>
@@ -189,6 +190,20 @@ int PositionSuite::get_random_move(const core::Board& board, std::mt19937& rng)
     return legal_moves[dist(rng)];
 }
 
+std::vector<core::Board> PositionSuite::load_file(const std::string& path, int max_count) {
+    std::vector<PositionFile::Position> loaded;
+    PositionFile::load(path, loaded);
+    size_t n = loaded.size();
+    if (max_count > 0) n = std::min(n, static_cast<size_t>(max_count));
+    
+    std::vector<core::Board> positions;
+    positions.reserve(n);
+    for (size_t i = 0; i < n; ++i) {
+        positions.push_back(loaded[i].board());
+    }
+    return positions;
+}
+
 } // namespace research
 } // namespace reversi
 
@@ -138,20 +138,32 @@ public:
      */
     static std::vector<core::Board> generate_standard_64(uint32_t seed = 0);
     
+    /**
+     * @brief Load a standard suite from an OBF / FFO file
+     * 
+     * One position per line ("<64 squares> <side>; ..."), in file order
+     * 
+     * @param path Suite file
+     * @param max_count Keep at most this many positions (0 = all)
+     * @return Positions (empty if the file cannot be read)
+     */
+    static std::vector<core::Board> load_file(const std::string& path, int max_count = 0);
+    
 private:
-    // Internal helpers implemented in PositionSuite.cpp (not exposed here to avoid
-    // depending on <random> in the header).
-};
-
-} // namespace research
-} // namespace reversi
-
-
+    /**
+     * @brief Play random legal moves (passing when required) from a position
+     */
+    static core::Board play_random_moves(
+        const core::Board& board,
+        int num_moves,
+        std::mt19937& rng
+    );
+    
+    /**
+     * @brief Pick a uniformly random legal move, or -1 if the side must pass
      */
     static int get_random_move(const core::Board& board, std::mt19937& rng);
 };
 
 } // namespace research
 } // namespace reversi
-
-
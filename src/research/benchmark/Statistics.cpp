@@ -64,6 +64,12 @@ Statistics::StatsResult Statistics::calculate(const std::vector<int>& data) {
     return calculate(double_data);
 }
 
+Statistics::StatsResult Statistics::calculate(const std::vector<uint64_t>& data) {
+    // Convert to double vector
+    std::vector<double> double_data(data.begin(), data.end());
+    return calculate(double_data);
+}
+
 std::string Statistics::format_mean_std(
     const StatsResult& stats,
     int precision
@@ -127,6 +133,41 @@ std::pair<double, double> Statistics::calculate_confidence_interval(
     return {mean - margin, mean + margin};
 }
 
+Statistics::TTestResult Statistics::welch_t_test(
+    const std::vector<double>& a,
+    const std::vector<double>& b,
+    double confidence_level
+) {
+    TTestResult result;
+    if (a.size() < 2 || b.size() < 2) {
+        return result;
+    }
+    
+    const double na = static_cast<double>(a.size());
+    const double nb = static_cast<double>(b.size());
+    const double mean_a = std::accumulate(a.begin(), a.end(), 0.0) / na;
+    const double mean_b = std::accumulate(b.begin(), b.end(), 0.0) / nb;
+    const double sa = calculate_std_dev(a, mean_a);
+    const double sb = calculate_std_dev(b, mean_b);
+    const double va = sa * sa / na;
+    const double vb = sb * sb / nb;
+    result.difference = mean_b - mean_a;
+    
+    if (va + vb <= 0.0) {
+        // No noise at all: any difference is real
+        result.significant = result.difference != 0.0;
+        result.degrees_of_freedom = na + nb - 2.0;
+        return result;
+    }
+    
+    result.t = result.difference / std::sqrt(va + vb);
+    const double denom = (na > 1 ? va * va / (na - 1.0) : 0.0) + (nb > 1 ? vb * vb / (nb - 1.0) : 0.0);
+    result.degrees_of_freedom = denom > 0.0 ? (va + vb) * (va + vb) / denom : na + nb - 2.0;
+    const int df = std::max(1, static_cast<int>(result.degrees_of_freedom));
+    result.significant = std::abs(result.t) > t_value(confidence_level, df);
+    return result;
+}
+
 double Statistics::t_value(double confidence_level, int degrees_of_freedom) {
     // For large samples (df >= 30), use normal distribution approximation (z = 1.96 for 95%)
     if (degrees_of_freedom >= 30) {
@@ -152,6 +193,195 @@ double Statistics::t_value(double confidence_level, int degrees_of_freedom) {
     return z_value * correction;
 }
 
+double Statistics::score_to_elo(double score) {
+    // Clamp away from 0/1 where Elo diverges
+    score = std::clamp(score, 1e-6, 1.0 - 1e-6);
+    return -400.0 * std::log10(1.0 / score - 1.0);
+}
+
+const char* Statistics::SPRTResult::decision_name() const {
+    switch (decision) {
+        case SPRTDecision::ACCEPT_H0: return "H0";
+        case SPRTDecision::ACCEPT_H1: return "H1";
+        default: return "continue";
+    }
+}
+
+Statistics::SPRTResult Statistics::sprt_pentanomial(
+    const std::array<int, 5>& pentanomial,
+    const SPRTConfig& config
+) {
+    SPRTResult result;
+    result.pentanomial = pentanomial;
+    result.lower_bound = std::log(config.beta / (1.0 - config.alpha));
+    result.upper_bound = std::log((1.0 - config.beta) / config.alpha);
+    
+    int pairs = 0;
+    for (int c : pentanomial) pairs += c;
+    result.pairs = pairs;
+    if (pairs == 0) {
+        return result;
+    }
+    
+    // Empirical pair-score distribution. Empty cells get a tiny count so a
+    // short run of identical pairs does not produce zero variance.
+    constexpr double scores[5] = {0.0, 0.25, 0.5, 0.75, 1.0};
+    constexpr double EPSILON = 1e-3;
+    double total = 0.0;
+    double probs[5];
+    for (int i = 0; i < 5; ++i) {
+        probs[i] = pentanomial[i] > 0 ? pentanomial[i] : EPSILON;
+        total += probs[i];
+    }
+    double mean = 0.0;
+    for (int i = 0; i < 5; ++i) {
+        probs[i] /= total;
+        mean += probs[i] * scores[i];
+    }
+    double variance = 0.0;
+    for (int i = 0; i < 5; ++i) {
+        double d = scores[i] - mean;
+        variance += probs[i] * d * d;
+    }
+    
+    // GSPRT: LLR = (s1 - s0) * (2 * mean - s0 - s1) / (2 * var / N)
+    double s0 = elo_to_score(config.elo0);
+    double s1 = elo_to_score(config.elo1);
+    double variance_of_mean = variance / pairs;
+    result.llr = (s1 - s0) * (2.0 * mean - s0 - s1) / (2.0 * variance_of_mean);
+    
+    if (pairs < config.min_pairs) {
+        // Keep CONTINUE; the LLR is still reported
+    } else if (result.llr >= result.upper_bound) {
+        result.decision = SPRTDecision::ACCEPT_H1;
+    } else if (result.llr <= result.lower_bound) {
+        result.decision = SPRTDecision::ACCEPT_H0;
+    }
+    
+    // Elo estimate with delta-method 95% interval
+    result.score = mean;
+    result.elo = score_to_elo(mean);
+    double stderr_score = std::sqrt(variance_of_mean);
+    double upper = score_to_elo(mean + 1.96 * stderr_score);
+    double lower = score_to_elo(mean - 1.96 * stderr_score);
+    result.elo_ci95 = (upper - lower) / 2.0;
+    
+    return result;
+}
+
+std::vector<Statistics::EloEstimate> Statistics::maximum_likelihood_elo(
+    const std::vector<std::vector<double>>& points,
+    const std::vector<std::vector<double>>& games,
+    double prior_draws
+) {
+    const size_t n = games.size();
+    std::vector<EloEstimate> result(n);
+    if (n < 2) {
+        return result;
+    }
+    
+    // A zero or perfect score has no finite maximum (gamma -> 0 or infinity):
+    // without a prior, those players' pairings still get one virtual draw
+    std::vector<bool> extreme(n, false);
+    for (size_t i = 0; i < n; ++i) {
+        double scored = 0.0, played = 0.0;
+        for (size_t j = 0; j < n; ++j) {
+            if (i == j || games[i][j] <= 0.0) continue;
+            scored += points[i][j];
+            played += games[i][j];
+        }
+        extreme[i] = played > 0.0 && (scored <= 0.0 || scored >= played);
+    }
+    
+    // Games and points including the prior
+    std::vector<std::vector<double>> g(n, std::vector<double>(n, 0.0));
+    std::vector<double> total_points(n, 0.0);
+    std::vector<bool> active(n, false);
+    for (size_t i = 0; i < n; ++i) {
+        for (size_t j = 0; j < n; ++j) {
+            if (i == j || games[i][j] <= 0.0) continue;
+            double prior = std::max(prior_draws, 0.0);
+            if (extreme[i] || extreme[j]) prior = std::max(prior, 1.0);
+            g[i][j] = games[i][j] + prior;
+            total_points[i] += points[i][j] + 0.5 * prior;
+            active[i] = true;
+        }
+    }
+    
+    // MM iteration (Hunter 2004): gamma_i = W_i / sum_j n_ij / (gamma_i + gamma_j)
+    std::vector<double> gamma(n, 1.0);
+    for (int iter = 0; iter < 10000; ++iter) {
+        double max_change = 0.0;
+        for (size_t i = 0; i < n; ++i) {
+            if (!active[i]) continue;
+            double denom = 0.0;
+            for (size_t j = 0; j < n; ++j) {
+                if (g[i][j] > 0.0) denom += g[i][j] / (gamma[i] + gamma[j]);
+            }
+            double updated = total_points[i] / denom;
+            max_change = std::max(max_change, std::abs(std::log(updated / gamma[i])));
+            gamma[i] = updated;
+        }
+        // Renormalise (geometric mean 1) so the scale stays bounded
+        double log_mean = 0.0;
+        int count = 0;
+        for (size_t i = 0; i < n; ++i) {
+            if (active[i]) { log_mean += std::log(gamma[i]); ++count; }
+        }
+        log_mean /= count;
+        for (size_t i = 0; i < n; ++i) {
+            if (active[i]) gamma[i] /= std::exp(log_mean);
+        }
+        if (max_change < 1e-10) break;
+    }
+    
+    // Fisher information in natural-log rating units. H has the constant
+    // vector in its null space; (H + J/m)^-1 - J/m is its pseudo-inverse,
+    // i.e. the covariance of the mean-centred ratings.
+    std::vector<size_t> idx;
+    for (size_t i = 0; i < n; ++i) {
+        if (active[i]) idx.push_back(i);
+    }
+    const size_t m = idx.size();
+    std::vector<std::vector<double>> a(m, std::vector<double>(2 * m, 0.0));
+    for (size_t r = 0; r < m; ++r) {
+        for (size_t c = 0; c < m; ++c) {
+            if (r == c) continue;
+            size_t i = idx[r], j = idx[c];
+            double p = gamma[i] / (gamma[i] + gamma[j]);
+            double info = g[i][j] * p * (1.0 - p);
+            a[r][c] -= info;
+            a[r][r] += info;
+        }
+        for (size_t c = 0; c < m; ++c) a[r][c] += 1.0 / m;
+        a[r][m + r] = 1.0;
+    }
+    // Gauss-Jordan with partial pivoting
+    for (size_t col = 0; col < m; ++col) {
+        size_t pivot = col;
+        for (size_t r = col + 1; r < m; ++r) {
+            if (std::abs(a[r][col]) > std::abs(a[pivot][col])) pivot = r;
+        }
+        std::swap(a[col], a[pivot]);
+        double d = a[col][col];
+        if (std::abs(d) < 1e-300) continue;
+        for (double& v : a[col]) v /= d;
+        for (size_t r = 0; r < m; ++r) {
+            if (r == col || a[r][col] == 0.0) continue;
+            double f = a[r][col];
+            for (size_t c = 0; c < 2 * m; ++c) a[r][c] -= f * a[col][c];
+        }
+    }
+    
+    const double to_elo = 400.0 / std::log(10.0);
+    for (size_t r = 0; r < m; ++r) {
+        double variance = std::max(0.0, a[r][m + r] - 1.0 / m);
+        result[idx[r]].elo = std::log(gamma[idx[r]]) * to_elo;
+        result[idx[r]].elo_ci95 = 1.96 * std::sqrt(variance) * to_elo;
+    }
+    return result;
+}
+
 double Statistics::calculate_median(const std::vector<double>& sorted_data) {
     size_t n = sorted_data.size();
     if (n == 0) {
@@ -17,6 +17,7 @@
 #include <numeric>
 #include <cmath>
 #include <cstdint>
+#include <array>
 
 namespace reversi {
 namespace research {
@@ -29,6 +30,8 @@ namespace research {
  * - 95% confidence intervals
  * - Min, max, quartiles
  * - Formatted output for academic reports
+ * - Sequential probability ratio test (SPRT) for match early stopping
+ * - Maximum-likelihood Elo ratings for multi-engine tournaments
  */
 class Statistics {
 public:
@@ -53,6 +56,111 @@ public:
         }
     };
     
+    /**
+     * @brief SPRT hypotheses and error rates
+     * 
+     * H0: Elo difference = elo0, H1: Elo difference = elo1 (logistic Elo,
+     * player1's perspective). alpha/beta are the false positive/negative rates.
+     */
+    struct SPRTConfig {
+        double elo0 = 0.0;   ///< Elo under H0
+        double elo1 = 10.0;  ///< Elo under H1
+        double alpha = 0.05; ///< Type I error (accept H1 when H0 true)
+        double beta = 0.05;  ///< Type II error (accept H0 when H1 true)
+        int min_pairs = 10;  ///< No decision before this many pairs (variance estimate too noisy)
+        
+        SPRTConfig() {}
+        SPRTConfig(double e0, double e1, double a = 0.05, double b = 0.05)
+            : elo0(e0), elo1(e1), alpha(a), beta(b) {}
+    };
+    
+    /**
+     * @brief SPRT decision state
+     */
+    enum class SPRTDecision {
+        CONTINUE,   ///< LLR between bounds: play more games
+        ACCEPT_H0,  ///< LLR <= lower bound
+        ACCEPT_H1   ///< LLR >= upper bound
+    };
+    
+    /**
+     * @brief SPRT evaluation over game pairs
+     */
+    struct SPRTResult {
+        double llr = 0.0;          ///< Log-likelihood ratio
+        double lower_bound = 0.0;  ///< ln(beta / (1 - alpha))
+        double upper_bound = 0.0;  ///< ln((1 - beta) / alpha)
+        SPRTDecision decision = SPRTDecision::CONTINUE;
+        int pairs = 0;             ///< Game pairs counted
+        double score = 0.5;        ///< Mean score per game (0.0-1.0)
+        double elo = 0.0;          ///< Elo estimate from score
+        double elo_ci95 = 0.0;     ///< 95% half-width of the Elo estimate
+        std::array<int, 5> pentanomial{}; ///< Pairs scoring 0, 0.5, 1, 1.5, 2 points
+        
+        /**
+         * @brief Short label for the decision ("H0", "H1", "continue")
+         */
+        const char* decision_name() const;
+    };
+    
+    /**
+     * @brief Pentanomial SPRT (GSPRT normal approximation)
+     * 
+     * Each game pair (same opening, colours swapped) is one sample with
+     * score 0, 0.25, 0.5, 0.75 or 1 per game. Pairing cancels most of
+     * the opening bias, so the pair variance is lower than the per-game
+     * (trinomial) variance and the test stops sooner.
+     * 
+     * @param pentanomial Pair counts by points scored (0, 0.5, 1, 1.5, 2)
+     * @param config Hypotheses and error rates
+     * @return LLR, bounds, decision and Elo estimate
+     */
+    static SPRTResult sprt_pentanomial(
+        const std::array<int, 5>& pentanomial,
+        const SPRTConfig& config
+    );
+    
+    /**
+     * @brief Rating of one player from maximum_likelihood_elo()
+     */
+    struct EloEstimate {
+        double elo = 0.0;      ///< Elo relative to the field mean
+        double elo_ci95 = 0.0; ///< 95% half-width
+    };
+    
+    /**
+     * @brief Maximum-likelihood (Bradley-Terry) Elo for N players
+     * 
+     * Draws count as half a win. Ratings are solved with the MM iteration
+     * and centred on mean 0; error bars come from the inverse Fisher
+     * information under the same centring. `prior_draws` virtual draws are
+     * added to every pairing that was played so that a perfect score still
+     * has a finite rating. With prior_draws <= 0, pairings of a player
+     * with a zero or perfect score still get one virtual draw.
+     * 
+     * @param points points[i][j] = points player i scored against j
+     * @param games games[i][j] = games between i and j (symmetric)
+     * @param prior_draws Virtual draws per played pairing
+     * @return One estimate per player
+     */
+    static std::vector<EloEstimate> maximum_likelihood_elo(
+        const std::vector<std::vector<double>>& points,
+        const std::vector<std::vector<double>>& games,
+        double prior_draws = 1.0
+    );
+    
+    /**
+     * @brief Expected score for an Elo difference (logistic model)
+     */
+    static double elo_to_score(double elo) {
+        return 1.0 / (1.0 + std::pow(10.0, -elo / 400.0));
+    }
+    
+    /**
+     * @brief Elo difference for an expected score in (0, 1)
+     */
+    static double score_to_elo(double score);
+    
     /**
      * @brief Calculate statistics from double vector
      * 
@@ -69,6 +177,14 @@ public:
      */
     static StatsResult calculate(const std::vector<int>& data);
     
+    /**
+     * @brief Calculate statistics from 64-bit counter vector (node counts)
+     * 
+     * @param data Input data vector
+     * @return Statistical result
+     */
+    static StatsResult calculate(const std::vector<uint64_t>& data);
+    
     /**
      * @brief Format as "mean ± std_dev" (academic format)
      * 
@@ -121,6 +237,28 @@ public:
         int sample_size
     );
     
+    /**
+     * @brief Welch's unequal-variance t-test of mean(b) - mean(a)
+     */
+    struct TTestResult {
+        double difference = 0.0;        ///< mean(b) - mean(a)
+        double t = 0.0;                 ///< t statistic
+        double degrees_of_freedom = 0.0; ///< Welch-Satterthwaite estimate
+        bool significant = false;       ///< |t| exceeds the critical value
+    };
+    
+    /**
+     * @brief Two-sided Welch t-test (e.g. baseline vs current benchmark samples)
+     * 
+     * @param confidence_level 0.90, 0.95 or 0.99 (see t_value)
+     * @return Not significant if either sample has fewer than 2 values
+     */
+    static TTestResult welch_t_test(
+        const std::vector<double>& a,
+        const std::vector<double>& b,
+        double confidence_level = 0.95
+    );
+    
     /**
      * @brief Calculate t-value for given confidence level and degrees of freedom
      * 
@@ -0,0 +1,385 @@
+/*
+ * Tournament.cpp - Multi-engine round-robin / gauntlet tournaments
+ * COMP390 Honours Year Project
+ *
+ * Author: Tianqixing
+ * Student ID: 201821852
+ */
+
+#include "Tournament.hpp"
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+#include <random>
+#include <algorithm>
+#include <unordered_set>
+#include <atomic>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <chrono>
+
+namespace reversi {
+namespace research {
+
+Tournament::Tournament(std::vector<EngineSpec> engines, const Config& config)
+    : engines_(std::move(engines)), config_(config)
+{
+    const int n = static_cast<int>(engines_.size());
+    if (config_.format == Format::GAUNTLET) {
+        for (int b = 1; b < n; ++b) pairings_.emplace_back(0, b);
+    } else {
+        for (int a = 0; a < n; ++a) {
+            for (int b = a + 1; b < n; ++b) pairings_.emplace_back(a, b);
+        }
+    }
+    openings_ = make_opening_set(config_.seed, config_.num_openings, config_.opening_plies);
+}
+
+int Tournament::scheduled_games() const {
+    return std::max(0, config_.rounds) * static_cast<int>(openings_.size()) *
+           static_cast<int>(pairings_.size()) * 2;
+}
+
+Tournament::GameRecord Tournament::schedule(int game) const {
+    // game = ((round * openings + opening) * pairings + pairing) * 2 + colour
+    const int num_pairings = static_cast<int>(pairings_.size());
+    const int num_openings = static_cast<int>(openings_.size());
+    GameRecord r;
+    r.game = game;
+    int colour = game % 2;
+    int rest = game / 2;
+    int pairing = rest % num_pairings;
+    rest /= num_pairings;
+    r.opening = rest % num_openings;
+    r.engine_a = pairings_[pairing].first;
+    r.engine_b = pairings_[pairing].second;
+    r.a_is_black = (colour == 0);
+    return r;
+}
+
+std::vector<core::Board> Tournament::make_opening_set(uint32_t seed, int count, int plies) {
+    std::vector<core::Board> openings;
+    if (count <= 0) return openings;
+    if (plies <= 0) {
+        openings.emplace_back();
+        return openings;
+    }
+
+    std::mt19937_64 rng(MatchEngine::game_seed(seed, 0, 0) ^ 0x5DEECE66DULL);
+    std::unordered_set<uint64_t> seen;
+    std::vector<int> moves;
+    const int max_attempts = count * 50;
+    for (int attempt = 0; attempt < max_attempts && static_cast<int>(openings.size()) < count; ++attempt) {
+        core::Board board;
+        for (int ply = 0; ply < plies; ++ply) {
+            moves.clear();
+            board.get_legal_moves(moves);
+            if (moves.empty()) {
+                if (board.is_terminal()) break;
+                board.pass();
+                continue;
+            }
+            std::uniform_int_distribution<size_t> dist(0, moves.size() - 1);
+            board.make_move(moves[dist(rng)]);
+        }
+        if (board.is_terminal() || !seen.insert(board.hash()).second) continue;
+        openings.push_back(board);
+    }
+    return openings;
+}
+
+std::string Tournament::header_line() const {
+    std::ostringstream out;
+    out << "# reversi-tournament v1"
+        << " format=" << (config_.format == Format::GAUNTLET ? "gauntlet" : "roundrobin")
+        << " seed=" << config_.seed
+        << " openings=" << openings_.size()
+        << " plies=" << config_.opening_plies
+        << " rounds=" << config_.rounds
+        << " engines=";
+    for (size_t i = 0; i < engines_.size(); ++i) {
+        if (i > 0) out << ";";
+        out << engines_[i].name;
+    }
+    return out.str();
+}
+
+bool Tournament::load_results(std::vector<GameRecord>& records, std::vector<char>& done,
+                              std::string& error) const {
+    std::ifstream in(config_.results_file);
+    if (!in.is_open()) return true;  // Fresh run
+
+    std::string line;
+    if (!std::getline(in, line)) return true;  // Empty file
+    if (line != header_line()) {
+        error = "Results file " + config_.results_file +
+                " belongs to a different tournament:\n  file:    " + line +
+                "\n  current: " + header_line();
+        return false;
+    }
+
+    const int total = scheduled_games();
+    while (std::getline(in, line)) {
+        std::istringstream fields(line);
+        GameRecord r;
+        int a_black = 0;
+        if (!(fields >> r.game >> r.engine_a >> r.engine_b >> a_black >> r.opening
+                     >> r.a_points2 >> r.disc_diff >> r.move_count)) {
+            continue;  // Truncated by an interrupted write
+        }
+        r.a_is_black = (a_black != 0);
+        if (r.game < 0 || r.game >= total || done[r.game]) continue;
+        GameRecord expected = schedule(r.game);
+        if (expected.engine_a != r.engine_a || expected.engine_b != r.engine_b ||
+            expected.a_is_black != r.a_is_black || expected.opening != r.opening ||
+            r.a_points2 < 0 || r.a_points2 > 2) {
+            continue;
+        }
+        done[r.game] = 1;
+        records[r.game] = r;
+    }
+    return true;
+}
+
+Tournament::Result Tournament::run() {
+    Result result;
+    result.scheduled_games = scheduled_games();
+    const int total = result.scheduled_games;
+
+    std::vector<GameRecord> records(total);
+    std::vector<char> done(total, 0);
+
+    std::ofstream log;
+    if (!config_.results_file.empty()) {
+        if (!load_results(records, done, result.error)) {
+            std::cerr << "Error: " << result.error << std::endl;
+            return result;
+        }
+        bool fresh = std::none_of(done.begin(), done.end(), [](char d) { return d != 0; });
+        std::ifstream probe(config_.results_file, std::ios::binary);
+        bool has_header = probe.is_open() && probe.peek() != std::ifstream::traits_type::eof();
+        bool torn_tail = false;  // Last write interrupted before its newline
+        if (has_header) {
+            probe.seekg(-1, std::ios::end);
+            torn_tail = probe.get() != '\n';
+        }
+        probe.close();
+        log.open(config_.results_file, std::ios::app);
+        if (!log.is_open()) {
+            result.error = "Cannot open file " + config_.results_file + " for writing";
+            std::cerr << "Error: " << result.error << std::endl;
+            return result;
+        }
+        if (fresh && !has_header) {
+            log << header_line() << "\n" << std::flush;
+        } else if (torn_tail) {
+            log << "\n" << std::flush;
+        }
+    }
+
+    // Work list: unfinished games in schedule order
+    std::vector<int> pending;
+    pending.reserve(total);
+    for (int g = 0; g < total; ++g) {
+        if (!done[g]) pending.push_back(g);
+    }
+    result.resumed_games = total - static_cast<int>(pending.size());
+    if (config_.max_new_games > 0 && static_cast<int>(pending.size()) > config_.max_new_games) {
+        pending.resize(config_.max_new_games);
+    }
+    const int num_pending = static_cast<int>(pending.size());
+
+    int num_threads = config_.num_threads;
+    if (num_threads <= 0) {
+        num_threads = static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+    }
+    num_threads = std::max(1, std::min(num_threads, num_pending));
+
+    std::atomic<int> next{0};
+    std::mutex state_mutex;  // Guards records/done/log and console output
+    int finished = 0;
+    std::exception_ptr failure;
+    auto start = std::chrono::steady_clock::now();
+
+    auto worker = [&]() {
+        try {
+            // Engines are created on first use so a gauntlet worker only
+            // builds what it plays
+            std::vector<std::shared_ptr<ai::AIStrategy>> engines(engines_.size());
+            auto engine = [&](int i) -> const std::shared_ptr<ai::AIStrategy>& {
+                if (!engines[i]) engines[i] = std::shared_ptr<ai::AIStrategy>(engines_[i].factory());
+                return engines[i];
+            };
+            MatchEngine::MatchConfig game_config;
+
+            for (;;) {
+                int slot = next.fetch_add(1);
+                if (slot >= num_pending) break;
+                GameRecord r = schedule(pending[slot]);
+
+                const auto& a = engine(r.engine_a);
+                const auto& b = engine(r.engine_b);
+                a->set_seed(MatchEngine::game_seed(config_.seed, r.game, 1));
+                b->set_seed(MatchEngine::game_seed(config_.seed, r.game, 2));
+                game_config.limits = engines_[r.engine_a].limits;
+                game_config.player2_limits = engines_[r.engine_b].limits;
+
+                MatchEngine::GameResult g = MatchEngine::play_single_game(
+                    a, b, openings_[r.opening], r.a_is_black, game_config.limits, game_config);
+                r.a_points2 = g.winner + 1;
+                r.disc_diff = g.final_score_diff;
+                r.move_count = g.move_count;
+
+                std::lock_guard<std::mutex> lock(state_mutex);
+                records[r.game] = r;
+                done[r.game] = 1;
+                ++finished;
+                if (log.is_open()) {
+                    log << r.game << " " << r.engine_a << " " << r.engine_b << " "
+                        << (r.a_is_black ? 1 : 0) << " " << r.opening << " "
+                        << r.a_points2 << " " << r.disc_diff << " " << r.move_count << "\n"
+                        << std::flush;
+                }
+                if (config_.progress_every > 0 && finished % config_.progress_every == 0) {
+                    double secs = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+                    std::cout << "[Tournament] " << (result.resumed_games + finished) << "/" << total
+                              << " games (" << std::fixed << std::setprecision(1)
+                              << (secs > 0 ? finished / secs : 0.0) << " games/s)" << std::endl;
+                }
+            }
+        } catch (...) {
+            std::lock_guard<std::mutex> lock(state_mutex);
+            if (!failure) failure = std::current_exception();
+            next.store(num_pending);
+        }
+    };
+
+    std::vector<std::thread> pool;
+    pool.reserve(num_threads - 1);
+    for (int i = 1; i < num_threads; ++i) pool.emplace_back(worker);
+    worker();
+    for (auto& t : pool) t.join();
+    if (failure) std::rethrow_exception(failure);
+
+    result.played_games = finished;
+    result.games.reserve(result.resumed_games + finished);
+    for (int g = 0; g < total; ++g) {
+        if (done[g]) result.games.push_back(records[g]);
+    }
+    result.complete = static_cast<int>(result.games.size()) == total;
+
+    std::vector<std::string> names;
+    for (const auto& e : engines_) names.push_back(e.name);
+    result.standings = compute_standings(names, result.games, config_.prior_draws);
+    return result;
+}
+
+std::vector<Tournament::Standing> Tournament::compute_standings(
+    const std::vector<std::string>& names,
+    const std::vector<GameRecord>& games,
+    double prior_draws
+) {
+    const size_t n = names.size();
+    std::vector<Standing> standings(n);
+    std::vector<std::vector<double>> points(n, std::vector<double>(n, 0.0));
+    std::vector<std::vector<double>> played(n, std::vector<double>(n, 0.0));
+
+    for (size_t i = 0; i < n; ++i) {
+        standings[i].name = names[i];
+        standings[i].engine = static_cast<int>(i);
+    }
+    for (const GameRecord& r : games) {
+        size_t a = r.engine_a, b = r.engine_b;
+        double pa = r.a_points2 * 0.5;
+        points[a][b] += pa;
+        points[b][a] += 1.0 - pa;
+        played[a][b] += 1.0;
+        played[b][a] += 1.0;
+
+        standings[a].games++;
+        standings[b].games++;
+        if (r.a_points2 == 2) { standings[a].wins++; standings[b].losses++; }
+        else if (r.a_points2 == 0) { standings[a].losses++; standings[b].wins++; }
+        else { standings[a].draws++; standings[b].draws++; }
+    }
+
+    auto ratings = Statistics::maximum_likelihood_elo(points, played, prior_draws);
+    for (size_t i = 0; i < n; ++i) {
+        Standing& s = standings[i];
+        s.score = s.games > 0 ? (s.wins + 0.5 * s.draws) / s.games : 0.0;
+        s.elo = ratings[i].elo;
+        s.elo_ci95 = ratings[i].elo_ci95;
+    }
+    std::stable_sort(standings.begin(), standings.end(),
+                     [](const Standing& x, const Standing& y) { return x.elo > y.elo; });
+    return standings;
+}
+
+void Tournament::Result::print(std::ostream& out) const {
+    size_t width = 6;
+    for (const auto& s : standings) width = std::max(width, s.name.size());
+
+    out << "\n" << std::string(width + 60, '=') << "\n";
+    out << "Tournament standings (" << games.size() << "/" << scheduled_games << " games";
+    if (resumed_games > 0) out << ", " << resumed_games << " resumed";
+    out << ")\n";
+    out << std::string(width + 60, '=') << "\n";
+    out << std::left << std::setw(5) << "Rank" << std::setw(static_cast<int>(width) + 2) << "Engine"
+        << std::right << std::setw(8) << "Elo" << std::setw(9) << "+/-"
+        << std::setw(8) << "Games" << std::setw(7) << "W" << std::setw(7) << "D"
+        << std::setw(7) << "L" << std::setw(9) << "Score" << "\n";
+    out << std::string(width + 60, '-') << "\n";
+    int rank = 1;
+    for (const auto& s : standings) {
+        out << std::left << std::setw(5) << rank++ << std::setw(static_cast<int>(width) + 2) << s.name
+            << std::right << std::fixed << std::setprecision(1)
+            << std::setw(8) << s.elo << std::setw(9) << s.elo_ci95
+            << std::setw(8) << s.games << std::setw(7) << s.wins << std::setw(7) << s.draws
+            << std::setw(7) << s.losses << std::setw(8) << (s.score * 100.0) << "%\n";
+    }
+    out << std::string(width + 60, '=') << "\n";
+
+    // Cross-table in standings order: row engine's points / games against the column engine
+    const size_t n = standings.size();
+    std::vector<size_t> row(n, 0);
+    for (size_t r = 0; r < n; ++r) row[standings[r].engine] = r;
+    std::vector<std::vector<int>> points2(n, std::vector<int>(n, 0));
+    std::vector<std::vector<int>> played(n, std::vector<int>(n, 0));
+    for (const GameRecord& g : games) {
+        const size_t a = row[g.engine_a], b = row[g.engine_b];
+        points2[a][b] += g.a_points2;
+        points2[b][a] += 2 - g.a_points2;
+        played[a][b]++;
+        played[b][a]++;
+    }
+    out << "\nCross-table (row engine's points / games against the column engine)\n";
+    out << std::left << std::setw(5) << "" << std::setw(static_cast<int>(width) + 2) << "";
+    for (size_t c = 0; c < n; ++c) out << std::right << std::setw(11) << (c + 1);
+    out << "\n";
+    for (size_t r = 0; r < n; ++r) {
+        out << std::left << std::setw(5) << (r + 1) << std::setw(static_cast<int>(width) + 2) << standings[r].name
+            << std::right;
+        for (size_t c = 0; c < n; ++c) {
+            std::ostringstream cell;
+            if (r == c) {
+                cell << "-";
+            } else if (played[r][c] == 0) {
+                cell << ".";
+            } else {
+                cell << std::fixed << std::setprecision(1) << points2[r][c] * 0.5 << "/" << played[r][c];
+            }
+            out << std::setw(11) << cell.str();
+        }
+        out << "\n";
+    }
+
+    if (!complete) {
+        out << "(partial: rerun with the same results file to resume)\n";
+    }
+}
+
+} // namespace research
+} // namespace reversi
@@ -0,0 +1,182 @@
+/*
+ * Tournament.hpp - Multi-engine round-robin / gauntlet tournaments
+ * COMP390 Honours Year Project
+ *
+ * Schedules every pairing of N engine specs over a shared opening set,
+ * plays the games on a worker pool, appends each finished game to a
+ * results file (so an interrupted run resumes where it stopped) and
+ * rates the field with maximum-likelihood Elo.
+ *
+ * Author: Tianqixing
+ * Student ID: 201821852
+ */
+
+#pragma once
+
+#include "../../ai/AIStrategy.hpp"
+#include "../../core/Board.hpp"
+#include "MatchEngine.hpp"
+#include "Statistics.hpp"
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <ostream>
+
+namespace reversi {
+namespace research {
+
+/**
+ * @brief Round-robin or gauntlet tournament between engine specs
+ *
+ * Game g has a fixed meaning: round, opening, pairing and colour are all
+ * derived from g, and the engines are reseeded from (seed, g). With
+ * deterministic limits the result of each game is therefore independent
+ * of the thread count and of how many times the run was resumed.
+ *
+ * Schedule order is round -> opening -> pairing -> colour, so a partial
+ * run has played every pairing roughly equally often.
+ *
+ * Results file: a header line identifying the tournament, then one line
+ * per finished game. Lines are appended and flushed as games finish; a
+ * truncated last line is ignored on resume.
+ */
+class Tournament {
+public:
+    /**
+     * @brief One participant
+     */
+    struct EngineSpec {
+        std::string name;                    ///< Unique display name (also stored in the results file)
+        MatchEngine::StrategyFactory factory; ///< Creates an instance per worker
+        ai::SearchLimits limits{6, 0};       ///< Limits used for this engine's moves
+
+        EngineSpec() {}
+        EngineSpec(std::string n, MatchEngine::StrategyFactory f, ai::SearchLimits l)
+            : name(std::move(n)), factory(std::move(f)), limits(l) {}
+    };
+
+    enum class Format {
+        ROUND_ROBIN,  ///< Every engine plays every other engine
+        GAUNTLET      ///< Engine 0 plays every other engine
+    };
+
+    /**
+     * @brief Tournament configuration
+     */
+    struct Config {
+        Format format = Format::ROUND_ROBIN;
+        int num_openings = 50;       ///< Distinct openings (each played with both colours)
+        int opening_plies = 8;       ///< Random plies per opening
+        int rounds = 1;              ///< Repetitions of the whole opening set
+        uint32_t seed = 1;           ///< Openings and engine seeds
+        int num_threads = 0;         ///< Worker threads (0 = all cores)
+        std::string results_file;    ///< Append-only results log ("" = in memory only)
+        int max_new_games = 0;       ///< Stop after this many new games (0 = run to completion)
+        int progress_every = 0;      ///< Print progress every N games (0 = silent)
+        double prior_draws = 1.0;    ///< Virtual draws per pairing in the Elo fit
+    };
+
+    /**
+     * @brief Compact record of one finished game
+     */
+    struct GameRecord {
+        int game = -1;        ///< Schedule index
+        int engine_a = 0;     ///< Lower-indexed engine of the pairing
+        int engine_b = 0;     ///< Higher-indexed engine
+        bool a_is_black = true;
+        int opening = 0;      ///< Index into openings()
+        int a_points2 = 1;    ///< Engine a's result in half-points (2 win, 1 draw, 0 loss)
+        int disc_diff = 0;    ///< Final disc difference from engine a's perspective
+        int move_count = 0;
+    };
+
+    /**
+     * @brief Per-engine summary
+     */
+    struct Standing {
+        std::string name;
+        int engine = 0;        ///< Index in the engine list (as in GameRecord)
+        int games = 0;
+        int wins = 0;
+        int draws = 0;
+        int losses = 0;
+        double score = 0.0;    ///< Points / games
+        double elo = 0.0;      ///< ML Elo, field mean 0
+        double elo_ci95 = 0.0; ///< 95% half-width
+    };
+
+    /**
+     * @brief Tournament outcome (all finished games, including resumed ones)
+     */
+    struct Result {
+        std::vector<GameRecord> games;       ///< Finished games in schedule order
+        std::vector<Standing> standings;     ///< Sorted by Elo, best first
+        int scheduled_games = 0;             ///< Games in the full schedule
+        int resumed_games = 0;               ///< Games loaded from results_file
+        int played_games = 0;                ///< Games played by this run
+        bool complete = false;               ///< Every scheduled game finished
+        std::string error;                   ///< Non-empty if the run could not start
+
+        /**
+         * @brief Print the standings table and the pairing cross-table
+         *        (points of each row engine against each column engine)
+         */
+        void print(std::ostream& out) const;
+    };
+
+    Tournament(std::vector<EngineSpec> engines, const Config& config);
+
+    /**
+     * @brief Play (or resume) the tournament
+     */
+    Result run();
+
+    /**
+     * @brief Pairings (a, b) with a < b in schedule order
+     */
+    const std::vector<std::pair<int, int>>& pairings() const { return pairings_; }
+
+    /**
+     * @brief The shared opening set
+     */
+    const std::vector<core::Board>& openings() const { return openings_; }
+
+    /**
+     * @brief Total games in the schedule
+     */
+    int scheduled_games() const;
+
+    /**
+     * @brief Schedule entry for game g (result fields left at defaults)
+     */
+    GameRecord schedule(int game) const;
+
+    /**
+     * @brief Distinct, non-terminal openings of `plies` random moves
+     *
+     * Positions are deduplicated by hash; if the tree is too narrow for
+     * `count` distinct positions the set is shorter.
+     */
+    static std::vector<core::Board> make_opening_set(uint32_t seed, int count, int plies);
+
+    /**
+     * @brief Standings and ML Elo from a set of game records
+     */
+    static std::vector<Standing> compute_standings(
+        const std::vector<std::string>& names,
+        const std::vector<GameRecord>& games,
+        double prior_draws = 1.0
+    );
+
+private:
+    std::string header_line() const;
+    bool load_results(std::vector<GameRecord>& records, std::vector<char>& done, std::string& error) const;
+
+    std::vector<EngineSpec> engines_;
+    Config config_;
+    std::vector<std::pair<int, int>> pairings_;
+    std::vector<core::Board> openings_;
+};
+
+} // namespace research
+} // namespace reversi
@@ -0,0 +1,221 @@
+/*
+ * GameArchive.cpp - Readers for public Othello game archives
+ * COMP390 Honours Year Project
+ *
+ * Author: Tianqixing
+ * Student ID: 201821852
+ */
+
+#include "GameArchive.hpp"
+#include "MappedFile.hpp"
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <string_view>
+
+namespace reversi {
+namespace research {
+
+namespace {
+
+constexpr size_t WTHOR_HEADER_BYTES = 16;
+constexpr size_t WTHOR_RECORD_BYTES = 68;
+
+uint32_t read_le32(const uint8_t* p) {
+    return static_cast<uint32_t>(p[0]) | (static_cast<uint32_t>(p[1]) << 8) |
+           (static_cast<uint32_t>(p[2]) << 16) | (static_cast<uint32_t>(p[3]) << 24);
+}
+
+bool ends_with(const std::string& s, const char* suffix) {
+    size_t n = std::strlen(suffix);
+    if (s.size() < n) return false;
+    for (size_t i = 0; i < n; ++i) {
+        char c = s[s.size() - n + i];
+        if (c >= 'A' && c <= 'Z') c = static_cast<char>(c - 'A' + 'a');
+        if (c != suffix[i]) return false;
+    }
+    return true;
+}
+
+/// Parse GGF "BO[8 <64 squares> <side>]"
+bool parse_ggf_board(std::string_view value, core::Board& board) {
+    size_t i = 0;
+    while (i < value.size() && value[i] == ' ') ++i;
+    if (i >= value.size() || value[i] != '8') return false;
+    ++i;
+    uint64_t black = 0, white = 0;
+    int square = 0;
+    for (; i < value.size() && square < 64; ++i) {
+        char c = value[i];
+        if (c == ' ' || c == '\n' || c == '\r' || c == '\t') continue;
+        if (c == '*' || c == 'x' || c == 'X') black |= 1ULL << square;
+        else if (c == 'O' || c == 'o') white |= 1ULL << square;
+        else if (c != '-' && c != '.') return false;
+        ++square;
+    }
+    if (square != 64) return false;
+    while (i < value.size() && (value[i] == ' ' || value[i] == '\n' || value[i] == '\r')) ++i;
+    if (i >= value.size()) return false;
+    bool white_to_move = value[i] == 'O' || value[i] == 'o';
+    board = core::Board(black, white);
+    if (white_to_move) board.pass();
+    return true;
+}
+
+} // namespace
+
+long long GameArchive::read_wthor(const std::string& path, const GameCallback& fn) {
+    MappedFile file;
+    if (!file.open(path)) {
+        std::cerr << "Error: Cannot open file " << path << std::endl;
+        return -1;
+    }
+    if (file.size() < WTHOR_HEADER_BYTES) {
+        std::cerr << "Error: " << path << " is not a WTHOR file" << std::endl;
+        return -1;
+    }
+    const uint8_t* data = file.data();
+    size_t available = (file.size() - WTHOR_HEADER_BYTES) / WTHOR_RECORD_BYTES;
+    size_t declared = read_le32(data + 4);
+    // Some archives leave the count at 0; trust the file size then
+    size_t count = (declared == 0 || declared > available) ? available : declared;
+
+    ArchiveGame game;
+    long long delivered = 0;
+    for (size_t g = 0; g < count; ++g) {
+        const uint8_t* rec = data + WTHOR_HEADER_BYTES + g * WTHOR_RECORD_BYTES;
+        game.start = core::Board();
+        game.moves.clear();
+        game.offset = WTHOR_HEADER_BYTES + g * WTHOR_RECORD_BYTES;
+        game.black_disc_diff = 2 * static_cast<int>(rec[6]) - 64;
+        game.has_result = true;
+        bool valid = true;
+        for (size_t k = 0; k < 60; ++k) {
+            int m = rec[8 + k];
+            if (m == 0) break;
+            int row = m / 10, col = m % 10;
+            if (row < 1 || row > 8 || col < 1 || col > 8) {
+                valid = false;
+                break;
+            }
+            game.moves.push_back(static_cast<uint8_t>((row - 1) * 8 + (col - 1)));
+        }
+        if (!valid) continue;
+        ++delivered;
+        if (!fn(game)) break;
+    }
+    return delivered;
+}
+
+bool GameArchive::parse_ggf_game(const char* begin, const char* end, ArchiveGame& game) {
+    game.start = core::Board();
+    game.moves.clear();
+    game.has_result = false;
+    game.black_disc_diff = 0;
+
+    const char* p = begin;
+    while (p < end) {
+        // Property: KEY[value]
+        const char* key = p;
+        while (p < end && *p >= 'A' && *p <= 'Z') ++p;
+        if (p == key || p >= end || *p != '[') {
+            ++p;
+            continue;
+        }
+        std::string_view name(key, static_cast<size_t>(p - key));
+        const char* value_begin = ++p;
+        while (p < end && *p != ']') ++p;
+        if (p >= end) return false;
+        std::string_view value(value_begin, static_cast<size_t>(p - value_begin));
+        ++p;
+
+        if (name == "TY") {
+            // Only 8x8 games; synchro ('s') and anti ('a') variants are skipped
+            if (value.empty() || value[0] != '8' || (value.size() > 1 && value[1] >= '0' && value[1] <= '9')) return false;
+            if (value.find('s') != std::string_view::npos || value.find('a') != std::string_view::npos) return false;
+        } else if (name == "BO") {
+            if (!parse_ggf_board(value, game.start)) return false;
+        } else if (name == "RE") {
+            std::string text(value);
+            char* parse_end = nullptr;
+            double margin = std::strtod(text.c_str(), &parse_end);
+            if (parse_end != text.c_str()) {
+                game.black_disc_diff = static_cast<int>(margin >= 0 ? margin + 0.5 : margin - 0.5);
+                game.has_result = true;
+            }
+        } else if (name == "B" || name == "W") {
+            if (value.size() < 2) return false;
+            if ((value[0] == 'p' || value[0] == 'P') && (value[1] == 'a' || value[1] == 'A')) continue;
+            int sq = parse_square(value[0], value[1]);
+            if (sq < 0) return false;
+            game.moves.push_back(static_cast<uint8_t>(sq));
+        }
+    }
+    return true;
+}
+
+long long GameArchive::read_ggf(const std::string& path, const GameCallback& fn) {
+    MappedFile file;
+    if (!file.open(path)) {
+        std::cerr << "Error: Cannot open file " << path << std::endl;
+        return -1;
+    }
+    std::string_view text(reinterpret_cast<const char*>(file.data()), file.size());
+    ArchiveGame game;
+    long long delivered = 0;
+    size_t pos = 0;
+    while ((pos = text.find("(;", pos)) != std::string_view::npos) {
+        size_t close = text.find(";)", pos + 2);
+        if (close == std::string_view::npos) break;
+        if (parse_ggf_game(text.data() + pos + 2, text.data() + close, game)) {
+            game.offset = pos;
+            ++delivered;
+            if (!fn(game)) break;
+        }
+        pos = close + 2;
+    }
+    return delivered;
+}
+
+long long GameArchive::read(const std::string& path, const GameCallback& fn) {
+    return ends_with(path, ".wtb") ? read_wthor(path, fn) : read_ggf(path, fn);
+}
+
+bool GameArchive::write_wthor(const std::string& path, const std::vector<ArchiveGame>& games) {
+    const core::Board standard;
+    std::vector<uint8_t> records;
+    uint32_t count = 0;
+    for (const ArchiveGame& g : games) {
+        if (g.start.player != standard.player || g.start.opponent != standard.opponent ||
+            g.start.side_to_move() != 0 || g.moves.size() > 60) {
+            continue;
+        }
+        uint8_t rec[WTHOR_RECORD_BYTES] = {};
+        int black = std::max(0, std::min(64, (g.black_disc_diff + 64) / 2));
+        rec[6] = static_cast<uint8_t>(black);
+        rec[7] = static_cast<uint8_t>(black);
+        for (size_t k = 0; k < g.moves.size(); ++k) {
+            rec[8 + k] = static_cast<uint8_t>((g.moves[k] / 8 + 1) * 10 + (g.moves[k] % 8 + 1));
+        }
+        records.insert(records.end(), rec, rec + WTHOR_RECORD_BYTES);
+        ++count;
+    }
+
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    if (!out.is_open()) {
+        std::cerr << "Error: Cannot open file " << path << " for writing" << std::endl;
+        return false;
+    }
+    uint8_t header[WTHOR_HEADER_BYTES] = {};
+    header[0] = 20;  // Century
+    for (int i = 0; i < 4; ++i) header[4 + i] = static_cast<uint8_t>(count >> (8 * i));
+    header[12] = 8;  // Board size
+    out.write(reinterpret_cast<const char*>(header), sizeof(header));
+    out.write(reinterpret_cast<const char*>(records.data()), static_cast<std::streamsize>(records.size()));
+    return static_cast<bool>(out);
+}
+
+} // namespace research
+} // namespace reversi
@@ -0,0 +1,117 @@
+/*
+ * GameArchive.hpp - Readers for public Othello game archives
+ * COMP390 Honours Year Project
+ *
+ * WTHOR (.wtb): 16-byte header, then 68-byte records
+ *   [0..1] tournament, [2..3] black player, [4..5] white player,
+ *   [6] black discs at the end, [7] theoretical score,
+ *   [8..67] moves as 10 * row + column (1-based, row 1 at the top), 0 = end
+ *
+ * GGF (text): (;GM[Othello]...TY[8]RE[+18.000]BO[8 <8 rows> *]B[d3]W[c5]...;)
+ *   BO gives the start position ('*' black, 'O' white, '-' empty) and the
+ *   side to move; RE is black's final disc margin; "pa" is a pass.
+ *
+ * Squares use the Othello convention of the Board bitboards: a1 is bit 0,
+ * h1 bit 7, a2 bit 8 ... (row 1 at the top), so "d3" is square 19. Note
+ * this differs from core::Move::from_string, which counts ranks from the
+ * bottom.
+ *
+ * Author: Tianqixing
+ * Student ID: 201821852
+ */
+
+#pragma once
+
+#include "../../core/Board.hpp"
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace reversi {
+namespace research {
+
+/**
+ * @brief One game read from an archive
+ */
+struct ArchiveGame {
+    core::Board start;               ///< Start position (standard for WTHOR)
+    std::vector<uint8_t> moves;      ///< Squares played (passes implicit)
+    int black_disc_diff = 0;         ///< Final black minus white discs (if has_result)
+    bool has_result = false;
+    uint64_t offset = 0;             ///< Byte offset of the record in its file
+};
+
+class GameArchive {
+public:
+    /// Return false from the callback to stop reading
+    using GameCallback = std::function<bool(const ArchiveGame&)>;
+
+    /**
+     * @brief Stream all games of a WTHOR file
+     * @return Games delivered, or -1 if the file cannot be read
+     */
+    static long long read_wthor(const std::string& path, const GameCallback& fn);
+
+    /**
+     * @brief Stream all 8x8 games of a GGF file (synchro/anti games skipped)
+     * @return Games delivered, or -1 if the file cannot be read
+     */
+    static long long read_ggf(const std::string& path, const GameCallback& fn);
+
+    /**
+     * @brief Dispatch on extension (.wtb -> WTHOR, otherwise GGF)
+     */
+    static long long read(const std::string& path, const GameCallback& fn);
+
+    /**
+     * @brief Parse one GGF game "(;...;)"
+     * @return false if it is not a playable 8x8 game
+     */
+    static bool parse_ggf_game(const char* begin, const char* end, ArchiveGame& game);
+
+    /**
+     * @brief Write games from the standard start as a WTHOR file
+     *
+     * Player and tournament ids are 0; the theoretical score is the
+     * actual one. Games with another start position are skipped.
+     */
+    static bool write_wthor(const std::string& path, const std::vector<ArchiveGame>& games);
+
+    /**
+     * @brief Replay a game, calling fn(const Board&, int ply) for the
+     *        position before every move and for the final position
+     *
+     * Passes are inserted where the side to move has no legal move.
+     * @return false if a move is illegal (positions up to it were reported)
+     */
+    template <typename Fn>
+    static bool replay(const ArchiveGame& game, Fn&& fn) {
+        core::Board board = game.start;
+        for (size_t i = 0; i < game.moves.size(); ++i) {
+            uint64_t legal = board.legal_moves();
+            if (legal == 0) {
+                board.pass();
+                legal = board.legal_moves();
+            }
+            fn(static_cast<const core::Board&>(board), static_cast<int>(i));
+            const int sq = game.moves[i];
+            if (sq >= 64 || !((legal >> sq) & 1)) return false;
+            board.apply_move_no_history(sq);
+        }
+        fn(static_cast<const core::Board&>(board), static_cast<int>(game.moves.size()));
+        return true;
+    }
+
+    /**
+     * @brief "d3" / "D3" -> 19, anything else -> -1
+     */
+    static int parse_square(char col, char row) {
+        if (col >= 'A' && col <= 'H') col = static_cast<char>(col - 'A' + 'a');
+        if (col < 'a' || col > 'h' || row < '1' || row > '8') return -1;
+        return (row - '1') * 8 + (col - 'a');
+    }
+};
+
+} // namespace research
+} // namespace reversi
@@ -0,0 +1,335 @@
+/*
+ * GameShards.cpp - Compact game storage in size-bounded shard files
+ * COMP390 Honours Year Project
+ *
+ * Author: Tianqixing
+ * Student ID: 201821852
+ */
+
+#include "GameShards.hpp"
+#include <bit>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <iostream>
+#include <random>
+
+namespace reversi {
+namespace research {
+
+namespace {
+
+constexpr char SHARD_MAGIC[8] = {'R', 'V', 'G', 'S', 'H', 'R', 'D', '1'};
+constexpr char INDEX_MAGIC[8] = {'R', 'V', 'G', 'I', 'N', 'D', 'X', '1'};
+constexpr size_t SHARD_HEADER_BYTES = 16;  // magic + shard number + reserved
+
+void put_varint(std::string& out, uint64_t v) {
+    while (v >= 0x80) {
+        out.push_back(static_cast<char>((v & 0x7F) | 0x80));
+        v >>= 7;
+    }
+    out.push_back(static_cast<char>(v));
+}
+
+bool get_varint(const uint8_t*& p, const uint8_t* end, uint64_t& v) {
+    v = 0;
+    for (int shift = 0; shift < 64 && p < end; shift += 7) {
+        uint8_t byte = *p++;
+        v |= static_cast<uint64_t>(byte & 0x7F) << shift;
+        if ((byte & 0x80) == 0) return true;
+    }
+    return false;
+}
+
+uint64_t zigzag(int64_t v) { return (static_cast<uint64_t>(v) << 1) ^ static_cast<uint64_t>(v >> 63); }
+int64_t unzigzag(uint64_t v) { return static_cast<int64_t>(v >> 1) ^ -static_cast<int64_t>(v & 1); }
+
+/// Legal moves for the side that actually moves next (applies a forced pass)
+uint64_t next_legal(core::Board& board) {
+    uint64_t legal = board.legal_moves();
+    if (legal == 0) {
+        board.pass();
+        legal = board.legal_moves();
+    }
+    return legal;
+}
+
+} // namespace
+
+// ==================== GameCodec ====================
+
+bool GameCodec::encode(const GameRecord& game, std::string& out) {
+    const size_t n = game.moves.size();
+    if (game.opening_plies < 0 || game.opening_plies > 255 || game.opening_plies > static_cast<int>(n) ||
+        (game.scores.size() != n && !(game.scores.empty() && game.opening_plies == static_cast<int>(n)))) {
+        return false;
+    }
+    const size_t start = out.size();
+    put_varint(out, n);
+    out.push_back(static_cast<char>(game.opening_plies));
+    put_varint(out, zigzag(game.black_disc_diff));
+
+    core::Board board;
+    for (size_t i = 0; i < n; ++i) {
+        uint64_t legal = next_legal(board);
+        int sq = game.moves[i];
+        if (sq >= 64 || !((legal >> sq) & 1)) {
+            out.resize(start);
+            return false;
+        }
+        out.push_back(static_cast<char>(std::popcount(legal & ((1ULL << sq) - 1))));
+        board.make_move(sq);
+    }
+
+    int64_t prev = 0;
+    for (size_t i = game.opening_plies; i < n; ++i) {
+        put_varint(out, zigzag(static_cast<int64_t>(game.scores[i]) + prev));
+        prev = game.scores[i];
+    }
+    return true;
+}
+
+bool GameCodec::decode(const uint8_t* data, size_t size, GameRecord& game, size_t* consumed) {
+    const uint8_t* p = data;
+    const uint8_t* end = data + size;
+    uint64_t n = 0, diff = 0;
+    if (!get_varint(p, end, n) || n > 64 || p >= end) return false;
+    int opening = *p++;
+    if (!get_varint(p, end, diff) || opening > static_cast<int>(n) ||
+        static_cast<size_t>(end - p) < n) {
+        return false;
+    }
+
+    game.opening_plies = opening;
+    game.black_disc_diff = static_cast<int>(unzigzag(diff));
+    game.moves.resize(n);
+    game.scores.assign(n, 0);
+
+    core::Board board;
+    for (size_t i = 0; i < n; ++i) {
+        uint64_t legal = next_legal(board);
+        int rank = *p++;
+        if (rank >= std::popcount(legal)) return false;
+        for (int r = 0; r < rank; ++r) legal &= legal - 1;
+        int sq = std::countr_zero(legal);
+        game.moves[i] = static_cast<uint8_t>(sq);
+        board.make_move(sq);
+    }
+
+    int64_t prev = 0;
+    for (size_t i = opening; i < n; ++i) {
+        uint64_t v = 0;
+        if (!get_varint(p, end, v)) return false;
+        int64_t score = unzigzag(v) - prev;
+        game.scores[i] = static_cast<int32_t>(score);
+        prev = score;
+    }
+    if (consumed) *consumed = static_cast<size_t>(p - data);
+    return true;
+}
+
+// ==================== ShardWriter ====================
+
+std::string ShardWriter::shard_path(const std::string& directory, uint32_t shard) {
+    char name[32];
+    std::snprintf(name, sizeof(name), "shard_%05u.rvg", shard);
+    return (std::filesystem::path(directory) / name).string();
+}
+
+std::string ShardWriter::index_path(const std::string& directory) {
+    return (std::filesystem::path(directory) / "index.rvi").string();
+}
+
+bool ShardWriter::open(const std::string& directory, size_t shard_bytes) {
+    close();
+    std::error_code ec;
+    std::filesystem::create_directories(directory, ec);
+    if (ec) {
+        std::cerr << "Error: Cannot create directory " << directory << ": " << ec.message() << std::endl;
+        return false;
+    }
+    // Remove a previous dataset so stale shards cannot be mixed in
+    std::filesystem::remove(index_path(directory), ec);
+    for (uint32_t s = 0; std::filesystem::remove(shard_path(directory, s), ec); ++s) {}
+
+    directory_ = directory;
+    shard_bytes_ = std::max<size_t>(shard_bytes, 1024);
+    index_.clear();
+    positions_ = 0;
+    bytes_ = 0;
+    open_ = start_shard(0);
+    return open_;
+}
+
+bool ShardWriter::start_shard(uint32_t shard) {
+    if (out_.is_open()) out_.close();
+    std::string path = shard_path(directory_, shard);
+    out_.open(path, std::ios::binary | std::ios::trunc);
+    if (!out_.is_open()) {
+        std::cerr << "Error: Cannot open file " << path << " for writing" << std::endl;
+        return false;
+    }
+    uint32_t header[2] = {shard, 0};
+    out_.write(SHARD_MAGIC, sizeof(SHARD_MAGIC));
+    out_.write(reinterpret_cast<const char*>(header), sizeof(header));
+    shard_ = shard;
+    shard_offset_ = SHARD_HEADER_BYTES;
+    bytes_ += SHARD_HEADER_BYTES;
+    return static_cast<bool>(out_);
+}
+
+bool ShardWriter::add(const GameRecord& game) {
+    if (!open_) return false;
+    buffer_.clear();
+    if (!GameCodec::encode(game, buffer_)) {
+        std::cerr << "Error: Illegal game record (" << game.moves.size() << " moves)" << std::endl;
+        return false;
+    }
+    if (shard_offset_ > SHARD_HEADER_BYTES && shard_offset_ + buffer_.size() > shard_bytes_) {
+        if (!start_shard(shard_ + 1)) return false;
+    }
+
+    ShardIndexEntry entry{};
+    entry.first_position = positions_;
+    entry.shard = shard_;
+    entry.offset = shard_offset_;
+    entry.length = static_cast<uint32_t>(buffer_.size());
+    entry.positions = static_cast<uint16_t>(game.moves.size());
+    entry.opening_plies = static_cast<uint16_t>(game.opening_plies);
+    index_.push_back(entry);
+
+    out_.write(buffer_.data(), static_cast<std::streamsize>(buffer_.size()));
+    shard_offset_ += entry.length;
+    positions_ += entry.positions;
+    bytes_ += entry.length;
+    return static_cast<bool>(out_);
+}
+
+bool ShardWriter::close() {
+    if (!open_) return true;
+    open_ = false;
+    out_.close();
+    bool ok = !out_.fail();
+
+    std::string path = index_path(directory_);
+    std::string tmp = path + ".tmp";
+    {
+        std::ofstream index(tmp, std::ios::binary | std::ios::trunc);
+        if (!index.is_open()) {
+            std::cerr << "Error: Cannot open file " << tmp << " for writing" << std::endl;
+            return false;
+        }
+        uint64_t counts[3] = {index_.size(), positions_, shard_ + 1ULL};
+        index.write(INDEX_MAGIC, sizeof(INDEX_MAGIC));
+        index.write(reinterpret_cast<const char*>(counts), sizeof(counts));
+        index.write(reinterpret_cast<const char*>(index_.data()),
+                    static_cast<std::streamsize>(index_.size() * sizeof(ShardIndexEntry)));
+        ok = ok && static_cast<bool>(index);
+    }
+    std::error_code ec;
+    std::filesystem::rename(tmp, path, ec);
+    bytes_ += sizeof(INDEX_MAGIC) + 3 * sizeof(uint64_t) + index_.size() * sizeof(ShardIndexEntry);
+    return ok && !ec;
+}
+
+// ==================== ShardReader ====================
+
+bool ShardReader::open(const std::string& directory) {
+    std::string path = ShardWriter::index_path(directory);
+    std::ifstream in(path, std::ios::binary);
+    if (!in.is_open()) {
+        std::cerr << "Error: Cannot open file " << path << std::endl;
+        return false;
+    }
+    char magic[8];
+    uint64_t counts[3];
+    if (!in.read(magic, sizeof(magic)) || std::memcmp(magic, INDEX_MAGIC, sizeof(magic)) != 0 ||
+        !in.read(reinterpret_cast<char*>(counts), sizeof(counts))) {
+        std::cerr << "Error: " << path << " is not a game shard index" << std::endl;
+        return false;
+    }
+    std::vector<ShardIndexEntry> index(counts[0]);
+    if (!in.read(reinterpret_cast<char*>(index.data()),
+                 static_cast<std::streamsize>(index.size() * sizeof(ShardIndexEntry)))) {
+        std::cerr << "Error: Truncated index " << path << std::endl;
+        return false;
+    }
+
+    directory_ = directory;
+    index_ = std::move(index);
+    num_positions_ = counts[1];
+    num_shards_ = static_cast<uint32_t>(counts[2]);
+    in_.close();
+    open_shard_ = UINT32_MAX;
+    cached_game_ = SIZE_MAX;
+    return true;
+}
+
+bool ShardReader::seek_shard(uint32_t shard) {
+    if (open_shard_ == shard && in_.is_open()) return true;
+    in_.close();
+    in_.clear();
+    in_.open(ShardWriter::shard_path(directory_, shard), std::ios::binary);
+    char magic[8];
+    if (!in_.is_open() || !in_.read(magic, sizeof(magic)) ||
+        std::memcmp(magic, SHARD_MAGIC, sizeof(magic)) != 0) {
+        open_shard_ = UINT32_MAX;
+        return false;
+    }
+    open_shard_ = shard;
+    return true;
+}
+
+bool ShardReader::read_game(size_t i, GameRecord& game) {
+    if (i >= index_.size()) return false;
+    if (i == cached_game_) {
+        game = cached_;
+        return true;
+    }
+    const ShardIndexEntry& e = index_[i];
+    if (!seek_shard(e.shard)) return false;
+    buffer_.resize(e.length);
+    in_.clear();
+    in_.seekg(e.offset);
+    if (!in_.read(reinterpret_cast<char*>(buffer_.data()), e.length)) return false;
+    if (!GameCodec::decode(buffer_.data(), buffer_.size(), game)) return false;
+    cached_ = game;
+    cached_game_ = i;
+    return true;
+}
+
+size_t ShardReader::game_of_position(uint64_t i) const {
+    auto it = std::upper_bound(index_.begin(), index_.end(), i,
+                               [](uint64_t pos, const ShardIndexEntry& e) { return pos < e.first_position; });
+    return static_cast<size_t>(it - index_.begin()) - 1;
+}
+
+bool ShardReader::read_position(uint64_t i, PositionRecord& position) {
+    if (i >= num_positions_) return false;
+    size_t g = game_of_position(i);
+    GameRecord game;
+    if (!read_game(g, game)) return false;
+    const int target = static_cast<int>(i - index_[g].first_position);
+    bool found = false;
+    GameCodec::replay(game, [&](const PositionRecord& pos) {
+        if (pos.ply == target) {
+            position = pos;
+            found = true;
+        }
+    });
+    return found;
+}
+
+std::vector<uint64_t> ShardReader::sample_positions(size_t n, uint64_t seed) const {
+    std::vector<uint64_t> picks;
+    if (num_positions_ == 0) return picks;
+    std::mt19937_64 rng(seed);
+    std::uniform_int_distribution<uint64_t> dist(0, num_positions_ - 1);
+    picks.reserve(n);
+    for (size_t k = 0; k < n; ++k) picks.push_back(dist(rng));
+    std::sort(picks.begin(), picks.end());
+    return picks;
+}
+
+} // namespace research
+} // namespace reversi
@@ -0,0 +1,240 @@
+/*
+ * GameShards.hpp - Compact game storage in size-bounded shard files
+ * COMP390 Honours Year Project
+ *
+ * A dataset is a directory of shard files plus one index file:
+ *
+ *   shard_00000.rvg ...  "RVGSHRD1" + shard number, then game records
+ *   index.rvi            "RVGINDX1" + counts, then one IndexEntry per game
+ *
+ * Game record (byte oriented, self-delimiting):
+ *   varint  number of moves (passes are implicit)
+ *   byte    opening plies (moves without a search score)
+ *   varint  zigzag final disc difference for black
+ *   byte[]  each move as its rank among the legal moves (ascending squares)
+ *   varint[] zigzag(score[i] + score[i-1]) for every scored move
+ *
+ * Storing the legal-move rank instead of the square keeps every move in a
+ * small range, and successive scores alternate perspective so their sum
+ * is near zero. A 60-move game with scores takes roughly 150 bytes instead
+ * of ~1 KB as boards.
+ *
+ * The index maps game -> (shard, offset, length) and a running position
+ * count, so a reader can seek to any game or any position without
+ * touching the rest of the shard.
+ *
+ * Author: Tianqixing
+ * Student ID: 201821852
+ */
+
+#pragma once
+
+#include "../../core/Board.hpp"
+#include <algorithm>
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace reversi {
+namespace research {
+
+/**
+ * @brief One game as stored in a shard
+ */
+struct GameRecord {
+    std::vector<uint8_t> moves;    ///< Squares played in order (passes implicit)
+    std::vector<int32_t> scores;   ///< Search score for the side to move before each move (0 in the opening)
+    int opening_plies = 0;         ///< Leading moves that were not searched (random opening)
+    int black_disc_diff = 0;       ///< Final black minus white disc count
+
+    size_t num_positions() const { return moves.size(); }
+};
+
+/**
+ * @brief One position reconstructed from a stored game
+ */
+struct PositionRecord {
+    core::Board board;        ///< Position before the move
+    int move = -1;            ///< Square played from here
+    int score = 0;            ///< Search score for the side to move (valid if has_score)
+    bool has_score = false;   ///< False for random opening moves
+    int result = 0;           ///< Final disc difference for the side to move
+    int ply = 0;              ///< Index of the move within its game
+};
+
+/**
+ * @brief Encode/decode single game records
+ */
+class GameCodec {
+public:
+    /**
+     * @brief Append the encoded game to `out`
+     * @return false if the move sequence is not a legal game
+     */
+    static bool encode(const GameRecord& game, std::string& out);
+
+    /**
+     * @brief Decode a record starting at `data`
+     * @param consumed Receives the number of bytes read
+     * @return false on malformed input
+     */
+    static bool decode(const uint8_t* data, size_t size, GameRecord& game, size_t* consumed = nullptr);
+
+    /**
+     * @brief Replay a game, calling fn(const PositionRecord&) for each position
+     */
+    template <typename Fn>
+    static void replay(const GameRecord& game, Fn&& fn) {
+        core::Board board;
+        PositionRecord pos;
+        for (size_t i = 0; i < game.moves.size(); ++i) {
+            if (board.legal_moves() == 0) board.pass();
+            pos.board = board;
+            pos.move = game.moves[i];
+            pos.ply = static_cast<int>(i);
+            pos.has_score = static_cast<int>(i) >= game.opening_plies;
+            pos.score = i < game.scores.size() ? game.scores[i] : 0;
+            pos.result = board.side_to_move() == 0 ? game.black_disc_diff : -game.black_disc_diff;
+            fn(static_cast<const PositionRecord&>(pos));
+            board.make_move(game.moves[i]);
+        }
+    }
+};
+
+/**
+ * @brief Index entry (fixed size, stored raw in index.rvi)
+ */
+struct ShardIndexEntry {
+    uint64_t first_position;  ///< Global index of the game's first position
+    uint32_t shard;           ///< Shard file number
+    uint32_t offset;          ///< Byte offset of the record in the shard
+    uint32_t length;          ///< Record length in bytes
+    uint16_t positions;       ///< Number of positions (moves) in the game
+    uint16_t opening_plies;   ///< Unscored leading positions
+};
+static_assert(sizeof(ShardIndexEntry) == 24, "ShardIndexEntry is stored raw");
+
+/**
+ * @brief Writes games into shards of at most `shard_bytes` each
+ *
+ * Games are appended in call order. The index is written by close();
+ * a directory without an index is incomplete.
+ */
+class ShardWriter {
+public:
+    static constexpr size_t DEFAULT_SHARD_BYTES = 4u << 20;
+
+    ShardWriter() = default;
+    ~ShardWriter() { close(); }
+    ShardWriter(const ShardWriter&) = delete;
+    ShardWriter& operator=(const ShardWriter&) = delete;
+
+    /**
+     * @brief Create (or empty) the dataset directory
+     */
+    bool open(const std::string& directory, size_t shard_bytes = DEFAULT_SHARD_BYTES);
+
+    /**
+     * @brief Append one game
+     * @return false if the game is illegal or a write failed
+     */
+    bool add(const GameRecord& game);
+
+    /**
+     * @brief Finish the last shard and write the index
+     */
+    bool close();
+
+    size_t games() const { return index_.size(); }
+    uint64_t positions() const { return positions_; }
+    uint32_t shards() const { return index_.empty() ? 0 : shard_ + 1; }
+    uint64_t bytes() const { return bytes_; }
+
+    static std::string shard_path(const std::string& directory, uint32_t shard);
+    static std::string index_path(const std::string& directory);
+
+private:
+    bool start_shard(uint32_t shard);
+
+    std::string directory_;
+    size_t shard_bytes_ = DEFAULT_SHARD_BYTES;
+    std::ofstream out_;
+    uint32_t shard_ = 0;
+    uint32_t shard_offset_ = 0;
+    uint64_t positions_ = 0;
+    uint64_t bytes_ = 0;
+    std::vector<ShardIndexEntry> index_;
+    std::string buffer_;
+    bool open_ = false;
+};
+
+/**
+ * @brief Random access and streaming over a shard dataset
+ *
+ * Only the index is loaded; games are read from the shards on demand.
+ * Not thread-safe: give each thread its own reader (the index is small).
+ */
+class ShardReader {
+public:
+    bool open(const std::string& directory);
+
+    size_t num_games() const { return index_.size(); }
+    uint64_t num_positions() const { return num_positions_; }
+    uint32_t num_shards() const { return num_shards_; }
+    const std::vector<ShardIndexEntry>& index() const { return index_; }
+
+    /**
+     * @brief Read game i
+     */
+    bool read_game(size_t i, GameRecord& game);
+
+    /**
+     * @brief Reconstruct global position i (0 .. num_positions() - 1)
+     */
+    bool read_position(uint64_t i, PositionRecord& position);
+
+    /**
+     * @brief Game containing global position i
+     */
+    size_t game_of_position(uint64_t i) const;
+
+    /**
+     * @brief Stream games [first, last) in storage order
+     *
+     * fn(size_t game_index, const GameRecord&) returns false to stop.
+     */
+    template <typename Fn>
+    bool for_each_game(Fn&& fn, size_t first = 0, size_t last = SIZE_MAX) {
+        GameRecord game;
+        last = std::min(last, index_.size());
+        for (size_t i = first; i < last; ++i) {
+            if (!read_game(i, game)) return false;
+            if (!fn(i, static_cast<const GameRecord&>(game))) break;
+        }
+        return true;
+    }
+
+    /**
+     * @brief n uniformly random position indices (with replacement), sorted
+     *
+     * Sorted so that reading them back walks each shard front to back.
+     */
+    std::vector<uint64_t> sample_positions(size_t n, uint64_t seed) const;
+
+private:
+    bool seek_shard(uint32_t shard);
+
+    std::string directory_;
+    std::vector<ShardIndexEntry> index_;
+    uint64_t num_positions_ = 0;
+    uint32_t num_shards_ = 0;
+    std::ifstream in_;
+    uint32_t open_shard_ = UINT32_MAX;
+    std::vector<uint8_t> buffer_;
+    size_t cached_game_ = SIZE_MAX;
+    GameRecord cached_;
+};
+
+} // namespace research
+} // namespace reversi
@@ -0,0 +1,86 @@
+/*
+ * MappedFile.cpp - Read-only memory-mapped file
+ * COMP390 Honours Year Project
+ *
+ * Author: Tianqixing
+ * Student ID: 201821852
+ */
+
+#include "MappedFile.hpp"
+#include <fstream>
+#include <iterator>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define REVERSI_HAVE_MMAP 1
+#endif
+
+namespace reversi {
+namespace research {
+
+MappedFile& MappedFile::operator=(MappedFile&& other) noexcept {
+    if (this != &other) {
+        close();
+        fallback_ = std::move(other.fallback_);
+        data_ = other.mapped_ ? other.data_ : fallback_.data();
+        size_ = other.size_;
+        open_ = other.open_;
+        mapped_ = other.mapped_;
+        other.data_ = nullptr;
+        other.size_ = 0;
+        other.open_ = false;
+        other.mapped_ = false;
+    }
+    return *this;
+}
+
+bool MappedFile::open(const std::string& path) {
+    close();
+#ifdef REVERSI_HAVE_MMAP
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) return false;
+    struct stat st;
+    if (::fstat(fd, &st) != 0) {
+        ::close(fd);
+        return false;
+    }
+    size_ = static_cast<size_t>(st.st_size);
+    if (size_ > 0) {
+        void* p = ::mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (p == MAP_FAILED) {
+            ::close(fd);
+            size_ = 0;
+            return false;
+        }
+        ::madvise(p, size_, MADV_WILLNEED);
+        data_ = static_cast<const uint8_t*>(p);
+        mapped_ = true;
+    }
+    ::close(fd);  // The mapping keeps its own reference
+#else
+    std::ifstream in(path, std::ios::binary);
+    if (!in.is_open()) return false;
+    fallback_.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+    data_ = fallback_.data();
+    size_ = fallback_.size();
+#endif
+    open_ = true;
+    return true;
+}
+
+void MappedFile::close() {
+#ifdef REVERSI_HAVE_MMAP
+    if (mapped_ && data_) ::munmap(const_cast<uint8_t*>(data_), size_);
+#endif
+    fallback_.clear();
+    data_ = nullptr;
+    size_ = 0;
+    open_ = false;
+    mapped_ = false;
+}
+
+} // namespace research
+} // namespace reversi
@@ -0,0 +1,51 @@
+/*
+ * MappedFile.hpp - Read-only memory-mapped file
+ * COMP390 Honours Year Project
+ *
+ * mmap on POSIX systems; elsewhere the file is read into memory so the
+ * callers (archive importers, position index, bulk loaders) work the same.
+ *
+ * Author: Tianqixing
+ * Student ID: 201821852
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace reversi {
+namespace research {
+
+class MappedFile {
+public:
+    MappedFile() = default;
+    ~MappedFile() { close(); }
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+    MappedFile(MappedFile&& other) noexcept { *this = std::move(other); }
+    MappedFile& operator=(MappedFile&& other) noexcept;
+
+    /**
+     * @brief Map the whole file read-only
+     * @return false if the file cannot be opened (an empty file maps fine)
+     */
+    bool open(const std::string& path);
+    void close();
+
+    const uint8_t* data() const { return data_; }
+    size_t size() const { return size_; }
+    bool is_open() const { return open_; }
+
+private:
+    const uint8_t* data_ = nullptr;
+    size_t size_ = 0;
+    bool open_ = false;
+    bool mapped_ = false;           ///< data_ comes from mmap (else from fallback_)
+    std::vector<uint8_t> fallback_;
+};
+
+} // namespace research
+} // namespace reversi
@@ -0,0 +1,254 @@
+/*
+ * PositionFile.cpp - Bulk OBF / FFO position files
+ * COMP390 Honours Year Project
+ *
+ * Author: Tianqixing
+ * Student ID: 201821852
+ */
+
+#include "PositionFile.hpp"
+#include "GameArchive.hpp"
+#include "MappedFile.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <thread>
+
+namespace reversi {
+namespace research {
+
+core::Board PositionFile::Position::board() const {
+    if (side == 0) return core::Board(player, opponent);
+    core::Board b(opponent, player);
+    b.pass();
+    return b;
+}
+
+bool PositionFile::parse_line(const char* begin, const char* end, Position& out) {
+    size_t consumed = 0;
+    int side = 0;
+    if (!core::Board::parse_obf(begin, static_cast<size_t>(end - begin), out.player, out.opponent, side, &consumed)) {
+        return false;
+    }
+    out.side = static_cast<uint8_t>(side);
+    out.best_move = -1;
+    out.score = 0;
+    out.has_score = 0;
+
+    // Optional "; <move>:<score>" annotation
+    const char* p = begin + consumed;
+    while (p < end && (*p == ' ' || *p == '\t' || *p == ';')) ++p;
+    if (end - p < 4 || p[2] != ':') return true;
+    const int sq = GameArchive::parse_square(p[0], p[1]);
+    if (sq < 0 && !((p[0] == 'P' || p[0] == 'p') && (p[1] == 'S' || p[1] == 's'))) return true;
+    p += 3;
+    bool negative = false;
+    if (p < end && (*p == '+' || *p == '-')) negative = *p++ == '-';
+    int score = 0, digits = 0;
+    for (; p < end && *p >= '0' && *p <= '9' && digits < 3; ++p, ++digits) score = score * 10 + (*p - '0');
+    if (digits == 0 || score > 64) return true;
+    out.best_move = static_cast<int8_t>(sq);  // -1 for a pass ("PS")
+    out.score = static_cast<int8_t>(negative ? -score : score);
+    out.has_score = 1;
+    return true;
+}
+
+size_t PositionFile::format_line(const Position& pos, char* out) {
+    const uint64_t black = pos.side == 0 ? pos.player : pos.opponent;
+    const uint64_t white = pos.side == 0 ? pos.opponent : pos.player;
+    for (int sq = 0; sq < 64; ++sq) {
+        out[sq] = ((black >> sq) & 1) ? 'X' : ((white >> sq) & 1) ? 'O' : '-';
+    }
+    size_t n = 64;
+    out[n++] = ' ';
+    out[n++] = pos.side == 0 ? 'X' : 'O';
+    out[n++] = ';';
+    if (pos.has_score) {
+        out[n++] = ' ';
+        if (pos.best_move >= 0) {
+            out[n++] = static_cast<char>('A' + pos.best_move % 8);
+            out[n++] = static_cast<char>('1' + pos.best_move / 8);
+        } else {
+            out[n++] = 'P';
+            out[n++] = 'S';
+        }
+        out[n++] = ':';
+        int score = pos.score;
+        out[n++] = score < 0 ? '-' : '+';
+        score = std::abs(score);
+        if (score >= 10) out[n++] = static_cast<char>('0' + score / 10);
+        out[n++] = static_cast<char>('0' + score % 10);
+        out[n++] = ';';
+    }
+    return n;
+}
+
+std::string PositionFile::parse_id(const char* begin, const char* end) {
+    static constexpr char OP[] = "id \"";
+    const char* p = std::search(begin, end, OP, OP + sizeof(OP) - 1);
+    if (p == end) return {};
+    p += sizeof(OP) - 1;
+    const char* close = std::find(p, end, '"');
+    return close == end ? std::string() : std::string(p, close);
+}
+
+std::vector<std::string> PositionFile::load_ids(const std::string& path, const std::vector<Position>& positions) {
+    std::vector<std::string> ids(positions.size());
+    std::ifstream in(path, std::ios::binary);
+    std::string text;
+    uint32_t line = 0;
+    size_t next = 0;  // Positions are in file order
+    while (next < positions.size() && std::getline(in, text)) {
+        ++line;
+        for (; next < positions.size() && positions[next].line == line; ++next) {
+            ids[next] = parse_id(text.data(), text.data() + text.size());
+        }
+    }
+    return ids;
+}
+
+PositionFile::Position PositionFile::from_board(const core::Board& board) {
+    Position pos;
+    pos.player = board.player;
+    pos.opponent = board.opponent;
+    pos.side = static_cast<uint8_t>(board.side_to_move());
+    return pos;
+}
+
+PositionFile::LoadStats PositionFile::load(const std::string& path, std::vector<Position>& out, int num_threads) {
+    LoadStats stats;
+    auto t0 = std::chrono::steady_clock::now();
+    out.clear();
+
+    MappedFile file;
+    if (!file.open(path)) {
+        std::cerr << "Error: Cannot open file " << path << std::endl;
+        stats.error = "cannot read " + path;
+        return stats;
+    }
+    const char* data = reinterpret_cast<const char*>(file.data());
+    const size_t size = file.size();
+
+    if (num_threads <= 0) {
+        num_threads = static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+        // Not worth a thread below ~1 MB
+        num_threads = static_cast<int>(std::clamp<size_t>(size >> 20, 1, static_cast<size_t>(num_threads)));
+    }
+
+    // Line-aligned chunk boundaries
+    std::vector<size_t> bounds(static_cast<size_t>(num_threads) + 1, size);
+    bounds[0] = 0;
+    for (int t = 1; t < num_threads; ++t) {
+        size_t b = std::max(bounds[t - 1], size / num_threads * t);
+        const void* nl = b < size ? std::memchr(data + b, '\n', size - b) : nullptr;
+        bounds[t] = nl ? static_cast<size_t>(static_cast<const char*>(nl) - data) + 1 : size;
+    }
+
+    struct Chunk {
+        std::vector<Position> positions;
+        uint64_t lines = 0;
+        uint64_t errors = 0;
+    };
+    std::vector<Chunk> chunks(static_cast<size_t>(num_threads));
+
+    auto parse_chunk = [&](int t) {
+        Chunk& chunk = chunks[t];
+        const char* p = data + bounds[t];
+        const char* end = data + bounds[t + 1];
+        chunk.positions.reserve(static_cast<size_t>(end - p) / 68 + 1);
+        Position pos;
+        while (p < end) {
+            const void* nl = std::memchr(p, '\n', static_cast<size_t>(end - p));
+            const char* eol = nl ? static_cast<const char*>(nl) : end;
+            const char* line_end = (eol > p && eol[-1] == '\r') ? eol - 1 : eol;
+            ++chunk.lines;
+            const char* first = p;
+            while (first < line_end && (*first == ' ' || *first == '\t')) ++first;
+            if (first != line_end && *first != '%' && *first != '#') {
+                if (parse_line(first, line_end, pos)) {
+                    pos.line = static_cast<uint32_t>(chunk.lines);  // Chunk-relative for now
+                    chunk.positions.push_back(pos);
+                } else {
+                    ++chunk.errors;
+                }
+            }
+            p = eol + 1;
+        }
+    };
+
+    std::vector<std::thread> pool;
+    pool.reserve(num_threads - 1);
+    for (int t = 1; t < num_threads; ++t) pool.emplace_back(parse_chunk, t);
+    parse_chunk(0);
+    for (auto& th : pool) th.join();
+    pool.clear();
+
+    // Gather into one array, fixing up line numbers
+    std::vector<size_t> offset(chunks.size() + 1, 0);
+    std::vector<uint64_t> line_base(chunks.size(), 0);
+    for (size_t t = 0; t < chunks.size(); ++t) {
+        offset[t + 1] = offset[t] + chunks[t].positions.size();
+        if (t + 1 < chunks.size()) line_base[t + 1] = line_base[t] + chunks[t].lines;
+        stats.lines += chunks[t].lines;
+        stats.errors += chunks[t].errors;
+    }
+    out.resize(offset.back());
+    auto gather = [&](int t) {
+        Position* dst = out.data() + offset[t];
+        for (const Position& pos : chunks[t].positions) {
+            *dst = pos;
+            dst->line += static_cast<uint32_t>(line_base[t]);
+            ++dst;
+        }
+        std::vector<Position>().swap(chunks[t].positions);
+    };
+    for (int t = 1; t < num_threads; ++t) pool.emplace_back(gather, t);
+    gather(0);
+    for (auto& th : pool) th.join();
+
+    stats.positions = out.size();
+    stats.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+    return stats;
+}
+
+bool PositionFile::save(const std::string& path, const std::vector<Position>& positions) {
+    std::string tmp = path + ".tmp";
+    {
+        std::ofstream out(tmp, std::ios::binary | std::ios::trunc);
+        if (!out.is_open()) {
+            std::cerr << "Error: Cannot open file " << tmp << " for writing" << std::endl;
+            return false;
+        }
+        std::string buffer;
+        buffer.reserve(1 << 20);
+        char line[MAX_LINE];
+        for (const Position& pos : positions) {
+            size_t n = format_line(pos, line);
+            line[n++] = '\n';
+            buffer.append(line, n);
+            if (buffer.size() >= (1 << 20) - MAX_LINE) {
+                out.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+                buffer.clear();
+            }
+        }
+        out.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+        if (!out) {
+            std::cerr << "Error: Write failed for " << tmp << std::endl;
+            return false;
+        }
+    }
+    std::error_code ec;
+    std::filesystem::rename(tmp, path, ec);
+    if (ec) {
+        std::cerr << "Error: Cannot rename " << tmp << ": " << ec.message() << std::endl;
+        return false;
+    }
+    return true;
+}
+
+} // namespace research
+} // namespace reversi
@@ -0,0 +1,103 @@
+/*
+ * PositionFile.hpp - Bulk OBF / FFO position files
+ * COMP390 Honours Year Project
+ *
+ * One position per line in the OBF format used by the FFO endgame
+ * suites and Edax test files:
+ *
+ *   <64 squares a1..h8> <side>; [<move>:<score>; ...]
+ *
+ * Only the first move:score pair (the best move and its exact score,
+ * when present) is kept. Empty lines and lines starting with '%' or '#'
+ * are comments. Suite files may name a position with an EPD-style op,
+ * "<board> X; A2:+38; id \"#40\";", read back by load_ids().
+ *
+ * load() maps the file, splits it into line-aligned chunks parsed by
+ * worker threads and gathers the result into one contiguous array of
+ * 24-byte positions - no Board objects, no per-line allocation.
+ *
+ * Author: Tianqixing
+ * Student ID: 201821852
+ */
+
+#pragma once
+
+#include "../../core/Board.hpp"
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace reversi {
+namespace research {
+
+class PositionFile {
+public:
+    /**
+     * @brief Compact position record (side-to-move relative bitboards)
+     */
+    struct Position {
+        uint64_t player;          ///< Discs of the side to move
+        uint64_t opponent;
+        uint8_t side;             ///< 0 = black to move, 1 = white
+        int8_t best_move = -1;    ///< First annotated move, -1 if none
+        int8_t score = 0;         ///< Its score (side to move's disc margin)
+        uint8_t has_score = 0;
+        uint32_t line = 0;        ///< 1-based line number in the source file
+
+        /// Full board with the correct side to move (allocates its history buffer)
+        core::Board board() const;
+        int empties() const { return 64 - std::popcount(player | opponent); }
+    };
+
+    struct LoadStats {
+        uint64_t lines = 0;       ///< Lines read (comments included)
+        uint64_t positions = 0;
+        uint64_t errors = 0;      ///< Malformed lines skipped
+        double seconds = 0.0;
+        std::string error;        ///< Set if the file could not be read
+    };
+
+    /**
+     * @brief Parse one line (without its newline)
+     * @return false for malformed lines; comments are rejected too
+     */
+    static bool parse_line(const char* begin, const char* end, Position& out);
+
+    /**
+     * @brief Write one position as an OBF line (no newline)
+     * @param out Buffer of at least MAX_LINE bytes
+     * @return Characters written
+     */
+    static size_t format_line(const Position& pos, char* out);
+
+    /**
+     * @brief Text of the line's id "<text>"; op, or "" if it has none
+     */
+    static std::string parse_id(const char* begin, const char* end);
+    static constexpr size_t MAX_LINE = 80;
+
+    static Position from_board(const core::Board& board);
+
+    /**
+     * @brief Parse a whole file in parallel, keeping file order
+     * @param num_threads Parser threads (0 = all cores)
+     */
+    static LoadStats load(const std::string& path, std::vector<Position>& out, int num_threads = 0);
+
+    /**
+     * @brief ids (parse_id) of positions loaded from path, one per position
+     *
+     * Reads the file again, so it is meant for small suites, not bulk data.
+     */
+    static std::vector<std::string> load_ids(const std::string& path, const std::vector<Position>& positions);
+
+    /**
+     * @brief Write positions as OBF lines (written to a temporary file, then renamed)
+     */
+    static bool save(const std::string& path, const std::vector<Position>& positions);
+};
+
+} // namespace research
+} // namespace reversi
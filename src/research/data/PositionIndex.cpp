@@ -0,0 +1,198 @@
+/*
+ * PositionIndex.cpp - Memory-mapped position -> games index
+ * COMP390 Honours Year Project
+ *
+ * Author: Tianqixing
+ * Student ID: 201821852
+ */
+
+#include "PositionIndex.hpp"
+#include <algorithm>
+#include <bit>
+#include <chrono>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+
+namespace reversi {
+namespace research {
+
+namespace {
+constexpr char INDEX_MAGIC[8] = {'R', 'V', 'P', 'I', 'D', 'X', '0', '1'};
+constexpr uint32_t INDEX_VERSION = 1;
+
+// count items of elem_size bytes at offset lie within a file of size bytes (no overflow)
+bool section_fits(uint64_t offset, uint64_t count, uint64_t elem_size, uint64_t size) {
+    return offset <= size && count <= (size - offset) / elem_size;
+}
+} // namespace
+
+PositionIndex::BuildStats PositionIndex::build(const std::vector<std::string>& sources,
+                                               const std::string& index_path) {
+    BuildStats stats;
+    auto t0 = std::chrono::steady_clock::now();
+    std::vector<GameInfo> games;
+    std::vector<Entry> entries;
+
+    for (uint32_t s = 0; s < sources.size(); ++s) {
+        long long read = GameArchive::read(sources[s], [&](const ArchiveGame& g) {
+            const uint32_t id = static_cast<uint32_t>(games.size());
+            const size_t mark = entries.size();
+            bool legal = GameArchive::replay(g, [&](const core::Board& board, int ply) {
+                entries.push_back({board.hash(), id, static_cast<uint16_t>(ply), 0});
+            });
+            if (!legal || g.moves.size() > 255) {
+                entries.resize(mark);
+                ++stats.skipped;
+                return true;
+            }
+            games.push_back({g.offset, s, static_cast<int8_t>(std::clamp(g.black_disc_diff, -64, 64)),
+                             static_cast<uint8_t>(g.moves.size()), static_cast<uint8_t>(g.has_result ? 1 : 0), 0});
+            return true;
+        });
+        if (read < 0) {
+            stats.error = "cannot read " + sources[s];
+            return stats;
+        }
+    }
+
+    std::sort(entries.begin(), entries.end(), [](const Entry& a, const Entry& b) {
+        return a.hash != b.hash ? a.hash < b.hash : a.game < b.game;
+    });
+
+    // ~8 entries per bucket keeps the binary search inside a cache line or two
+    const int width = static_cast<int>(std::bit_width(entries.size()));
+    const uint32_t bits = static_cast<uint32_t>(std::clamp(width - 3, 8, 26));
+    const size_t num_buckets = size_t{1} << bits;
+    std::vector<uint64_t> buckets(num_buckets + 1);
+    size_t e = 0;
+    for (size_t b = 0; b < num_buckets; ++b) {
+        buckets[b] = e;
+        while (e < entries.size() && (entries[e].hash >> (64 - bits)) == b) ++e;
+    }
+    buckets[num_buckets] = entries.size();
+
+    std::string names;
+    for (const auto& src : sources) names += src + "\n";
+
+    Header h{};
+    std::memcpy(h.magic, INDEX_MAGIC, sizeof(h.magic));
+    h.version = INDEX_VERSION;
+    h.bucket_bits = bits;
+    h.num_games = games.size();
+    h.num_entries = entries.size();
+    h.games_offset = sizeof(Header);
+    h.buckets_offset = h.games_offset + games.size() * sizeof(GameInfo);
+    h.entries_offset = h.buckets_offset + buckets.size() * sizeof(uint64_t);
+    h.sources_offset = h.entries_offset + entries.size() * sizeof(Entry);
+    h.sources_bytes = names.size();
+
+    std::string tmp = index_path + ".tmp";
+    {
+        std::ofstream out(tmp, std::ios::binary | std::ios::trunc);
+        if (!out.is_open()) {
+            stats.error = "cannot write " + tmp;
+            return stats;
+        }
+        out.write(reinterpret_cast<const char*>(&h), sizeof(h));
+        out.write(reinterpret_cast<const char*>(games.data()),
+                  static_cast<std::streamsize>(games.size() * sizeof(GameInfo)));
+        out.write(reinterpret_cast<const char*>(buckets.data()),
+                  static_cast<std::streamsize>(buckets.size() * sizeof(uint64_t)));
+        out.write(reinterpret_cast<const char*>(entries.data()),
+                  static_cast<std::streamsize>(entries.size() * sizeof(Entry)));
+        out.write(names.data(), static_cast<std::streamsize>(names.size()));
+        if (!out) {
+            stats.error = "write failed for " + tmp;
+            return stats;
+        }
+    }
+    std::error_code ec;
+    std::filesystem::rename(tmp, index_path, ec);
+    if (ec) {
+        stats.error = "cannot rename " + tmp + ": " + ec.message();
+        return stats;
+    }
+
+    stats.games = static_cast<long long>(games.size());
+    stats.positions = entries.size();
+    stats.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+    return stats;
+}
+
+bool PositionIndex::open(const std::string& index_path) {
+    header_ = nullptr;
+    sources_.clear();
+    if (!file_.open(index_path)) {
+        std::cerr << "Error: Cannot open file " << index_path << std::endl;
+        return false;
+    }
+    const uint8_t* base = file_.data();
+    const size_t size = file_.size();
+    const auto* h = reinterpret_cast<const Header*>(base);
+    // bucket_bits must be in 1..32: find() shifts by 64 - bucket_bits
+    if (size < sizeof(Header) || std::memcmp(h->magic, INDEX_MAGIC, sizeof(h->magic)) != 0 ||
+        h->version != INDEX_VERSION || h->bucket_bits == 0 || h->bucket_bits > 32 ||
+        !section_fits(h->games_offset, h->num_games, sizeof(GameInfo), size) ||
+        !section_fits(h->sources_offset, h->sources_bytes, 1, size) ||
+        !section_fits(h->entries_offset, h->num_entries, sizeof(Entry), size) ||
+        !section_fits(h->buckets_offset, (uint64_t{1} << h->bucket_bits) + 1, sizeof(uint64_t), size) ||
+        reinterpret_cast<const uint64_t*>(base + h->buckets_offset)[uint64_t{1} << h->bucket_bits] >
+            h->num_entries) {
+        std::cerr << "Error: " << index_path << " is not a position index" << std::endl;
+        file_.close();
+        return false;
+    }
+
+    header_ = h;
+    games_ = reinterpret_cast<const GameInfo*>(base + h->games_offset);
+    buckets_ = reinterpret_cast<const uint64_t*>(base + h->buckets_offset);
+    entries_ = reinterpret_cast<const Entry*>(base + h->entries_offset);
+
+    const char* names = reinterpret_cast<const char*>(base + h->sources_offset);
+    std::string current;
+    for (uint64_t i = 0; i < h->sources_bytes; ++i) {
+        if (names[i] == '\n') {
+            sources_.push_back(current);
+            current.clear();
+        } else {
+            current.push_back(names[i]);
+        }
+    }
+    return true;
+}
+
+std::pair<const PositionIndex::Entry*, const PositionIndex::Entry*> PositionIndex::find(uint64_t hash) const {
+    if (!header_) return {nullptr, nullptr};
+    const uint64_t bucket = hash >> (64 - header_->bucket_bits);
+    const Entry* lo = entries_ + buckets_[bucket];
+    const Entry* hi = entries_ + buckets_[bucket + 1];
+    lo = std::lower_bound(lo, hi, hash, [](const Entry& e, uint64_t h) { return e.hash < h; });
+    hi = std::upper_bound(lo, hi, hash, [](uint64_t h, const Entry& e) { return h < e.hash; });
+    return {lo, hi};
+}
+
+PositionIndex::Summary PositionIndex::summarize(const core::Board& board) const {
+    Summary s;
+    auto [first, last] = find(board);
+    long long margin = 0;
+    for (const Entry* e = first; e != last; ++e) {
+        const GameInfo& g = games_[e->game];
+        s.games++;
+        if (!g.has_result) {
+            s.unknown++;
+            continue;
+        }
+        margin += g.black_disc_diff;
+        if (g.black_disc_diff > 0) s.black_wins++;
+        else if (g.black_disc_diff < 0) s.white_wins++;
+        else s.draws++;
+    }
+    int decided = s.games - s.unknown;
+    s.mean_disc_diff = decided > 0 ? static_cast<double>(margin) / decided : 0.0;
+    return s;
+}
+
+} // namespace research
+} // namespace reversi
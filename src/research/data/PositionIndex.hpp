@@ -0,0 +1,127 @@
+/*
+ * PositionIndex.hpp - Memory-mapped position -> games index
+ * COMP390 Honours Year Project
+ *
+ * Built once from WTHOR / GGF archives: every position reached in every
+ * game (before each move, plus the final position) contributes an entry
+ * (Board::hash(), game, ply). Entries are sorted by hash and bucketed by
+ * the top hash bits, so a lookup is one bucket read plus a short binary
+ * search directly in the mapped file - no loading or parsing at query
+ * time.
+ *
+ * File layout (all fields host-endian, stored raw):
+ *   Header
+ *   GameInfo[num_games]          source file, offset, result, length
+ *   uint64_t[2^bucket_bits + 1]  first entry of each hash bucket
+ *   Entry[num_entries]           sorted by (hash, game)
+ *   source file names, '\n'-separated
+ *
+ * Hashes are 64-bit Zobrist keys (colour-absolute, side to move
+ * included); collisions are ignored.
+ *
+ * Author: Tianqixing
+ * Student ID: 201821852
+ */
+
+#pragma once
+
+#include "../../core/Board.hpp"
+#include "GameArchive.hpp"
+#include "MappedFile.hpp"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace reversi {
+namespace research {
+
+class PositionIndex {
+public:
+    struct GameInfo {
+        uint64_t offset;          ///< Byte offset of the game in its source file
+        uint32_t source;          ///< Index into sources()
+        int8_t black_disc_diff;   ///< Final black minus white discs
+        uint8_t num_moves;
+        uint8_t has_result;
+        uint8_t reserved;
+    };
+
+    struct Entry {
+        uint64_t hash;
+        uint32_t game;
+        uint16_t ply;             ///< Moves played before this position
+        uint16_t reserved;
+    };
+
+    /**
+     * @brief Aggregate over the games reaching a position
+     */
+    struct Summary {
+        int games = 0;
+        int black_wins = 0;
+        int white_wins = 0;
+        int draws = 0;
+        int unknown = 0;           ///< Games without a recorded result
+        double mean_disc_diff = 0.0;  ///< Black's mean final margin (games with a result)
+    };
+
+    struct BuildStats {
+        long long games = 0;           ///< Games indexed
+        long long skipped = 0;         ///< Games with an illegal move
+        uint64_t positions = 0;        ///< Index entries
+        double seconds = 0.0;
+        std::string error;
+    };
+
+    PositionIndex() = default;
+
+    /**
+     * @brief Import the archives and write an index file
+     */
+    static BuildStats build(const std::vector<std::string>& sources, const std::string& index_path);
+
+    /**
+     * @brief Map an index file
+     */
+    bool open(const std::string& index_path);
+
+    uint64_t num_games() const { return header_ ? header_->num_games : 0; }
+    uint64_t num_entries() const { return header_ ? header_->num_entries : 0; }
+    const std::vector<std::string>& sources() const { return sources_; }
+    const GameInfo& game(uint32_t i) const { return games_[i]; }
+
+    /**
+     * @brief Entries for a position hash, as [first, last) pointers into the mapping
+     */
+    std::pair<const Entry*, const Entry*> find(uint64_t hash) const;
+    std::pair<const Entry*, const Entry*> find(const core::Board& board) const { return find(board.hash()); }
+
+    /**
+     * @brief Results of all games reaching a position
+     */
+    Summary summarize(const core::Board& board) const;
+
+private:
+    struct Header {
+        char magic[8];
+        uint32_t version;
+        uint32_t bucket_bits;
+        uint64_t num_games;
+        uint64_t num_entries;
+        uint64_t games_offset;
+        uint64_t buckets_offset;
+        uint64_t entries_offset;
+        uint64_t sources_offset;
+        uint64_t sources_bytes;
+    };
+
+    MappedFile file_;
+    const Header* header_ = nullptr;
+    const GameInfo* games_ = nullptr;
+    const uint64_t* buckets_ = nullptr;
+    const Entry* entries_ = nullptr;
+    std::vector<std::string> sources_;
+};
+
+} // namespace research
+} // namespace reversi
@@ -0,0 +1,170 @@
+/*
+ * SelfPlayGenerator.cpp - Multi-threaded self-play data generation
+ * COMP390 Honours Year Project
+ *
+ * Author: Tianqixing
+ * Student ID: 201821852
+ */
+
+#include "SelfPlayGenerator.hpp"
+#include "../benchmark/MatchEngine.hpp"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <exception>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <stdexcept>
+#include <thread>
+
+namespace reversi {
+namespace research {
+
+SelfPlayGenerator::SelfPlayGenerator(std::vector<EngineSpec> engines, Config config)
+    : engines_(std::move(engines)), config_(std::move(config)) {}
+
+GameRecord SelfPlayGenerator::play_game(ai::AIStrategy& black, const ai::SearchLimits& black_limits,
+                                        ai::AIStrategy& white, const ai::SearchLimits& white_limits,
+                                        uint64_t opening_seed, int random_plies) {
+    GameRecord game;
+    core::Board board;
+    std::mt19937_64 rng(opening_seed ^ 0xA5A5A5A5A5A5A5A5ULL);
+    std::vector<int> moves;
+
+    while (!board.is_terminal()) {
+        moves.clear();
+        board.get_legal_moves(moves);
+        if (moves.empty()) {
+            board.pass();
+            continue;
+        }
+
+        int square;
+        int score = 0;
+        if (static_cast<int>(game.moves.size()) < random_plies) {
+            std::uniform_int_distribution<size_t> dist(0, moves.size() - 1);
+            square = moves[dist(rng)];
+            game.opening_plies++;
+        } else {
+            bool black_to_move = board.side_to_move() == 0;
+            ai::AIStrategy& engine = black_to_move ? black : white;
+            core::Move best = engine.find_best_move(board, black_to_move ? black_limits : white_limits);
+            square = best.position;
+            score = engine.get_stats().score;
+            // Same fallback as MatchEngine for an illegal answer
+            if (std::find(moves.begin(), moves.end(), square) == moves.end()) square = moves[0];
+        }
+        game.moves.push_back(static_cast<uint8_t>(square));
+        game.scores.push_back(score);
+        board.make_move(square);
+    }
+
+    int diff = board.count_player() - board.count_opponent();
+    game.black_disc_diff = board.side_to_move() == 0 ? diff : -diff;
+    return game;
+}
+
+SelfPlayGenerator::Result SelfPlayGenerator::run() {
+    Result result;
+    if (engines_.empty()) {
+        result.error = "no engines";
+        return result;
+    }
+
+    ShardWriter writer;
+    if (!writer.open(config_.output_dir, config_.shard_bytes)) {
+        result.error = "cannot create " + config_.output_dir;
+        return result;
+    }
+
+    const int total = std::max(0, config_.games);
+    const int n = static_cast<int>(engines_.size());
+    int num_threads = config_.num_threads;
+    if (num_threads <= 0) {
+        num_threads = static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+    }
+    num_threads = std::max(1, std::min(num_threads, total));
+
+    std::atomic<int> next{0};
+    std::mutex write_mutex;  // Guards writer, reorder buffer and console output
+    std::map<int, GameRecord> finished;  // Games waiting for their predecessors
+    int next_to_write = 0;
+    std::exception_ptr failure;
+    auto start = std::chrono::steady_clock::now();
+
+    auto worker = [&]() {
+        try {
+            std::vector<std::unique_ptr<ai::AIStrategy>> engines(engines_.size());
+            auto engine = [&](int i) -> ai::AIStrategy& {
+                if (!engines[i]) engines[i] = engines_[i].factory();
+                return *engines[i];
+            };
+
+            for (;;) {
+                int g = next.fetch_add(1);
+                if (g >= total) break;
+                int b = g % n;
+                int w = (g / n) % n;
+                // Fresh state per game (as MatchEngine does) so a game does
+                // not depend on what this worker played before
+                ai::AIStrategy& black = engine(b);
+                black.reset();
+                black.set_seed(MatchEngine::game_seed(config_.seed, g, 1));
+                ai::AIStrategy& white = (w == b) ? black : engine(w);
+                if (w != b) {
+                    white.reset();
+                    white.set_seed(MatchEngine::game_seed(config_.seed, g, 2));
+                }
+
+                GameRecord game = play_game(black, engines_[b].limits, white, engines_[w].limits,
+                                            MatchEngine::game_seed(config_.seed, g, 0),
+                                            config_.random_plies);
+
+                std::lock_guard<std::mutex> lock(write_mutex);
+                finished.emplace(g, std::move(game));
+                while (!finished.empty() && finished.begin()->first == next_to_write) {
+                    if (!writer.add(finished.begin()->second)) {
+                        throw std::runtime_error("write failed in " + config_.output_dir);
+                    }
+                    finished.erase(finished.begin());
+                    ++next_to_write;
+                    if (config_.progress_every > 0 && next_to_write % config_.progress_every == 0) {
+                        double secs = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+                        std::cout << "[SelfPlay] " << next_to_write << "/" << total << " games, "
+                                  << writer.positions() << " positions (" << std::fixed
+                                  << std::setprecision(1) << (secs > 0 ? next_to_write / secs : 0.0)
+                                  << " games/s)" << std::endl;
+                    }
+                }
+            }
+        } catch (...) {
+            std::lock_guard<std::mutex> lock(write_mutex);
+            if (!failure) failure = std::current_exception();
+            next.store(total);
+        }
+    };
+
+    std::vector<std::thread> pool;
+    pool.reserve(num_threads - 1);
+    for (int i = 1; i < num_threads; ++i) pool.emplace_back(worker);
+    worker();
+    for (auto& t : pool) t.join();
+
+    bool closed = writer.close();
+    if (failure) std::rethrow_exception(failure);
+    if (!closed) result.error = "cannot write index in " + config_.output_dir;
+
+    result.games = static_cast<int>(writer.games());
+    result.positions = writer.positions();
+    result.shards = writer.shards();
+    result.bytes = writer.bytes();
+    result.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    return result;
+}
+
+} // namespace research
+} // namespace reversi
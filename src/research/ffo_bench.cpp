@@ -0,0 +1,84 @@
+/*
+ * ffo_bench.cpp - Endgame solver benchmark on FFO-style suites
+ * COMP390 Honours Year Project
+ *
+ * Solves each position of an OBF suite exactly and checks it against
+ * the reference score on the line. The classic test is FFO #40-#59
+ * (fforum-40-59.obf as distributed with Edax: "<board> <side>; G8:+38;");
+ * tests/data/ffo-40-42.obf bundles #40 and #42. Positions are labelled by
+ * their id "#40"; op, or by file line when they have none.
+ *
+ * Usage:
+ *   reversi_ffo <suite.obf> [--count N] [--max-empties E]
+ *               [--tt-bits B] [--csv file] [--json file] [--solves-csv file]
+ */
+
+#include "benchmark/Benchmark.hpp"
+#include "data/PositionFile.hpp"
+#include <algorithm>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace reversi::research;
+
+namespace {
+
+void print_usage() {
+    std::cout << "Usage: reversi_ffo <suite.obf> [options]\n"
+              << "  --count <n>           Solve only the first n positions\n"
+              << "  --max-empties <n>     Skip positions with more empty squares\n"
+              << "  --tt-bits <n>         Transposition table size 2^n (default 22)\n"
+              << "  --csv <file>          Summary CSV\n"
+              << "  --json <file>         Summary and per-position JSON\n"
+              << "  --solves-csv <file>   One CSV row per position\n"
+              << "Example: reversi_ffo fforum-40-59.obf --json ffo.json\n";
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    if (argc < 2 || std::string(argv[1]) == "--help") {
+        print_usage();
+        return argc < 2 ? 1 : 0;
+    }
+    const std::string suite_path = argv[1];
+    EndgameSuiteConfig config;
+    int count = 0;
+    std::string csv, json, solves_csv;
+    for (int i = 2; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (i + 1 >= argc) {
+            print_usage();
+            return 1;
+        }
+        if (arg == "--count") count = std::atoi(argv[++i]);
+        else if (arg == "--max-empties") config.max_empties = std::atoi(argv[++i]);
+        else if (arg == "--tt-bits") config.tt_bits = std::clamp(std::atoi(argv[++i]), 10, 24);
+        else if (arg == "--csv") csv = argv[++i];
+        else if (arg == "--json") json = argv[++i];
+        else if (arg == "--solves-csv") solves_csv = argv[++i];
+        else {
+            print_usage();
+            return 1;
+        }
+    }
+
+    std::vector<PositionFile::Position> suite;
+    auto stats = PositionFile::load(suite_path, suite);
+    if (!stats.error.empty()) return 1;
+    if (stats.errors > 0) std::cerr << "Warning: " << stats.errors << " malformed line(s) skipped\n";
+    if (count > 0 && static_cast<size_t>(count) < suite.size()) suite.resize(static_cast<size_t>(count));
+    config.labels = PositionFile::load_ids(suite_path, suite);
+    std::cout << "Solving " << suite.size() << " position(s) from " << suite_path << "\n\n";
+
+    std::vector<BenchmarkResult> results{Benchmark::run_endgame_suite(suite, config)};
+    if (!csv.empty()) Benchmark::export_results(results, "csv", csv);
+    if (!json.empty()) Benchmark::export_results(results, "json", json);
+    if (!solves_csv.empty()) Benchmark::export_results(results, "solves_csv", solves_csv);
+
+    // Exit 2 on a wrong score, or when no position had a score to check
+    const auto& r = results[0];
+    return r.positions_checked > 0 && r.positions_correct == r.positions_checked ? 0 : 2;
+}
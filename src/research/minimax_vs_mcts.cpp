@@ -15,6 +15,7 @@
 #include "ai/MCTSEngine.hpp"
 #include <iostream>
 #include <iomanip>
+#include <string>
 
 using namespace reversi::research;
 using namespace reversi::ai;
@@ -58,6 +59,16 @@ void print_match_result(const MatchEngine::MatchResult& result) {
     std::cout << "    Avg time/move: " << std::setprecision(2) 
               << result.avg_player2_time_ms << " ms\n";
     
+    if (result.sprt.pairs > 0) {
+        std::cout << "\nSPRT (pentanomial, " << result.sprt.pairs << " pairs):\n";
+        std::cout << "  LLR: " << std::setprecision(2) << result.sprt.llr
+                  << " [" << result.sprt.lower_bound << ", " << result.sprt.upper_bound << "]\n";
+        std::cout << "  Decision: " << result.sprt.decision_name()
+                  << (result.stopped_early ? " (stopped early)" : "") << "\n";
+        std::cout << "  Elo: " << std::setprecision(1) << result.sprt.elo
+                  << " +/- " << result.sprt.elo_ci95 << "\n";
+    }
+    
     std::cout << std::string(60, '=') << "\n";
 }
 
@@ -78,8 +89,11 @@ int main(int argc, char* argv[]) {
         alternate_colors = (std::atoi(argv[2]) != 0);
     }
     
+    // "sprt": num_games becomes the maximum, stop at the SPRT decision
+    bool use_sprt = (argc > 3 && std::string(argv[3]) == "sprt");
+    
     std::cout << "Configuration:\n";
-    std::cout << "  Number of games: " << num_games << "\n";
+    std::cout << "  Number of games: " << num_games << (use_sprt ? " (max, SPRT elo0=0 elo1=50)" : "") << "\n";
     std::cout << "  Alternate colors: " << (alternate_colors ? "Yes" : "No") << "\n";
     std::cout << "\nStarting experiment...\n\n";
     
@@ -93,12 +107,11 @@ int main(int argc, char* argv[]) {
     // MCTS uses simulation count, not depth
     
     // Run comparison
-    MatchEngine::MatchResult result = Benchmark::compare_minimax_vs_mcts(
-        minimax_limits,
-        mcts_limits,
-        num_games,
-        alternate_colors
-    );
+    MatchEngine::MatchResult result = use_sprt
+        ? Benchmark::compare_minimax_vs_mcts(minimax_limits, mcts_limits,
+                                             Statistics::SPRTConfig(0.0, 50.0), num_games)
+        : Benchmark::compare_minimax_vs_mcts(minimax_limits, mcts_limits,
+                                             num_games, alternate_colors);
     
     // Print results
     print_match_result(result);
@@ -0,0 +1,469 @@
+/*
+ * perft.cpp - Perft and unique-position counting tool
+ * COMP390 Honours Year Project
+ *
+ * Validates and benchmarks move generation end to end:
+ * - Leaf counting to depth N with bulk counting at the last ply
+ *   (popcount of legal_moves(), no make/undo at the frontier)
+ * - Optional shared hash table of subtree counts (lockless XOR scheme)
+ * - Multi-threaded splitting at the root (and ply 2 when the root is narrow)
+ * - Per-move breakdown ("divide") and nodes/sec
+ * - Verification against the published Othello perft numbers
+ * - Unique-position counting per ply (level-by-level deduplication)
+ *
+ * Conventions (match the published numbers):
+ * - A forced pass counts as one ply
+ * - A finished game reached before depth N counts as one leaf
+ *
+ * Usage:
+ *   reversi_perft [depth] [--moves e3f3] [--threads N] [--hash-bits B]
+ *                 [--verify] [--unique]
+ */
+
+#include "core/Board.hpp"
+#include "core/Move.hpp"
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+#include <algorithm>
+
+using namespace reversi::core;
+
+namespace {
+
+// Published perft values from the standard starting position (OEIS A124004)
+constexpr uint64_t KNOWN_PERFT[] = {
+    1ULL, 4ULL, 12ULL, 56ULL, 244ULL, 1396ULL, 8200ULL, 55092ULL, 390216ULL,
+    3005288ULL, 24571284ULL, 212258800ULL, 1939886636ULL, 18429641748ULL,
+    184042084512ULL
+};
+constexpr int KNOWN_PERFT_MAX = static_cast<int>(sizeof(KNOWN_PERFT) / sizeof(KNOWN_PERFT[0])) - 1;
+
+// ==================== Subtree Count Table ====================
+
+/**
+ * @brief Shared transposition table of subtree leaf counts
+ *
+ * Each slot stores (key ^ count, count) in two relaxed atomics. A torn
+ * write from another thread fails the XOR check and reads as a miss, so
+ * no locks are needed.
+ */
+class PerftTable {
+public:
+    explicit PerftTable(int size_bits)
+        : mask_((1ULL << size_bits) - 1),
+          slots_(std::make_unique<Slot[]>(1ULL << size_bits)) {
+        uint64_t x = 0x9E3779B97F4A7C15ULL;
+        for (uint64_t& k : depth_keys_) {
+            // splitmix64 sequence: independent per-depth salts
+            x += 0x9E3779B97F4A7C15ULL;
+            uint64_t z = x;
+            z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+            z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+            k = z ^ (z >> 31);
+        }
+    }
+
+    uint64_t key(const Board& board, int depth) const {
+        return board.hash() ^ depth_keys_[depth];
+    }
+
+    bool probe(uint64_t key, uint64_t& count) const {
+        const Slot& s = slots_[key & mask_];
+        uint64_t data = s.data.load(std::memory_order_relaxed);
+        uint64_t check = s.key_xor_data.load(std::memory_order_relaxed);
+        if ((check ^ data) != key) return false;
+        count = data;
+        return true;
+    }
+
+    void store(uint64_t key, uint64_t count) {
+        Slot& s = slots_[key & mask_];
+        s.key_xor_data.store(key ^ count, std::memory_order_relaxed);
+        s.data.store(count, std::memory_order_relaxed);
+    }
+
+private:
+    struct Slot {
+        std::atomic<uint64_t> key_xor_data{0};
+        std::atomic<uint64_t> data{0};
+    };
+
+    uint64_t mask_;
+    std::unique_ptr<Slot[]> slots_;
+    uint64_t depth_keys_[64];
+};
+
+// ==================== Perft Core ====================
+
+/**
+ * @brief Count leaves below board at given depth
+ * @param table Optional subtree count table (nullptr = disabled)
+ */
+uint64_t perft(Board& board, int depth, PerftTable* table) {
+    uint64_t moves = board.legal_moves();
+
+    if (moves == 0) {
+        // Pass (one ply) or game over (leaf)
+        board.pass();
+        bool game_over = board.legal_moves() == 0;
+        uint64_t n = (game_over || depth == 1) ? 1 : perft(board, depth - 1, table);
+        board.pass();
+        return n;
+    }
+
+    // Bulk counting at the frontier
+    if (depth == 1) {
+        return static_cast<uint64_t>(std::popcount(moves));
+    }
+
+    uint64_t key = 0;
+    if (table && depth >= 3) {
+        key = table->key(board, depth);
+        uint64_t cached;
+        if (table->probe(key, cached)) return cached;
+    }
+
+    uint64_t nodes = 0;
+    while (moves) {
+        int pos = std::countr_zero(moves);
+        moves &= moves - 1;
+        uint64_t prev_p = board.get_player_bb();
+        uint64_t prev_o = board.get_opponent_bb();
+        uint64_t prev_hash = board.hash();
+        board.apply_move_no_history(pos);
+        nodes += perft(board, depth - 1, table);
+        board.restore_state(prev_p, prev_o, prev_hash);
+    }
+
+    if (table && depth >= 3) {
+        table->store(key, nodes);
+    }
+    return nodes;
+}
+
+/**
+ * @brief Root children, with Move::PASS standing in for a forced pass
+ */
+std::vector<int> root_moves(const Board& board) {
+    std::vector<int> moves;
+    board.get_legal_moves(moves);
+    if (moves.empty()) {
+        Board tmp = board;
+        tmp.pass();
+        if (tmp.legal_moves() != 0) moves.push_back(Move::PASS);
+    }
+    return moves;
+}
+
+Board play(const Board& board, int move) {
+    Board next = board.copy();
+    if (move == Move::PASS) {
+        next.pass();
+    } else {
+        next.apply_move_no_history(move);
+    }
+    return next;
+}
+
+struct DivideResult {
+    std::vector<int> moves;
+    std::vector<uint64_t> counts;
+    uint64_t total = 0;
+    double time_ms = 0.0;
+};
+
+/**
+ * @brief Perft with per-root-move breakdown, split across worker threads
+ *
+ * Work items are root moves, or (root move, reply) pairs when the root has
+ * fewer moves than 2x the thread count, so 4-move openings still use all cores.
+ */
+DivideResult divide(const Board& board, int depth, int num_threads, PerftTable* table) {
+    using Clock = std::chrono::high_resolution_clock;
+    auto start = Clock::now();
+
+    DivideResult result;
+    result.moves = root_moves(board);
+
+    if (depth <= 0 || result.moves.empty()) {
+        result.total = 1;  // Depth 0 or game over: the root is the leaf
+        result.time_ms = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+        return result;
+    }
+
+    struct Task {
+        size_t root_index;
+        Board board;
+        int depth;
+    };
+    std::vector<Task> tasks;
+
+    bool split_ply2 = depth >= 3 &&
+                      static_cast<int>(result.moves.size()) < 2 * num_threads;
+    for (size_t i = 0; i < result.moves.size(); ++i) {
+        Board child = play(board, result.moves[i]);
+        if (!split_ply2) {
+            tasks.push_back({i, child, depth - 1});
+            continue;
+        }
+        std::vector<int> replies = root_moves(child);
+        if (replies.empty()) {
+            tasks.push_back({i, child, depth - 1});  // Game over: counted as leaf
+            continue;
+        }
+        for (int reply : replies) {
+            tasks.push_back({i, play(child, reply), depth - 2});
+        }
+    }
+
+    std::vector<std::atomic<uint64_t>> counts(result.moves.size());
+    for (auto& c : counts) c.store(0);
+    std::atomic<size_t> next_task{0};
+
+    auto worker = [&]() {
+        for (;;) {
+            size_t t = next_task.fetch_add(1);
+            if (t >= tasks.size()) break;
+            Task& task = tasks[t];
+            uint64_t n;
+            if (task.depth == 0) {
+                n = 1;
+            } else if (task.board.is_terminal()) {
+                n = 1;
+            } else {
+                n = perft(task.board, task.depth, table);
+            }
+            counts[task.root_index].fetch_add(n);
+        }
+    };
+
+    int workers = std::max(1, std::min<int>(num_threads, static_cast<int>(tasks.size())));
+    std::vector<std::thread> pool;
+    for (int i = 1; i < workers; ++i) pool.emplace_back(worker);
+    worker();
+    for (auto& th : pool) th.join();
+
+    for (auto& c : counts) {
+        result.counts.push_back(c.load());
+        result.total += result.counts.back();
+    }
+    result.time_ms = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+    return result;
+}
+
+// ==================== Unique Positions ====================
+
+struct PackedPosition {
+    uint64_t hash;
+    uint64_t player;
+    uint64_t opponent;
+
+    bool operator<(const PackedPosition& o) const {
+        if (hash != o.hash) return hash < o.hash;
+        if (player != o.player) return player < o.player;
+        return opponent < o.opponent;
+    }
+    bool operator==(const PackedPosition& o) const {
+        return hash == o.hash && player == o.player && opponent == o.opponent;
+    }
+};
+
+/**
+ * @brief Count distinct positions reached after exactly n plies, n = 1..depth
+ *
+ * Expands each ply from the deduplicated previous ply, so transpositions are
+ * expanded once. Finished games have no successors.
+ */
+void count_unique(const Board& board, int depth) {
+    using Clock = std::chrono::high_resolution_clock;
+
+    std::vector<PackedPosition> level{{board.hash(), board.player, board.opponent}};
+    std::cout << std::left << std::setw(6) << "Ply" << std::right
+              << std::setw(16) << "Unique" << std::setw(14) << "Time(ms)" << "\n";
+
+    for (int ply = 1; ply <= depth; ++ply) {
+        auto start = Clock::now();
+        std::vector<PackedPosition> next;
+        next.reserve(level.size() * 8);
+
+        for (const PackedPosition& pp : level) {
+            Board b(pp.player, pp.opponent);
+            if (pp.hash & 1ULL) {
+                // Re-establish side to move (bit 0 of the hash)
+                b.pass();
+                b.set_player_opponent(pp.player, pp.opponent);
+            }
+            uint64_t moves = b.legal_moves();
+            if (moves == 0) {
+                b.pass();
+                if (b.legal_moves() != 0) next.push_back({b.hash(), b.player, b.opponent});
+                continue;
+            }
+            while (moves) {
+                int pos = std::countr_zero(moves);
+                moves &= moves - 1;
+                Board child = b;
+                child.apply_move_no_history(pos);
+                next.push_back({child.hash(), child.player, child.opponent});
+            }
+        }
+
+        std::sort(next.begin(), next.end());
+        next.erase(std::unique(next.begin(), next.end()), next.end());
+        level.swap(next);
+
+        double ms = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+        std::cout << std::left << std::setw(6) << ply << std::right
+                  << std::setw(16) << level.size()
+                  << std::setw(14) << std::fixed << std::setprecision(1) << ms << "\n";
+    }
+}
+
+// ==================== Command Line ====================
+
+struct Options {
+    int depth = 8;
+    int threads = 0;          ///< 0 = hardware concurrency
+    int hash_bits = 22;       ///< 0 = no subtree table
+    bool verify = false;
+    bool unique = false;
+    std::string moves;
+};
+
+void print_usage() {
+    std::cout << "Usage: reversi_perft [depth] [options]\n"
+              << "  --moves <seq>     Start from position after moves, e.g. e3f3\n"
+              << "  --threads <n>     Worker threads (default: all cores)\n"
+              << "  --hash-bits <b>   Subtree table size 2^b, 0 disables (default: 22)\n"
+              << "  --verify          Check depths 1..depth against known perft numbers\n"
+              << "  --unique          Count unique positions per ply instead of leaves\n";
+}
+
+bool parse_moves(const std::string& seq, Board& board) {
+    for (size_t i = 0; i + 1 < seq.size(); i += 2) {
+        Move m = Move::from_string(seq.substr(i, 2));
+        if (!m.is_valid() || board.calc_flip(m.position) == 0) {
+            // Allow an implicit pass when the side to move has no moves
+            if (board.legal_moves() == 0) {
+                board.pass();
+                if (m.is_valid() && board.calc_flip(m.position) != 0) {
+                    board.make_move(m.position);
+                    continue;
+                }
+            }
+            std::cerr << "Illegal move in sequence: " << seq.substr(i, 2) << "\n";
+            return false;
+        }
+        board.make_move(m.position);
+    }
+    return true;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    Options opt;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--help" || arg == "-h") {
+            print_usage();
+            return 0;
+        } else if (arg == "--moves" && i + 1 < argc) {
+            opt.moves = argv[++i];
+        } else if (arg == "--threads" && i + 1 < argc) {
+            opt.threads = std::atoi(argv[++i]);
+        } else if (arg == "--hash-bits" && i + 1 < argc) {
+            opt.hash_bits = std::atoi(argv[++i]);
+        } else if (arg == "--verify") {
+            opt.verify = true;
+        } else if (arg == "--unique") {
+            opt.unique = true;
+        } else if (!arg.empty() && arg[0] != '-') {
+            opt.depth = std::atoi(arg.c_str());
+        } else {
+            print_usage();
+            return 1;
+        }
+    }
+    if (opt.threads <= 0) {
+        opt.threads = std::max(1u, std::thread::hardware_concurrency());
+    }
+    opt.hash_bits = std::clamp(opt.hash_bits, 0, 30);
+    opt.depth = std::clamp(opt.depth, 0, 60);
+
+    Board board;
+    if (!opt.moves.empty() && !parse_moves(opt.moves, board)) {
+        return 1;
+    }
+
+    std::unique_ptr<PerftTable> table;
+    if (opt.hash_bits > 0) {
+        table = std::make_unique<PerftTable>(opt.hash_bits);
+    }
+
+    std::cout << "========================================\n";
+    std::cout << "Reversi Perft\n";
+    std::cout << "========================================\n";
+    board.print();
+    std::cout << "Threads: " << opt.threads
+              << ", hash table: " << (table ? "2^" + std::to_string(opt.hash_bits) : std::string("off"))
+              << "\n\n";
+
+    if (opt.unique) {
+        count_unique(board, opt.depth);
+        return 0;
+    }
+
+    if (opt.verify) {
+        if (!opt.moves.empty()) {
+            std::cerr << "--verify checks the standard starting position; ignoring --moves\n";
+            board = Board();
+        }
+        int max_depth = std::min(opt.depth, KNOWN_PERFT_MAX);
+        int failures = 0;
+        std::cout << std::left << std::setw(6) << "Depth" << std::right
+                  << std::setw(16) << "Nodes" << std::setw(16) << "Expected"
+                  << std::setw(12) << "Time(ms)" << std::setw(14) << "Mnodes/s" << "  Result\n";
+        for (int d = 1; d <= max_depth; ++d) {
+            DivideResult r = divide(board, d, opt.threads, table.get());
+            bool ok = r.total == KNOWN_PERFT[d];
+            failures += ok ? 0 : 1;
+            double mnps = r.time_ms > 0 ? r.total / (r.time_ms * 1000.0) : 0.0;
+            std::cout << std::left << std::setw(6) << d << std::right
+                      << std::setw(16) << r.total << std::setw(16) << KNOWN_PERFT[d]
+                      << std::setw(12) << std::fixed << std::setprecision(1) << r.time_ms
+                      << std::setw(14) << std::setprecision(2) << mnps
+                      << "  " << (ok ? "OK" : "MISMATCH") << "\n";
+        }
+        std::cout << (failures == 0 ? "\nAll perft values match.\n" : "\nPerft verification FAILED.\n");
+        return failures == 0 ? 0 : 1;
+    }
+
+    DivideResult r = divide(board, opt.depth, opt.threads, table.get());
+    std::cout << "Depth " << opt.depth << " breakdown:\n";
+    for (size_t i = 0; i < r.moves.size(); ++i) {
+        std::cout << "  " << std::left << std::setw(6) << Move(r.moves[i]).to_string()
+                  << std::right << std::setw(16) << r.counts[i] << "\n";
+    }
+    double nps = r.time_ms > 0 ? r.total * 1000.0 / r.time_ms : 0.0;
+    std::cout << "\nNodes:   " << r.total << "\n";
+    std::cout << "Time:    " << std::fixed << std::setprecision(1) << r.time_ms << " ms\n";
+    std::cout << "Speed:   " << std::setprecision(2) << nps / 1e6 << " M nodes/sec\n";
+    if (opt.moves.empty() && opt.depth <= KNOWN_PERFT_MAX) {
+        bool ok = r.total == KNOWN_PERFT[opt.depth];
+        std::cout << "Check:   " << (ok ? "matches" : "DOES NOT MATCH") << " known value "
+                  << KNOWN_PERFT[opt.depth] << "\n";
+        return ok ? 0 : 1;
+    }
+    return 0;
+}
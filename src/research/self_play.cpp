@@ -4,12 +4,17 @@
  * 
  * Tests Week 4 enhanced evaluator against Week 3 baseline
  * Collects statistics: win rate, game length, performance
+ * 
+ * Evaluators are BoardEvaluator types plugged into the real MinimaxEngine
+ * (alpha-beta + TT) via UseEvaluator, so comparisons use the same
+ * optimized search as play.
  */
 
 #include "core/Board.hpp"
 #include "ai/MinimaxEngine.hpp"
 #include "ai/Evaluator.hpp"           // Week 3 version
 #include "ai/Evaluator_Week4.hpp"     // Week 4 version
+#include "ai/EvaluatorConcept.hpp"
 #include <iostream>
 #include <iomanip>
 #include <chrono>
@@ -45,47 +50,32 @@ struct Statistics {
     std::vector<int> score_diffs;
 };
 
-// Play one game between two evaluators
+// Play one game between two engines (player1_black selects who moves first)
 GameResult play_game(
-    int (*eval1)(const Board&),
-    int (*eval2)(const Board&),
-    int depth,
+    MinimaxEngine& player1,
+    MinimaxEngine& player2,
+    bool player1_black,
     bool verbose = false)
 {
     Board board;  // Default constructor initializes standard opening
     int move_count = 0;
+    player1.reset();
+    player2.reset();
     
     auto start = std::chrono::high_resolution_clock::now();
     
     while (!board.is_terminal()) {
-        auto moves = board.get_legal_moves();
-        
-        if (moves.empty()) {
+        if (board.legal_moves() == 0) {
             board.pass();
             continue;
         }
         
-        // Choose evaluator based on current player
-        auto evaluator = (move_count % 2 == 0) ? eval1 : eval2;
-        
-        // Simple minimax search (no alpha-beta for fairness)
-        int best_move = moves[0];
-        int best_score = -999999;
-        
-        for (int move : moves) {
-            Board next = board;
-            next.make_move(move);
-            
-            // Evaluate from next player's perspective (negamax style)
-            int score = -evaluator(next);
-            
-            if (score > best_score) {
-                best_score = score;
-                best_move = move;
-            }
-        }
+        // Side 0 (black) moves first
+        bool black_to_move = board.side_to_move() == 0;
+        MinimaxEngine& engine = (black_to_move == player1_black) ? player1 : player2;
         
-        board.make_move(best_move);
+        auto result = engine.find_best_move(board);
+        board.make_move(result.best_move);
         move_count++;
         
         if (verbose && move_count % 10 == 0) {
@@ -97,23 +87,16 @@ GameResult play_game(
     auto end = std::chrono::high_resolution_clock::now();
     auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(end - start);
     
-    // Determine winner
+    // Disc difference from black's perspective
     int diff = board.count_player() - board.count_opponent();
-    // Note: count_player returns count of LAST player who moved
-    // Need to adjust based on move count parity
+    if (board.side_to_move() != 0) diff = -diff;
+    int player1_diff = player1_black ? diff : -diff;
     
     GameResult result;
     result.final_score_diff = std::abs(diff);
     result.move_count = move_count;
     result.duration_ms = duration.count();
-    
-    if (diff > 0) {
-        result.winner = (move_count % 2 == 0) ? -1 : 1;
-    } else if (diff < 0) {
-        result.winner = (move_count % 2 == 0) ? 1 : -1;
-    } else {
-        result.winner = 0;
-    }
+    result.winner = (player1_diff > 0) ? 1 : (player1_diff < 0 ? -1 : 0);
     
     if (verbose) {
         std::cout << "\n";
@@ -122,21 +105,6 @@ GameResult play_game(
     return result;
 }
 
-// Week 3 evaluator wrapper
-int eval_week3(const Board& board) {
-    return Evaluator::evaluate(board);
-}
-
-// Week 4 evaluator wrapper
-int eval_week4(const Board& board) {
-    return EvaluatorWeek4::evaluate(board);
-}
-
-// Week 4 fast evaluator wrapper
-int eval_week4_fast(const Board& board) {
-    return EvaluatorWeek4::evaluate_fast(board);
-}
-
 void print_statistics(const Statistics& stats, int total_games) {
     std::cout << CYAN << "\n╔════════════════════════════════════════╗\n";
     std::cout << "║  Statistics                            ║\n";
@@ -169,28 +137,33 @@ void print_statistics(const Statistics& stats, int total_games) {
     }
 }
 
-void run_experiment(const char* name, 
-                   int (*eval1)(const Board&),
-                   int (*eval2)(const Board&),
-                   const char* name1,
-                   const char* name2,
-                   int num_games,
-                   int depth)
+/**
+ * @brief Play num_games between two evaluators with the full MinimaxEngine
+ * 
+ * Each side searches with its own evaluator instantiation (no virtual
+ * dispatch in the node loop). Colours alternate every game.
+ */
+template <BoardEvaluator Eval1, BoardEvaluator Eval2>
+void run_experiment(const char* name,
+                    int num_games,
+                    int depth1,
+                    int depth2)
 {
     std::cout << BOLD << CYAN << "\n╔════════════════════════════════════════╗\n";
-    std::cout << "║  " << name << std::string(38 - strlen(name), ' ') << "║\n";
+    std::cout << "║  " << name << std::string(std::max<int>(0, 38 - static_cast<int>(strlen(name))), ' ') << "║\n";
     std::cout << "╚════════════════════════════════════════╝\n" << RESET;
-    std::cout << "Player 1: " << name1 << "\n";
-    std::cout << "Player 2: " << name2 << "\n";
-    std::cout << "Depth: " << depth << "\n";
+    std::cout << "Player 1: " << Eval1::name() << " (depth " << depth1 << ")\n";
+    std::cout << "Player 2: " << Eval2::name() << " (depth " << depth2 << ")\n";
     std::cout << "Games: " << num_games << "\n";
     
+    MinimaxEngine player1(MinimaxEngine::Config(depth1), UseEvaluator<Eval1>{});
+    MinimaxEngine player2(MinimaxEngine::Config(depth2), UseEvaluator<Eval2>{});
     Statistics stats;
     
     std::cout << "\nProgress: ";
     
     for (int i = 0; i < num_games; ++i) {
-        GameResult result = play_game(eval1, eval2, depth, true);
+        GameResult result = play_game(player1, player2, i % 2 == 0, false);
         
         if (result.winner == 1) {
             stats.player1_wins++;
@@ -210,10 +183,11 @@ void run_experiment(const char* name,
     
     std::cout << "\n";
     
-    stats.avg_game_length /= num_games;
-    stats.avg_duration_ms /= num_games;
-    
-    print_statistics(stats, num_games);
+    if (num_games > 0) {
+        stats.avg_game_length /= num_games;
+        stats.avg_duration_ms /= num_games;
+        print_statistics(stats, num_games);
+    }
 }
 
 int main(int argc, char* argv[]) {
@@ -229,37 +203,19 @@ int main(int argc, char* argv[]) {
     }
     
     // Experiment 1: Week 4 vs Week 3 (same depth)
-    run_experiment(
+    run_experiment<EvaluatorWeek4, Evaluator>(
         "Experiment 1: Week 4 vs Week 3 (depth 5)",
-        eval_week4,
-        eval_week3,
-        "Week 4 Enhanced",
-        "Week 3 Baseline",
-        num_games,
-        5
-    );
+        num_games, 5, 5);
     
     // Experiment 2: Week 4 Fast vs Week 3 (higher depth for Week 4)
-    run_experiment(
-        "Experiment 2: Week 4 Fast (depth 6) vs Week 3 (depth 5)",
-        eval_week4_fast,
-        eval_week3,
-        "Week 4 Fast (d=6)",
-        "Week 3 Baseline (d=5)",
-        num_games / 2,  // Fewer games (slower)
-        5
-    );
+    run_experiment<EvaluatorWeek4Fast, Evaluator>(
+        "Experiment 2: Week 4 Fast (d=6) vs Week 3 (d=5)",
+        num_games / 2, 6, 5);  // Fewer games (slower)
     
     // Experiment 3: Week 4 Full vs Week 4 Fast
-    run_experiment(
+    run_experiment<EvaluatorWeek4, EvaluatorWeek4Fast>(
         "Experiment 3: Week 4 Full vs Week 4 Fast",
-        eval_week4,
-        eval_week4_fast,
-        "Week 4 Full Analysis",
-        "Week 4 Fast Analysis",
-        num_games / 2,
-        5
-    );
+        num_games / 2, 5, 5);
     
     std::cout << BOLD << GREEN << "\n✓ All experiments completed!\n" << RESET;
     std::cout << "\nResults saved to: docs/week4_experiments.md\n";
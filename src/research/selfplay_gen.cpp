@@ -0,0 +1,206 @@
+/*
+ * selfplay_gen.cpp - Self-play training data generator
+ * COMP390 Honours Year Project
+ *
+ * Generates games between the chosen engines from random openings on all
+ * cores and stores them as compressed shards (see data/GameShards.hpp).
+ * The same tool inspects a dataset and exports positions for the Texel
+ * tuner (reversi_texel).
+ *
+ * Engines (comma-separated for --engines; one engine = pure self-play):
+ *   minimax, week4, mcts
+ *
+ * Usage:
+ *   reversi_selfplay [--games N] [--engines a,b] [--depth D] [--sims S]
+ *                    [--plies P] [--threads T] [--seed S] [--shard-kb K]
+ *                    [--out DIR]
+ *   reversi_selfplay --info DIR
+ *   reversi_selfplay --export-texel DIR FILE [--sample N] [--seed S]
+ */
+
+#include "data/SelfPlayGenerator.hpp"
+#include "ai/MinimaxEngine.hpp"
+#include "ai/MCTSEngine.hpp"
+#include "ai/Evaluator_Week4.hpp"
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace reversi::research;
+using namespace reversi::ai;
+
+namespace {
+
+void print_usage() {
+    std::cout << "Usage: reversi_selfplay [options]\n"
+              << "  --games <n>       Games to generate (default: 1000)\n"
+              << "  --engines <list>  Comma-separated: minimax, week4, mcts (default: week4)\n"
+              << "  --depth <d>       Minimax search depth (default: 4)\n"
+              << "  --sims <s>        MCTS simulations per move (default: 2000)\n"
+              << "  --plies <p>       Random opening plies (default: 8)\n"
+              << "  --threads <t>     Worker threads (default: all cores)\n"
+              << "  --seed <s>        Opening / engine seed (default: 1)\n"
+              << "  --shard-kb <k>    Maximum shard size in KiB (default: 4096)\n"
+              << "  --out <dir>       Output directory (default: selfplay_data)\n"
+              << "  --info <dir>      Summarise an existing dataset\n"
+              << "  --export-texel <dir> <file>  Write positions for reversi_texel\n"
+              << "  --sample <n>      With --export-texel: n random positions (default: all)\n";
+}
+
+bool make_spec(const std::string& key, int depth, int sims, SelfPlayGenerator::EngineSpec& spec) {
+    SearchLimits minimax_limits(depth, 0);  // Depth-limited: reproducible
+    SearchLimits mcts_limits(0, 600000);    // Simulation-limited
+    mcts_limits.max_nodes = static_cast<uint64_t>(sims);
+
+    if (key == "minimax") {
+        spec = {"Minimax-d" + std::to_string(depth), [] { return std::make_unique<MinimaxEngine>(); },
+                minimax_limits};
+    } else if (key == "week4") {
+        spec = {"Week4-d" + std::to_string(depth), [] {
+            return std::make_unique<MinimaxEngine>(MinimaxEngine::Config(), UseEvaluator<EvaluatorWeek4>{});
+        }, minimax_limits};
+    } else if (key == "mcts") {
+        spec = {"MCTS-" + std::to_string(sims), [] { return std::make_unique<MCTSEngine>(); }, mcts_limits};
+    } else {
+        return false;
+    }
+    return true;
+}
+
+int show_info(const std::string& dir) {
+    ShardReader reader;
+    if (!reader.open(dir)) return 1;
+    uint64_t bytes = 0, scored = 0;
+    for (const auto& e : reader.index()) {
+        bytes += e.length;
+        scored += e.positions - e.opening_plies;
+    }
+    std::cout << "Dataset:   " << dir << "\n"
+              << "Games:     " << reader.num_games() << "\n"
+              << "Positions: " << reader.num_positions() << " (" << scored << " with search scores)\n"
+              << "Shards:    " << reader.num_shards() << "\n"
+              << "Records:   " << bytes << " bytes (" << std::fixed << std::setprecision(2)
+              << (reader.num_games() ? static_cast<double>(bytes) / reader.num_games() : 0.0)
+              << " bytes/game)\n";
+    return 0;
+}
+
+int export_texel(const std::string& dir, const std::string& file, size_t sample, uint32_t seed) {
+    ShardReader reader;
+    if (!reader.open(dir)) return 1;
+    std::ofstream out(file);
+    if (!out.is_open()) {
+        std::cerr << "Error: Cannot open file " << file << " for writing\n";
+        return 1;
+    }
+    out << "# player opponent disc_diff (from " << dir << ")\n" << std::hex;
+    size_t written = 0;
+    auto write = [&](const PositionRecord& p) {
+        out << p.board.player << " " << p.board.opponent << " " << std::dec << p.result << std::hex << "\n";
+        ++written;
+    };
+
+    if (sample > 0) {
+        PositionRecord p;
+        for (uint64_t i : reader.sample_positions(sample, seed)) {
+            if (reader.read_position(i, p)) write(p);
+        }
+    } else {
+        reader.for_each_game([&](size_t, const GameRecord& game) {
+            GameCodec::replay(game, write);
+            return true;
+        });
+    }
+    std::cout << "Exported " << written << " positions to " << file << "\n";
+    return out ? 0 : 1;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    std::string engines = "week4";
+    int depth = 4;
+    int sims = 2000;
+    size_t sample = 0;
+    std::string info_dir, export_dir, export_file;
+    SelfPlayGenerator::Config config;
+
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--help" || arg == "-h") {
+            print_usage();
+            return 0;
+        } else if (arg == "--games" && i + 1 < argc) {
+            config.games = std::atoi(argv[++i]);
+        } else if (arg == "--engines" && i + 1 < argc) {
+            engines = argv[++i];
+        } else if (arg == "--depth" && i + 1 < argc) {
+            depth = std::atoi(argv[++i]);
+        } else if (arg == "--sims" && i + 1 < argc) {
+            sims = std::atoi(argv[++i]);
+        } else if (arg == "--plies" && i + 1 < argc) {
+            config.random_plies = std::atoi(argv[++i]);
+        } else if (arg == "--threads" && i + 1 < argc) {
+            config.num_threads = std::atoi(argv[++i]);
+        } else if (arg == "--seed" && i + 1 < argc) {
+            config.seed = static_cast<uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+        } else if (arg == "--shard-kb" && i + 1 < argc) {
+            config.shard_bytes = static_cast<size_t>(std::atol(argv[++i])) * 1024;
+        } else if (arg == "--out" && i + 1 < argc) {
+            config.output_dir = argv[++i];
+        } else if (arg == "--info" && i + 1 < argc) {
+            info_dir = argv[++i];
+        } else if (arg == "--export-texel" && i + 2 < argc) {
+            export_dir = argv[++i];
+            export_file = argv[++i];
+        } else if (arg == "--sample" && i + 1 < argc) {
+            sample = static_cast<size_t>(std::atoll(argv[++i]));
+        } else {
+            print_usage();
+            return 1;
+        }
+    }
+
+    if (!info_dir.empty()) return show_info(info_dir);
+    if (!export_dir.empty()) return export_texel(export_dir, export_file, sample, config.seed);
+
+    std::vector<SelfPlayGenerator::EngineSpec> specs;
+    std::stringstream list(engines);
+    std::string key;
+    while (std::getline(list, key, ',')) {
+        SelfPlayGenerator::EngineSpec spec;
+        if (!make_spec(key, depth, sims, spec)) {
+            std::cerr << "Unknown engine: " << key << "\n";
+            return 1;
+        }
+        specs.push_back(std::move(spec));
+    }
+
+    std::cout << "========================================\n";
+    std::cout << "Self-Play Data Generation\n";
+    std::cout << "========================================\n";
+    std::cout << "Engines:";
+    for (const auto& s : specs) std::cout << " " << s.name;
+    std::cout << "\nGames: " << config.games << ", random plies: " << config.random_plies
+              << ", output: " << config.output_dir << "\n\n";
+
+    config.progress_every = std::max(1, config.games / 20);
+    SelfPlayGenerator generator(std::move(specs), config);
+    auto result = generator.run();
+    if (!result.error.empty()) {
+        std::cerr << "Error: " << result.error << "\n";
+        return 1;
+    }
+
+    std::cout << "\n" << result.games << " games, " << result.positions << " positions in "
+              << result.shards << " shard(s), " << result.bytes << " bytes ("
+              << std::fixed << std::setprecision(1)
+              << (result.positions ? static_cast<double>(result.bytes) / result.positions : 0.0)
+              << " bytes/position), " << std::setprecision(2) << result.seconds << " s\n";
+    return 0;
+}
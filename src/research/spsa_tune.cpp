@@ -0,0 +1,141 @@
+/*
+ * spsa_tune.cpp - SPSA tuning of search and evaluation parameters
+ * COMP390 Honours Year Project
+ *
+ * Replaces the node-count searches in tests/param_*.cpp with game
+ * results: every iteration plays a batch of short time-limited game
+ * pairs between two perturbed engines on all cores. State is written to
+ * the checkpoint file after each iteration; rerunning the same command
+ * resumes.
+ *
+ * Usage:
+ *   reversi_spsa [--params a,b,...] [--iterations N] [--pairs P]
+ *                [--time-ms T | --depth D] [--threads T] [--seed S]
+ *                [--preset default|optimized|fixed] [--all-features]
+ *                [--checkpoint FILE] [--list]
+ */
+
+#include "tuning/SpsaTuner.hpp"
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace reversi::research;
+using namespace reversi::ai;
+
+namespace {
+
+void print_usage() {
+    std::cout << "Usage: reversi_spsa [options]\n"
+              << "  --params <list>     Comma-separated parameters (see --list)\n"
+              << "  --iterations <n>    SPSA iterations (default: 200)\n"
+              << "  --pairs <p>         Game pairs per iteration (default: 8)\n"
+              << "  --time-ms <t>       Per-move time limit (default: 40)\n"
+              << "  --depth <d>         Fixed-depth games instead of time-limited\n"
+              << "  --threads <t>       Game workers (default: all cores)\n"
+              << "  --seed <s>          Perturbation / opening seed (default: 1)\n"
+              << "  --preset <name>     Base config: default, optimized, fixed (default: default)\n"
+              << "  --all-features      Enable PVS, aspiration windows and killer moves\n"
+              << "  --checkpoint <file> State file, resumed if present (default: spsa_checkpoint.txt)\n"
+              << "  --list              List tunable parameters\n";
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    std::string params = "tt_weight,flip_mul,Opening.mobility_weight,"
+                         "EarlyMid.mobility_weight,LateMid.stability_weight,EarlyMid.corner_bonus";
+    std::string preset = "default";
+    bool all_features = false;
+    SpsaTuner::Config config;
+    config.checkpoint_file = "spsa_checkpoint.txt";
+
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--help" || arg == "-h") {
+            print_usage();
+            return 0;
+        } else if (arg == "--list") {
+            for (const auto& name : SpsaTuner::known_parameters()) std::cout << name << "\n";
+            return 0;
+        } else if (arg == "--params" && i + 1 < argc) {
+            params = argv[++i];
+        } else if (arg == "--iterations" && i + 1 < argc) {
+            config.iterations = std::atoi(argv[++i]);
+        } else if (arg == "--pairs" && i + 1 < argc) {
+            config.pairs_per_iteration = std::atoi(argv[++i]);
+        } else if (arg == "--time-ms" && i + 1 < argc) {
+            config.limits = SearchLimits(60, std::atoi(argv[++i]));
+        } else if (arg == "--depth" && i + 1 < argc) {
+            config.limits = SearchLimits(std::atoi(argv[++i]), 0);
+        } else if (arg == "--threads" && i + 1 < argc) {
+            config.num_threads = std::atoi(argv[++i]);
+        } else if (arg == "--seed" && i + 1 < argc) {
+            config.seed = static_cast<uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+        } else if (arg == "--preset" && i + 1 < argc) {
+            preset = argv[++i];
+        } else if (arg == "--all-features") {
+            all_features = true;
+        } else if (arg == "--checkpoint" && i + 1 < argc) {
+            config.checkpoint_file = argv[++i];
+        } else {
+            print_usage();
+            return 1;
+        }
+    }
+
+    SpsaTuner::Candidate base;
+    if (preset == "optimized") {
+        base.config = MinimaxEngine::Config::preset_optimized();
+    } else if (preset == "fixed") {
+        base.config = MinimaxEngine::Config::preset_fixed_found();
+    } else if (preset != "default") {
+        std::cerr << "Unknown preset: " << preset << "\n";
+        return 1;
+    }
+    if (all_features) {
+        base.config.use_pvs = true;
+        base.config.use_aspiration = true;
+        base.config.use_killer_moves = true;
+    }
+
+    std::vector<SpsaTuner::Parameter> parameters;
+    std::stringstream list(params);
+    std::string name;
+    while (std::getline(list, name, ',')) {
+        SpsaTuner::Parameter p;
+        if (!SpsaTuner::find_parameter(name, base, p)) {
+            std::cerr << "Unknown parameter: " << name << " (see --list)\n";
+            return 1;
+        }
+        if (name == "killer_weight" && !base.config.use_killer_moves) {
+            std::cerr << "killer_weight only affects search with killer moves (--all-features)\n";
+            return 1;
+        }
+        parameters.push_back(std::move(p));
+    }
+
+    std::cout << "========================================\n";
+    std::cout << "SPSA Tuning\n";
+    std::cout << "========================================\n";
+    std::cout << "Parameters: " << parameters.size() << ", iterations: " << config.iterations
+              << ", pairs/iteration: " << config.pairs_per_iteration << "\n";
+    std::cout << "Limits: " << (config.limits.max_time_ms > 0
+                                    ? std::to_string(config.limits.max_time_ms) + " ms/move"
+                                    : "depth " + std::to_string(config.limits.max_depth))
+              << ", checkpoint: " << config.checkpoint_file << "\n\n";
+
+    SpsaTuner tuner(std::move(parameters), base, config);
+    tuner.run();
+
+    std::cout << "\nFinal values:\n";
+    for (const auto& p : tuner.parameters()) {
+        std::cout << "  " << std::left << std::setw(28) << p.name << std::right
+                  << std::fixed << std::setprecision(2) << p.value
+                  << "  (" << std::lround(p.value) << ")\n";
+    }
+    return 0;
+}
@@ -0,0 +1,150 @@
+/*
+ * texel_tune.cpp - Texel tuning of EvaluatorWeek4 phase weights
+ * COMP390 Honours Year Project
+ *
+ * Reads labelled positions ("player_hex opponent_hex disc_diff" per line,
+ * disc_diff from the side to move's view), extracts EvaluatorWeek4
+ * features once (optionally cached in a binary file), fits the weights of
+ * all four phases by minimising the logistic loss and writes the rounded
+ * table in the PhaseWeights::load_table() format.
+ *
+ * Usage:
+ *   reversi_texel <positions.txt> [--cache FILE] [--epochs N] [--lr X]
+ *                 [--k K] [--threads T] [--out FILE]
+ *   reversi_texel --cache FILE [...]     (reuse an existing cache)
+ */
+
+#include "tuning/TexelTuner.hpp"
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <string>
+
+using namespace reversi::research;
+using namespace reversi::ai;
+
+namespace {
+
+void print_usage() {
+    std::cout << "Usage: reversi_texel [positions.txt] [options]\n"
+              << "  --cache <file>    Feature cache (read if present, else written)\n"
+              << "  --epochs <n>      Adam steps (default: 300)\n"
+              << "  --lr <x>          Learning rate (default: 0.1)\n"
+              << "  --k <k>           Sigmoid scale (default: fitted to the current weights)\n"
+              << "  --threads <t>     Worker threads (default: all cores)\n"
+              << "  --start <file>    Start from this weights table (default: built-in)\n"
+              << "  --out <file>      Output weights table (default: phase_weights.txt)\n";
+}
+
+void print_table(const PhaseWeightTable& table) {
+    // One column per PhaseWeights field, wide enough for its weight-file name
+    int widths[PhaseWeights::NUM_FIELDS];
+    std::cout << std::left << std::setw(10) << "phase";
+    for (int f = 0; f < PhaseWeights::NUM_FIELDS; ++f) {
+        widths[f] = static_cast<int>(std::strlen(PhaseWeights::FIELD_NAMES[f])) + 2;
+        std::cout << std::right << std::setw(widths[f]) << PhaseWeights::FIELD_NAMES[f];
+    }
+    std::cout << "\n";
+    const GamePhase phases[] = {GamePhase::Opening, GamePhase::EarlyMid,
+                                GamePhase::LateMid, GamePhase::Endgame};
+    for (int p = 0; p < 4; ++p) {
+        std::cout << std::left << std::setw(10) << PhaseWeights::phase_name(phases[p]);
+        for (int f = 0; f < PhaseWeights::NUM_FIELDS; ++f) {
+            std::cout << std::right << std::setw(widths[f]) << table[p].*PhaseWeights::FIELDS[f];
+        }
+        std::cout << "\n";
+    }
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    std::string positions;
+    std::string cache;
+    std::string start_file;
+    std::string out = "phase_weights.txt";
+    TexelTuner::Config config;
+
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--help" || arg == "-h") {
+            print_usage();
+            return 0;
+        } else if (arg == "--cache" && i + 1 < argc) {
+            cache = argv[++i];
+        } else if (arg == "--epochs" && i + 1 < argc) {
+            config.epochs = std::atoi(argv[++i]);
+        } else if (arg == "--lr" && i + 1 < argc) {
+            config.learning_rate = std::atof(argv[++i]);
+        } else if (arg == "--k" && i + 1 < argc) {
+            config.k = std::atof(argv[++i]);
+        } else if (arg == "--threads" && i + 1 < argc) {
+            config.num_threads = std::atoi(argv[++i]);
+        } else if (arg == "--start" && i + 1 < argc) {
+            start_file = argv[++i];
+        } else if (arg == "--out" && i + 1 < argc) {
+            out = argv[++i];
+        } else if (!arg.empty() && arg[0] != '-' && positions.empty()) {
+            positions = arg;
+        } else {
+            print_usage();
+            return 1;
+        }
+    }
+
+    std::cout << "========================================\n";
+    std::cout << "Texel Tuning (EvaluatorWeek4)\n";
+    std::cout << "========================================\n";
+
+    auto t0 = std::chrono::steady_clock::now();
+    TexelTuner::FeatureMatrix data;
+    if (!cache.empty() && data.load(cache)) {
+        std::cout << "Loaded " << data.size() << " cached positions from " << cache << "\n";
+    } else {
+        if (positions.empty()) {
+            print_usage();
+            return 1;
+        }
+        std::vector<TexelTuner::Sample> samples;
+        if (TexelTuner::load_positions(positions, samples) < 0) return 1;
+        data = TexelTuner::build_features(samples, config.num_threads);
+        std::cout << "Extracted features for " << data.size() << " of " << samples.size()
+                  << " positions";
+        if (!cache.empty() && data.save(cache)) std::cout << " (cached to " << cache << ")";
+        std::cout << "\n";
+    }
+    double prep = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+    std::cout << "Preparation: " << std::fixed << std::setprecision(2) << prep << " s\n";
+    for (int p = 0; p < TexelTuner::NUM_PHASES; ++p) {
+        std::cout << "  phase " << p << ": " << data.phase_begin[p + 1] - data.phase_begin[p] << "\n";
+    }
+    if (data.size() == 0) {
+        std::cerr << "Error: No usable positions\n";
+        return 1;
+    }
+
+    PhaseWeightTable start = PhaseWeights::default_table();
+    if (!start_file.empty() && !PhaseWeights::load_table(start_file, start)) {
+        std::cerr << "Error: Cannot load weights from " << start_file << "\n";
+        return 1;
+    }
+
+    std::cout << "\n";
+    auto result = TexelTuner::tune(data, start, config);
+
+    std::cout << "\nK = " << std::setprecision(4) << result.k << "\n";
+    std::cout << std::setprecision(6)
+              << "Loss: " << result.initial_loss << " -> " << result.final_loss
+              << " (rounded " << result.rounded_loss << ")\n";
+    std::cout << std::setprecision(3) << "Time: " << result.seconds << " s ("
+              << 1000.0 * result.seconds / std::max(1, config.epochs) << " ms/epoch over "
+              << data.size() << " positions)\n\n";
+    print_table(result.table);
+
+    if (!PhaseWeights::save_table(out, result.table)) return 1;
+    std::cout << "\nWeights written to " << out
+              << " (use with reversi_tournament --weights " << out << ")\n";
+    return 0;
+}
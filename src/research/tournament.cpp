@@ -0,0 +1,193 @@
+/*
+ * tournament.cpp - Multi-engine tournament runner
+ * COMP390 Honours Year Project
+ *
+ * Plays a round-robin (or gauntlet) between Minimax presets and MCTS
+ * configurations over a shared opening set and prints ML Elo ratings.
+ * Every finished game is appended to the results file, so rerunning the
+ * same command after an interruption resumes the tournament.
+ *
+ * Engines (comma-separated for --engines):
+ *   minimax    MinimaxEngine default config
+ *   optimized  MinimaxEngine::Config::preset_optimized()
+ *   fixed      MinimaxEngine::Config::preset_fixed_found()
+ *   week4      MinimaxEngine with EvaluatorWeek4
+ *   mcts       MCTSEngine, heuristic playouts
+ *   mcts-rand  MCTSEngine, random playouts
+ *   mcts-rave  MCTSEngine::Config::preset_rave()
+ *   mcts-ab    MCTSEngine::Config::preset_hybrid() (evaluator leaves)
+ *
+ * Usage:
+ *   reversi_tournament [--engines a,b,...] [--depth D] [--sims S]
+ *                      [--openings N] [--plies P] [--rounds R]
+ *                      [--threads T] [--seed S] [--gauntlet]
+ *                      [--results FILE] [--max-games N]
+ *                      [--weights FILE]
+ */
+
+#include "benchmark/Tournament.hpp"
+#include "ai/MinimaxEngine.hpp"
+#include "ai/MCTSEngine.hpp"
+#include "ai/Evaluator_Week4.hpp"
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace reversi::research;
+using namespace reversi::ai;
+
+namespace {
+
+struct Options {
+    std::string engines = "minimax,optimized,fixed,week4,mcts";
+    int depth = 4;
+    int sims = 2000;
+    std::string results = "tournament_results.txt";
+    Tournament::Config config;
+};
+
+void print_usage() {
+    std::cout << "Usage: reversi_tournament [options]\n"
+              << "  --engines <list>  Comma-separated: minimax, optimized, fixed, week4, mcts, mcts-rand, mcts-rave,\n"
+              << "                    mcts-ab\n"
+              << "                    (default: minimax,optimized,fixed,week4,mcts)\n"
+              << "  --depth <d>       Minimax search depth (default: 4)\n"
+              << "  --sims <s>        MCTS simulations per move (default: 2000)\n"
+              << "  --openings <n>    Distinct openings, each played with both colours (default: 50)\n"
+              << "  --plies <p>       Random plies per opening (default: 8)\n"
+              << "  --rounds <r>      Repetitions of the opening set (default: 1)\n"
+              << "  --threads <t>     Worker threads (default: all cores)\n"
+              << "  --seed <s>        Opening / engine seed (default: 1)\n"
+              << "  --gauntlet        First engine plays all others (default: round-robin)\n"
+              << "  --results <file>  Results log, resumed if present (default: tournament_results.txt)\n"
+              << "  --max-games <n>   Stop after n new games (0 = all)\n"
+              << "  --weights <file>  PhaseWeights table for week4 (e.g. from reversi_texel)\n";
+}
+
+bool make_spec(const std::string& key, const Options& opt, Tournament::EngineSpec& spec) {
+    SearchLimits minimax_limits(opt.depth, 0);  // Depth-limited: reproducible
+    SearchLimits mcts_limits(0, 600000);        // Simulation-limited
+    mcts_limits.max_nodes = static_cast<uint64_t>(opt.sims);
+    std::string d = "-d" + std::to_string(opt.depth);
+    std::string s = "-" + std::to_string(opt.sims);
+
+    if (key == "minimax") {
+        spec = {"Minimax" + d, [] { return std::make_unique<MinimaxEngine>(); }, minimax_limits};
+    } else if (key == "optimized") {
+        spec = {"Optimized" + d, [] {
+            return std::make_unique<MinimaxEngine>(MinimaxEngine::Config::preset_optimized());
+        }, minimax_limits};
+    } else if (key == "fixed") {
+        spec = {"FixedFound" + d, [] {
+            return std::make_unique<MinimaxEngine>(MinimaxEngine::Config::preset_fixed_found());
+        }, minimax_limits};
+    } else if (key == "week4") {
+        spec = {"Week4" + d, [] {
+            return std::make_unique<MinimaxEngine>(MinimaxEngine::Config(), UseEvaluator<EvaluatorWeek4>{});
+        }, minimax_limits};
+    } else if (key == "mcts") {
+        spec = {"MCTS" + s, [] { return std::make_unique<MCTSEngine>(); }, mcts_limits};
+    } else if (key == "mcts-rand") {
+        spec = {"MCTS-rand" + s, [] {
+            MCTSEngine::Config c;
+            c.use_heuristic_playout = false;
+            return std::make_unique<MCTSEngine>(c);
+        }, mcts_limits};
+    } else if (key == "mcts-rave") {
+        spec = {"MCTS-RAVE" + s, [] {
+            return std::make_unique<MCTSEngine>(MCTSEngine::Config::preset_rave());
+        }, mcts_limits};
+    } else if (key == "mcts-ab") {
+        spec = {"MCTS-AB" + s, [] {
+            return std::make_unique<MCTSEngine>(MCTSEngine::Config::preset_hybrid());
+        }, mcts_limits};
+    } else {
+        return false;
+    }
+    return true;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    Options opt;
+    opt.config.progress_every = 100;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--help" || arg == "-h") {
+            print_usage();
+            return 0;
+        } else if (arg == "--engines" && i + 1 < argc) {
+            opt.engines = argv[++i];
+        } else if (arg == "--depth" && i + 1 < argc) {
+            opt.depth = std::atoi(argv[++i]);
+        } else if (arg == "--sims" && i + 1 < argc) {
+            opt.sims = std::atoi(argv[++i]);
+        } else if (arg == "--openings" && i + 1 < argc) {
+            opt.config.num_openings = std::atoi(argv[++i]);
+        } else if (arg == "--plies" && i + 1 < argc) {
+            opt.config.opening_plies = std::atoi(argv[++i]);
+        } else if (arg == "--rounds" && i + 1 < argc) {
+            opt.config.rounds = std::atoi(argv[++i]);
+        } else if (arg == "--threads" && i + 1 < argc) {
+            opt.config.num_threads = std::atoi(argv[++i]);
+        } else if (arg == "--seed" && i + 1 < argc) {
+            opt.config.seed = static_cast<uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+        } else if (arg == "--gauntlet") {
+            opt.config.format = Tournament::Format::GAUNTLET;
+        } else if (arg == "--results" && i + 1 < argc) {
+            opt.results = argv[++i];
+        } else if (arg == "--max-games" && i + 1 < argc) {
+            opt.config.max_new_games = std::atoi(argv[++i]);
+        } else if (arg == "--weights" && i + 1 < argc) {
+            PhaseWeightTable table;
+            if (!PhaseWeights::load_table(argv[++i], table)) {
+                std::cerr << "Error: Cannot load weights from " << argv[i] << "\n";
+                return 1;
+            }
+            PhaseWeights::set_default_table(table);
+        } else {
+            print_usage();
+            return 1;
+        }
+    }
+    opt.config.results_file = opt.results;
+
+    std::vector<Tournament::EngineSpec> specs;
+    std::stringstream list(opt.engines);
+    std::string key;
+    while (std::getline(list, key, ',')) {
+        Tournament::EngineSpec spec;
+        if (!make_spec(key, opt, spec)) {
+            std::cerr << "Unknown engine: " << key << "\n";
+            print_usage();
+            return 1;
+        }
+        specs.push_back(std::move(spec));
+    }
+    if (specs.size() < 2) {
+        std::cerr << "A tournament needs at least two engines\n";
+        return 1;
+    }
+
+    Tournament tournament(std::move(specs), opt.config);
+
+    std::cout << "========================================\n";
+    std::cout << "Reversi Tournament\n";
+    std::cout << "========================================\n";
+    std::cout << "Format: " << (opt.config.format == Tournament::Format::GAUNTLET ? "gauntlet" : "round-robin")
+              << ", pairings: " << tournament.pairings().size()
+              << ", openings: " << tournament.openings().size()
+              << ", games: " << tournament.scheduled_games() << "\n";
+    std::cout << "Results file: " << opt.results << "\n\n";
+
+    Tournament::Result result = tournament.run();
+    if (!result.error.empty()) {
+        return 1;
+    }
+    result.print(std::cout);
+    return 0;
+}
@@ -0,0 +1,95 @@
+/*
+ * tree_stats.cpp - Search tree recording and move-ordering report
+ * COMP390 Honours Year Project
+ *
+ * record: searches a fixed set of midgame positions with a
+ * SearchRecorder attached, saves the node records and prints the
+ * report. analyze: prints the report for a saved record file, so runs
+ * with different ordering settings can be compared offline.
+ *
+ * Usage:
+ *   reversi_treestat record <out.rvsr> [--depth 7] [--positions 20]
+ *                    [--seed 7] [--pvs] [--no-killers] [--no-tt]
+ *   reversi_treestat analyze <in.rvsr>
+ */
+
+#include "benchmark/PositionSuite.hpp"
+#include "../ai/MinimaxEngine.hpp"
+#include "../ai/SearchRecorder.hpp"
+#include <algorithm>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace reversi;
+using namespace reversi::research;
+
+namespace {
+
+void print_usage() {
+    std::cout << "Usage:\n"
+              << "  reversi_treestat record <out.rvsr> [options]\n"
+              << "    --depth <n>        Search depth (default 7)\n"
+              << "    --positions <n>    Midgame positions to search (default 20)\n"
+              << "    --seed <n>         Position generator seed (default 7)\n"
+              << "    --pvs              Principal variation search (default negamax)\n"
+              << "    --no-killers       Disable killer moves\n"
+              << "    --no-tt            Disable the transposition table\n"
+              << "  reversi_treestat analyze <in.rvsr>\n";
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    if (argc < 3) {
+        print_usage();
+        return 1;
+    }
+    const std::string mode = argv[1];
+    const std::string path = argv[2];
+
+    if (mode == "analyze") {
+        std::vector<ai::NodeRecord> records;
+        if (!ai::SearchRecorder::load(path, records)) return 1;
+        ai::SearchRecorder::analyze(records).print();
+        return 0;
+    }
+    if (mode != "record") {
+        print_usage();
+        return 1;
+    }
+
+    ai::MinimaxEngine::Config config(7);
+    config.use_killer_moves = true;
+    int positions = 20;
+    uint32_t seed = 7;
+    for (int i = 3; i < argc; ++i) {
+        std::string arg = argv[i];
+        bool has_value = i + 1 < argc;
+        if (arg == "--depth" && has_value) config.max_depth = std::max(1, std::atoi(argv[++i]));
+        else if (arg == "--positions" && has_value) positions = std::max(1, std::atoi(argv[++i]));
+        else if (arg == "--seed" && has_value) seed = static_cast<uint32_t>(std::atoi(argv[++i]));
+        else if (arg == "--pvs") config.use_pvs = true;
+        else if (arg == "--no-killers") config.use_killer_moves = false;
+        else if (arg == "--no-tt") config.use_transposition = false;
+        else {
+            print_usage();
+            return 1;
+        }
+    }
+
+    ai::SearchRecorder recorder;
+    ai::MinimaxEngine engine(config);
+    engine.set_recorder(&recorder);
+    uint64_t nodes = 0;
+    for (const auto& board : PositionSuite::generate_midgame(positions, 20, 30, seed)) {
+        engine.reset();
+        nodes += engine.find_best_move(board).nodes_searched;
+    }
+    std::cout << positions << " positions, depth " << config.max_depth << ", " << nodes << " nodes\n";
+    if (!recorder.save(path)) return 1;
+    std::cout << "Saved " << recorder.records().size() << " records to " << path << "\n\n";
+    ai::SearchRecorder::analyze(recorder.records()).print();
+    return 0;
+}
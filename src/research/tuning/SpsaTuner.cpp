@@ -0,0 +1,322 @@
+/*
+ * SpsaTuner.cpp - SPSA parameter tuning from self-play games
+ * COMP390 Honours Year Project
+ *
+ * Author: Tianqixing
+ * Student ID: 201821852
+ */
+
+#include "SpsaTuner.hpp"
+#include "../../ai/Evaluator_Week4.hpp"
+#include <algorithm>
+#include <cmath>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <random>
+#include <sstream>
+
+namespace reversi {
+namespace research {
+
+namespace {
+
+/**
+ * @brief MinimaxEngine that evaluates with its own PhaseWeightTable
+ *
+ * Installs the table for the duration of each search, so two tuned
+ * engines can alternate moves on the same thread.
+ */
+class TunedMinimax : public ai::AIStrategy {
+public:
+    explicit TunedMinimax(const SpsaTuner::Candidate& candidate)
+        : candidate_(candidate), engine_(make_engine(candidate)) {}
+
+    core::Move find_best_move(const core::Board& board, const ai::SearchLimits& limits) override {
+        ai::PhaseWeights::ScopedTable scope(candidate_.weights);
+        return engine_->find_best_move(board, limits);
+    }
+    std::string get_name() const override { return engine_->get_name() + " (tuned)"; }
+    const ai::SearchStats& get_stats() const override { return engine_->get_stats(); }
+    void reset() override { engine_->reset(); }
+    std::unique_ptr<ai::AIStrategy> clone() const override {
+        return std::make_unique<TunedMinimax>(candidate_);
+    }
+
+private:
+    static std::unique_ptr<ai::MinimaxEngine> make_engine(const SpsaTuner::Candidate& c) {
+        if (c.use_week4) {
+            return std::make_unique<ai::MinimaxEngine>(c.config, ai::UseEvaluator<ai::EvaluatorWeek4>{});
+        }
+        return std::make_unique<ai::MinimaxEngine>(c.config);
+    }
+
+    SpsaTuner::Candidate candidate_;
+    std::unique_ptr<ai::MinimaxEngine> engine_;
+};
+
+struct ConfigField {
+    const char* name;
+    int ai::MinimaxEngine::Config::* field;
+    double min_value, max_value, c_end;
+};
+
+// Integer search parameters worth tuning (bounds keep the engine sane)
+const ConfigField CONFIG_FIELDS[] = {
+    {"pvs_research_margin", &ai::MinimaxEngine::Config::pvs_research_margin, 0, 64, 4},
+    {"aspiration_window",   &ai::MinimaxEngine::Config::aspiration_window,  10, 400, 15},
+    {"tt_weight",           &ai::MinimaxEngine::Config::tt_weight,          0, 20000, 800},
+    {"killer_weight",       &ai::MinimaxEngine::Config::killer_weight,      0, 4000, 150},
+    {"pos_weight_mul",      &ai::MinimaxEngine::Config::pos_weight_mul,     0, 32, 2},
+    {"flip_mul",            &ai::MinimaxEngine::Config::flip_mul,           0, 32, 2},
+    {"history_weight",      &ai::MinimaxEngine::Config::history_weight,     0, 200, 10},
+};
+
+struct PhaseField {
+    const char* name;
+    int ai::PhaseWeightConfig::* field;
+    double min_value, max_value, c_end;
+};
+
+const PhaseField PHASE_FIELDS[] = {
+    {"piece_count_weight",        &ai::PhaseWeightConfig::piece_count_weight,        0, 40, 2},
+    {"mobility_weight",           &ai::PhaseWeightConfig::mobility_weight,           0, 40, 2},
+    {"potential_mobility_weight", &ai::PhaseWeightConfig::potential_mobility_weight, 0, 30, 1.5},
+    {"stability_weight",          &ai::PhaseWeightConfig::stability_weight,          0, 40, 2},
+    {"frontier_penalty",          &ai::PhaseWeightConfig::frontier_penalty,        -20, 5, 1.5},
+    {"position_weight_scale",     &ai::PhaseWeightConfig::position_weight_scale,     0, 20, 1},
+    {"corner_bonus",              &ai::PhaseWeightConfig::corner_bonus,              0, 150, 6},
+};
+
+constexpr ai::GamePhase ALL_PHASES[] = {
+    ai::GamePhase::Opening, ai::GamePhase::EarlyMid, ai::GamePhase::LateMid, ai::GamePhase::Endgame
+};
+
+} // namespace
+
+SpsaTuner::SpsaTuner(std::vector<Parameter> parameters, const Candidate& base, const Config& config)
+    : parameters_(std::move(parameters)), base_(base), config_(config) {}
+
+double SpsaTuner::c_numerator(const Parameter& p) const {
+    return p.c_end * std::pow(static_cast<double>(std::max(1, config_.iterations)), config_.gamma);
+}
+
+double SpsaTuner::a_numerator(const Parameter& p) const {
+    double big_a = config_.a_ratio * config_.iterations;
+    double a_end = p.r_end * p.c_end * p.c_end;
+    return a_end * std::pow(big_a + std::max(1, config_.iterations), config_.alpha);
+}
+
+SpsaTuner::Candidate SpsaTuner::make_candidate(const std::vector<double>& values) const {
+    Candidate c = base_;
+    for (size_t i = 0; i < parameters_.size(); ++i) {
+        parameters_[i].apply(c, static_cast<int>(std::lround(values[i])));
+    }
+    return c;
+}
+
+SpsaTuner::Candidate SpsaTuner::current() const {
+    std::vector<double> values;
+    for (const auto& p : parameters_) values.push_back(p.value);
+    return make_candidate(values);
+}
+
+MatchEngine::StrategyFactory SpsaTuner::factory(const Candidate& candidate) {
+    return [candidate] { return std::make_unique<TunedMinimax>(candidate); };
+}
+
+SpsaTuner::IterationResult SpsaTuner::step() {
+    const int k = iteration_;
+    const size_t n = parameters_.size();
+    const double big_a = config_.a_ratio * config_.iterations;
+
+    // Perturbation signs depend only on (seed, k)
+    std::mt19937_64 rng(MatchEngine::game_seed(config_.seed, k, 1));
+    std::vector<double> delta(n), ck(n), plus(n), minus(n);
+    for (size_t i = 0; i < n; ++i) {
+        const Parameter& p = parameters_[i];
+        delta[i] = (rng() & 1) ? 1.0 : -1.0;
+        ck[i] = c_numerator(p) / std::pow(k + 1.0, config_.gamma);
+        plus[i] = std::clamp(p.value + ck[i] * delta[i], p.min_value, p.max_value);
+        minus[i] = std::clamp(p.value - ck[i] * delta[i], p.min_value, p.max_value);
+    }
+
+    MatchEngine::MatchConfig match;
+    match.num_games = 2 * std::max(1, config_.pairs_per_iteration);
+    match.alternate_colors = true;
+    match.random_seed = static_cast<uint32_t>(MatchEngine::game_seed(config_.seed, k, 0)) | 1u;
+    match.num_threads = config_.num_threads;
+    match.limits = config_.limits;
+    match.opening_plies = config_.opening_plies;
+    MatchEngine::MatchResult games = MatchEngine::play_match(
+        factory(make_candidate(plus)), factory(make_candidate(minus)), match);
+
+    IterationResult result;
+    result.iteration = k;
+    result.plus_wins = games.player1_wins;
+    result.minus_wins = games.player2_wins;
+    result.draws = games.draws;
+    for (const auto& g : games.games) {
+        result.search_ms += g.player1_time_ms + g.player2_time_ms;
+    }
+
+    const double outcome = result.plus_wins - result.minus_wins;
+    for (size_t i = 0; i < n; ++i) {
+        Parameter& p = parameters_[i];
+        double ak = a_numerator(p) / std::pow(big_a + k + 1.0, config_.alpha);
+        double rk = ak / (ck[i] * ck[i]);
+        p.value = std::clamp(p.value + rk * ck[i] * outcome * delta[i], p.min_value, p.max_value);
+    }
+    ++iteration_;
+
+    if (config_.verbose) {
+        std::cout << "[SPSA] iter " << iteration_ << "/" << config_.iterations
+                  << "  +" << result.plus_wins << " -" << result.minus_wins << " =" << result.draws
+                  << "  " << std::fixed << std::setprecision(0) << result.search_ms << " ms ";
+        for (const auto& p : parameters_) {
+            std::cout << " " << p.name << "=" << std::setprecision(2) << p.value;
+        }
+        std::cout << std::endl;
+    }
+    return result;
+}
+
+void SpsaTuner::run() {
+    if (!config_.checkpoint_file.empty() && std::filesystem::exists(config_.checkpoint_file)) {
+        if (load_checkpoint(config_.checkpoint_file) && config_.verbose) {
+            std::cout << "[SPSA] Resumed from " << config_.checkpoint_file
+                      << " at iteration " << iteration_ << std::endl;
+        }
+    }
+    while (iteration_ < config_.iterations) {
+        step();
+        if (!config_.checkpoint_file.empty()) {
+            save_checkpoint(config_.checkpoint_file);
+        }
+    }
+}
+
+bool SpsaTuner::save_checkpoint(const std::string& path) const {
+    // Write then rename so an interrupted save never leaves a torn file
+    const std::string tmp = path + ".tmp";
+    {
+        std::ofstream out(tmp);
+        if (!out.is_open()) {
+            std::cerr << "Error: Cannot open file " << tmp << " for writing" << std::endl;
+            return false;
+        }
+        out << "# reversi-spsa v1\n";
+        out << "iteration " << iteration_ << "\n";
+        out << std::setprecision(17);
+        for (const auto& p : parameters_) {
+            out << p.name << " " << p.value << "\n";
+        }
+        if (!out) return false;
+    }
+    std::error_code ec;
+    std::filesystem::rename(tmp, path, ec);
+    if (ec) {
+        std::cerr << "Error: Cannot replace " << path << ": " << ec.message() << std::endl;
+        return false;
+    }
+    return true;
+}
+
+bool SpsaTuner::load_checkpoint(const std::string& path) {
+    std::ifstream in(path);
+    if (!in.is_open()) return false;
+
+    std::string line;
+    if (!std::getline(in, line) || line != "# reversi-spsa v1") {
+        std::cerr << "Error: " << path << " is not an SPSA checkpoint" << std::endl;
+        return false;
+    }
+    int iteration = -1;
+    std::map<std::string, double> values;
+    while (std::getline(in, line)) {
+        std::istringstream fields(line);
+        std::string key;
+        double value = 0.0;
+        if (!(fields >> key >> value)) continue;
+        if (key == "iteration") iteration = static_cast<int>(value);
+        else values[key] = value;
+    }
+
+    if (iteration < 0 || values.size() != parameters_.size()) {
+        std::cerr << "Error: " << path << " tunes a different parameter set" << std::endl;
+        return false;
+    }
+    for (const auto& p : parameters_) {
+        if (!values.count(p.name)) {
+            std::cerr << "Error: " << path << " has no value for " << p.name << std::endl;
+            return false;
+        }
+    }
+    for (auto& p : parameters_) {
+        p.value = std::clamp(values[p.name], p.min_value, p.max_value);
+    }
+    iteration_ = iteration;
+    return true;
+}
+
+SpsaTuner::Parameter SpsaTuner::config_parameter(const std::string& name,
+                                                 int ai::MinimaxEngine::Config::* field,
+                                                 double min_value, double max_value, double c_end) {
+    Parameter p;
+    p.name = name;
+    p.min_value = min_value;
+    p.max_value = max_value;
+    p.c_end = c_end;
+    p.apply = [field](Candidate& c, int v) { c.config.*field = v; };
+    return p;
+}
+
+SpsaTuner::Parameter SpsaTuner::phase_parameter(const std::string& name, ai::GamePhase phase,
+                                                int ai::PhaseWeightConfig::* field,
+                                                double min_value, double max_value, double c_end) {
+    Parameter p;
+    p.name = name;
+    p.min_value = min_value;
+    p.max_value = max_value;
+    p.c_end = c_end;
+    const int index = static_cast<int>(phase);
+    p.apply = [field, index](Candidate& c, int v) { c.weights[index].*field = v; };
+    return p;
+}
+
+bool SpsaTuner::find_parameter(const std::string& name, const Candidate& base, Parameter& out) {
+    for (const auto& f : CONFIG_FIELDS) {
+        if (name == f.name) {
+            out = config_parameter(name, f.field, f.min_value, f.max_value, f.c_end);
+            out.value = base.config.*f.field;
+            return true;
+        }
+    }
+    for (ai::GamePhase phase : ALL_PHASES) {
+        for (const auto& f : PHASE_FIELDS) {
+            if (name == std::string(ai::PhaseWeights::phase_name(phase)) + "." + f.name) {
+                out = phase_parameter(name, phase, f.field, f.min_value, f.max_value, f.c_end);
+                out.value = base.weights[static_cast<int>(phase)].*f.field;
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+std::vector<std::string> SpsaTuner::known_parameters() {
+    std::vector<std::string> names;
+    for (const auto& f : CONFIG_FIELDS) names.emplace_back(f.name);
+    for (ai::GamePhase phase : ALL_PHASES) {
+        for (const auto& f : PHASE_FIELDS) {
+            names.push_back(std::string(ai::PhaseWeights::phase_name(phase)) + "." + f.name);
+        }
+    }
+    return names;
+}
+
+} // namespace research
+} // namespace reversi
@@ -0,0 +1,178 @@
+/*
+ * SpsaTuner.hpp - SPSA parameter tuning from self-play games
+ * COMP390 Honours Year Project
+ *
+ * Simultaneous Perturbation Stochastic Approximation over any integer
+ * MinimaxEngine::Config field or PhaseWeightConfig weight. Each iteration
+ * perturbs every parameter at once (theta +/- c_k * delta), plays a
+ * batch of game pairs between the two perturbed engines in parallel and
+ * moves theta towards the side that won. Games are time-limited by
+ * default, so parameters that search faster win more games for the
+ * same CPU time.
+ *
+ * Author: Tianqixing
+ * Student ID: 201821852
+ */
+
+#pragma once
+
+#include "../../ai/MinimaxEngine.hpp"
+#include "../../ai/PhaseWeights.hpp"
+#include "../benchmark/MatchEngine.hpp"
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace reversi {
+namespace research {
+
+/**
+ * @brief SPSA tuner for Minimax search and evaluation parameters
+ *
+ * Schedules follow the usual SPSA form with the Fishtest
+ * parameterisation (c_end / r_end given for the last iteration):
+ *   c_k = c / (k + 1)^gamma,  a_k = a / (A + k + 1)^alpha,  r_k = a_k / c_k^2
+ *   theta_i += r_k * c_k * (wins_plus - wins_minus) * delta_i
+ *
+ * The perturbation signs and match seed of iteration k depend only on
+ * (seed, k), so a run resumed from a checkpoint continues exactly as an
+ * uninterrupted one would (with depth-limited games).
+ */
+class SpsaTuner {
+public:
+    /**
+     * @brief Engine settings being tuned
+     */
+    struct Candidate {
+        ai::MinimaxEngine::Config config;                        ///< Search parameters
+        ai::PhaseWeightTable weights = ai::PhaseWeights::default_table(); ///< Evaluation weights
+        bool use_week4 = true;  ///< Evaluate with EvaluatorWeek4 (reads weights)
+    };
+
+    /**
+     * @brief One tuned parameter
+     */
+    struct Parameter {
+        std::string name;
+        double value = 0.0;      ///< Current estimate
+        double min_value = 0.0;
+        double max_value = 0.0;
+        double c_end = 1.0;      ///< Perturbation size at the last iteration
+        double r_end = 0.002;    ///< Learning rate at the last iteration
+        std::function<void(Candidate&, int)> apply;  ///< Writes a rounded value into a candidate
+    };
+
+    /**
+     * @brief Tuning run configuration
+     */
+    struct Config {
+        int iterations = 200;             ///< Total SPSA iterations
+        int pairs_per_iteration = 8;      ///< Game pairs (colours swapped) per iteration
+        int opening_plies = 8;            ///< Random plies per pair opening
+        ai::SearchLimits limits{60, 40};  ///< Per-move limits (time-limited by default)
+        int num_threads = 0;              ///< Game workers (0 = all cores)
+        uint32_t seed = 1;                ///< Perturbation and opening seed
+        double alpha = 0.602;             ///< Learning-rate decay exponent
+        double gamma = 0.101;             ///< Perturbation decay exponent
+        double a_ratio = 0.1;             ///< A = a_ratio * iterations
+        std::string checkpoint_file;      ///< Written after every iteration ("" = none)
+        bool verbose = true;              ///< Print one line per iteration
+    };
+
+    /**
+     * @brief Outcome of one iteration
+     */
+    struct IterationResult {
+        int iteration = 0;
+        int plus_wins = 0;       ///< Games won by theta + c_k * delta
+        int minus_wins = 0;      ///< Games won by theta - c_k * delta
+        int draws = 0;
+        double search_ms = 0.0;  ///< Total search time of both sides
+    };
+
+    SpsaTuner(std::vector<Parameter> parameters, const Candidate& base, const Config& config);
+
+    /**
+     * @brief Run one iteration and update the estimates
+     */
+    IterationResult step();
+
+    /**
+     * @brief Run the remaining iterations, checkpointing after each one
+     *
+     * Resumes from config.checkpoint_file when it exists.
+     */
+    void run();
+
+    /**
+     * @brief Write iteration count and parameter values
+     */
+    bool save_checkpoint(const std::string& path) const;
+
+    /**
+     * @brief Restore state written by save_checkpoint()
+     *
+     * Fails (and leaves the tuner unchanged) if the file tunes a
+     * different parameter set.
+     */
+    bool load_checkpoint(const std::string& path);
+
+    /**
+     * @brief Base candidate with the given parameter values applied
+     */
+    Candidate make_candidate(const std::vector<double>& values) const;
+
+    /**
+     * @brief Base candidate with the current estimates applied
+     */
+    Candidate current() const;
+
+    /**
+     * @brief Creates engines playing a candidate's settings
+     */
+    static MatchEngine::StrategyFactory factory(const Candidate& candidate);
+
+    const std::vector<Parameter>& parameters() const { return parameters_; }
+    int iteration() const { return iteration_; }
+
+    /**
+     * @brief Parameter bound to an integer MinimaxEngine::Config field
+     */
+    static Parameter config_parameter(const std::string& name, int ai::MinimaxEngine::Config::* field,
+                                      double min_value, double max_value, double c_end);
+
+    /**
+     * @brief Parameter bound to one phase's PhaseWeightConfig field
+     */
+    static Parameter phase_parameter(const std::string& name, ai::GamePhase phase,
+                                     int ai::PhaseWeightConfig::* field,
+                                     double min_value, double max_value, double c_end);
+
+    /**
+     * @brief Look up a known parameter by name, starting from base's value
+     *
+     * Config fields use their member name (e.g. "killer_weight"); phase
+     * weights use "<Phase>.<field>" (e.g. "Opening.mobility_weight").
+     *
+     * @return false if the name is unknown
+     */
+    static bool find_parameter(const std::string& name, const Candidate& base, Parameter& out);
+
+    /**
+     * @brief Names accepted by find_parameter()
+     */
+    static std::vector<std::string> known_parameters();
+
+private:
+    double a_numerator(const Parameter& p) const;
+    double c_numerator(const Parameter& p) const;
+
+    std::vector<Parameter> parameters_;
+    Candidate base_;
+    Config config_;
+    int iteration_ = 0;
+};
+
+} // namespace research
+} // namespace reversi
@@ -0,0 +1,355 @@
+/*
+ * TexelTuner.cpp - Texel-style tuning of EvaluatorWeek4 phase weights
+ * COMP390 Honours Year Project
+ *
+ * Author: Tianqixing
+ * Student ID: 201821852
+ */
+
+#include "TexelTuner.hpp"
+#include "../../ai/Evaluator_Week4.hpp"
+#include <algorithm>
+#include <charconv>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <iterator>
+#include <thread>
+
+namespace reversi {
+namespace research {
+
+namespace {
+
+constexpr char CACHE_MAGIC[8] = {'R', 'V', 'T', 'X', 'F', '1', 0, 0};
+constexpr double LN10 = 2.302585092994046;
+
+int resolve_threads(int requested) {
+    if (requested > 0) return requested;
+    return static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+}
+
+/**
+ * @brief Run fn(t) for t in [0, n) on n threads (inline when n == 1)
+ */
+template <typename Fn>
+void parallel_for(int n, Fn&& fn) {
+    if (n <= 1) {
+        fn(0);
+        return;
+    }
+    std::vector<std::thread> pool;
+    pool.reserve(n - 1);
+    for (int t = 1; t < n; ++t) pool.emplace_back(fn, t);
+    fn(0);
+    for (auto& th : pool) th.join();
+}
+
+/**
+ * @brief Loss and gradient accumulation over rows [begin, end) of one phase
+ *
+ * Works in fixed blocks: scores and residuals go through small float
+ * buffers so the column loops stay simple, contiguous and vectorisable;
+ * only the sigmoid/log step is scalar.
+ */
+void accumulate_rows(const TexelTuner::FeatureMatrix& data, size_t begin, size_t end,
+                     const std::array<double, TexelTuner::NUM_FEATURES>& w, double c,
+                     double& loss_sum, std::array<double, TexelTuner::NUM_FEATURES>* grad) {
+    constexpr size_t BLOCK = 256;
+    float score[BLOCK];
+    float resid[BLOCK];
+    float wf[TexelTuner::NUM_FEATURES];
+    for (int f = 0; f < TexelTuner::NUM_FEATURES; ++f) wf[f] = static_cast<float>(w[f]);
+    const float cf = static_cast<float>(c);
+
+    for (size_t b = begin; b < end; b += BLOCK) {
+        const size_t n = std::min(BLOCK, end - b);
+        for (size_t j = 0; j < n; ++j) score[j] = 0.0f;
+        for (int f = 0; f < TexelTuner::NUM_FEATURES; ++f) {
+            const int16_t* col = data.columns[f].data() + b;
+            const float wv = wf[f];
+            for (size_t j = 0; j < n; ++j) score[j] += wv * static_cast<float>(col[j]);
+        }
+
+        const float* y = data.targets.data() + b;
+        double block_loss = 0.0;
+        for (size_t j = 0; j < n; ++j) {
+            float p = 1.0f / (1.0f + std::exp(-cf * score[j]));
+            p = std::clamp(p, 1e-6f, 1.0f - 1e-6f);
+            block_loss -= y[j] * std::log(p) + (1.0f - y[j]) * std::log(1.0f - p);
+            resid[j] = p - y[j];
+        }
+        loss_sum += block_loss;
+
+        if (grad) {
+            for (int f = 0; f < TexelTuner::NUM_FEATURES; ++f) {
+                const int16_t* col = data.columns[f].data() + b;
+                float acc = 0.0f;
+                for (size_t j = 0; j < n; ++j) acc += resid[j] * static_cast<float>(col[j]);
+                (*grad)[f] += acc;
+            }
+        }
+    }
+}
+
+} // namespace
+
+// ==================== Dataset ====================
+
+long long TexelTuner::load_positions(const std::string& path, std::vector<Sample>& out) {
+    std::ifstream in(path, std::ios::binary);
+    if (!in.is_open()) {
+        std::cerr << "Error: Cannot open file " << path << std::endl;
+        return -1;
+    }
+    std::string text((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+
+    long long added = 0;
+    const char* p = text.data();
+    const char* end = p + text.size();
+    while (p < end) {
+        const char* eol = static_cast<const char*>(std::memchr(p, '\n', end - p));
+        if (!eol) eol = end;
+        const char* q = p;
+        auto skip_space = [&] { while (q < eol && (*q == ' ' || *q == '\t' || *q == '\r')) ++q; };
+        skip_space();
+        if (q < eol && *q != '#') {
+            uint64_t player = 0, opponent = 0;
+            int diff = 0;
+            auto r1 = std::from_chars(q, eol, player, 16);
+            q = r1.ptr; skip_space();
+            auto r2 = std::from_chars(q, eol, opponent, 16);
+            q = r2.ptr; skip_space();
+            auto r3 = std::from_chars(q, eol, diff);
+            if (r1.ec == std::errc() && r2.ec == std::errc() && r3.ec == std::errc() &&
+                (player & opponent) == 0) {
+                out.push_back({core::Board(player, opponent), target_from_score(diff)});
+                ++added;
+            }
+        }
+        p = eol + 1;
+    }
+    return added;
+}
+
+TexelTuner::FeatureMatrix TexelTuner::build_features(const std::vector<Sample>& samples, int num_threads) {
+    // Assign rows grouped by phase (terminal positions are not linear in
+    // the weights and are dropped)
+    std::vector<int> row(samples.size(), -1);
+    std::array<size_t, NUM_PHASES> counts{};
+    std::vector<uint8_t> phase(samples.size());
+    for (size_t i = 0; i < samples.size(); ++i) {
+        if (samples[i].board.is_terminal()) continue;
+        phase[i] = static_cast<uint8_t>(ai::PhaseWeights::detect_phase(samples[i].board));
+        counts[phase[i]]++;
+    }
+
+    FeatureMatrix m;
+    m.phase_begin[0] = 0;
+    for (int p = 0; p < NUM_PHASES; ++p) m.phase_begin[p + 1] = m.phase_begin[p] + counts[p];
+    const size_t rows = m.phase_begin[NUM_PHASES];
+    for (auto& col : m.columns) col.resize(rows);
+    m.targets.resize(rows);
+
+    std::array<size_t, NUM_PHASES> next{};
+    for (int p = 0; p < NUM_PHASES; ++p) next[p] = m.phase_begin[p];
+    for (size_t i = 0; i < samples.size(); ++i) {
+        if (samples[i].board.is_terminal()) continue;
+        row[i] = static_cast<int>(next[phase[i]]++);
+    }
+
+    // Feature extraction (stability analysis dominates) in parallel
+    const int threads = std::max(1, std::min<int>(resolve_threads(num_threads),
+                                                  static_cast<int>(samples.size() / 1024 + 1)));
+    parallel_for(threads, [&](int t) {
+        size_t begin = samples.size() * t / threads;
+        size_t end = samples.size() * (t + 1) / threads;
+        for (size_t i = begin; i < end; ++i) {
+            if (row[i] < 0) continue;
+            auto features = ai::EvaluatorWeek4::extract_features(samples[i].board);
+            for (int f = 0; f < NUM_FEATURES; ++f) {
+                m.columns[f][row[i]] = static_cast<int16_t>(features[f]);
+            }
+            m.targets[row[i]] = samples[i].target;
+        }
+    });
+    return m;
+}
+
+bool TexelTuner::FeatureMatrix::save(const std::string& path) const {
+    std::ofstream out(path, std::ios::binary);
+    if (!out.is_open()) {
+        std::cerr << "Error: Cannot open file " << path << " for writing" << std::endl;
+        return false;
+    }
+    uint64_t n = size();
+    out.write(CACHE_MAGIC, sizeof(CACHE_MAGIC));
+    out.write(reinterpret_cast<const char*>(&n), sizeof(n));
+    for (size_t b : phase_begin) {
+        uint64_t v = b;
+        out.write(reinterpret_cast<const char*>(&v), sizeof(v));
+    }
+    for (const auto& col : columns) {
+        out.write(reinterpret_cast<const char*>(col.data()), static_cast<std::streamsize>(n * sizeof(int16_t)));
+    }
+    out.write(reinterpret_cast<const char*>(targets.data()), static_cast<std::streamsize>(n * sizeof(float)));
+    return static_cast<bool>(out);
+}
+
+bool TexelTuner::FeatureMatrix::load(const std::string& path) {
+    std::ifstream in(path, std::ios::binary);
+    if (!in.is_open()) return false;
+    char magic[8];
+    uint64_t n = 0;
+    if (!in.read(magic, sizeof(magic)) || std::memcmp(magic, CACHE_MAGIC, sizeof(magic)) != 0 ||
+        !in.read(reinterpret_cast<char*>(&n), sizeof(n))) {
+        return false;
+    }
+    FeatureMatrix m;
+    for (size_t& b : m.phase_begin) {
+        uint64_t v = 0;
+        if (!in.read(reinterpret_cast<char*>(&v), sizeof(v))) return false;
+        b = static_cast<size_t>(v);
+    }
+    if (m.phase_begin[NUM_PHASES] != n) return false;
+    for (auto& col : m.columns) {
+        col.resize(n);
+        if (!in.read(reinterpret_cast<char*>(col.data()), static_cast<std::streamsize>(n * sizeof(int16_t)))) {
+            return false;
+        }
+    }
+    m.targets.resize(n);
+    if (!in.read(reinterpret_cast<char*>(m.targets.data()), static_cast<std::streamsize>(n * sizeof(float)))) {
+        return false;
+    }
+    *this = std::move(m);
+    return true;
+}
+
+// ==================== Loss ====================
+
+double TexelTuner::loss(const FeatureMatrix& data, const Weights& weights, double k,
+                        int num_threads, Weights* gradient) {
+    const size_t n = data.size();
+    if (n == 0) {
+        if (gradient) *gradient = Weights{};
+        return 0.0;
+    }
+    const double c = k * LN10 / 400.0;
+    const int threads = std::max(1, std::min<int>(resolve_threads(num_threads),
+                                                  static_cast<int>(n / 4096 + 1)));
+
+    std::vector<double> losses(threads, 0.0);
+    std::vector<Weights> grads(threads, Weights{});
+    parallel_for(threads, [&](int t) {
+        for (int p = 0; p < NUM_PHASES; ++p) {
+            size_t b = data.phase_begin[p], e = data.phase_begin[p + 1];
+            size_t len = e - b;
+            accumulate_rows(data, b + len * t / threads, b + len * (t + 1) / threads,
+                            weights[p], c, losses[t], gradient ? &grads[t][p] : nullptr);
+        }
+    });
+
+    double total = 0.0;
+    for (double l : losses) total += l;
+    if (gradient) {
+        *gradient = Weights{};
+        for (const auto& g : grads) {
+            for (int p = 0; p < NUM_PHASES; ++p) {
+                for (int f = 0; f < NUM_FEATURES; ++f) (*gradient)[p][f] += g[p][f];
+            }
+        }
+        for (auto& phase_grad : *gradient) {
+            for (double& v : phase_grad) v *= c / static_cast<double>(n);
+        }
+    }
+    return total / static_cast<double>(n);
+}
+
+double TexelTuner::fit_k(const FeatureMatrix& data, const Weights& weights, int num_threads) {
+    // Golden-section search on log(k)
+    const double phi = (std::sqrt(5.0) - 1.0) / 2.0;
+    double lo = std::log(1e-3), hi = std::log(1e2);
+    double x1 = hi - phi * (hi - lo), x2 = lo + phi * (hi - lo);
+    double f1 = loss(data, weights, std::exp(x1), num_threads);
+    double f2 = loss(data, weights, std::exp(x2), num_threads);
+    for (int iter = 0; iter < 50; ++iter) {
+        if (f1 < f2) {
+            hi = x2; x2 = x1; f2 = f1;
+            x1 = hi - phi * (hi - lo);
+            f1 = loss(data, weights, std::exp(x1), num_threads);
+        } else {
+            lo = x1; x1 = x2; f1 = f2;
+            x2 = lo + phi * (hi - lo);
+            f2 = loss(data, weights, std::exp(x2), num_threads);
+        }
+    }
+    return std::exp((lo + hi) / 2.0);
+}
+
+// ==================== Optimisation ====================
+
+TexelTuner::Weights TexelTuner::to_weights(const ai::PhaseWeightTable& table) {
+    Weights w{};
+    for (int p = 0; p < NUM_PHASES; ++p) {
+        for (int f = 0; f < NUM_FEATURES; ++f) w[p][f] = table[p].*ai::PhaseWeights::FIELDS[f];
+    }
+    return w;
+}
+
+ai::PhaseWeightTable TexelTuner::to_table(const Weights& weights) {
+    ai::PhaseWeightTable table{};
+    for (int p = 0; p < NUM_PHASES; ++p) {
+        for (int f = 0; f < NUM_FEATURES; ++f) {
+            table[p].*ai::PhaseWeights::FIELDS[f] = static_cast<int>(std::lround(weights[p][f]));
+        }
+    }
+    return table;
+}
+
+TexelTuner::Result TexelTuner::tune(const FeatureMatrix& data, const ai::PhaseWeightTable& start,
+                                    const Config& config) {
+    auto t0 = std::chrono::steady_clock::now();
+    Result result;
+    Weights w = to_weights(start);
+    result.k = config.k > 0.0 ? config.k : fit_k(data, w, config.num_threads);
+    result.initial_loss = loss(data, w, result.k, config.num_threads);
+
+    // EvaluatorWeek4 skips the potential-mobility and stability terms
+    // when their weight is not positive, so keep them >= 0 to stay linear
+    constexpr int NON_NEGATIVE[] = {2, 3};
+
+    constexpr double beta1 = 0.9, beta2 = 0.999, eps = 1e-8;
+    Weights m{}, v{}, grad{};
+    double current = result.initial_loss;
+    for (int epoch = 1; epoch <= config.epochs; ++epoch) {
+        current = loss(data, w, result.k, config.num_threads, &grad);
+        const double bc1 = 1.0 - std::pow(beta1, epoch);
+        const double bc2 = 1.0 - std::pow(beta2, epoch);
+        for (int p = 0; p < NUM_PHASES; ++p) {
+            for (int f = 0; f < NUM_FEATURES; ++f) {
+                m[p][f] = beta1 * m[p][f] + (1.0 - beta1) * grad[p][f];
+                v[p][f] = beta2 * v[p][f] + (1.0 - beta2) * grad[p][f] * grad[p][f];
+                w[p][f] -= config.learning_rate * (m[p][f] / bc1) / (std::sqrt(v[p][f] / bc2) + eps);
+            }
+            for (int f : NON_NEGATIVE) w[p][f] = std::max(0.0, w[p][f]);
+        }
+        if (config.report_every > 0 && (epoch % config.report_every == 0 || epoch == 1)) {
+            std::cout << "[Texel] epoch " << epoch << "/" << config.epochs
+                      << "  loss " << std::fixed << std::setprecision(6) << current << std::endl;
+        }
+    }
+
+    result.weights = w;
+    result.final_loss = loss(data, w, result.k, config.num_threads);
+    result.table = to_table(w);
+    result.rounded_loss = loss(data, to_weights(result.table), result.k, config.num_threads);
+    result.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+    return result;
+}
+
+} // namespace research
+} // namespace reversi
@@ -0,0 +1,138 @@
+/*
+ * TexelTuner.hpp - Texel-style tuning of EvaluatorWeek4 phase weights
+ * COMP390 Honours Year Project
+ *
+ * EvaluatorWeek4 is linear in its PhaseWeightConfig weights for a fixed
+ * phase, so every labelled position is reduced once to its 7 raw feature
+ * values. Tuning then never touches a Board again: each epoch is a pass
+ * over a compact structure-of-arrays matrix (one int16 column per
+ * feature, positions grouped by phase), split across threads, computing
+ * the logistic (cross-entropy) loss of sigmoid(K * eval) against the game
+ * result and its gradient. Adam updates the 28 weights.
+ *
+ * Author: Tianqixing
+ * Student ID: 201821852
+ */
+
+#pragma once
+
+#include "../../core/Board.hpp"
+#include "../../ai/PhaseWeights.hpp"
+#include <array>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace reversi {
+namespace research {
+
+/**
+ * @brief Texel tuner for PhaseWeights
+ */
+class TexelTuner {
+public:
+    static constexpr int NUM_FEATURES = ai::PhaseWeights::NUM_FIELDS;
+    static constexpr int NUM_PHASES = 4;
+
+    /// Real-valued weights [phase][feature] used during optimisation
+    using Weights = std::array<std::array<double, NUM_FEATURES>, NUM_PHASES>;
+
+    /**
+     * @brief A labelled position
+     */
+    struct Sample {
+        core::Board board;
+        float target = 0.5f;  ///< Expected result for the side to move (1 win, 0.5 draw, 0 loss)
+    };
+
+    /**
+     * @brief Cached features in SoA layout, grouped by phase
+     *
+     * Phase p occupies rows [phase_begin[p], phase_begin[p + 1]), so the
+     * inner loop runs with constant weights over contiguous columns.
+     */
+    struct FeatureMatrix {
+        std::array<std::vector<int16_t>, NUM_FEATURES> columns;
+        std::vector<float> targets;
+        std::array<size_t, NUM_PHASES + 1> phase_begin{};
+
+        size_t size() const { return targets.size(); }
+
+        /**
+         * @brief Binary cache (so features are extracted once per dataset)
+         */
+        bool save(const std::string& path) const;
+        bool load(const std::string& path);
+    };
+
+    /**
+     * @brief Optimisation settings
+     */
+    struct Config {
+        int epochs = 300;             ///< Full-batch Adam steps
+        double learning_rate = 0.1;   ///< Adam step size (weight units)
+        double k = 0.0;               ///< Sigmoid scale (0 = fit to the start weights)
+        int num_threads = 0;          ///< Loss/gradient workers (0 = all cores)
+        int report_every = 25;        ///< Print loss every N epochs (0 = silent)
+    };
+
+    /**
+     * @brief Tuning outcome
+     */
+    struct Result {
+        Weights weights{};              ///< Optimised real-valued weights
+        ai::PhaseWeightTable table{};   ///< Rounded table (loadable at runtime)
+        double k = 0.0;                 ///< Sigmoid scale used
+        double initial_loss = 0.0;      ///< Loss of the start weights
+        double final_loss = 0.0;        ///< Loss of the real-valued result
+        double rounded_loss = 0.0;      ///< Loss of the rounded table
+        double seconds = 0.0;           ///< Optimisation wall time
+    };
+
+    /**
+     * @brief Label from the final disc difference for the side to move
+     */
+    static float target_from_score(int disc_diff) {
+        return disc_diff > 0 ? 1.0f : (disc_diff < 0 ? 0.0f : 0.5f);
+    }
+
+    /**
+     * @brief Read "player_hex opponent_hex disc_diff" lines
+     *
+     * disc_diff is the final (or solved) disc difference for the side to
+     * move. Lines starting with '#' are skipped.
+     *
+     * @return Number of positions appended, or -1 if the file cannot be read
+     */
+    static long long load_positions(const std::string& path, std::vector<Sample>& out);
+
+    /**
+     * @brief Extract features for all non-terminal samples (multi-threaded)
+     */
+    static FeatureMatrix build_features(const std::vector<Sample>& samples, int num_threads = 0);
+
+    /**
+     * @brief Mean cross-entropy loss and (optionally) its gradient
+     *
+     * @param gradient If non-null, receives d loss / d weight
+     */
+    static double loss(const FeatureMatrix& data, const Weights& weights, double k,
+                       int num_threads = 0, Weights* gradient = nullptr);
+
+    /**
+     * @brief Sigmoid scale minimising the loss for fixed weights
+     */
+    static double fit_k(const FeatureMatrix& data, const Weights& weights, int num_threads = 0);
+
+    /**
+     * @brief Optimise the weights starting from `start`
+     */
+    static Result tune(const FeatureMatrix& data, const ai::PhaseWeightTable& start,
+                       const Config& config);
+
+    static Weights to_weights(const ai::PhaseWeightTable& table);
+    static ai::PhaseWeightTable to_table(const Weights& weights);
+};
+
+} // namespace research
+} // namespace reversi
@@ -0,0 +1,171 @@
+/*
+ * alloc_counter.hpp - Per-thread heap allocation counting for tests/benches
+ * COMP390 Honours Year Project - Reversi AI
+ *
+ * Replaces the global operator new / delete family (and, on glibc,
+ * malloc / calloc / realloc / free) with versions that count calls on
+ * the calling thread, then forward to the normal allocator. A region
+ * is measured with AllocScope:
+ *
+ *   test::AllocScope scope;
+ *   engine.find_best_move(board);
+ *   ASSERT_EQ(scope.allocations(), 0ULL);
+ *
+ * The replacements are definitions, so include this header in exactly
+ * one translation unit of a test or benchmark executable.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+
+namespace test {
+
+struct AllocCounts {
+    uint64_t allocations = 0;   ///< new / malloc / calloc / realloc calls
+    uint64_t frees = 0;         ///< delete / free calls (non-null)
+    uint64_t bytes = 0;         ///< Bytes requested
+};
+
+/// Counts for the calling thread since it started
+inline thread_local AllocCounts thread_alloc_counts;
+
+/**
+ * @brief Allocation deltas of the calling thread over a scope
+ */
+class AllocScope {
+public:
+    AllocScope() : start_(thread_alloc_counts) {}
+
+    uint64_t allocations() const { return thread_alloc_counts.allocations - start_.allocations; }
+    uint64_t frees() const { return thread_alloc_counts.frees - start_.frees; }
+    uint64_t bytes() const { return thread_alloc_counts.bytes - start_.bytes; }
+
+    /** @brief Start counting again from now */
+    void reset() { start_ = thread_alloc_counts; }
+
+private:
+    AllocCounts start_;
+};
+
+namespace detail {
+
+inline void count_alloc(std::size_t size) {
+    ++thread_alloc_counts.allocations;
+    thread_alloc_counts.bytes += size;
+}
+
+inline void count_free(void* p) {
+    if (p) ++thread_alloc_counts.frees;
+}
+
+inline void* checked_alloc(std::size_t size) {
+    count_alloc(size);
+    if (void* p = std::malloc(size ? size : 1)) return p;
+    throw std::bad_alloc();
+}
+
+/// Release without counting (the caller already counted)
+void raw_free(void* p) noexcept;
+
+inline void* checked_aligned_alloc(std::size_t size, std::align_val_t align) {
+    count_alloc(size);
+    const std::size_t a = static_cast<std::size_t>(align);
+    // aligned_alloc wants a multiple of the alignment
+    if (void* p = std::aligned_alloc(a, ((size ? size : 1) + a - 1) / a * a)) return p;
+    throw std::bad_alloc();
+}
+
+} // namespace detail
+} // namespace test
+
+#if defined(__GLIBC__)
+// malloc family: forward to glibc's implementation. operator new below
+// calls std::malloc, so it is counted there and not again here.
+extern "C" {
+void* __libc_malloc(std::size_t);
+void* __libc_calloc(std::size_t, std::size_t);
+void* __libc_realloc(void*, std::size_t);
+void __libc_free(void*);
+
+void* malloc(std::size_t size) {
+    test::detail::count_alloc(size);
+    return __libc_malloc(size);
+}
+void* calloc(std::size_t n, std::size_t size) {
+    test::detail::count_alloc(n * size);
+    return __libc_calloc(n, size);
+}
+void* realloc(void* p, std::size_t size) {
+    test::detail::count_alloc(size);
+    return __libc_realloc(p, size);
+}
+void free(void* p) {
+    test::detail::count_free(p);
+    __libc_free(p);
+}
+}
+
+void test::detail::raw_free(void* p) noexcept { __libc_free(p); }
+
+void* operator new(std::size_t size) {
+    if (void* p = std::malloc(size ? size : 1)) return p;
+    throw std::bad_alloc();
+}
+void* operator new[](std::size_t size) {
+    if (void* p = std::malloc(size ? size : 1)) return p;
+    throw std::bad_alloc();
+}
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete[](void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+void operator delete[](void* p, std::size_t) noexcept { std::free(p); }
+#else
+void* operator new(std::size_t size) { return test::detail::checked_alloc(size); }
+void* operator new[](std::size_t size) { return test::detail::checked_alloc(size); }
+void operator delete(void* p) noexcept {
+    test::detail::count_free(p);
+    std::free(p);
+}
+void operator delete[](void* p) noexcept {
+    test::detail::count_free(p);
+    std::free(p);
+}
+void operator delete(void* p, std::size_t) noexcept {
+    test::detail::count_free(p);
+    std::free(p);
+}
+void operator delete[](void* p, std::size_t) noexcept {
+    test::detail::count_free(p);
+    std::free(p);
+}
+
+void test::detail::raw_free(void* p) noexcept { std::free(p); }
+#endif
+
+// Aligned forms: aligned_alloc bypasses the malloc replacement, so these
+// count for themselves on every platform
+void* operator new(std::size_t size, std::align_val_t align) {
+    return test::detail::checked_aligned_alloc(size, align);
+}
+void* operator new[](std::size_t size, std::align_val_t align) {
+    return test::detail::checked_aligned_alloc(size, align);
+}
+void operator delete(void* p, std::align_val_t) noexcept {
+    test::detail::count_free(p);
+    test::detail::raw_free(p);
+}
+void operator delete[](void* p, std::align_val_t) noexcept {
+    test::detail::count_free(p);
+    test::detail::raw_free(p);
+}
+void operator delete(void* p, std::size_t, std::align_val_t) noexcept {
+    test::detail::count_free(p);
+    test::detail::raw_free(p);
+}
+void operator delete[](void* p, std::size_t, std::align_val_t) noexcept {
+    test::detail::count_free(p);
+    test::detail::raw_free(p);
+}
@@ -101,7 +101,7 @@ int main() {
     const auto r2 = run_fixed_time("make_move+undo", bench_make_undo);
     print_result(r2);
 
-    // 3) pass() benchmark (includes hash recomputation in current implementation)
+    // 3) pass() benchmark (O(1): side-key XOR, no hash recomputation)
     auto bench_pass = [&]() {
         board.pass();
         board.pass(); // return to original side so board doesn't diverge
@@ -0,0 +1,136 @@
+/*
+ * mcts_test_utils.hpp - Shared fixtures for the MCTS engine tests
+ * COMP390 Honours Year Project - Reversi AI
+ *
+ * Games against a random player or between two engines, and exact-value
+ * checks of MCTS-Solver proofs, for tests that vary only the engine
+ * configuration:
+ *
+ *   ASSERT_GE(test::play_vs_random(config, 10, 17), 8);
+ *   auto proofs = test::prove_endgames(config, positions, exact);
+ *   ASSERT_EQ(proofs.correct, proofs.checked);
+ */
+
+#pragma once
+
+#include "ai/EndgameSolver.hpp"
+#include "ai/FastRng.hpp"
+#include "ai/MCTSEngine.hpp"
+#include <bit>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+namespace test {
+
+inline int sign(int v) { return (v > 0) - (v < 0); }
+
+/// Position a few moves into the game (plenty of transpositions close to the root)
+inline reversi::core::Board opening_position() {
+    reversi::core::Board board;
+    for (int move : {19, 18, 17}) board.apply_move_no_history(move);
+    return board;
+}
+
+/**
+ * @brief Games won by MCTS against a uniformly random player
+ *
+ * Colours alternate; game g uses a fresh engine seeded g + 1, and the
+ * random player draws from FastRng(seed).
+ */
+inline int play_vs_random(reversi::ai::MCTSEngine::Config config, int games, uint64_t seed) {
+    using reversi::core::Board;
+    reversi::ai::FastRng rng(seed);
+    int wins = 0;
+    for (int game = 0; game < games; ++game) {
+        config.seed = static_cast<uint64_t>(game + 1);
+        reversi::ai::MCTSEngine engine(config);
+        const int mcts_side = game % 2;
+        Board board;
+        int side = 0;
+        while (!board.is_terminal()) {
+            const uint64_t legal = board.legal_moves();
+            if (legal == 0) {
+                board.pass();
+                side ^= 1;
+                continue;
+            }
+            int move;
+            if (side == mcts_side) {
+                move = engine.find_best_move(board, reversi::ai::SearchLimits(64, 600000)).position;
+            } else {
+                uint64_t m = legal;
+                for (uint32_t k = rng.below(static_cast<uint32_t>(std::popcount(legal))); k > 0; --k) m &= m - 1;
+                move = std::countr_zero(m);
+            }
+            board.apply_move_no_history(move);
+            side ^= 1;
+        }
+        int diff = board.count_player() - board.count_opponent();  // For the side to move
+        if (side != mcts_side) diff = -diff;
+        wins += diff > 0;
+    }
+    return wins;
+}
+
+/**
+ * @brief Play one game between two engines from an opening
+ * @param sims Simulation budget per move (SearchLimits::max_nodes)
+ * @return Disc difference for the first engine
+ */
+inline int play_game(reversi::ai::AIStrategy& first, reversi::ai::AIStrategy& second, reversi::core::Board board,
+                     bool first_to_move, int sims) {
+    reversi::ai::SearchLimits limits(64, 600000);
+    limits.max_nodes = static_cast<uint64_t>(sims);
+    bool first_side = first_to_move;
+    while (!board.is_terminal()) {
+        if (board.legal_moves() == 0) {
+            board.pass();
+            first_side = !first_side;
+            continue;
+        }
+        reversi::ai::AIStrategy& engine = first_side ? first : second;
+        const reversi::core::Move move = engine.find_best_move(board, limits);
+        board.apply_move_no_history(move.position);
+        first_side = !first_side;
+    }
+    const int diff = board.count_player() - board.count_opponent();  // For the side to move
+    return first_side ? diff : -diff;
+}
+
+/**
+ * @brief Outcome of prove_endgames()
+ */
+struct EndgameProofs {
+    int checked = 0;   ///< Positions searched (those with a legal move)
+    int proven = 0;    ///< Roots proven by the search
+    int correct = 0;   ///< Proven with the exact value, and the chosen move keeps it
+};
+
+/**
+ * @brief Search each position with a fresh engine and check proofs against EndgameSolver
+ * @param inspect Called with the engine after each search (optional)
+ */
+inline EndgameProofs prove_endgames(const reversi::ai::MCTSEngine::Config& config,
+                                    const std::vector<reversi::core::Board>& positions,
+                                    reversi::ai::EndgameSolver& exact,
+                                    const std::function<void(const reversi::ai::MCTSEngine&)>& inspect = {}) {
+    EndgameProofs result;
+    for (const reversi::core::Board& board : positions) {
+        if (board.legal_moves() == 0) continue;
+        reversi::ai::MCTSEngine engine(config);
+        const reversi::core::Move move = engine.find_best_move(board, reversi::ai::SearchLimits(64, 600000));
+        const auto& stats = engine.get_mcts_stats();
+        if (inspect) inspect(engine);
+        ++result.checked;
+        if (!stats.root_solved) continue;
+        ++result.proven;
+        const int value = sign(exact.solve(board).score);
+        reversi::core::Board next = board;
+        next.apply_move_no_history(move.position);
+        result.correct += stats.root_result == value && -sign(exact.solve(next).score) == value;
+    }
+    return result;
+}
+
+} // namespace test
@@ -0,0 +1,185 @@
+/*
+ * test_allocations.cpp - Heap allocations in search hot loops
+ * COMP390 Honours Year Project
+ *
+ * - Allocation counter harness (new/delete, malloc, per-thread counts)
+ * - Evaluator::evaluate / EvaluatorWeek4::evaluate never allocate
+ * - MinimaxEngine::find_best_move allocates nothing once its scratch
+ *   buffers are warm (every search mode, boards with move history)
+ * - MCTSEngine allocates only for tree nodes, never in playouts
+ */
+
+#include "alloc_counter.hpp"
+#include "test_utils.hpp"
+#include "ai/Evaluator.hpp"
+#include "ai/Evaluator_Week4.hpp"
+#include "ai/MCTSEngine.hpp"
+#include "ai/MinimaxEngine.hpp"
+#include <iostream>
+#include <memory>
+#include <thread>
+#include <vector>
+
+using namespace reversi::ai;
+using namespace test;
+using reversi::core::Board;
+
+namespace {
+
+/// Positions from a short game line; the boards carry move history
+std::vector<Board> game_positions() {
+    std::vector<Board> positions;
+    Board board;
+    for (int move : {19, 18, 17, 34, 20, 21, 29, 12, 43, 37}) {
+        board.make_move(move);
+        positions.push_back(board);
+    }
+    return positions;
+}
+
+} // namespace
+
+void test_harness() {
+    std::cout << "\n[TEST] Allocation counter\n";
+    std::cout << "-------------------------\n";
+
+    AllocScope scope;
+    ASSERT_EQ(scope.allocations(), 0ULL);
+
+    auto value = std::make_unique<int>(42);
+    ASSERT_EQ(scope.allocations(), 1ULL);
+    ASSERT_GE(scope.bytes(), static_cast<uint64_t>(sizeof(int)));
+    value.reset();
+    ASSERT_EQ(scope.frees(), 1ULL);
+
+    void* raw = std::malloc(64);
+    ASSERT_EQ(scope.allocations(), 2ULL);
+    std::free(raw);
+    ASSERT_EQ(scope.frees(), 2ULL);
+
+    scope.reset();
+    std::vector<int> grow;
+    for (int i = 0; i < 100; ++i) grow.push_back(i);
+    ASSERT_GT(scope.allocations(), 1ULL);  // Geometric growth reallocates
+
+    scope.reset();
+    grow.clear();
+    for (int i = 0; i < 100; ++i) grow.push_back(i);  // Capacity already there
+    ASSERT_EQ(scope.allocations(), 0ULL);
+
+    // Counts are per thread: another thread's allocations are not seen here
+    scope.reset();
+    uint64_t other_thread = 0;
+    std::thread worker([&other_thread] {
+        AllocScope inner;
+        std::vector<int> v(1000);
+        other_thread = inner.allocations();
+    });
+    const AllocCounts before_join = thread_alloc_counts;
+    worker.join();
+    ASSERT_EQ(other_thread, 1ULL);
+    ASSERT_EQ(thread_alloc_counts.allocations, before_join.allocations);
+}
+
+void test_evaluators() {
+    std::cout << "\n[TEST] Evaluators do not allocate\n";
+    std::cout << "---------------------------------\n";
+
+    const auto positions = game_positions();
+    AllocScope scope;
+    long long sum = 0;
+    for (int i = 0; i < 1000; ++i) {
+        for (const Board& board : positions) {
+            sum += Evaluator::evaluate(board);
+            sum += EvaluatorWeek4::evaluate(board);
+        }
+    }
+    const uint64_t allocations = scope.allocations();
+    std::cout << "  " << 2000 * positions.size() << " evaluations, " << allocations
+              << " allocations (checksum " << sum << ")\n";
+    ASSERT_EQ(allocations, 0ULL);
+}
+
+void test_minimax() {
+    std::cout << "\n[TEST] Minimax search does not allocate at steady state\n";
+    std::cout << "-------------------------------------------------------\n";
+
+    const auto positions = game_positions();
+    const Board& board = positions[5];
+
+    struct Mode {
+        const char* name;
+        bool killer, pvs, iterative, aspiration, specialized;
+    };
+    const Mode modes[] = {
+        {"alpha-beta", false, false, false, false, true},
+        {"killer", true, false, false, false, true},
+        {"pvs", true, true, false, false, true},
+        {"iterative + aspiration", true, false, true, true, true},
+        {"pvs, runtime flags", true, true, false, false, false},
+    };
+
+    for (const Mode& mode : modes) {
+        MinimaxEngine::Config config(6);
+        config.use_killer_moves = mode.killer;
+        config.use_pvs = mode.pvs;
+        config.use_iterative_deepening = mode.iterative;
+        config.use_aspiration = mode.aspiration;
+        config.use_specialized_search = mode.specialized;
+        config.tt_size_bits = 16;
+        MinimaxEngine engine(config);
+
+        // Warm up: scratch buffers reach their working size
+        engine.find_best_move(board);
+        engine.clear_tt();
+
+        AllocScope scope;
+        const auto result = engine.find_best_move(board);
+        const uint64_t allocations = scope.allocations();
+        std::cout << "  " << mode.name << ": " << result.nodes_searched << " nodes, " << allocations
+                  << " allocations\n";
+        ASSERT_GT(result.nodes_searched, 100);
+        ASSERT_EQ(allocations, 0ULL);
+    }
+}
+
+void test_mcts() {
+    std::cout << "\n[TEST] MCTS allocates only for tree nodes\n";
+    std::cout << "-----------------------------------------\n";
+
+    const auto positions = game_positions();
+    for (bool heuristic : {true, false}) {
+        MCTSEngine::Config config(2000, 60000);
+        config.seed = 7;
+        config.use_heuristic_playout = heuristic;
+        MCTSEngine engine(config);
+        engine.find_best_move(positions[3], SearchLimits(64, 60000));
+
+        AllocScope scope;
+        engine.find_best_move(positions[3], SearchLimits(64, 60000));
+        const uint64_t allocations = scope.allocations();
+        const auto& stats = engine.get_mcts_stats();
+        std::cout << "  " << (heuristic ? "heuristic" : "random") << " playouts: "
+                  << stats.simulations_performed << " simulations, " << stats.tree_nodes_created
+                  << " nodes, " << allocations << " allocations\n";
+        ASSERT_EQ(stats.simulations_performed, 2000);
+        // Per node: the Node and (once expanded) its edge and statistics arrays;
+        // playouts add nothing
+        ASSERT_LT(allocations, 2ULL * static_cast<uint64_t>(stats.tree_nodes_created) + 64);
+    }
+}
+
+int main() {
+    std::cout << "========================================\n";
+    std::cout << "Allocation Test\n";
+    std::cout << "========================================\n";
+
+    test_harness();
+    test_evaluators();
+    test_minimax();
+    test_mcts();
+
+    print_summary();
+
+    return tests_failed > 0 ? 1 : 0;
+}
@@ -0,0 +1,236 @@
+/*
+ * test_archive.cpp - WTHOR / GGF importer and position index tests
+ * COMP390 Honours Year Project
+ *
+ * - WTHOR files round-trip games and results
+ * - GGF parsing: standard and custom start boards, passes, skipped variants
+ * - The mapped index returns exactly the games reaching a position
+ * - Corrupt index headers (bucket bits, section bounds) are rejected
+ */
+
+#include "test_utils.hpp"
+#include "research/data/PositionIndex.hpp"
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <map>
+#include <random>
+
+using namespace reversi::research;
+using reversi::core::Board;
+using namespace test;
+
+namespace {
+
+// Copy of file src with bytes overwritten at offset (header fields of a position index)
+void write_patched(const std::string& src, const std::string& dst, size_t offset, const void* bytes, size_t n,
+                   size_t truncate_to = 0) {
+    std::ifstream in(src, std::ios::binary);
+    std::string data((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+    std::memcpy(data.data() + offset, bytes, n);
+    if (truncate_to) data.resize(truncate_to);
+    std::ofstream(dst, std::ios::binary).write(data.data(), static_cast<std::streamsize>(data.size()));
+}
+
+std::vector<ArchiveGame> random_games(int count, uint32_t seed) {
+    std::mt19937 rng(seed);
+    std::vector<ArchiveGame> games;
+    std::vector<int> moves;
+    for (int g = 0; g < count; ++g) {
+        ArchiveGame game;
+        Board board;
+        while (!board.is_terminal()) {
+            board.get_legal_moves(moves);
+            if (moves.empty()) {
+                board.pass();
+                continue;
+            }
+            // Few distinct first moves so positions are shared between games
+            int sq = game.moves.size() < 2 ? moves[rng() % 2] : moves[rng() % moves.size()];
+            game.moves.push_back(static_cast<uint8_t>(sq));
+            board.make_move(sq);
+        }
+        int diff = board.count_player() - board.count_opponent();
+        diff = board.side_to_move() == 0 ? diff : -diff;
+        // WTHOR stores black's disc count, so margins are even there
+        int empties = 64 - board.count_player() - board.count_opponent();
+        game.black_disc_diff = diff + (diff > 0 ? empties : diff < 0 ? -empties : 0);
+        game.has_result = true;
+        games.push_back(std::move(game));
+    }
+    return games;
+}
+
+const char* GGF_SAMPLE =
+    "(;GM[Othello]PC[NEOS]DT[2003.12.15]PB[alpha]PW[beta]TY[8]RE[+4.000]"
+    "BO[8 -------- -------- -------- ---O*--- ---*O--- -------- -------- -------- *]"
+    "B[d3//1.2]W[c5]B[f6/0.5]W[f5];)\n"
+    "(;GM[Othello]TY[8s]RE[+2.000]BO[8 -------- -------- -------- ---O*--- ---*O--- "
+    "-------- -------- -------- *]B[d3];)\n"
+    "(;GM[Othello]TY[8r]RE[?]BO[8 -------- -------- -------- --*O*--- ---OO--- "
+    "---*---- -------- -------- O]W[b4]B[a4];)\n";
+
+} // namespace
+
+void test_wthor_round_trip() {
+    std::cout << "\n[TEST] WTHOR write/read round trip\n";
+    std::cout << "----------------------------------\n";
+
+    auto games = random_games(200, 1);
+    const std::string path = "test_archive_tmp.wtb";
+    ASSERT_TRUE(GameArchive::write_wthor(path, games));
+
+    std::vector<ArchiveGame> read;
+    long long n = GameArchive::read(path, [&](const ArchiveGame& g) {
+        read.push_back(g);
+        return true;
+    });
+    ASSERT_EQ(n, 200LL);
+    bool same = read.size() == games.size();
+    for (size_t i = 0; same && i < games.size(); ++i) {
+        same = read[i].moves == games[i].moves && read[i].black_disc_diff == games[i].black_disc_diff;
+    }
+    ASSERT_TRUE(same);
+    std::remove(path.c_str());
+}
+
+void test_ggf_parsing() {
+    std::cout << "\n[TEST] GGF parsing\n";
+    std::cout << "------------------\n";
+
+    const std::string path = "test_archive_tmp.ggf";
+    {
+        std::ofstream out(path);
+        out << GGF_SAMPLE;
+    }
+    std::vector<ArchiveGame> games;
+    long long n = GameArchive::read(path, [&](const ArchiveGame& g) {
+        games.push_back(g);
+        return true;
+    });
+    std::remove(path.c_str());
+
+    // Synchro game skipped
+    ASSERT_EQ(n, 2LL);
+    ASSERT_EQ(games[0].moves.size(), static_cast<size_t>(4));
+    ASSERT_EQ(static_cast<int>(games[0].moves[0]), 19);  // d3 (row 1 at the top)
+    ASSERT_EQ(games[0].black_disc_diff, 4);
+    ASSERT_TRUE(games[0].has_result);
+    ASSERT_EQ(games[0].start.hash(), Board().hash());
+    ASSERT_TRUE(GameArchive::replay(games[0], [](const Board&, int) {}));
+
+    // Custom start, white to move, unknown result
+    const ArchiveGame& custom = games[1];
+    ASSERT_TRUE(!custom.has_result);
+    ASSERT_EQ(custom.start.side_to_move(), 1);
+    ASSERT_EQ(custom.moves.size(), static_cast<size_t>(2));
+    int positions = 0;
+    ASSERT_TRUE(GameArchive::replay(custom, [&](const Board&, int) { ++positions; }));
+    ASSERT_EQ(positions, 3);
+
+    // Explicit passes are dropped (replay re-inserts them)
+    const char* with_pass = "TY[8]B[f5]W[pa]B[PA]W[d6]";
+    ArchiveGame passed;
+    ASSERT_TRUE(GameArchive::parse_ggf_game(with_pass, with_pass + std::strlen(with_pass), passed));
+    ASSERT_EQ(passed.moves.size(), static_cast<size_t>(2));
+
+    // Illegal moves are detected on replay
+    ArchiveGame bad = games[0];
+    bad.moves[1] = 0;  // a1 is not legal after d3
+    ASSERT_TRUE(!GameArchive::replay(bad, [](const Board&, int) {}));
+}
+
+void test_position_index() {
+    std::cout << "\n[TEST] Memory-mapped position index\n";
+    std::cout << "-----------------------------------\n";
+
+    auto games = random_games(3000, 7);
+    const std::string wtb = "test_archive_idx.wtb";
+    const std::string index_path = "test_archive_idx.rpi";
+    ASSERT_TRUE(GameArchive::write_wthor(wtb, games));
+
+    auto stats = PositionIndex::build({wtb}, index_path);
+    std::cout << "  " << stats.games << " games, " << stats.positions << " positions in "
+              << stats.seconds * 1000 << " ms\n";
+    ASSERT_TRUE(stats.error.empty());
+    ASSERT_EQ(stats.games, 3000LL);
+    ASSERT_EQ(stats.skipped, 0LL);
+
+    PositionIndex index;
+    ASSERT_TRUE(index.open(index_path));
+    ASSERT_EQ(index.num_games(), 3000ULL);
+    ASSERT_EQ(index.sources().size(), static_cast<size_t>(1));
+
+    // Brute force: games reaching each position
+    std::map<uint64_t, std::vector<uint32_t>> expected;
+    for (uint32_t g = 0; g < games.size(); ++g) {
+        GameArchive::replay(games[g], [&](const Board& b, int) { expected[b.hash()].push_back(g); });
+    }
+    int mismatches = 0;
+    for (const auto& [hash, ids] : expected) {
+        auto [first, last] = index.find(hash);
+        std::vector<uint32_t> got;
+        for (auto* e = first; e != last; ++e) got.push_back(e->game);
+        if (got != ids) ++mismatches;
+    }
+    ASSERT_EQ(mismatches, 0);
+    auto [none_first, none_last] = index.find(0x123456789ULL);
+    ASSERT_TRUE(none_first == none_last);
+
+    // Start position: every game, results add up
+    auto s = index.summarize(Board());
+    ASSERT_EQ(s.games, 3000);
+    ASSERT_EQ(s.black_wins + s.white_wins + s.draws, 3000);
+    int black_wins = 0;
+    for (const auto& g : games) black_wins += g.black_disc_diff > 0;
+    ASSERT_EQ(s.black_wins, black_wins);
+
+    // Lookup latency
+    Timer timer;
+    uint64_t hits = 0;
+    for (int rep = 0; rep < 10; ++rep) {
+        for (const auto& [hash, ids] : expected) {
+            auto [first, last] = index.find(hash);
+            hits += static_cast<uint64_t>(last - first);
+        }
+    }
+    double us = timer.elapsed_ms() * 1000.0 / (10.0 * expected.size());
+    std::cout << "  " << us << " us per lookup (" << hits << " hits)\n";
+    ASSERT_LT(us, 50.0);
+
+    // Corrupt headers: version at byte 8, bucket_bits at 12, num_games at 16
+    const std::string corrupt = "test_archive_bad.rpi";
+    const uint32_t version = 1;
+    const uint32_t zero_bits = 0, wide_bits = 40;
+    const uint64_t huge_games = uint64_t{1} << 60;
+    write_patched(index_path, corrupt, 12, &zero_bits, sizeof(zero_bits));
+    ASSERT_TRUE(!PositionIndex().open(corrupt));
+    write_patched(index_path, corrupt, 12, &wide_bits, sizeof(wide_bits));
+    ASSERT_TRUE(!PositionIndex().open(corrupt));
+    write_patched(index_path, corrupt, 16, &huge_games, sizeof(huge_games));
+    ASSERT_TRUE(!PositionIndex().open(corrupt));
+    write_patched(index_path, corrupt, 8, &version, sizeof(version), 4096);  // Truncated
+    ASSERT_TRUE(!PositionIndex().open(corrupt));
+    write_patched(index_path, corrupt, 8, &version, sizeof(version));  // Unchanged copy
+    ASSERT_TRUE(PositionIndex().open(corrupt));
+    std::remove(corrupt.c_str());
+
+    std::remove(wtb.c_str());
+    std::remove(index_path.c_str());
+}
+
+int main() {
+    std::cout << "========================================\n";
+    std::cout << "Game Archive Test\n";
+    std::cout << "========================================\n";
+
+    test_wthor_round_trip();
+    test_ggf_parsing();
+    test_position_index();
+
+    print_summary();
+
+    return tests_failed > 0 ? 1 : 0;
+}
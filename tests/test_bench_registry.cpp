@@ -0,0 +1,153 @@
+/*
+ * test_bench_registry.cpp - Benchmark registry, JSON and baseline comparison
+ * COMP390 Honours Year Project
+ *
+ * - Filtering, warmup and repetition counts
+ * - JSON results round-trip through read_json
+ * - Welch t-test and regression / improvement flags
+ */
+
+#include "test_utils.hpp"
+#include "research/benchmark/BenchRegistry.hpp"
+#include <cstdio>
+#include <iostream>
+#include <stdexcept>
+
+using namespace reversi::research;
+using namespace test;
+
+namespace {
+
+BenchRegistry::Result make_result(const std::string& name, double mean, double spread) {
+    BenchRegistry::Result r;
+    r.name = name;
+    r.unit = "ops";
+    for (int i = 0; i < 10; ++i) r.samples.push_back(mean + spread * ((i % 5) - 2));
+    r.stats = Statistics::calculate(r.samples);
+    return r;
+}
+
+} // namespace
+
+void test_registry_run() {
+    std::cout << "\n[TEST] Registry selection and repetitions\n";
+    std::cout << "-----------------------------------------\n";
+
+    BenchRegistry registry;
+    int setups = 0, calls = 0;
+    registry.add("micro", "count", "ops", [&] {
+        ++setups;
+        return BenchRegistry::Body([&] {
+            ++calls;
+            volatile uint64_t x = 0;
+            for (int i = 0; i < 10000; ++i) x = x + i;
+            return uint64_t{10000};
+        });
+    });
+    registry.add("macro", "other", "games", [] { return BenchRegistry::Body([] { return uint64_t{1}; }); });
+
+    bool threw = false;
+    try {
+        registry.add("micro", "count", "ops", [] { return BenchRegistry::Body([] { return uint64_t{1}; }); });
+    } catch (const std::invalid_argument&) {
+        threw = true;
+    }
+    ASSERT_TRUE(threw);
+
+    ASSERT_EQ(registry.select("").size(), static_cast<size_t>(2));
+    ASSERT_EQ(registry.select("macro").size(), static_cast<size_t>(1));
+    ASSERT_EQ(registry.select("count,other").size(), static_cast<size_t>(2));
+    ASSERT_EQ(registry.select("nothing").size(), static_cast<size_t>(0));
+
+    BenchRegistry::Config config;
+    config.filter = "micro";
+    config.warmup = 2;
+    config.repetitions = 5;
+    config.verbose = false;
+    auto results = registry.run(config);
+    ASSERT_EQ(results.size(), static_cast<size_t>(1));
+    ASSERT_EQ(setups, 1);
+    ASSERT_EQ(calls, 7);
+    ASSERT_EQ(results[0].name, std::string("micro/count"));
+    ASSERT_EQ(results[0].samples.size(), static_cast<size_t>(5));
+    ASSERT_EQ(results[0].ops_per_rep, 10000ULL);
+    ASSERT_GT(results[0].stats.mean, 0.0);
+
+#ifdef __linux__
+    ASSERT_TRUE(BenchRegistry::pin_to_cpu(0));
+#endif
+    ASSERT_TRUE(!BenchRegistry::pin_to_cpu(-1));
+}
+
+void test_json_round_trip() {
+    std::cout << "\n[TEST] JSON write / read\n";
+    std::cout << "------------------------\n";
+
+    std::vector<BenchRegistry::Result> results{make_result("micro/a", 1e6, 1e3), make_result("macro/b", 42.5, 0.5)};
+    const std::string path = "test_bench_registry_tmp.json";
+    ASSERT_TRUE(BenchRegistry::write_json(path, results, BenchRegistry::Config{}));
+
+    std::vector<BenchRegistry::Result> read;
+    ASSERT_TRUE(BenchRegistry::read_json(path, read));
+    ASSERT_EQ(read.size(), static_cast<size_t>(2));
+    ASSERT_EQ(read[1].name, std::string("macro/b"));
+    ASSERT_EQ(read[1].unit, std::string("ops"));
+    ASSERT_EQ(read[0].samples.size(), static_cast<size_t>(10));
+    ASSERT_LT(std::abs(read[0].stats.mean - results[0].stats.mean), 1e-3);
+    std::remove(path.c_str());
+
+    std::vector<BenchRegistry::Result> none;
+    ASSERT_TRUE(!BenchRegistry::read_json("does_not_exist.json", none));
+}
+
+void test_baseline_comparison() {
+    std::cout << "\n[TEST] Baseline comparison\n";
+    std::cout << "--------------------------\n";
+
+    // Welch t-test: clear shift vs. overlapping noise
+    auto t1 = Statistics::welch_t_test({10, 11, 9, 10, 10}, {20, 21, 19, 20, 20});
+    ASSERT_TRUE(t1.significant);
+    ASSERT_GT(t1.difference, 9.0);
+    auto t2 = Statistics::welch_t_test({10, 12, 8, 11, 9}, {10.5, 11, 9, 12, 8});
+    ASSERT_TRUE(!t2.significant);
+    ASSERT_TRUE(!Statistics::welch_t_test({1}, {2, 3}).significant);
+
+    std::vector<BenchRegistry::Result> base{
+        make_result("micro/slow", 1000, 5), make_result("micro/fast", 1000, 5),
+        make_result("micro/noisy", 1000, 300), make_result("micro/tiny", 1000, 1),
+        make_result("micro/gone", 1000, 5)};
+    std::vector<BenchRegistry::Result> cur{
+        make_result("micro/slow", 900, 5), make_result("micro/fast", 1100, 5),
+        make_result("micro/noisy", 950, 300), make_result("micro/tiny", 995, 1),
+        make_result("micro/added", 1000, 5)};
+
+    auto cmp = BenchRegistry::compare(base, cur, 3.0);
+    auto verdict = [&](const std::string& name) {
+        for (const auto& c : cmp) {
+            if (c.name == name) return c.verdict;
+        }
+        return BenchRegistry::Verdict::UNCHANGED;
+    };
+    ASSERT_EQ(cmp.size(), static_cast<size_t>(6));
+    ASSERT_TRUE(verdict("micro/slow") == BenchRegistry::Verdict::REGRESSED);
+    ASSERT_TRUE(verdict("micro/fast") == BenchRegistry::Verdict::IMPROVED);
+    ASSERT_TRUE(verdict("micro/noisy") == BenchRegistry::Verdict::UNCHANGED);  // Not significant
+    ASSERT_TRUE(verdict("micro/tiny") == BenchRegistry::Verdict::UNCHANGED);   // Significant but < 3%
+    ASSERT_TRUE(verdict("micro/added") == BenchRegistry::Verdict::NEW);
+    ASSERT_TRUE(verdict("micro/gone") == BenchRegistry::Verdict::MISSING);
+    ASSERT_LT(std::abs(cmp[0].change_pct + 10.0), 1e-9);
+}
+
+int main() {
+    std::cout << "========================================\n";
+    std::cout << "Benchmark Registry Test\n";
+    std::cout << "========================================\n";
+
+    test_registry_run();
+    test_json_round_trip();
+    test_baseline_comparison();
+
+    print_summary();
+
+    return tests_failed > 0 ? 1 : 0;
+}
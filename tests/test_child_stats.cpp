@@ -0,0 +1,222 @@
+/*
+ * test_child_stats.cpp - SoA child statistics and the UCB argmax kernels
+ * COMP390 Honours Year Project
+ *
+ * - ChildStats layout: padded strides, zeroed arrays
+ * - UCB1 / RAVE / implicit minimax argmax (AVX2 when built with it) agree
+ *   with the scalar reference on random statistics, child counts 1..64
+ * - Unvisited children first (lowest index), exclusions, all excluded
+ * - MCTS still searches correctly on top of it (visit counts add up)
+ */
+
+#include "test_utils.hpp"
+#include "ai/ChildStats.hpp"
+#include "ai/FastRng.hpp"
+#include "ai/MCTSEngine.hpp"
+#include <cmath>
+#include <iostream>
+#include <numeric>
+
+using namespace reversi::ai;
+using namespace test;
+
+namespace {
+
+double ucb1(double n, double w, double log_parent, double c) {
+    if (n == 0.0) return INFINITY;
+    return w / n + c * std::sqrt(log_parent / n);
+}
+
+double rave(double n, double w, double an, double aw, double log_parent, double c, double k) {
+    if (an == 0.0) return ucb1(n, w, log_parent, c);
+    const double safe_n = std::max(n, 1.0);
+    const double beta = std::sqrt(k / (3.0 * n + k));
+    return (1.0 - beta) * (w / safe_n) + beta * (aw / an) + c * std::sqrt(log_parent / safe_n);
+}
+
+double minimax(double n, double w, double v, double log_parent, double c, double alpha) {
+    const double safe_n = std::max(n, 1.0);
+    const double mean = n == 0.0 ? v : w / safe_n;
+    return (1.0 - alpha) * mean + alpha * v + c * std::sqrt(log_parent / safe_n);
+}
+
+/// Random statistics; some children unvisited, some without AMAF samples
+void fill(ChildStats& stats, int count, FastRng& rng, bool with_unvisited) {
+    stats.reset(count);
+    for (int i = 0; i < count; ++i) {
+        const bool unvisited = with_unvisited && rng.below(6) == 0;
+        stats.visits()[i] = unvisited ? 0.0f : static_cast<float>(1 + rng.below(5000));
+        stats.wins()[i] = stats.visits()[i] * static_cast<float>(rng.below(1001)) / 1000.0f;
+        stats.amaf_visits()[i] = rng.below(4) == 0 ? 0.0f : static_cast<float>(1 + rng.below(20000));
+        stats.amaf_wins()[i] = stats.amaf_visits()[i] * static_cast<float>(rng.below(1001)) / 1000.0f;
+        stats.values()[i] = static_cast<float>(rng.below(1001)) / 1000.0f;
+    }
+}
+
+} // namespace
+
+void test_layout() {
+    std::cout << "\n[TEST] ChildStats layout\n";
+    std::cout << "------------------------\n";
+
+    ChildStats stats;
+    stats.reset(10);
+    ASSERT_EQ(stats.size(), 10);
+    ASSERT_EQ(stats.stride(), 16);
+    ASSERT_EQ(stats.wins() - stats.visits(), 16);
+    ASSERT_EQ(stats.amaf_wins() - stats.visits(), 48);
+    ASSERT_EQ(stats.values() - stats.visits(), 64);
+    bool zero = true;
+    for (int i = 0; i < 5 * stats.stride(); ++i) zero = zero && stats.visits()[i] == 0.0f;
+    ASSERT_TRUE(zero);
+
+    stats.reset(8);
+    ASSERT_EQ(stats.stride(), 8);
+    stats.reset(1);
+    ASSERT_EQ(stats.stride(), 8);
+}
+
+void test_matches_reference() {
+    std::cout << "\n[TEST] Argmax matches the scalar reference\n";
+    std::cout << "------------------------------------------\n";
+
+    FastRng rng(99);
+    int checked = 0, ucb1_ok = 0, rave_ok = 0, minimax_ok = 0, same_index = 0;
+    for (int round = 0; round < 4000; ++round) {
+        const int count = 1 + static_cast<int>(rng.below(64));
+        ChildStats stats;
+        fill(stats, count, rng, round % 3 == 0);
+        uint64_t excluded = 0;
+        if (round % 4 == 1) excluded = rng() & rng();   // About a quarter excluded
+        if (count < 64) excluded &= (1ULL << count) - 1;
+        if (count < 64 && excluded == (1ULL << count) - 1) excluded = 0;
+        if (count == 64 && excluded == ~0ULL) excluded = 0;
+        const float log_parent = std::log(static_cast<float>(1 + rng.below(200000)));
+        const float c = 0.1f + static_cast<float>(rng.below(20)) / 10.0f;
+        const float alpha = static_cast<float>(rng.below(11)) / 10.0f;
+
+        // Exact (double) best value among the allowed children
+        double best_ucb1 = -INFINITY, best_rave = -INFINITY, best_minimax = -INFINITY;
+        for (int i = 0; i < count; ++i) {
+            if ((excluded >> i) & 1ULL) continue;
+            best_ucb1 = std::max(best_ucb1, ucb1(stats.visits()[i], stats.wins()[i], log_parent, c));
+            best_rave = std::max(best_rave, rave(stats.visits()[i], stats.wins()[i], stats.amaf_visits()[i],
+                                                 stats.amaf_wins()[i], log_parent, c, 100.0));
+            best_minimax = std::max(best_minimax, minimax(stats.visits()[i], stats.wins()[i], stats.values()[i],
+                                                          log_parent, c, alpha));
+        }
+
+        const int u = stats.select_ucb1(log_parent, c, excluded);
+        const int r = stats.select_rave(log_parent, c, 100.0f, excluded);
+        const int m = stats.select_minimax(log_parent, c, alpha, excluded);
+        const int u_scalar = ucb::argmax_ucb1_scalar(stats.visits(), stats.wins(), count, log_parent, c, excluded);
+        ++checked;
+        // Picked child is allowed and best up to float rounding
+        if (u >= 0 && u < count && !((excluded >> u) & 1ULL)) {
+            const double v = ucb1(stats.visits()[u], stats.wins()[u], log_parent, c);
+            ucb1_ok += (std::isinf(best_ucb1) ? std::isinf(v) : v >= best_ucb1 - 1e-5 * std::abs(best_ucb1));
+        }
+        if (r >= 0 && r < count && !((excluded >> r) & 1ULL)) {
+            const double v = rave(stats.visits()[r], stats.wins()[r], stats.amaf_visits()[r],
+                                  stats.amaf_wins()[r], log_parent, c, 100.0);
+            rave_ok += (std::isinf(best_rave) ? std::isinf(v) : v >= best_rave - 1e-5 * std::abs(best_rave));
+        }
+        if (m >= 0 && m < count && !((excluded >> m) & 1ULL)) {
+            const double v = minimax(stats.visits()[m], stats.wins()[m], stats.values()[m], log_parent, c, alpha);
+            minimax_ok += v >= best_minimax - 1e-5 * std::abs(best_minimax);
+        }
+        same_index += u == u_scalar;
+    }
+    std::cout << "  " << checked << " nodes: UCB1 " << ucb1_ok << " best, RAVE " << rave_ok << " best, minimax "
+              << minimax_ok << " best, " << same_index << " identical to the scalar path\n";
+    ASSERT_EQ(ucb1_ok, checked);
+    ASSERT_EQ(rave_ok, checked);
+    ASSERT_EQ(minimax_ok, checked);
+    ASSERT_GT(same_index, checked * 99 / 100);
+}
+
+void test_ties_and_exclusions() {
+    std::cout << "\n[TEST] Ties, unvisited children and exclusions\n";
+    std::cout << "----------------------------------------------\n";
+
+    ChildStats stats;
+    stats.reset(20);
+    for (int i = 0; i < 20; ++i) {
+        stats.visits()[i] = 10.0f;
+        stats.wins()[i] = 5.0f;
+    }
+    const float log_parent = std::log(201.0f);
+    ASSERT_EQ(stats.select_ucb1(log_parent, 1.4f, 0), 0);           // All equal: first
+    ASSERT_EQ(stats.select_ucb1(log_parent, 1.4f, 0x7), 3);         // First three excluded
+    ASSERT_EQ(ucb::argmax_ucb1_scalar(stats.visits(), stats.wins(), 20, log_parent, 1.4f, 0x7), 3);
+
+    stats.visits()[13] = 0.0f;
+    stats.wins()[13] = 0.0f;
+    stats.visits()[17] = 0.0f;
+    stats.wins()[17] = 0.0f;
+    ASSERT_EQ(stats.select_ucb1(log_parent, 1.4f, 0), 13);          // First unvisited
+    ASSERT_EQ(stats.select_ucb1(log_parent, 1.4f, 1ULL << 13), 17);
+    ASSERT_EQ(stats.select_rave(log_parent, 1.4f, 100.0f, 0), 13);  // No AMAF: plain UCB1
+
+    stats.wins()[19] = 9.0f;
+    ASSERT_EQ(stats.select_ucb1(log_parent, 1.4f, (1ULL << 13) | (1ULL << 17)), 19);  // Best win rate
+    ASSERT_EQ(stats.select_ucb1(log_parent, 1.4f, (1ULL << 20) - 1), -1);              // All excluded
+
+    // Padding lanes (20..23) are never picked, even though their visits are 0
+    ChildStats padded;
+    padded.reset(3);
+    for (int i = 0; i < 3; ++i) {
+        padded.visits()[i] = 4.0f;
+        padded.wins()[i] = 1.0f;
+    }
+    ASSERT_EQ(padded.select_ucb1(std::log(13.0f), 1.0f, 0), 0);
+    ASSERT_EQ(padded.select_ucb1(std::log(13.0f), 1.0f, 0x7), -1);
+
+    // AMAF pulls an unvisited child's score: the better AMAF wins
+    ChildStats amaf;
+    amaf.reset(3);
+    amaf.amaf_visits()[0] = 100.0f;
+    amaf.amaf_wins()[0] = 20.0f;
+    amaf.amaf_visits()[1] = 100.0f;
+    amaf.amaf_wins()[1] = 80.0f;
+    amaf.amaf_visits()[2] = 100.0f;
+    amaf.amaf_wins()[2] = 50.0f;
+    ASSERT_EQ(amaf.select_rave(0.0f, 0.2f, 100.0f, 0), 1);
+}
+
+void test_mcts_on_soa() {
+    std::cout << "\n[TEST] MCTS on SoA statistics\n";
+    std::cout << "-----------------------------\n";
+
+    reversi::core::Board board;
+    for (int move : {19, 18, 17, 34, 20}) board.apply_move_no_history(move);
+    for (bool rave_on : {false, true}) {
+        MCTSEngine::Config config = rave_on ? MCTSEngine::Config::preset_rave() : MCTSEngine::Config();
+        config.max_simulations = 4000;
+        config.seed = 12;
+        config.use_solver = false;
+        MCTSEngine engine(config);
+        const auto move = engine.find_best_move(board, SearchLimits(64, 60000));
+        const auto& stats = engine.get_mcts_stats();
+        const auto& visits = stats.move_visit_counts;
+        ASSERT_TRUE((board.legal_moves() >> move.position) & 1ULL);
+        ASSERT_EQ(std::accumulate(visits.begin(), visits.end(), 0), 4000);
+        ASSERT_GT(stats.win_rate, 0.0);
+        ASSERT_LT(stats.win_rate, 1.0);
+    }
+}
+
+int main() {
+    std::cout << "========================================\n";
+    std::cout << "Child Stats Test\n";
+    std::cout << "========================================\n";
+
+    test_layout();
+    test_matches_reference();
+    test_ties_and_exclusions();
+    test_mcts_on_soa();
+
+    print_summary();
+
+    return tests_failed > 0 ? 1 : 0;
+}
@@ -0,0 +1,181 @@
+/*
+ * test_endgame.cpp - Exact endgame solver and endgame suite benchmark
+ * COMP390 Honours Year Project
+ *
+ * - Solver scores match a plain negamax on random endgames
+ * - Last-empty shortcut and pass / game-over handling
+ * - run_endgame_suite checks reference scores and exports CSV / JSON
+ */
+
+#include "test_utils.hpp"
+#include "ai/EndgameSolver.hpp"
+#include "research/benchmark/Benchmark.hpp"
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <random>
+#include <sstream>
+
+using namespace reversi::research;
+using reversi::ai::EndgameSolver;
+using reversi::core::Board;
+using namespace test;
+
+namespace {
+
+Board random_endgame(std::mt19937& rng, int empties) {
+    for (;;) {
+        Board board;
+        std::vector<int> moves;
+        while (64 - board.count_player() - board.count_opponent() > empties && !board.is_terminal()) {
+            board.get_legal_moves(moves);
+            if (moves.empty()) {
+                board.pass();
+                continue;
+            }
+            board.make_move(moves[rng() % moves.size()]);
+        }
+        if (!board.is_terminal()) return board;
+    }
+}
+
+/// Reference: full-width negamax, no pruning
+int negamax(Board& board) {
+    std::vector<int> moves;
+    board.get_legal_moves(moves);
+    if (moves.empty()) {
+        board.pass();
+        bool over = board.legal_moves() == 0;
+        int score = over ? -EndgameSolver::final_score(board) : -negamax(board);
+        board.pass();
+        return score;
+    }
+    int best = -65;
+    for (int m : moves) {
+        uint64_t p = board.player, o = board.opponent, h = board.hash();
+        board.apply_move_no_history(m);
+        best = std::max(best, -negamax(board));
+        board.restore_state(p, o, h);
+    }
+    return best;
+}
+
+std::string read_file(const std::string& path) {
+    std::ifstream in(path);
+    std::stringstream ss;
+    ss << in.rdbuf();
+    return ss.str();
+}
+
+} // namespace
+
+void test_solver_matches_negamax() {
+    std::cout << "\n[TEST] Solver vs full-width negamax\n";
+    std::cout << "-----------------------------------\n";
+
+    std::mt19937 rng(5);
+    EndgameSolver solver(16);
+    int mismatches = 0, bad_moves = 0;
+    for (int i = 0; i < 60; ++i) {
+        Board board = random_endgame(rng, 1 + i % 9);
+        Board ref = board.copy();
+        int expected = negamax(ref);
+        solver.clear();
+        auto r = solver.solve(board);
+        if (r.score != expected) ++mismatches;
+        // The returned move must achieve the score
+        if (board.legal_moves()) {
+            Board after = board.copy();
+            after.apply_move_no_history(r.best_move);
+            if (-negamax(after) != expected) ++bad_moves;
+        }
+    }
+    ASSERT_EQ(mismatches, 0);
+    ASSERT_EQ(bad_moves, 0);
+
+    // Narrow windows still give correct bounds
+    Board board = random_endgame(rng, 8);
+    Board ref = board.copy();
+    int exact = negamax(ref);
+    solver.clear();
+    ASSERT_TRUE(solver.solve(board, exact - 1, exact + 1).score == exact);
+    solver.clear();
+    ASSERT_TRUE(solver.solve(board, exact, exact + 1).score <= exact);
+    solver.clear();
+    ASSERT_TRUE(solver.solve(board, exact - 1, exact).score >= exact);
+}
+
+void test_terminal_positions() {
+    std::cout << "\n[TEST] Passes and finished games\n";
+    std::cout << "--------------------------------\n";
+
+    // Full board: 40 player vs 24 opponent discs
+    Board full(0xFFFFFFFFFF000000ULL, 0x0000000000FFFFFFULL);
+    EndgameSolver solver(12);
+    ASSERT_EQ(solver.solve(full).score, 16);
+    ASSERT_EQ(solver.solve(full).best_move, -1);
+
+    // Nobody can move with empties left: they go to the winner
+    Board blocked(0x00000000000000FFULL, 0);
+    ASSERT_EQ(EndgameSolver::final_score(blocked), 64);
+    ASSERT_EQ(solver.solve(blocked).score, 64);
+}
+
+void test_endgame_suite() {
+    std::cout << "\n[TEST] Endgame suite benchmark and export\n";
+    std::cout << "----------------------------------------\n";
+
+    std::mt19937 rng(9);
+    std::vector<PositionFile::Position> suite;
+    for (int i = 0; i < 6; ++i) {
+        Board board = random_endgame(rng, 6 + i);
+        Board ref = board.copy();
+        auto pos = PositionFile::from_board(board);
+        pos.has_score = 1;
+        pos.score = static_cast<int8_t>(negamax(ref));
+        suite.push_back(pos);
+    }
+    suite[2].score = static_cast<int8_t>(suite[2].score + 2);  // Deliberately wrong reference
+    suite.push_back(PositionFile::from_board(random_endgame(rng, 14)));  // No reference
+
+    EndgameSuiteConfig config;
+    for (int i = 0; i < 7; ++i) config.labels.push_back("#" + std::to_string(40 + i));
+    config.tt_bits = 18;
+    BenchmarkResult r = Benchmark::run_endgame_suite(suite, config);
+    ASSERT_EQ(r.positions_tested, 7);
+    ASSERT_EQ(r.positions_checked, 6);
+    ASSERT_EQ(r.positions_correct, 5);
+    ASSERT_TRUE(!r.solves[2].correct);
+    ASSERT_EQ(r.solves[0].label, std::string("#40"));
+    ASSERT_GT(r.total_nodes, 0ULL);
+
+    config.max_empties = 10;
+    config.verbose = false;
+    ASSERT_EQ(Benchmark::run_endgame_suite(suite, config).positions_tested, 5);
+
+    std::vector<BenchmarkResult> results{r};
+    Benchmark::export_results(results, "auto", "test_endgame_tmp.json");
+    Benchmark::export_results(results, "solves_csv", "test_endgame_tmp.csv");
+    std::string json = read_file("test_endgame_tmp.json");
+    std::string csv = read_file("test_endgame_tmp.csv");
+    ASSERT_TRUE(json.find("\"algorithm\": \"EndgameSolver\"") != std::string::npos);
+    ASSERT_TRUE(json.find("\"position\": \"#46\"") != std::string::npos);
+    ASSERT_TRUE(json.find("\"correct\": false") != std::string::npos);
+    ASSERT_EQ(static_cast<int>(std::count(csv.begin(), csv.end(), '\n')), 8);
+    std::remove("test_endgame_tmp.json");
+    std::remove("test_endgame_tmp.csv");
+}
+
+int main() {
+    std::cout << "========================================\n";
+    std::cout << "Endgame Solver Test\n";
+    std::cout << "========================================\n";
+
+    test_solver_matches_negamax();
+    test_terminal_positions();
+    test_endgame_suite();
+
+    print_summary();
+
+    return tests_failed > 0 ? 1 : 0;
+}
@@ -2,25 +2,26 @@
  * Hash cache vs recompute consistency test
  */
 
+#include "test_utils.hpp"
 #include "core/Board.hpp"
-#include <cassert>
 #include <random>
 #include <bit>
 
 using namespace reversi::core;
+using namespace test;
 
-static uint64_t recompute_reference(const Board& b) {
+static uint64_t recompute_reference(const Board& b, int side) {
     uint64_t p = b.player;
     uint64_t o = b.opponent;
-    uint64_t h = 0;
+    uint64_t h = side ? Board::zobrist_side : 0;
     while (p) {
         int pos = std::countr_zero(p);
-        h ^= Board::zobrist_player[pos];
+        h ^= Board::zobrist_disc[side][pos];
         p &= p - 1;
     }
     while (o) {
         int pos = std::countr_zero(o);
-        h ^= Board::zobrist_opponent[pos];
+        h ^= Board::zobrist_disc[side ^ 1][pos];
         o &= o - 1;
     }
     return h;
@@ -29,27 +30,58 @@ static uint64_t recompute_reference(const Board& b) {
 int main() {
     Board b;
     std::mt19937 rng(42);
+    int side = 0;  // Side to move, tracked independently of the board
 
     for (int step = 0; step < 200; ++step) {
         auto moves = b.get_legal_moves();
         if (moves.empty()) {
             b.pass();
+            side ^= 1;
+            ASSERT_EQ(b.hash(), recompute_reference(b, side));
+            if (b.get_legal_moves().empty()) {
+                b = Board();
+                side = 0;
+            }
             continue;
         }
         int idx = rng() % moves.size();
         b.make_move(moves[idx]);
+        side ^= 1;
 
         uint64_t h_cache = b.hash();
-        uint64_t h_ref = recompute_reference(b);
-        assert(h_cache == h_ref);
+        uint64_t h_ref = recompute_reference(b, side);
+        ASSERT_EQ(h_cache, h_ref);
+        ASSERT_EQ(b.side_to_move(), side);
+
+        // pass() is a single side-key XOR and must round-trip exactly
+        b.pass();
+        ASSERT_EQ(b.hash(), recompute_reference(b, side ^ 1));
+        b.pass();
+        ASSERT_EQ(b.hash(), h_cache);
+
+        // Fast path must agree with make_move
+        Board fast = b;
+        Board slow = b;
+        auto next = b.get_legal_moves();
+        if (!next.empty()) {
+            int mv = next[rng() % next.size()];
+            fast.apply_move_no_history(mv);
+            slow.make_move(mv);
+            ASSERT_EQ(fast.hash(), slow.hash());
+            ASSERT_EQ(fast.hash(), fast.compute_hash());
+        }
 
         // Occasionally undo
         if (step % 7 == 0) {
             b.undo_move(0);
-            assert(b.hash() == recompute_reference(b));
+            side ^= 1;
+            ASSERT_EQ(b.hash(), recompute_reference(b, side));
         }
     }
-    return 0;
+
+    print_summary();
+
+    return tests_failed > 0 ? 1 : 0;
 }
 
 
@@ -0,0 +1,230 @@
+/*
+ * test_hash_quality.cpp - Zobrist hash quality test
+ * COMP390 Honours Year Project
+ *
+ * Measures collision behaviour of Board::hash() over millions of positions
+ * derived from PositionSuite:
+ * - Full 64-bit collisions between distinct positions (expected: none)
+ * - Collisions on the low TT-index bits vs. the birthday-bound expectation
+ * - Bucket uniformity (chi-square) of the TT index
+ * - pass() round trip stays consistent with a full recompute
+ */
+
+#include "test_utils.hpp"
+#include "core/Board.hpp"
+#include "research/benchmark/PositionSuite.hpp"
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <algorithm>
+#include <cmath>
+#include <bit>
+
+using namespace reversi::core;
+using reversi::research::PositionSuite;
+using namespace test;
+
+namespace {
+
+struct HashedPosition {
+    uint64_t hash;
+    uint64_t player;
+    uint64_t opponent;
+
+    bool same_position(const HashedPosition& o) const {
+        // Side to move lives in bit 0 of the hash
+        return player == o.player && opponent == o.opponent &&
+               ((hash ^ o.hash) & 1ULL) == 0;
+    }
+};
+
+constexpr int TARGET_POSITIONS = 2'000'000;
+constexpr int INDEX_BITS = 20;      // MinimaxEngine default TT size (2^20)
+constexpr int CHI_BUCKET_BITS = 16; // Buckets for the uniformity test
+
+/**
+ * @brief Collect positions: PositionSuite seeds expanded two plies deep
+ */
+std::vector<HashedPosition> collect_positions() {
+    std::vector<HashedPosition> out;
+    out.reserve(TARGET_POSITIONS + 4096);
+
+    auto push = [&](const Board& b) {
+        out.push_back({b.hash(), b.player, b.opponent});
+    };
+
+    uint32_t seed = 1;
+    while (static_cast<int>(out.size()) < TARGET_POSITIONS) {
+        auto seeds = PositionSuite::generate_suite(PositionSuite::SuiteType::RANDOM, 256, seed++);
+        for (const Board& root : seeds) {
+            push(root);
+            Board b = root;
+            uint64_t m1 = b.legal_moves();
+            while (m1) {
+                int mv = std::countr_zero(m1);
+                m1 &= m1 - 1;
+                uint64_t p = b.player, o = b.opponent, h = b.hash();
+                b.apply_move_no_history(mv);
+                push(b);
+                uint64_t m2 = b.legal_moves();
+                if (m2 == 0) {
+                    b.pass();
+                    push(b);
+                    b.pass();
+                }
+                while (m2) {
+                    int mv2 = std::countr_zero(m2);
+                    m2 &= m2 - 1;
+                    uint64_t p2 = b.player, o2 = b.opponent, h2 = b.hash();
+                    b.apply_move_no_history(mv2);
+                    push(b);
+                    b.restore_state(p2, o2, h2);
+                }
+                b.restore_state(p, o, h);
+            }
+        }
+    }
+    return out;
+}
+
+/**
+ * @brief Number of colliding pairs among keys (keys are sorted in place)
+ */
+double count_pairs(std::vector<uint64_t>& keys) {
+    std::sort(keys.begin(), keys.end());
+    double pairs = 0.0;
+    size_t i = 0;
+    while (i < keys.size()) {
+        size_t j = i + 1;
+        while (j < keys.size() && keys[j] == keys[i]) ++j;
+        double run = static_cast<double>(j - i);
+        pairs += run * (run - 1.0) / 2.0;
+        i = j;
+    }
+    return pairs;
+}
+
+} // namespace
+
+void test_full_hash_collisions(std::vector<HashedPosition>& positions, std::vector<HashedPosition>& distinct) {
+    std::cout << "\n[TEST] Full 64-bit collisions\n";
+    std::cout << "-----------------------------\n";
+
+    std::sort(positions.begin(), positions.end(), [](const auto& a, const auto& b) {
+        if (a.hash != b.hash) return a.hash < b.hash;
+        if (a.player != b.player) return a.player < b.player;
+        return a.opponent < b.opponent;
+    });
+
+    int collisions = 0;
+    distinct.clear();
+    distinct.reserve(positions.size());
+    for (const auto& p : positions) {
+        if (!distinct.empty() && distinct.back().hash == p.hash) {
+            if (!distinct.back().same_position(p)) ++collisions;
+            continue;
+        }
+        distinct.push_back(p);
+    }
+
+    std::cout << "  Positions sampled:  " << format_number(positions.size()) << "\n";
+    std::cout << "  Distinct positions: " << format_number(distinct.size()) << "\n";
+    std::cout << "  64-bit collisions:  " << collisions << "\n";
+
+    ASSERT_GE(distinct.size(), static_cast<size_t>(1'000'000));
+    ASSERT_EQ(collisions, 0);
+}
+
+void test_index_collision_rate(const std::vector<HashedPosition>& distinct) {
+    std::cout << "\n[TEST] TT index collision rate (" << INDEX_BITS << " bits)\n";
+    std::cout << "----------------------------------\n";
+
+    const uint64_t mask = (1ULL << INDEX_BITS) - 1;
+    std::vector<uint64_t> keys;
+    keys.reserve(distinct.size());
+    double n_side[2] = {0.0, 0.0};
+    for (const auto& p : distinct) {
+        keys.push_back(p.hash & mask);
+        n_side[p.hash & 1ULL] += 1.0;
+    }
+    double observed = count_pairs(keys);
+
+    // Bit 0 is the side to move, so only same-side pairs can share an index;
+    // the remaining INDEX_BITS-1 bits should behave like uniform random bits.
+    double slots = static_cast<double>(1ULL << (INDEX_BITS - 1));
+    double expected = (n_side[0] * (n_side[0] - 1.0) / 2.0 +
+                       n_side[1] * (n_side[1] - 1.0) / 2.0) / slots;
+    double ratio = observed / expected;
+
+    std::cout << std::fixed << std::setprecision(4);
+    std::cout << "  Colliding pairs (observed): " << observed << "\n";
+    std::cout << "  Colliding pairs (expected): " << expected << "\n";
+    std::cout << "  Observed / expected:        " << ratio << "\n";
+    std::cout << "  Pair collision rate:        "
+              << observed / (static_cast<double>(distinct.size()) * (distinct.size() - 1) / 2.0) << "\n";
+
+    ASSERT_GT(ratio, 0.97);
+    ASSERT_LT(ratio, 1.03);
+}
+
+void test_bucket_uniformity(const std::vector<HashedPosition>& distinct) {
+    std::cout << "\n[TEST] Bucket uniformity (chi-square, " << (1 << CHI_BUCKET_BITS) << " buckets)\n";
+    std::cout << "--------------------------------------------\n";
+
+    // Skip the side bit; use the next CHI_BUCKET_BITS bits of the index
+    const size_t buckets = 1ULL << CHI_BUCKET_BITS;
+    std::vector<uint32_t> counts(buckets, 0);
+    for (const auto& p : distinct) {
+        ++counts[(p.hash >> 1) & (buckets - 1)];
+    }
+    double expected = static_cast<double>(distinct.size()) / buckets;
+    double chi2 = 0.0;
+    for (uint32_t c : counts) {
+        double d = c - expected;
+        chi2 += d * d / expected;
+    }
+    double dof = static_cast<double>(buckets - 1);
+    double z = (chi2 - dof) / std::sqrt(2.0 * dof);
+
+    std::cout << std::fixed << std::setprecision(2);
+    std::cout << "  chi2 = " << chi2 << " (dof " << dof << ", z = " << z << ")\n";
+
+    ASSERT_LT(std::abs(z), 6.0);
+}
+
+void test_pass_consistency(const std::vector<HashedPosition>& distinct) {
+    std::cout << "\n[TEST] pass() vs full recompute\n";
+    std::cout << "-------------------------------\n";
+
+    int mismatches = 0;
+    for (size_t i = 0; i < distinct.size(); i += 97) {
+        Board b(distinct[i].player, distinct[i].opponent);
+        b.pass();
+        if (b.hash() != b.compute_hash()) ++mismatches;
+        b.pass();
+        if (b.hash() != b.compute_hash()) ++mismatches;
+    }
+    std::cout << "  Mismatches: " << mismatches << "\n";
+    ASSERT_EQ(mismatches, 0);
+}
+
+int main() {
+    std::cout << "========================================\n";
+    std::cout << "Zobrist Hash Quality Test\n";
+    std::cout << "========================================\n";
+
+    Timer timer;
+    auto positions = collect_positions();
+    std::cout << "Collected " << format_number(positions.size()) << " positions in "
+              << std::fixed << std::setprecision(1) << timer.elapsed_ms() << " ms\n";
+
+    std::vector<HashedPosition> distinct;
+    test_full_hash_collisions(positions, distinct);
+    test_index_collision_rate(distinct);
+    test_bucket_uniformity(distinct);
+    test_pass_consistency(distinct);
+
+    print_summary();
+
+    return tests_failed > 0 ? 1 : 0;
+}
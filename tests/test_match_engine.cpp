@@ -0,0 +1,215 @@
+/*
+ * test_match_engine.cpp - MatchEngine parallel runner tests
+ * COMP390 Honours Year Project
+ *
+ * - Parallel and sequential matches give identical per-game results for
+ *   the same seed (deterministic search limits)
+ * - Results are stored in game order with the scheduled colours
+ * - Factory-based matches with evaluator-specific engines
+ * - Pentanomial SPRT: decisions on synthetic counts, early stopping on a
+ *   lopsided match, and the same stop point for any thread count
+ * - Throughput vs thread count (reported, not asserted)
+ */
+
+#include "test_utils.hpp"
+#include "ai/MinimaxEngine.hpp"
+#include "ai/MCTSEngine.hpp"
+#include "ai/Evaluator_Week4.hpp"
+#include "research/benchmark/MatchEngine.hpp"
+#include <iostream>
+#include <iomanip>
+#include <memory>
+#include <thread>
+#include <array>
+#include <cmath>
+
+using namespace reversi::ai;
+using reversi::research::MatchEngine;
+using reversi::research::Statistics;
+using namespace test;
+
+namespace {
+
+MatchEngine::MatchConfig make_config(int games, int threads) {
+    MatchEngine::MatchConfig config(games);
+    config.random_seed = 12345;
+    config.num_threads = threads;
+    config.collect_move_history = true;
+    config.limits = SearchLimits(3, 0);  // Depth-limited: deterministic
+    return config;
+}
+
+bool same_games(const MatchEngine::MatchResult& a, const MatchEngine::MatchResult& b) {
+    if (a.games.size() != b.games.size()) return false;
+    for (size_t i = 0; i < a.games.size(); ++i) {
+        if (a.games[i].winner != b.games[i].winner ||
+            a.games[i].final_score_diff != b.games[i].final_score_diff ||
+            a.games[i].moves != b.games[i].moves ||
+            a.games[i].player1_nodes != b.games[i].player1_nodes) {
+            return false;
+        }
+    }
+    return true;
+}
+
+} // namespace
+
+void test_parallel_matches_sequential() {
+    std::cout << "\n[TEST] Parallel match == sequential match (same seed)\n";
+    std::cout << "-----------------------------------------------------\n";
+    
+    MCTSEngine::Config mcts_config(100, 600000);  // Simulation-limited
+    auto minimax = std::make_shared<MinimaxEngine>(MinimaxEngine::Config(3));
+    auto mcts = std::make_shared<MCTSEngine>(mcts_config);
+    
+    auto seq = MatchEngine::play_match(minimax, mcts, make_config(4, 1));
+    auto par = MatchEngine::play_match(minimax, mcts, make_config(4, 4));
+    
+    std::cout << "  Sequential: " << seq.player1_wins << "-" << seq.player2_wins << "-" << seq.draws << "\n";
+    std::cout << "  Parallel:   " << par.player1_wins << "-" << par.player2_wins << "-" << par.draws << "\n";
+    
+    ASSERT_EQ(seq.total_games(), 4);
+    ASSERT_EQ(par.total_games(), 4);
+    ASSERT_EQ(seq.random_seed, par.random_seed);
+    ASSERT_TRUE(same_games(seq, par));
+    ASSERT_EQ(seq.player1_name, par.player1_name);
+    
+    // Same seed again: still identical (MCTS reseeded per game)
+    auto again = MatchEngine::play_match(minimax, mcts, make_config(4, 3));
+    ASSERT_TRUE(same_games(seq, again));
+}
+
+void test_game_order_and_colours() {
+    std::cout << "\n[TEST] Results in game order with alternating colours\n";
+    std::cout << "------------------------------------------------------\n";
+    
+    MatchEngine::StrategyFactory week3 = [] {
+        return std::make_unique<MinimaxEngine>(MinimaxEngine::Config(2));
+    };
+    MatchEngine::StrategyFactory week4 = [] {
+        return std::make_unique<MinimaxEngine>(MinimaxEngine::Config(2), UseEvaluator<EvaluatorWeek4>{});
+    };
+    
+    auto result = MatchEngine::play_match(week4, week3, make_config(6, 3));
+    ASSERT_EQ(static_cast<int>(result.games.size()), 6);
+    for (size_t i = 0; i < result.games.size(); ++i) {
+        ASSERT_EQ(result.games[i].player1_was_black, i % 2 == 0);
+        ASSERT_GT(result.games[i].move_count, 0);
+    }
+    ASSERT_TRUE(result.player1_name.find("Week4") != std::string::npos);
+    ASSERT_EQ(result.game_lengths.size(), result.games.size());
+    std::cout << "  " << result.player1_name << " vs " << result.player2_name << ": "
+              << result.player1_wins << "-" << result.player2_wins << "-" << result.draws << "\n";
+}
+
+void test_sprt_statistics() {
+    std::cout << "\n[TEST] Pentanomial SPRT decisions\n";
+    std::cout << "---------------------------------\n";
+    
+    Statistics::SPRTConfig config(0.0, 10.0, 0.05, 0.05);
+    
+    // Too few pairs: keep going
+    auto early = Statistics::sprt_pentanomial({0, 1, 2, 1, 0}, config);
+    ASSERT_TRUE(early.decision == Statistics::SPRTDecision::CONTINUE);
+    ASSERT_GT(early.upper_bound, 0.0);
+    ASSERT_LT(early.lower_bound, 0.0);
+    
+    // Clearly stronger player1 (~+190 Elo): accept H1
+    auto strong = Statistics::sprt_pentanomial({5, 20, 60, 120, 95}, config);
+    std::cout << "  strong: LLR " << strong.llr << " elo " << strong.elo << " " << strong.decision_name() << "\n";
+    ASSERT_TRUE(strong.decision == Statistics::SPRTDecision::ACCEPT_H1);
+    ASSERT_GT(strong.elo, 100.0);
+    
+    // Equal players over many pairs: accept H0 (elo0 = 0 is closer than elo1 = 10)
+    auto equal = Statistics::sprt_pentanomial({300, 1200, 3000, 1200, 300}, config);
+    std::cout << "  equal:  LLR " << equal.llr << " elo " << equal.elo << " " << equal.decision_name() << "\n";
+    ASSERT_TRUE(equal.decision == Statistics::SPRTDecision::ACCEPT_H0);
+    ASSERT_EQ(equal.pairs, 6000);
+    ASSERT_LT(std::abs(equal.elo), 1.0);
+    
+    // Elo <-> score round trip
+    ASSERT_LT(std::abs(Statistics::score_to_elo(Statistics::elo_to_score(50.0)) - 50.0), 1e-6);
+}
+
+void test_sprt_match_stops_early() {
+    std::cout << "\n[TEST] SPRT stops a lopsided match (same stop for 1 and 3 threads)\n";
+    std::cout << "--------------------------------------------------------------------\n";
+    
+    auto strong = std::make_shared<MinimaxEngine>(MinimaxEngine::Config(4));
+    auto weak = std::make_shared<MinimaxEngine>(MinimaxEngine::Config(1));
+    
+    MatchEngine::MatchConfig config = make_config(400, 1);
+    config.limits = SearchLimits(4, 0);
+    config.player2_limits = SearchLimits(1, 0);
+    config.opening_plies = 6;
+    config.use_sprt = true;
+    config.sprt = Statistics::SPRTConfig(0.0, 100.0, 0.05, 0.05);
+    config.sprt_report_every = 5;
+    
+    auto seq = MatchEngine::play_match(strong, weak, config);
+    std::cout << "  stopped after " << seq.total_games() << " games, " << seq.sprt.decision_name()
+              << ", elo " << seq.sprt.elo << " +/- " << seq.sprt.elo_ci95 << "\n";
+    ASSERT_TRUE(seq.stopped_early);
+    ASSERT_TRUE(seq.sprt.decision == Statistics::SPRTDecision::ACCEPT_H1);
+    ASSERT_LT(seq.total_games(), 400);
+    ASSERT_EQ(seq.total_games() % 2, 0);
+    ASSERT_EQ(seq.sprt.pairs * 2, seq.total_games());
+    ASSERT_GE(seq.sprt.pairs, config.sprt.min_pairs);
+    
+    // Pentanomial counts agree with the stored games
+    std::array<int, 5> penta{};
+    for (size_t i = 0; i + 1 < seq.games.size(); i += 2) {
+        penta[MatchEngine::pair_points(seq.games[i], seq.games[i + 1])]++;
+    }
+    ASSERT_TRUE(penta == seq.sprt.pentanomial);
+    
+    config.num_threads = 3;
+    config.sprt_report_every = 0;
+    auto par = MatchEngine::play_match(strong, weak, config);
+    ASSERT_EQ(par.total_games(), seq.total_games());
+    ASSERT_TRUE(same_games(seq, par));
+    
+    // Pair openings are reproducible and shared by both games of a pair
+    auto o1 = MatchEngine::make_opening(12345, 3, 6);
+    auto o2 = MatchEngine::make_opening(12345, 3, 6);
+    ASSERT_EQ(o1.hash(), o2.hash());
+    ASSERT_EQ(o1.count_player() + o1.count_opponent(), 10);
+}
+
+void test_throughput() {
+    std::cout << "\n[TEST] Throughput vs threads\n";
+    std::cout << "----------------------------\n";
+    
+    auto a = std::make_shared<MinimaxEngine>(MinimaxEngine::Config(3));
+    auto b = std::make_shared<MinimaxEngine>(MinimaxEngine::Config(3), UseEvaluator<EvaluatorWeek4Fast>{});
+    int cores = static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+    
+    double base_ms = 0.0;
+    for (int threads : {1, cores}) {
+        Timer timer;
+        auto r = MatchEngine::play_match(a, b, make_config(8, threads));
+        double ms = timer.elapsed_ms();
+        if (threads == 1) base_ms = ms;
+        std::cout << "  " << threads << " thread(s): " << std::fixed << std::setprecision(1)
+                  << ms << " ms, " << r.total_games() * 1000.0 / ms << " games/s"
+                  << " (speedup " << std::setprecision(2) << base_ms / ms << "x)\n";
+        ASSERT_EQ(r.total_games(), 8);
+        if (cores == 1) break;
+    }
+}
+
+int main() {
+    std::cout << "========================================\n";
+    std::cout << "MatchEngine Parallel Runner Test\n";
+    std::cout << "========================================\n";
+    
+    test_parallel_matches_sequential();
+    test_game_order_and_colours();
+    test_sprt_statistics();
+    test_sprt_match_stops_early();
+    test_throughput();
+    
+    print_summary();
+    
+    return tests_failed > 0 ? 1 : 0;
+}
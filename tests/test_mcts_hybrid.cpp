@@ -0,0 +1,123 @@
+/*
+ * test_mcts_hybrid.cpp - Hybrid MCTS-alpha-beta (evaluator leaves)
+ * COMP390 Honours Year Project
+ *
+ * - Evaluator leaves (direct and via a depth-1 search) replace playouts
+ *   and give legal, reproducible moves
+ * - The bound evaluator survives clone() and shows in the name
+ * - preset_hybrid() proves small endgames with the exact value
+ * - At equal simulations, preset_hybrid() outplays playout-based MCTS
+ */
+
+#include "test_utils.hpp"
+#include "mcts_test_utils.hpp"
+#include "ai/EndgameSolver.hpp"
+#include "ai/Evaluator_Week4.hpp"
+#include "ai/MCTSEngine.hpp"
+#include "research/benchmark/PositionSuite.hpp"
+#include <iostream>
+#include <memory>
+#include <vector>
+
+using namespace reversi::ai;
+using namespace test;
+using reversi::core::Board;
+using reversi::core::Move;
+using reversi::research::PositionSuite;
+
+void test_leaf_search() {
+    std::cout << "\n[TEST] Evaluator leaves replace playouts\n";
+    std::cout << "---------------------------------------\n";
+
+    Board board;
+    for (int move : {19, 18, 17, 34}) board.apply_move_no_history(move);
+    for (int depth : {0, 1}) {
+        MCTSEngine::Config config = MCTSEngine::Config::preset_hybrid();
+        config.max_simulations = 1000;
+        config.leaf_search_depth = depth;
+        config.seed = 8;
+        MCTSEngine a(config);
+        MCTSEngine b(config);
+        const Move ma = a.find_best_move(board, SearchLimits(64, 60000));
+        const Move mb = b.find_best_move(board, SearchLimits(64, 60000));
+        const auto& stats = a.get_mcts_stats();
+        std::cout << "  depth " << depth << ": move " << ma.position << ", " << stats.leaf_evaluations
+                  << " leaf evaluations\n";
+        ASSERT_EQ(ma.position, mb.position);
+        ASSERT_TRUE((board.legal_moves() >> ma.position) & 1ULL);
+        ASSERT_EQ(stats.simulations_performed, 1000);
+        ASSERT_GT(stats.leaf_evaluations, 0);
+        ASSERT_EQ(stats.average_playout_length, 0.0);
+    }
+}
+
+void test_evaluator_binding() {
+    std::cout << "\n[TEST] Bound evaluator survives clone()\n";
+    std::cout << "--------------------------------------\n";
+
+    MCTSEngine::Config config = MCTSEngine::Config::preset_hybrid();
+    config.leaf_eval_scale = 4 * config.leaf_eval_scale;
+    config.max_simulations = 300;
+    MCTSEngine engine(config, UseEvaluator<EvaluatorWeek4>{});
+    const std::unique_ptr<AIStrategy> copy = engine.clone();
+    std::cout << "  " << engine.get_name() << " / " << copy->get_name() << "\n";
+    ASSERT_TRUE(engine.get_name().find("Week4") != std::string::npos);
+    ASSERT_TRUE(copy->get_name() == engine.get_name());
+
+    Board board;
+    const Move a = engine.find_best_move(board, SearchLimits(64, 60000));
+    const Move b = copy->find_best_move(board, SearchLimits(64, 60000));
+    ASSERT_EQ(a.position, b.position);
+}
+
+void test_hybrid_solver() {
+    std::cout << "\n[TEST] preset_hybrid() proves small endgames\n";
+    std::cout << "--------------------------------------------\n";
+
+    EndgameSolver exact(16);
+    MCTSEngine::Config config = MCTSEngine::Config::preset_hybrid();
+    config.max_simulations = 200000;
+    config.seed = 3;
+    const auto proofs = prove_endgames(config, PositionSuite::generate_endgame(8, 54, 55, 31), exact);
+    std::cout << "  " << proofs.correct << "/" << proofs.checked << " roots proven with the exact value\n";
+    ASSERT_GT(proofs.checked, 0);
+    ASSERT_EQ(proofs.correct, proofs.checked);
+}
+
+void test_hybrid_strength() {
+    std::cout << "\n[TEST] Hybrid outplays playout MCTS at 300 simulations\n";
+    std::cout << "------------------------------------------------------\n";
+
+    const auto openings = PositionSuite::generate_opening(10, 4, 4, 9);
+    int wins = 0, losses = 0;
+    for (size_t i = 0; i < openings.size(); ++i) {
+        for (bool hybrid_first : {true, false}) {
+            MCTSEngine::Config hybrid_config = MCTSEngine::Config::preset_hybrid();
+            hybrid_config.seed = i + 1;
+            MCTSEngine::Config plain_config;
+            plain_config.seed = i + 101;
+            MCTSEngine hybrid(hybrid_config);
+            MCTSEngine plain(plain_config);
+            const int diff = play_game(hybrid, plain, openings[i], hybrid_first, 300);
+            wins += diff > 0;
+            losses += diff < 0;
+        }
+    }
+    std::cout << "  Hybrid " << wins << " wins, " << losses << " losses in " << 2 * openings.size() << " games\n";
+    ASSERT_GT(wins, 2 * losses);
+}
+
+int main() {
+    std::cout << "========================================\n";
+    std::cout << "MCTS Hybrid (Alpha-Beta Leaves) Test\n";
+    std::cout << "========================================\n";
+
+    test_leaf_search();
+    test_evaluator_binding();
+    test_hybrid_solver();
+    test_hybrid_strength();
+
+    print_summary();
+
+    return tests_failed > 0 ? 1 : 0;
+}
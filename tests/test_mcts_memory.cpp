@@ -0,0 +1,130 @@
+/*
+ * test_mcts_memory.cpp - Memory-bounded MCTS (node recycling)
+ * COMP390 Honours Year Project
+ *
+ * - Without a budget the tree outgrows it; with one it stays within it
+ *   and reports the nodes reclaimed
+ * - Bounded search (tree and DAG modes) returns legal, reproducible moves
+ * - Proofs reached under a tight budget (subtrees pruned) stay exact
+ * - A bounded engine still beats a random player
+ */
+
+#include "test_utils.hpp"
+#include "mcts_test_utils.hpp"
+#include "ai/EndgameSolver.hpp"
+#include "ai/MCTSEngine.hpp"
+#include "research/benchmark/PositionSuite.hpp"
+#include <iostream>
+#include <vector>
+
+using namespace reversi::ai;
+using namespace test;
+using reversi::core::Board;
+using reversi::core::Move;
+using reversi::research::PositionSuite;
+
+namespace {
+
+MCTSEngine::Config bounded_config(int sims, uint64_t seed, size_t budget_mb) {
+    MCTSEngine::Config config(sims, 600000);
+    config.seed = seed;
+    config.memory_budget_mb = budget_mb;
+    return config;
+}
+
+} // namespace
+
+void test_budget_respected() {
+    std::cout << "\n[TEST] Tree stays within the budget\n";
+    std::cout << "-----------------------------------\n";
+
+    const Board board = opening_position();
+    const size_t budget = 1;  // MiB
+    MCTSEngine unbounded(bounded_config(60000, 3, 0));
+    unbounded.find_best_move(board, SearchLimits(64, 600000));
+    const auto& u = unbounded.get_mcts_stats();
+
+    MCTSEngine bounded(bounded_config(60000, 3, budget));
+    const Move move = bounded.find_best_move(board, SearchLimits(64, 600000));
+    const auto& b = bounded.get_mcts_stats();
+    std::cout << "  Unbounded: " << u.tree_nodes_created << " nodes, " << (u.tree_bytes >> 10) << " KiB\n";
+    std::cout << "  1 MiB budget: " << b.tree_nodes_created << " nodes, " << (b.tree_bytes >> 10) << " KiB, "
+              << b.nodes_reclaimed << " reclaimed\n";
+    ASSERT_EQ(u.nodes_reclaimed, 0);
+    ASSERT_GT(u.tree_bytes, budget << 20);
+    ASSERT_GT(b.nodes_reclaimed, 0);
+    ASSERT_LE(b.tree_bytes, budget << 20);
+    ASSERT_EQ(b.simulations_performed, 60000);
+    ASSERT_TRUE((board.legal_moves() >> move.position) & 1ULL);
+}
+
+void test_bounded_search() {
+    std::cout << "\n[TEST] Bounded search is legal and reproducible\n";
+    std::cout << "-----------------------------------------------\n";
+
+    const Board board = opening_position();
+    for (bool dag : {false, true}) {
+        MCTSEngine::Config config = bounded_config(30000, 11, 1);
+        config.use_transpositions = dag;
+        config.use_rave = dag;
+        MCTSEngine a(config);
+        MCTSEngine b(config);
+        const Move ma = a.find_best_move(board, SearchLimits(64, 600000));
+        const Move mb = b.find_best_move(board, SearchLimits(64, 600000));
+        // A second search on the same engine (same seed) reuses the pool from scratch
+        a.set_seed(config.seed);
+        const Move again = a.find_best_move(board, SearchLimits(64, 600000));
+        const auto& stats = b.get_mcts_stats();
+        std::cout << "  " << (dag ? "DAG + RAVE" : "tree") << ": move " << ma.position << ", "
+                  << stats.nodes_reclaimed << " reclaimed, " << stats.transpositions << " transpositions\n";
+        ASSERT_EQ(ma.position, mb.position);
+        ASSERT_EQ(again.position, ma.position);
+        ASSERT_GT(stats.nodes_reclaimed, 0);
+        ASSERT_LE(stats.tree_bytes, size_t{1} << 20);
+        ASSERT_TRUE((board.legal_moves() >> ma.position) & 1ULL);
+    }
+}
+
+void test_solver_bounded() {
+    std::cout << "\n[TEST] Solver under a tight budget\n";
+    std::cout << "----------------------------------\n";
+
+    // Pruned subtrees keep their proofs: every proof reached is still exact
+    EndgameSolver exact(16);
+    int reclaimed = 0;
+    const auto proofs = prove_endgames(bounded_config(400000, 4, 1), PositionSuite::generate_endgame(8, 50, 51, 19),
+                                       exact, [&](const MCTSEngine& engine) {
+                                           reclaimed += engine.get_mcts_stats().nodes_reclaimed > 0;
+                                       });
+    std::cout << "  " << proofs.proven << "/" << proofs.checked << " roots proven, " << proofs.correct
+              << " correct; " << reclaimed << " searches reclaimed nodes\n";
+    ASSERT_GT(proofs.checked, 0);
+    ASSERT_GT(proofs.proven, 0);
+    ASSERT_GT(reclaimed, 0);
+    ASSERT_EQ(proofs.correct, proofs.proven);
+}
+
+void test_beats_random() {
+    std::cout << "\n[TEST] Bounded engine beats a random player\n";
+    std::cout << "-------------------------------------------\n";
+
+    const int games = 10;
+    const int wins = play_vs_random(bounded_config(3000, 1, 1), games, 23);
+    std::cout << "  MCTS won " << wins << "/" << games << "\n";
+    ASSERT_GE(wins, 8);
+}
+
+int main() {
+    std::cout << "========================================\n";
+    std::cout << "MCTS Memory Budget Test\n";
+    std::cout << "========================================\n";
+
+    test_budget_respected();
+    test_bounded_search();
+    test_solver_bounded();
+    test_beats_random();
+
+    print_summary();
+
+    return tests_failed > 0 ? 1 : 0;
+}
@@ -0,0 +1,203 @@
+/*
+ * test_mcts_rave.cpp - RAVE / AMAF statistics in MCTS
+ * COMP390 Honours Year Project
+ *
+ * - Playout kernel reports the squares each side played (AMAF input)
+ * - AMAF counts: every simulation through a root move credits it, plus
+ *   later plays of the same square; nothing without RAVE
+ * - Beta schedule sqrt(k / (3n + k)) hands selection from AMAF to the mean
+ * - RAVE search returns legal, reproducible moves (tree and DAG modes)
+ * - MCTS-Solver still proves small endgames with RAVE on
+ * - At a low budget, preset_rave() outplays the default configuration
+ */
+
+#include "test_utils.hpp"
+#include "mcts_test_utils.hpp"
+#include "ai/EndgameSolver.hpp"
+#include "ai/FastRng.hpp"
+#include "ai/MCTSEngine.hpp"
+#include "ai/PlayoutKernel.hpp"
+#include "research/benchmark/PositionSuite.hpp"
+#include <bit>
+#include <cmath>
+#include <iostream>
+#include <vector>
+
+using namespace reversi::ai;
+using namespace test;
+using reversi::core::Board;
+using reversi::core::Move;
+using reversi::research::PositionSuite;
+
+void test_played_squares() {
+    std::cout << "\n[TEST] Playouts report played squares\n";
+    std::cout << "-------------------------------------\n";
+
+    FastRng rng(12);
+    const Board start;
+    const uint64_t empty = ~(start.player | start.opponent);
+    bool ok = true;
+    for (int i = 0; i < 500; ++i) {
+        uint64_t played[2] = {};
+        int plies = 0;
+        if (i & 1) {
+            playout::heuristic_game(start.player, start.opponent, 0.3, rng, plies, played);
+        } else {
+            playout::random_game(start.player, start.opponent, rng, plies, played);
+        }
+        // Each square at most once, only empty squares, one square per ply
+        ok = ok && (played[0] & played[1]) == 0 && ((played[0] | played[1]) & ~empty) == 0 &&
+             std::popcount(played[0]) + std::popcount(played[1]) == plies;
+    }
+    ASSERT_TRUE(ok);
+
+    // Forced pass at the start: the only move belongs to the other side
+    Board pass_first(1ULL << 1, 1ULL << 0);  // Player B1, opponent A1
+    uint64_t played[2] = {};
+    int plies = 0;
+    playout::random_game(pass_first.player, pass_first.opponent, rng, plies, played);
+    ASSERT_EQ(played[0], 0ULL);
+    ASSERT_EQ(played[1], 1ULL << 2);  // C1
+}
+
+void test_amaf_statistics() {
+    std::cout << "\n[TEST] AMAF statistics at the root\n";
+    std::cout << "----------------------------------\n";
+
+    const Board board = opening_position();
+    for (bool rave : {true, false}) {
+        MCTSEngine::Config config(3000, 60000);
+        config.seed = 12;
+        config.use_solver = false;
+        config.use_rave = rave;
+        MCTSEngine engine(config);
+        engine.find_best_move(board, SearchLimits(64, 60000));
+        const auto root = engine.view_node({});
+        const ChildStats& stats = *root.stats;
+        float visits = 0.0f, amaf_visits = 0.0f;
+        int below_visits = 0, bad_wins = 0;
+        for (int e = 0; e < stats.size(); ++e) {
+            visits += stats.visits()[e];
+            amaf_visits += stats.amaf_visits()[e];
+            below_visits += stats.amaf_visits()[e] < stats.visits()[e];
+            bad_wins += stats.amaf_wins()[e] < 0.0f || stats.amaf_wins()[e] > stats.amaf_visits()[e];
+        }
+        std::cout << "  " << (rave ? "RAVE" : "UCB1") << ": " << visits << " root visits, " << amaf_visits
+                  << " AMAF visits\n";
+        ASSERT_EQ(static_cast<int>(visits), 3000);
+        if (rave) {
+            // The move taken counts as played first; other squares the root
+            // side plays later in the simulation add to their own edges
+            ASSERT_EQ(below_visits, 0);
+            ASSERT_GT(amaf_visits, visits);
+            ASSERT_EQ(bad_wins, 0);
+        } else {
+            ASSERT_EQ(amaf_visits, 0.0f);
+        }
+    }
+}
+
+void test_beta_schedule() {
+    std::cout << "\n[TEST] RAVE beta schedule\n";
+    std::cout << "-------------------------\n";
+
+    // Child 0: mean 0.6, AMAF 0.2; child 1: mean 0.4, AMAF 0.8. With no
+    // exploration child 1 wins while beta > 1/4, i.e. while n < 5k
+    const float k = 100.0f;
+    for (float n : {100.0f, 400.0f, 600.0f, 2000.0f}) {
+        ChildStats stats;
+        stats.reset(2);
+        const float mean[2] = {0.6f, 0.4f}, amaf[2] = {0.2f, 0.8f};
+        for (int e = 0; e < 2; ++e) {
+            stats.visits()[e] = n;
+            stats.wins()[e] = mean[e] * n;
+            stats.amaf_visits()[e] = 4 * n;
+            stats.amaf_wins()[e] = amaf[e] * 4 * n;
+        }
+        const int expected = n < 5 * k ? 1 : 0;
+        const float beta = std::sqrt(k / (3 * n + k));
+        std::cout << "  n = " << n << ": beta " << beta << ", child " << stats.select_rave(1.0f, 0.0f, k, 0)
+                  << "\n";
+        ASSERT_EQ(stats.select_rave(1.0f, 0.0f, k, 0), expected);
+        ASSERT_EQ(ucb::argmax_rave_scalar(stats.visits(), stats.wins(), stats.amaf_visits(), stats.amaf_wins(),
+                                          2, 1.0f, 0.0f, k, 0),
+                  expected);
+    }
+}
+
+void test_rave_search() {
+    std::cout << "\n[TEST] RAVE search\n";
+    std::cout << "------------------\n";
+
+    Board board;
+    for (int move : {19, 18, 17, 34}) board.apply_move_no_history(move);
+    for (bool dag : {false, true}) {
+        MCTSEngine::Config config = MCTSEngine::Config::preset_rave();
+        config.max_simulations = 2000;
+        config.seed = 6;
+        config.use_transpositions = dag;
+        MCTSEngine a(config);
+        MCTSEngine b(config);
+        const Move ma = a.find_best_move(board, SearchLimits(64, 60000));
+        const Move mb = b.find_best_move(board, SearchLimits(64, 60000));
+        std::cout << "  " << (dag ? "DAG" : "tree") << ": move " << ma.position << ", "
+                  << a.get_mcts_stats().tree_nodes_created << " nodes\n";
+        ASSERT_EQ(ma.position, mb.position);
+        ASSERT_TRUE((board.legal_moves() >> ma.position) & 1ULL);
+        ASSERT_EQ(a.get_mcts_stats().simulations_performed, 2000);
+    }
+}
+
+void test_rave_solver() {
+    std::cout << "\n[TEST] Solver with RAVE\n";
+    std::cout << "-----------------------\n";
+
+    EndgameSolver exact(16);
+    MCTSEngine::Config config = MCTSEngine::Config::preset_rave();
+    config.max_simulations = 200000;
+    config.seed = 2;
+    const auto proofs = prove_endgames(config, PositionSuite::generate_endgame(8, 54, 55, 77), exact);
+    std::cout << "  " << proofs.correct << "/" << proofs.checked << " roots proven with the exact value\n";
+    ASSERT_GT(proofs.checked, 0);
+    ASSERT_EQ(proofs.correct, proofs.checked);
+}
+
+void test_low_budget_strength() {
+    std::cout << "\n[TEST] RAVE outplays the default at 300 simulations\n";
+    std::cout << "---------------------------------------------------\n";
+
+    const auto openings = PositionSuite::generate_opening(30, 4, 4, 5);
+    int wins = 0, losses = 0;
+    for (size_t i = 0; i < openings.size(); ++i) {
+        for (bool rave_first : {true, false}) {
+            MCTSEngine::Config rave_config = MCTSEngine::Config::preset_rave();
+            rave_config.seed = i + 1;
+            MCTSEngine::Config plain_config;
+            plain_config.seed = i + 101;
+            MCTSEngine rave(rave_config);
+            MCTSEngine plain(plain_config);
+            const int diff = play_game(rave, plain, openings[i], rave_first, 300);
+            wins += diff > 0;
+            losses += diff < 0;
+        }
+    }
+    std::cout << "  RAVE " << wins << " wins, " << losses << " losses in " << 2 * openings.size() << " games\n";
+    ASSERT_GT(wins, losses);
+}
+
+int main() {
+    std::cout << "========================================\n";
+    std::cout << "MCTS RAVE Test\n";
+    std::cout << "========================================\n";
+
+    test_played_squares();
+    test_amaf_statistics();
+    test_beta_schedule();
+    test_rave_search();
+    test_rave_solver();
+    test_low_budget_strength();
+
+    print_summary();
+
+    return tests_failed > 0 ? 1 : 0;
+}
@@ -0,0 +1,199 @@
+/*
+ * test_mcts_solver.cpp - MCTS-Solver (proven wins/losses in the tree)
+ * COMP390 Honours Year Project
+ *
+ * - Hand-built forced win and loss: proofs propagate from the final
+ *   positions (through a forced pass) to the root
+ * - Small endgames: the solver proves the root, matching EndgameSolver
+ * - Exact leaf solve (solve_empties): chosen moves keep the exact outcome
+ * - Without the solver the search runs its full budget
+ * - Forced pass and finished positions return a pass
+ * - MCTS beats a random player (value perspective check)
+ */
+
+#include "test_utils.hpp"
+#include "mcts_test_utils.hpp"
+#include "ai/EndgameSolver.hpp"
+#include "ai/MCTSEngine.hpp"
+#include "research/benchmark/PositionSuite.hpp"
+#include <bit>
+#include <iostream>
+#include <vector>
+
+using namespace reversi::ai;
+using namespace test;
+using reversi::core::Board;
+using reversi::core::Move;
+using reversi::research::PositionSuite;
+
+namespace {
+
+int empties(const Board& b) { return std::popcount(~(b.player | b.opponent)); }
+
+/// Exact outcome for the side to move after playing move (from the mover's view)
+int outcome_after(EndgameSolver& solver, const Board& board, int move) {
+    Board next = board;
+    next.apply_move_no_history(move);
+    return -sign(solver.solve(next).score);
+}
+
+} // namespace
+
+void test_proof_propagation() {
+    std::cout << "\n[TEST] Proofs propagate to the root\n";
+    std::cout << "-----------------------------------\n";
+
+    EndgameSolver exact(16);
+    const uint64_t a1 = 1ULL << 0, b1 = 1ULL << 1, c1 = 1ULL << 2;
+    const uint64_t f8 = 1ULL << 61, h8 = 1ULL << 63;
+
+    // Forced win: A1 (flipping B1) fills the board
+    const Board win(~(a1 | b1), b1);
+    // Forced loss: A1 and H8 both flip one disc, the opponent then has to
+    // pass, and the mover finishes 6-58 either way
+    const Board loss(c1 | f8, ~(a1 | c1 | f8 | h8));
+
+    for (const auto& [board, value] : {std::pair{win, 1}, std::pair{loss, -1}}) {
+        ASSERT_EQ(sign(exact.solve(board).score), value);
+        MCTSEngine::Config config(10000, 60000);
+        config.seed = 1;
+        MCTSEngine engine(config);
+        engine.find_best_move(board, SearchLimits(64, 60000));
+        const auto& stats = engine.get_mcts_stats();
+        std::cout << "  Forced " << (value > 0 ? "win" : "loss") << ": proven after "
+                  << stats.simulations_performed << " simulations, " << stats.solved_nodes << " proven nodes\n";
+        ASSERT_TRUE(stats.root_solved);
+        ASSERT_EQ(stats.root_result, value);
+        ASSERT_LT(stats.simulations_performed, 100);
+
+        // Node proofs are for the player who moved into the node
+        const auto root = engine.view_node({});
+        ASSERT_TRUE(root.proven);
+        ASSERT_EQ(root.proof, -value);
+        int winning_children = 0;
+        for (int move : root.moves) {
+            const auto child = engine.view_node({move});
+            ASSERT_TRUE(child.proven);
+            winning_children += child.proof == 1;
+        }
+        ASSERT_EQ(winning_children, value > 0 ? 1 : 0);
+    }
+
+    // Forced loss: the opponent's pass node and the final position below it
+    MCTSEngine engine(MCTSEngine::Config(10000, 60000));
+    engine.find_best_move(loss, SearchLimits(64, 60000));
+    const auto pass = engine.view_node({0});
+    ASSERT_EQ(pass.moves.size(), static_cast<size_t>(1));
+    ASSERT_EQ(pass.moves.front(), -1);
+    const auto final_position = engine.view_node({0, -1, 63});
+    ASSERT_TRUE(final_position.id != nullptr);
+    ASSERT_TRUE(final_position.proven);
+    ASSERT_EQ(final_position.proof, -1);
+}
+
+void test_small_endgames_proven() {
+    std::cout << "\n[TEST] Solver proves small endgames\n";
+    std::cout << "-----------------------------------\n";
+
+    EndgameSolver exact(16);
+    MCTSEngine::Config config(200000, 60000);
+    config.seed = 3;
+    const auto proofs = prove_endgames(config, PositionSuite::generate_endgame(12, 54, 55, 31), exact);
+    std::cout << "  " << proofs.proven << "/" << proofs.checked << " roots proven, " << proofs.correct << " correct\n";
+    ASSERT_GT(proofs.checked, 0);
+    ASSERT_EQ(proofs.proven, proofs.checked);
+    ASSERT_EQ(proofs.correct, proofs.proven);
+}
+
+void test_exact_leaf_solve() {
+    std::cout << "\n[TEST] Exact leaf solve keeps the outcome\n";
+    std::cout << "-----------------------------------------\n";
+
+    EndgameSolver exact(18);
+    const auto positions = PositionSuite::generate_endgame(10, 46, 48, 47);
+    int checked = 0, correct = 0, solved_roots = 0;
+    for (const Board& board : positions) {
+        if (board.legal_moves() == 0) continue;
+        const int value = sign(exact.solve(board).score);
+
+        MCTSEngine::Config config(20000, 60000);
+        config.seed = 5;
+        config.solve_empties = 10;
+        MCTSEngine engine(config);
+        const Move move = engine.find_best_move(board, SearchLimits(64, 60000));
+        const auto& stats = engine.get_mcts_stats();
+        ++checked;
+        solved_roots += stats.root_solved;
+        correct += outcome_after(exact, board, move.position) == value;
+        if (stats.root_solved) {
+            ASSERT_EQ(stats.root_result, value);
+        }
+    }
+    std::cout << "  " << correct << "/" << checked << " moves keep the exact outcome, " << solved_roots
+              << " roots proven (" << empties(positions.front()) << " empties)\n";
+    ASSERT_GT(checked, 0);
+    ASSERT_EQ(correct, checked);
+    ASSERT_GT(solved_roots, 0);
+}
+
+void test_solver_off() {
+    std::cout << "\n[TEST] Solver off uses the full budget\n";
+    std::cout << "--------------------------------------\n";
+
+    const auto positions = PositionSuite::generate_endgame(1, 56, 56, 9);
+    const Board& board = positions.front();
+    MCTSEngine::Config config(3000, 60000);
+    config.seed = 1;
+    config.use_solver = false;
+    MCTSEngine plain(config);
+    plain.find_best_move(board, SearchLimits(64, 60000));
+    ASSERT_EQ(plain.get_mcts_stats().simulations_performed, 3000);
+    ASSERT_FALSE(plain.get_mcts_stats().root_solved);
+
+    config.use_solver = true;
+    MCTSEngine solver(config);
+    solver.find_best_move(board, SearchLimits(64, 60000));
+    std::cout << "  " << empties(board) << " empties: solved in " << solver.get_mcts_stats().simulations_performed
+              << " simulations, " << solver.get_mcts_stats().solved_nodes << " proven nodes\n";
+    ASSERT_TRUE(solver.get_mcts_stats().root_solved);
+    ASSERT_LT(solver.get_mcts_stats().simulations_performed, 3000);
+}
+
+void test_pass_positions() {
+    std::cout << "\n[TEST] Pass and finished positions\n";
+    std::cout << "----------------------------------\n";
+
+    MCTSEngine engine(MCTSEngine::Config(100, 60000));
+    // Player B1 cannot move, opponent A1 can (C1)
+    ASSERT_TRUE(engine.find_best_move(Board(1ULL << 1, 1ULL << 0), SearchLimits(64, 60000)).is_pass());
+    // Neither side can move
+    ASSERT_TRUE(engine.find_best_move(Board(0x00000000FFFFFFFFULL, 0xFFFFFF0000000000ULL),
+                                      SearchLimits(64, 60000)).is_pass());
+}
+
+void test_beats_random() {
+    std::cout << "\n[TEST] MCTS beats a random player\n";
+    std::cout << "---------------------------------\n";
+
+    const int games = 10;
+    const int wins = play_vs_random(MCTSEngine::Config(500, 60000), games, 3);
+    std::cout << "  MCTS won " << wins << "/" << games << "\n";
+    ASSERT_GE(wins, 8);
+}
+
+int main() {
+    std::cout << "========================================\n";
+    std::cout << "MCTS Solver Test\n";
+    std::cout << "========================================\n";
+
+    test_proof_propagation();
+    test_small_endgames_proven();
+    test_exact_leaf_solve();
+    test_solver_off();
+    test_pass_positions();
+    test_beats_random();
+
+    print_summary();
+
+    return tests_failed > 0 ? 1 : 0;
+}
@@ -0,0 +1,207 @@
+/*
+ * test_mcts_transposition.cpp - Transposition-aware MCTS (shared nodes, DAG)
+ * COMP390 Honours Year Project
+ *
+ * - Transpositions are found and fewer nodes are created for the same budget
+ * - A position reached by several move orders is one node, whose visits
+ *   are the sum of its incoming edges (the tree keeps separate copies)
+ * - Backpropagation follows the path taken: root visits stay consistent
+ * - Same seed, same move with the table on
+ * - MCTS-Solver still proves small endgames correctly through shared nodes
+ * - DAG mode still beats a random player
+ */
+
+#include "test_utils.hpp"
+#include "mcts_test_utils.hpp"
+#include "ai/EndgameSolver.hpp"
+#include "ai/MCTSEngine.hpp"
+#include "research/benchmark/PositionSuite.hpp"
+#include <bit>
+#include <iostream>
+#include <map>
+#include <numeric>
+#include <vector>
+
+using namespace reversi::ai;
+using namespace test;
+using reversi::core::Board;
+using reversi::core::Move;
+using reversi::research::PositionSuite;
+
+namespace {
+
+MCTSEngine::Config dag_config(int sims, uint64_t seed) {
+    MCTSEngine::Config config(sims, 60000);
+    config.seed = seed;
+    config.use_transpositions = true;
+    return config;
+}
+
+/// A node found by walk(): its position, parents and visits through them
+struct Incoming {
+    uint64_t hash = 0;
+    int visits = 0;
+    int parents = 0;           ///< Distinct parent nodes
+    float edge_visits = 0.0f;  ///< Sum of the visits of the edges into it
+};
+
+/// Every node within depth moves of the root, once each, keyed by identity
+std::map<const void*, Incoming> walk(const MCTSEngine& engine, int depth) {
+    std::map<const void*, Incoming> nodes;
+    std::vector<std::vector<int>> frontier{{}};
+    for (int d = 0; d < depth; ++d) {
+        std::vector<std::vector<int>> next;
+        for (const auto& path : frontier) {
+            const auto parent = engine.view_node(path);
+            for (size_t e = 0; e < parent.moves.size(); ++e) {
+                std::vector<int> child_path = path;
+                child_path.push_back(parent.moves[e]);
+                const auto child = engine.view_node(child_path);
+                Incoming& in = nodes[child.id];
+                if (in.parents++ == 0) {
+                    in.hash = child.hash;
+                    in.visits = child.visits;
+                    next.push_back(std::move(child_path));  // First path only: parents stay distinct
+                }
+                in.edge_visits += parent.stats->visits()[e];
+            }
+        }
+        frontier = std::move(next);
+    }
+    return nodes;
+}
+
+} // namespace
+
+void test_node_identity() {
+    std::cout << "\n[TEST] One node per position\n";
+    std::cout << "----------------------------\n";
+
+    const Board board = opening_position();
+    MCTSEngine::Config config(5000, 60000);
+    config.seed = 4;
+    config.use_solver = false;
+    MCTSEngine tree(config);
+    tree.find_best_move(board, SearchLimits(64, 60000));
+    config.use_transpositions = true;
+    MCTSEngine dag(config);
+    dag.find_best_move(board, SearchLimits(64, 60000));
+
+    int tree_copies = 0;  // Nodes duplicating a position already seen in the tree
+    int tree_shared = 0;
+    std::map<uint64_t, int> positions;
+    for (const auto& [id, in] : walk(tree, 4)) {
+        tree_shared += in.parents > 1;
+        tree_copies += positions[in.hash]++ > 0;
+    }
+
+    int shared = 0, mismatched = 0;
+    positions.clear();
+    for (const auto& [id, in] : walk(dag, 4)) {
+        ++positions[in.hash];
+        shared += in.parents > 1;
+        mismatched += static_cast<int>(in.edge_visits) != in.visits;
+    }
+    int duplicated = 0;
+    for (const auto& [hash, count] : positions) duplicated += count > 1;
+    std::cout << "  Depth 4: tree holds " << tree_copies << " duplicate positions; DAG shares " << shared
+              << " nodes between parents\n";
+    ASSERT_GT(tree_copies, 0);
+    ASSERT_EQ(tree_shared, 0);
+    ASSERT_GT(shared, 0);
+    ASSERT_EQ(duplicated, 0);
+    ASSERT_EQ(mismatched, 0);
+}
+
+void test_shared_nodes() {
+    std::cout << "\n[TEST] Transpositions share nodes\n";
+    std::cout << "---------------------------------\n";
+
+    const Board board = opening_position();
+    MCTSEngine::Config config(5000, 60000);
+    config.seed = 4;
+    config.use_solver = false;
+    MCTSEngine tree(config);
+    tree.find_best_move(board, SearchLimits(64, 60000));
+
+    config.use_transpositions = true;
+    MCTSEngine dag(config);
+    dag.find_best_move(board, SearchLimits(64, 60000));
+
+    const auto& t = tree.get_mcts_stats();
+    const auto& d = dag.get_mcts_stats();
+    std::cout << "  Tree: " << t.tree_nodes_created << " nodes; DAG: " << d.tree_nodes_created << " nodes, "
+              << d.transpositions << " transpositions\n";
+    ASSERT_EQ(t.transpositions, 0);
+    ASSERT_GT(d.transpositions, 0);
+    ASSERT_EQ(d.simulations_performed, t.simulations_performed);
+    ASSERT_LT(d.tree_nodes_created, t.tree_nodes_created);
+}
+
+void test_root_visits() {
+    std::cout << "\n[TEST] Backpropagation along the path taken\n";
+    std::cout << "-------------------------------------------\n";
+
+    // Root children are only reachable from the root, so their visits add up
+    // to the simulation count even when deeper nodes are shared
+    const Board board = opening_position();
+    MCTSEngine engine(dag_config(3000, 8));
+    engine.find_best_move(board, SearchLimits(64, 60000));
+    const auto& stats = engine.get_mcts_stats();
+    const auto& visits = stats.move_visit_counts;
+    ASSERT_EQ(visits.size(), static_cast<size_t>(std::popcount(board.legal_moves())));
+    ASSERT_EQ(std::accumulate(visits.begin(), visits.end(), 0), stats.simulations_performed);
+    ASSERT_GT(stats.max_tree_depth, 2);
+}
+
+void test_deterministic() {
+    std::cout << "\n[TEST] Same seed, same move\n";
+    std::cout << "---------------------------\n";
+
+    const Board board = opening_position();
+    MCTSEngine a(dag_config(2000, 21));
+    MCTSEngine b(dag_config(2000, 21));
+    const Move ma = a.find_best_move(board, SearchLimits(64, 60000));
+    const Move mb = b.find_best_move(board, SearchLimits(64, 60000));
+    ASSERT_EQ(ma.position, mb.position);
+    ASSERT_EQ(a.get_mcts_stats().tree_nodes_created, b.get_mcts_stats().tree_nodes_created);
+    ASSERT_TRUE((board.legal_moves() >> ma.position) & 1ULL);
+}
+
+void test_solver_endgames() {
+    std::cout << "\n[TEST] Solver proves endgames through shared nodes\n";
+    std::cout << "--------------------------------------------------\n";
+
+    EndgameSolver exact(16);
+    const auto proofs = prove_endgames(dag_config(200000, 3), PositionSuite::generate_endgame(12, 52, 54, 13), exact);
+    std::cout << "  " << proofs.correct << "/" << proofs.checked << " roots proven with the exact value\n";
+    ASSERT_GT(proofs.checked, 0);
+    ASSERT_EQ(proofs.correct, proofs.checked);
+}
+
+void test_beats_random() {
+    std::cout << "\n[TEST] DAG mode beats a random player\n";
+    std::cout << "-------------------------------------\n";
+
+    const int games = 10;
+    const int wins = play_vs_random(dag_config(500, 1), games, 17);
+    std::cout << "  MCTS won " << wins << "/" << games << "\n";
+    ASSERT_GE(wins, 8);
+}
+
+int main() {
+    std::cout << "========================================\n";
+    std::cout << "MCTS Transposition Test\n";
+    std::cout << "========================================\n";
+
+    test_shared_nodes();
+    test_node_identity();
+    test_root_visits();
+    test_deterministic();
+    test_solver_endgames();
+    test_beats_random();
+
+    print_summary();
+
+    return tests_failed > 0 ? 1 : 0;
+}
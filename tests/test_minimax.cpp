@@ -12,9 +12,12 @@
 #include "test_utils.hpp"
 #include "ai/MinimaxEngine.hpp"
 #include "ai/Evaluator.hpp"
+#include "ai/Evaluator_Week4.hpp"
+#include "ai/EvaluatorConcept.hpp"
 #include "../src/core/Board.hpp"
 #include <iostream>
 #include <iomanip>
+#include <vector>
 
 using namespace reversi::core;
 using namespace reversi::ai;
@@ -190,6 +193,92 @@ void test_depth_scaling() {
     std::cout << "\n";
 }
 
+/**
+ * @brief Specialized (compile-time) and runtime-flag searches must agree
+ * 
+ * Covers every alpha-beta/TT/killer/PVS combination, with and without
+ * iterative deepening, from a few midgame positions.
+ */
+void test_specialized_matches_runtime() {
+    std::cout << "\n[TEST] Specialized search matches runtime-flag search\n";
+    std::cout << "-----------------------------------------------------\n";
+    
+    std::vector<Board> positions(1);
+    Board b;
+    for (int ply = 0; ply < 16; ++ply) {
+        auto moves = b.get_legal_moves();
+        if (moves.empty()) break;
+        b.make_move(moves[(ply * 7) % moves.size()]);
+        if (ply % 5 == 4) positions.push_back(b);
+    }
+    
+    int mismatches = 0;
+    int combos = 0;
+    for (int mask = 0; mask < 32; ++mask) {
+        MinimaxEngine::Config config(4);
+        config.use_alpha_beta = mask & 1;
+        config.use_transposition = mask & 2;
+        config.use_killer_moves = mask & 4;
+        config.use_pvs = mask & 8;
+        config.use_iterative_deepening = mask & 16;
+        
+        for (const Board& pos : positions) {
+            config.use_specialized_search = true;
+            MinimaxEngine fast(config);
+            config.use_specialized_search = false;
+            MinimaxEngine slow(config);
+            
+            auto r1 = fast.find_best_move(pos);
+            auto r2 = slow.find_best_move(pos);
+            ++combos;
+            if (r1.best_move != r2.best_move || r1.score != r2.score ||
+                r1.nodes_searched != r2.nodes_searched) {
+                ++mismatches;
+            }
+        }
+    }
+    
+    std::cout << "  Configurations x positions: " << combos << "\n";
+    std::cout << "  Mismatches: " << mismatches << "\n";
+    ASSERT_EQ(mismatches, 0);
+}
+
+/**
+ * @brief Engines instantiated with other evaluators use them at the leaves
+ */
+void test_pluggable_evaluator() {
+    std::cout << "\n[TEST] Pluggable evaluators\n";
+    std::cout << "---------------------------\n";
+    
+    static_assert(BoardEvaluator<Evaluator>);
+    static_assert(BoardEvaluator<EvaluatorWeek4>);
+    static_assert(BoardEvaluator<EvaluatorWeek4Fast>);
+    
+    Board board;
+    MinimaxEngine::Config config(1, true, false);
+    MinimaxEngine week3(config);
+    MinimaxEngine week4(config, UseEvaluator<EvaluatorWeek4>{});
+    
+    ASSERT_TRUE(week3.evaluator_name() == "Week3");
+    ASSERT_TRUE(week4.evaluator_name() == "Week4");
+    ASSERT_TRUE(week4.get_name() != week3.get_name());
+    
+    // Depth 1: the root score is the best negated leaf evaluation
+    auto result = week4.find_best_move(board);
+    int expected = -1000000;
+    for (int move : board.get_legal_moves()) {
+        Board next = board;
+        next.make_move(move);
+        expected = std::max(expected, -EvaluatorWeek4::evaluate(next));
+    }
+    ASSERT_EQ(result.score, expected);
+    
+    // Deeper search with the Week 4 evaluator returns a legal move
+    MinimaxEngine deep(MinimaxEngine::Config(4), UseEvaluator<EvaluatorWeek4Fast>{});
+    auto deep_result = deep.find_best_move(board);
+    ASSERT_TRUE(deep_result.best_move >= 0 && board.calc_flip(deep_result.best_move) != 0);
+}
+
 /**
  * @brief Main test runner
  */
@@ -203,6 +292,8 @@ int main() {
     test_alpha_beta_correctness();
     test_single_move();
     test_depth_scaling();
+    test_specialized_matches_runtime();
+    test_pluggable_evaluator();
     test_performance_target();
     
     print_summary();
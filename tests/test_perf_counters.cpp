@@ -0,0 +1,149 @@
+/*
+ * test_perf_counters.cpp - Hardware performance counter instrumentation
+ * COMP390 Honours Year Project
+ *
+ * - PerfSample arithmetic (IPC, miss rates, per-op figures, summing)
+ * - Start/stop is safe whether or not counters are available
+ * - SearchResult carries counters only when requested and supported, and
+ *   count the searching thread even when it changes between searches
+ */
+
+#include "test_utils.hpp"
+#include "ai/MinimaxEngine.hpp"
+#include "ai/PerfCounters.hpp"
+#include "research/benchmark/BenchRegistry.hpp"
+#include <cmath>
+#include <iostream>
+#include <thread>
+
+using namespace reversi::ai;
+using namespace test;
+using reversi::core::Board;
+
+void test_sample_arithmetic() {
+    std::cout << "\n[TEST] PerfSample arithmetic\n";
+    std::cout << "----------------------------\n";
+
+    PerfSample empty;
+    ASSERT_TRUE(!empty.valid());
+    ASSERT_EQ(empty.ipc(), 0.0);
+    ASSERT_EQ(empty.per(PerfSample::LLC_MISSES, 100), 0.0);
+    ASSERT_TRUE(empty.summary(100).empty());
+
+    PerfSample s;
+    s.values[PerfSample::CYCLES] = 1000;
+    s.values[PerfSample::INSTRUCTIONS] = 2500;
+    s.values[PerfSample::BRANCHES] = 400;
+    s.values[PerfSample::BRANCH_MISSES] = 20;
+    s.values[PerfSample::LLC_MISSES] = 5;
+    s.counted = (1u << PerfSample::CYCLES) | (1u << PerfSample::INSTRUCTIONS) | (1u << PerfSample::BRANCHES) |
+                (1u << PerfSample::BRANCH_MISSES) | (1u << PerfSample::LLC_MISSES);
+    ASSERT_TRUE(s.valid());
+    ASSERT_TRUE(!s.has(PerfSample::L1D_MISSES));
+    ASSERT_LT(std::abs(s.ipc() - 2.5), 1e-12);
+    ASSERT_LT(std::abs(s.branch_miss_rate() - 0.05), 1e-12);
+    ASSERT_LT(std::abs(s.per(PerfSample::LLC_MISSES, 50) - 0.1), 1e-12);
+    ASSERT_EQ(s.per(PerfSample::L1D_MISSES, 50), 0.0);  // Not counted
+
+    const std::string text = s.summary(50);
+    std::cout << "  " << text << "\n";
+    ASSERT_TRUE(text.find("IPC 2.50") != std::string::npos);
+    ASSERT_TRUE(text.find("branch-miss 5.00%") != std::string::npos);
+    ASSERT_TRUE(text.find("L1D") == std::string::npos);
+
+    PerfSample sum;
+    sum += s;
+    sum += s;
+    ASSERT_EQ(sum.get(PerfSample::INSTRUCTIONS), 5000ULL);
+    ASSERT_EQ(sum.counted, s.counted);
+    ASSERT_LT(std::abs(sum.ipc() - 2.5), 1e-12);
+}
+
+void test_counters() {
+    std::cout << "\n[TEST] Counter start / stop\n";
+    std::cout << "---------------------------\n";
+
+    PerfCounters counters;
+    std::cout << "  Hardware counters " << (PerfCounters::supported() ? "available" : "unavailable") << "\n";
+    ASSERT_EQ(counters.available(), PerfCounters::supported());
+
+    PerfSample total;
+    {
+        ScopedPerf scope(counters, total);
+        volatile uint64_t x = 0;
+        for (int i = 0; i < 100000; ++i) x = x + i;
+    }
+    ASSERT_EQ(total.valid(), counters.available());
+    if (total.has(PerfSample::INSTRUCTIONS)) {
+        ASSERT_GT(total.get(PerfSample::INSTRUCTIONS), 100000ULL);
+    }
+}
+
+void test_search_result() {
+    std::cout << "\n[TEST] SearchResult counters\n";
+    std::cout << "----------------------------\n";
+
+    Board board;
+    MinimaxEngine::Config config(5);
+    MinimaxEngine plain(config);
+    auto r1 = plain.find_best_move(board);
+    ASSERT_TRUE(!r1.perf.valid());
+    ASSERT_EQ(r1.ipc(), 0.0);
+
+    config.use_perf_counters = true;
+    MinimaxEngine counted(config);
+    auto r2 = counted.find_best_move(board);
+    ASSERT_EQ(r2.best_move, r1.best_move);  // Counting must not change the search
+    ASSERT_EQ(r2.nodes_searched, r1.nodes_searched);
+    ASSERT_EQ(r2.perf.valid(), PerfCounters::supported());
+    if (r2.perf.has(PerfSample::CYCLES) && r2.perf.has(PerfSample::INSTRUCTIONS)) {
+        ASSERT_GT(r2.ipc(), 0.0);
+    }
+    r2.print();
+
+    // The AIStrategy interface keeps the counters, and a search on another
+    // thread counts that thread (counters reopened, not the first thread's)
+    counted.find_best_move(board, SearchLimits(5, 0));
+    ASSERT_EQ(counted.get_minimax_stats().perf.valid(), PerfCounters::supported());
+    counted.reset();  // Cold TT, so the search repeats r2's work
+    MinimaxEngine::SearchResult r3;
+    std::thread([&] { r3 = counted.find_best_move(board); }).join();
+    ASSERT_EQ(r3.nodes_searched, r1.nodes_searched);
+    ASSERT_EQ(r3.perf.valid(), PerfCounters::supported());
+    if (r3.perf.has(PerfSample::INSTRUCTIONS) && r2.perf.has(PerfSample::INSTRUCTIONS)) {
+        // Same search, so roughly the same work (a stale fd would count ~nothing)
+        ASSERT_GT(r3.perf.get(PerfSample::INSTRUCTIONS), r2.perf.get(PerfSample::INSTRUCTIONS) / 4);
+    }
+
+    // Registry: counters are opt-in and summed over repetitions
+    reversi::research::BenchRegistry registry;
+    registry.add("micro", "loop", "ops", [] {
+        return reversi::research::BenchRegistry::Body([] {
+            volatile uint64_t x = 0;
+            for (int i = 0; i < 10000; ++i) x = x + i;
+            return uint64_t{10000};
+        });
+    });
+    reversi::research::BenchRegistry::Config bench;
+    bench.repetitions = 3;
+    bench.verbose = false;
+    ASSERT_TRUE(!registry.run(bench)[0].perf.valid());
+    bench.perf_counters = true;
+    auto results = registry.run(bench);
+    ASSERT_EQ(results[0].perf.valid(), PerfCounters::supported());
+    ASSERT_EQ(results[0].perf_ops, 30000ULL);
+}
+
+int main() {
+    std::cout << "========================================\n";
+    std::cout << "Performance Counters Test\n";
+    std::cout << "========================================\n";
+
+    test_sample_arithmetic();
+    test_counters();
+    test_search_result();
+
+    print_summary();
+
+    return tests_failed > 0 ? 1 : 0;
+}
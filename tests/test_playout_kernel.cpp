@@ -0,0 +1,194 @@
+/*
+ * test_playout_kernel.cpp - Raw-bitboard MCTS playout kernel and FastRng
+ * COMP390 Honours Year Project
+ *
+ * - Kernel move generation and flips match Board on random games
+ * - Square classes partition the board
+ * - FastRng: reproducible, below() in range and roughly uniform
+ * - Playouts end in terminal positions with consistent results
+ * - Heuristic policy takes corners when offered
+ */
+
+#include "test_utils.hpp"
+#include "ai/FastRng.hpp"
+#include "ai/PlayoutKernel.hpp"
+#include "core/Board.hpp"
+#include <bit>
+#include <iostream>
+#include <vector>
+
+using namespace reversi::ai;
+using namespace test;
+using reversi::core::Board;
+
+void test_move_generation() {
+    std::cout << "\n[TEST] Kernel move generation matches Board\n";
+    std::cout << "-------------------------------------------\n";
+
+    FastRng rng(2024);
+    bool legal_ok = true, flips_ok = true;
+    int positions = 0;
+    for (int game = 0; game < 200; ++game) {
+        Board board;
+        for (;;) {
+            const uint64_t legal = board.legal_moves();
+            legal_ok = legal_ok && playout::legal_moves(board.player, board.opponent) == legal;
+            for (uint64_t m = legal; m; m &= m - 1) {
+                const int sq = std::countr_zero(m);
+                flips_ok = flips_ok && playout::flips(sq, board.player, board.opponent) == board.calc_flip(sq);
+            }
+            ++positions;
+            if (legal == 0) {
+                if (board.opponent_legal_moves() == 0) break;
+                board.pass();
+                continue;
+            }
+            board.apply_move_no_history(playout::pick_random(legal, rng));
+        }
+    }
+    std::cout << "  " << positions << " positions checked\n";
+    ASSERT_TRUE(legal_ok);
+    ASSERT_TRUE(flips_ok);
+    ASSERT_EQ(playout::flips(0, 0, 0), 0ULL);
+}
+
+void test_square_classes() {
+    std::cout << "\n[TEST] Square classes\n";
+    std::cout << "---------------------\n";
+
+    uint64_t all = 0;
+    int total = 0;
+    for (uint64_t tier : playout::SQUARE_TIERS) {
+        ASSERT_EQ(all & tier, 0ULL);
+        all |= tier;
+        total += std::popcount(tier);
+    }
+    ASSERT_EQ(all, ~0ULL);
+    ASSERT_EQ(total, 64);
+    ASSERT_EQ(std::popcount(playout::CORNERS), 4);
+    ASSERT_EQ(std::popcount(playout::X_SQUARES), 4);
+    ASSERT_EQ(std::popcount(playout::C_SQUARES), 8);
+    ASSERT_TRUE(playout::X_SQUARES & (1ULL << 9));   // B2
+    ASSERT_TRUE(playout::C_SQUARES & (1ULL << 1));   // B1
+    ASSERT_TRUE(playout::C_SQUARES & (1ULL << 8));   // A2
+    ASSERT_TRUE(playout::EDGES & (1ULL << 3));       // D1
+}
+
+void test_rng() {
+    std::cout << "\n[TEST] FastRng\n";
+    std::cout << "--------------\n";
+
+    FastRng a(42), b(42), c(43);
+    bool same = true, differs = false;
+    for (int i = 0; i < 100; ++i) {
+        const uint64_t x = a();
+        same = same && x == b();
+        differs = differs || x != c();
+    }
+    ASSERT_TRUE(same);
+    ASSERT_TRUE(differs);
+
+    a.seed(7);
+    const uint64_t first = a();
+    a.seed(7);
+    ASSERT_EQ(a(), first);
+
+    int counts[10] = {};
+    bool in_range = true;
+    for (int i = 0; i < 100000; ++i) {
+        const uint32_t v = a.below(10);
+        in_range = in_range && v < 10;
+        if (v < 10) ++counts[v];
+    }
+    ASSERT_TRUE(in_range);
+    for (int v = 0; v < 10; ++v) {
+        ASSERT_GT(counts[v], 9500);
+        ASSERT_LT(counts[v], 10500);
+    }
+    ASSERT_EQ(a.below(1), 0U);
+}
+
+void test_playouts() {
+    std::cout << "\n[TEST] Playouts\n";
+    std::cout << "---------------\n";
+
+    FastRng rng(5);
+    const Board start;
+    bool sane = true;
+    int total_plies = 0;
+    for (int i = 0; i < 1000; ++i) {
+        int plies = 0;
+        const bool heuristic = (i & 1) != 0;
+        const int diff = heuristic
+            ? playout::heuristic_game(start.player, start.opponent, 0.3, rng, plies)
+            : playout::random_game(start.player, start.opponent, rng, plies);
+        // At most 60 moves from the start
+        sane = sane && plies > 0 && plies <= 60 && diff >= -64 && diff <= 64;
+        total_plies += plies;
+    }
+    ASSERT_TRUE(sane);
+    std::cout << "  Average playout length: " << total_plies / 1000.0 << " plies\n";
+    ASSERT_GT(total_plies, 1000 * 50);
+
+    // Same seed, same game
+    FastRng r1(9), r2(9);
+    int p1 = 0, p2 = 0;
+    ASSERT_EQ(playout::random_game(start.player, start.opponent, r1, p1),
+              playout::random_game(start.player, start.opponent, r2, p2));
+    ASSERT_EQ(p1, p2);
+
+    // Finished position: no moves played, result is the disc difference
+    Board full(0x00000000FFFFFFFFULL, 0xFFFFFF0000000000ULL);
+    int plies = 0;
+    const int diff = playout::random_game(full.player, full.opponent, rng, plies);
+    ASSERT_EQ(plies, 0);
+    ASSERT_EQ(diff, 32 - 24);
+
+    // Side to move must pass: the opponent plays C1, result stays with the starter
+    Board pass_first(1ULL << 1, 1ULL << 0);  // Player B1, opponent A1
+    int pass_plies = 0;
+    const int pass_diff = playout::random_game(pass_first.player, pass_first.opponent, rng, pass_plies);
+    ASSERT_EQ(pass_plies, 1);
+    ASSERT_EQ(pass_diff, -3);  // A1, B1, C1 all the opponent's
+}
+
+void test_heuristic_policy() {
+    std::cout << "\n[TEST] Heuristic policy prefers corners\n";
+    std::cout << "---------------------------------------\n";
+
+    FastRng rng(11);
+    const uint64_t legal = (1ULL << 0) | (1ULL << 9) | (1ULL << 20) | (1ULL << 3);  // A1, B2, E3, D1
+    bool corner = true;
+    for (int i = 0; i < 100; ++i) corner = corner && playout::pick_heuristic(legal, 0.3, rng) == 0;
+    ASSERT_TRUE(corner);
+
+    // Larger fraction widens the candidate set by whole tiers (corner + edge)
+    bool top_two = true, saw_edge = false;
+    for (int i = 0; i < 200; ++i) {
+        const int sq = playout::pick_heuristic(legal, 0.5, rng);
+        top_two = top_two && (sq == 0 || sq == 3);
+        saw_edge = saw_edge || sq == 3;
+    }
+    ASSERT_TRUE(top_two);
+    ASSERT_TRUE(saw_edge);
+
+    // X-square only when nothing else is legal
+    const uint64_t x_only = 1ULL << 9;
+    ASSERT_EQ(playout::pick_heuristic(x_only, 0.3, rng), 9);
+}
+
+int main() {
+    std::cout << "========================================\n";
+    std::cout << "Playout Kernel Test\n";
+    std::cout << "========================================\n";
+
+    test_move_generation();
+    test_square_classes();
+    test_rng();
+    test_playouts();
+    test_heuristic_policy();
+
+    print_summary();
+
+    return tests_failed > 0 ? 1 : 0;
+}
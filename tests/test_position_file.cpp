@@ -0,0 +1,213 @@
+/*
+ * test_position_file.cpp - OBF / FFO position parsing and bulk loading
+ * COMP390 Honours Year Project
+ *
+ * - Board(const std::string&) / to_obf round trips, side to move and hash
+ * - Malformed strings are rejected (constructor falls back to the start)
+ * - Annotated FFO lines keep the best move and score, and suite ids
+ * - The parallel loader matches a sequential parse in order and line numbers
+ */
+
+#include "test_utils.hpp"
+#include "research/data/PositionFile.hpp"
+#include "research/benchmark/PositionSuite.hpp"
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <random>
+
+using namespace reversi::research;
+using reversi::core::Board;
+using namespace test;
+
+namespace {
+
+const char* START_OBF = "---------------------------OX------XO--------------------------- X;";
+
+std::vector<Board> random_positions(int count, uint32_t seed) {
+    std::mt19937 rng(seed);
+    std::vector<Board> boards;
+    std::vector<int> moves;
+    for (int i = 0; i < count; ++i) {
+        Board board;
+        int plies = static_cast<int>(rng() % 60);
+        for (int p = 0; p < plies && !board.is_terminal(); ++p) {
+            board.get_legal_moves(moves);
+            if (moves.empty()) {
+                board.pass();
+                continue;
+            }
+            board.make_move(moves[rng() % moves.size()]);
+        }
+        boards.push_back(board);
+    }
+    return boards;
+}
+
+} // namespace
+
+void test_board_string() {
+    std::cout << "\n[TEST] Board(const std::string&) and to_obf\n";
+    std::cout << "-------------------------------------------\n";
+
+    Board start(START_OBF);
+    ASSERT_EQ(start.player, Board().player);
+    ASSERT_EQ(start.opponent, Board().opponent);
+    ASSERT_EQ(start.hash(), Board().hash());
+    ASSERT_EQ(Board().to_obf(), std::string(START_OBF));
+
+    // Round trip with either side to move; hash matches the played line
+    int mismatches = 0;
+    for (const Board& b : random_positions(500, 3)) {
+        Board parsed(b.to_obf());
+        if (parsed.player != b.player || parsed.opponent != b.opponent || parsed.hash() != b.hash()) ++mismatches;
+    }
+    ASSERT_EQ(mismatches, 0);
+
+    // Alternative symbols, white to move, trailing annotation
+    Board white(std::string("  ") + std::string(27, '.') + "o*......*o" + std::string(27, '.') + "\tO; junk");
+    ASSERT_EQ(white.side_to_move(), 1);
+    ASSERT_EQ(white.count_player(), 2);
+    ASSERT_EQ(white.player, Board().opponent);
+
+    // Malformed: too short, bad square, missing side
+    uint64_t p = 0, o = 0;
+    int side = 0;
+    std::string bad = START_OBF;
+    ASSERT_TRUE(!Board::parse_obf(bad.data(), 64, p, o, side));
+    bad[10] = 'Z';
+    ASSERT_TRUE(!Board::parse_obf(bad.data(), bad.size(), p, o, side));
+    bad = std::string(START_OBF).substr(0, 64) + " ?";
+    ASSERT_TRUE(!Board::parse_obf(bad.data(), bad.size(), p, o, side));
+    ASSERT_EQ(Board(bad).hash(), Board().hash());
+}
+
+void test_annotations() {
+    std::cout << "\n[TEST] FFO annotations\n";
+    std::cout << "----------------------\n";
+
+    const std::string line = std::string(START_OBF) + " D3:+4; C4:+4;";
+    PositionFile::Position pos;
+    ASSERT_TRUE(PositionFile::parse_line(line.data(), line.data() + line.size(), pos));
+    ASSERT_EQ(static_cast<int>(pos.best_move), 19);
+    ASSERT_EQ(static_cast<int>(pos.score), 4);
+    ASSERT_TRUE(pos.has_score);
+    ASSERT_EQ(pos.empties(), 60);
+
+    char buf[PositionFile::MAX_LINE];
+    pos.score = -12;
+    std::string formatted(buf, PositionFile::format_line(pos, buf));
+    ASSERT_EQ(formatted, std::string(START_OBF) + " D3:-12;");
+
+    const std::string pass_line = std::string(START_OBF) + " PS:-2;";
+    ASSERT_TRUE(PositionFile::parse_line(pass_line.data(), pass_line.data() + pass_line.size(), pos));
+    ASSERT_EQ(static_cast<int>(pos.best_move), -1);
+    ASSERT_EQ(static_cast<int>(pos.score), -2);
+
+    const std::string plain = START_OBF;
+    ASSERT_TRUE(PositionFile::parse_line(plain.data(), plain.data() + plain.size(), pos));
+    ASSERT_TRUE(!pos.has_score);
+
+    // Suite ids: an EPD-style op after the annotation
+    const std::string named = std::string(START_OBF) + " D3:+4; id \"#40\";";
+    ASSERT_TRUE(PositionFile::parse_line(named.data(), named.data() + named.size(), pos));
+    ASSERT_EQ(static_cast<int>(pos.score), 4);
+    ASSERT_EQ(PositionFile::parse_id(named.data(), named.data() + named.size()), std::string("#40"));
+    ASSERT_EQ(PositionFile::parse_id(line.data(), line.data() + line.size()), std::string());
+
+    // load_ids() follows each position back to its line
+    const std::string path = "test_position_file_ids.obf";
+    std::ofstream(path) << "% suite\n" << named << "\n" << plain << "\n\n" << START_OBF << " id \"#42\";\n";
+    std::vector<PositionFile::Position> suite;
+    PositionFile::load(path, suite);
+    const auto ids = PositionFile::load_ids(path, suite);
+    ASSERT_EQ(ids.size(), static_cast<size_t>(3));
+    ASSERT_EQ(ids[0], std::string("#40"));
+    ASSERT_EQ(ids[1], std::string());
+    ASSERT_EQ(ids[2], std::string("#42"));
+    std::remove(path.c_str());
+}
+
+void test_bulk_load() {
+    std::cout << "\n[TEST] Parallel bulk load\n";
+    std::cout << "-------------------------\n";
+
+    auto boards = random_positions(2000, 11);
+    std::vector<PositionFile::Position> positions;
+    for (const Board& b : boards) positions.push_back(PositionFile::from_board(b));
+
+    // Repeat to a larger file, with comments, CRLF and a malformed line mixed in
+    const std::string path = "test_position_file_tmp.obf";
+    {
+        std::ofstream out(path, std::ios::binary);
+        out << "% generated by test_position_file\r\n";
+        char buf[PositionFile::MAX_LINE];
+        for (int rep = 0; rep < 50; ++rep) {
+            for (const auto& pos : positions) {
+                out.write(buf, static_cast<std::streamsize>(PositionFile::format_line(pos, buf)));
+                out << (rep % 2 ? "\r\n" : "\n");
+            }
+            if (rep == 25) out << "not a position\n\n";
+        }
+    }
+
+    std::vector<PositionFile::Position> one, many;
+    auto s1 = PositionFile::load(path, one, 1);
+    auto s4 = PositionFile::load(path, many, 4);
+    std::cout << "  " << s4.positions << " positions, " << s4.lines << " lines: 1 thread "
+              << s1.seconds * 1000 << " ms, 4 threads " << s4.seconds * 1000 << " ms ("
+              << (s1.seconds > 0 ? s1.positions / s1.seconds / 1e6 : 0.0) << " M lines/s)\n";
+    ASSERT_TRUE(s4.error.empty());
+    ASSERT_EQ(s4.positions, 100000ULL);
+    ASSERT_EQ(s4.errors, 1ULL);
+    ASSERT_EQ(s4.lines, 100003ULL);
+    ASSERT_EQ(s1.positions, s4.positions);
+
+    int mismatches = 0;
+    for (size_t i = 0; i < many.size(); ++i) {
+        const auto& a = one[i];
+        const auto& b = many[i];
+        const auto& ref = positions[i % positions.size()];
+        if (a.player != b.player || a.opponent != b.opponent || a.side != b.side || a.line != b.line ||
+            b.player != ref.player || b.opponent != ref.opponent || b.side != ref.side) {
+            ++mismatches;
+        }
+    }
+    ASSERT_EQ(mismatches, 0);
+    ASSERT_EQ(many[0].line, 2U);
+    ASSERT_EQ(many.back().line, 100003U);
+    ASSERT_EQ(many[5].board().hash(), boards[5].hash());
+
+    // save() writes the same lines back
+    const std::string copy = "test_position_file_copy.obf";
+    ASSERT_TRUE(PositionFile::save(copy, many));
+    std::vector<PositionFile::Position> reloaded;
+    auto s2 = PositionFile::load(copy, reloaded, 3);
+    ASSERT_EQ(s2.positions, 100000ULL);
+    ASSERT_EQ(reloaded[4321].player, many[4321].player);
+
+    // PositionSuite reads standard suite files
+    auto suite = PositionSuite::load_file(copy, 64);
+    ASSERT_EQ(suite.size(), static_cast<size_t>(64));
+    ASSERT_EQ(suite[7].hash(), boards[7].hash());
+
+    std::vector<PositionFile::Position> missing;
+    ASSERT_TRUE(!PositionFile::load("does_not_exist.obf", missing).error.empty());
+
+    std::remove(path.c_str());
+    std::remove(copy.c_str());
+}
+
+int main() {
+    std::cout << "========================================\n";
+    std::cout << "Position File Test\n";
+    std::cout << "========================================\n";
+
+    test_board_string();
+    test_annotations();
+    test_bulk_load();
+
+    print_summary();
+
+    return tests_failed > 0 ? 1 : 0;
+}
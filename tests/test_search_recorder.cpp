@@ -0,0 +1,183 @@
+/*
+ * test_search_recorder.cpp - Search tree recorder and ordering analysis
+ * COMP390 Honours Year Project
+ *
+ * - Recording does not change the search (same move, score, nodes)
+ * - Records are consistent with the searched tree
+ * - Binary save / load round trip
+ * - Analyzer statistics on hand-made records
+ */
+
+#include "test_utils.hpp"
+#include "ai/MinimaxEngine.hpp"
+#include "ai/SearchRecorder.hpp"
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+
+using namespace reversi::ai;
+using namespace test;
+using reversi::core::Board;
+
+namespace {
+
+NodeRecord make_record(int ply, int cutoff_index, uint8_t sources) {
+    NodeRecord r;
+    r.ply = static_cast<uint8_t>(ply);
+    r.depth = 3;
+    r.moves = 8;
+    r.cutoff_index = static_cast<uint8_t>(cutoff_index);
+    r.flags = NodeRecord::ORDERED;
+    r.sources = sources;
+    r.bound = cutoff_index == NodeRecord::NO_CUTOFF ? 2 : 1;
+    return r;
+}
+
+} // namespace
+
+void test_recording() {
+    std::cout << "\n[TEST] Recording a search\n";
+    std::cout << "-------------------------\n";
+
+    Board board;
+    board.make_move(19);
+    board.make_move(18);
+    board.make_move(17);
+
+    for (bool pvs : {false, true}) {
+        MinimaxEngine::Config config(6);
+        config.use_killer_moves = true;
+        config.use_pvs = pvs;
+
+        MinimaxEngine plain(config);
+        auto expected = plain.find_best_move(board);
+
+        SearchRecorder recorder;
+        MinimaxEngine engine(config);
+        engine.set_recorder(&recorder);
+        auto result = engine.find_best_move(board);
+        ASSERT_EQ(result.best_move, expected.best_move);
+        ASSERT_EQ(result.score, expected.score);
+        ASSERT_EQ(result.nodes_searched, expected.nodes_searched);
+
+        const auto& records = recorder.records();
+        ASSERT_GT(records.size(), static_cast<size_t>(0));
+        ASSERT_LT(records.size(), static_cast<size_t>(result.nodes_searched));
+        bool consistent = true;
+        size_t pvs_nodes = 0;
+        for (const auto& r : records) {
+            pvs_nodes += r.has(NodeRecord::PVS_NODE);
+            if (r.has(NodeRecord::TT_CUTOFF)) {
+                consistent = consistent && r.has(NodeRecord::TT_HIT) && r.moves == 0;
+                continue;
+            }
+            consistent = consistent && r.moves > 0 && r.best_index < r.moves && r.depth >= 1 && r.ply >= 1;
+            consistent = consistent && (!r.cutoff() || (r.cutoff_index < r.moves && r.bound == 1));
+            consistent = consistent && r.has(NodeRecord::ORDERED);
+        }
+        ASSERT_TRUE(consistent);
+        // PVS falls back to negamax at plies with many zero-window failures
+        ASSERT_EQ(pvs_nodes > 0, pvs);
+
+        auto analysis = SearchRecorder::analyze(records);
+        std::cout << "  " << (pvs ? "PVS" : "negamax") << ": " << records.size() << " records, first-move cutoff "
+                  << 100.0 * analysis.first_move_cutoff_rate() << "%\n";
+        ASSERT_GT(analysis.cutoffs, 0ULL);
+        ASSERT_GT(analysis.first_move_cutoff_rate(), 0.5);  // Ordering does better than chance
+        uint64_t flagged = 0;
+        for (const auto& s : analysis.per_source) flagged += s.cutoffs;
+        ASSERT_GT(flagged, 0ULL);
+
+        engine.set_recorder(nullptr);
+        recorder.clear();
+        engine.reset();
+        engine.find_best_move(board);
+        ASSERT_EQ(recorder.records().size(), static_cast<size_t>(0));
+    }
+
+    SearchRecorder capped(10);
+    for (int i = 0; i < 15; ++i) capped.record(NodeRecord{});
+    ASSERT_EQ(capped.records().size(), static_cast<size_t>(10));
+    ASSERT_EQ(capped.dropped(), 5ULL);
+}
+
+void test_save_load() {
+    std::cout << "\n[TEST] Binary save / load\n";
+    std::cout << "-------------------------\n";
+
+    SearchRecorder recorder;
+    recorder.record(make_record(1, 0, NodeRecord::SRC_TT));
+    recorder.record(make_record(2, 3, NodeRecord::SRC_FLIPS | NodeRecord::SRC_POSITIONAL));
+    recorder.record(make_record(2, NodeRecord::NO_CUTOFF, 0));
+
+    const std::string path = "test_search_recorder_tmp.rvsr";
+    ASSERT_TRUE(recorder.save(path));
+    std::vector<NodeRecord> loaded;
+    ASSERT_TRUE(SearchRecorder::load(path, loaded));
+    ASSERT_EQ(loaded.size(), static_cast<size_t>(3));
+    ASSERT_EQ(static_cast<int>(loaded[1].cutoff_index), 3);
+    ASSERT_EQ(static_cast<int>(loaded[1].sources), NodeRecord::SRC_FLIPS | NodeRecord::SRC_POSITIONAL);
+
+    // Truncated and foreign files are rejected
+    {
+        std::ofstream out(path, std::ios::binary | std::ios::trunc);
+        out << "RVSR";
+    }
+    ASSERT_TRUE(!SearchRecorder::load(path, loaded));
+    {
+        std::ofstream out(path, std::ios::binary | std::ios::trunc);
+        out << "not a record file at all";
+    }
+    ASSERT_TRUE(!SearchRecorder::load(path, loaded));
+    std::remove(path.c_str());
+}
+
+void test_analysis() {
+    std::cout << "\n[TEST] Ordering analysis\n";
+    std::cout << "------------------------\n";
+
+    std::vector<NodeRecord> records{
+        make_record(1, 0, NodeRecord::SRC_TT),
+        make_record(1, 0, NodeRecord::SRC_TT | NodeRecord::SRC_KILLER),
+        make_record(1, 2, NodeRecord::SRC_FLIPS),
+        make_record(2, 1, 0),
+        make_record(2, NodeRecord::NO_CUTOFF, 0),
+    };
+    NodeRecord tt_cut;
+    tt_cut.flags = NodeRecord::TT_HIT | NodeRecord::TT_CUTOFF;
+    records.push_back(tt_cut);
+
+    auto a = SearchRecorder::analyze(records);
+    ASSERT_EQ(a.records, 6ULL);
+    ASSERT_EQ(a.interior_nodes, 5ULL);
+    ASSERT_EQ(a.tt_cutoffs, 1ULL);
+    ASSERT_EQ(a.cutoffs, 4ULL);
+    ASSERT_EQ(a.first_move_cutoffs, 2ULL);
+    ASSERT_LT(std::abs(a.first_move_cutoff_rate() - 0.5), 1e-12);
+    ASSERT_LT(std::abs(a.average_cutoff_index() - 0.75), 1e-12);
+    ASSERT_LT(std::abs(a.per_ply[1].average_cutoff_index() - 2.0 / 3.0), 1e-12);
+    ASSERT_EQ(a.per_ply[2].nodes, 2ULL);
+    ASSERT_EQ(a.unattributed_cutoffs, 1ULL);
+    ASSERT_EQ(a.per_source[0].cutoffs, 2ULL);  // TT
+    ASSERT_EQ(a.per_source[0].first_move, 2ULL);
+    ASSERT_EQ(a.per_source[0].sole, 1ULL);
+    ASSERT_EQ(a.per_source[1].sole, 0ULL);     // Killer only together with TT
+    ASSERT_EQ(a.per_source[3].cutoffs, 1ULL);  // Flips
+    ASSERT_EQ(a.bounds[1], 4ULL);
+    a.print();
+}
+
+int main() {
+    std::cout << "========================================\n";
+    std::cout << "Search Recorder Test\n";
+    std::cout << "========================================\n";
+
+    test_recording();
+    test_save_load();
+    test_analysis();
+
+    print_summary();
+
+    return tests_failed > 0 ? 1 : 0;
+}
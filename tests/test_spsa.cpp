@@ -0,0 +1,196 @@
+/*
+ * test_spsa.cpp - SPSA tuner tests
+ * COMP390 Honours Year Project
+ *
+ * - PhaseWeights::ScopedTable changes EvaluatorWeek4 on this thread only
+ * - Parameter registry covers Config fields and per-phase weights
+ * - Every registered move-ordering field changes the search
+ * - An iteration moves parameters within bounds, deterministically
+ * - Checkpoint + resume reproduces an uninterrupted run
+ */
+
+#include "test_utils.hpp"
+#include "ai/Evaluator_Week4.hpp"
+#include "research/tuning/SpsaTuner.hpp"
+#include <cstdio>
+#include <iostream>
+#include <thread>
+
+using namespace reversi::ai;
+using reversi::core::Board;
+using reversi::research::SpsaTuner;
+using namespace test;
+
+namespace {
+
+std::vector<SpsaTuner::Parameter> make_parameters(const SpsaTuner::Candidate& base) {
+    std::vector<SpsaTuner::Parameter> params;
+    for (const char* name : {"killer_weight", "Opening.mobility_weight", "LateMid.stability_weight"}) {
+        SpsaTuner::Parameter p;
+        SpsaTuner::find_parameter(name, base, p);
+        params.push_back(p);
+    }
+    return params;
+}
+
+SpsaTuner::Config small_config() {
+    SpsaTuner::Config config;
+    config.iterations = 4;
+    config.pairs_per_iteration = 2;
+    config.opening_plies = 6;
+    config.limits = SearchLimits(2, 0);  // Deterministic games
+    config.num_threads = 2;
+    config.seed = 99;
+    config.verbose = false;
+    return config;
+}
+
+std::vector<double> values_of(const SpsaTuner& tuner) {
+    std::vector<double> v;
+    for (const auto& p : tuner.parameters()) v.push_back(p.value);
+    return v;
+}
+
+} // namespace
+
+void test_scoped_weights() {
+    std::cout << "\n[TEST] Thread-local PhaseWeights table\n";
+    std::cout << "--------------------------------------\n";
+
+    Board board;
+    board.make_move(19);
+    int baseline = EvaluatorWeek4::evaluate(board);
+
+    PhaseWeightTable heavy = PhaseWeights::default_table();
+    for (auto& w : heavy) w.piece_count_weight += 10;
+    {
+        PhaseWeights::ScopedTable scope(heavy);
+        ASSERT_TRUE(EvaluatorWeek4::evaluate(board) != baseline);
+        ASSERT_EQ(PhaseWeights::get_weights(GamePhase::Opening).piece_count_weight,
+                  heavy[0].piece_count_weight);
+
+        // Other threads still see the defaults
+        int other = 0;
+        std::thread t([&] { other = EvaluatorWeek4::evaluate(board); });
+        t.join();
+        ASSERT_EQ(other, baseline);
+    }
+    ASSERT_EQ(EvaluatorWeek4::evaluate(board), baseline);
+}
+
+void test_registry() {
+    std::cout << "\n[TEST] Parameter registry\n";
+    std::cout << "-------------------------\n";
+
+    SpsaTuner::Candidate base;
+    auto names = SpsaTuner::known_parameters();
+    std::cout << "  " << names.size() << " tunable parameters\n";
+    ASSERT_EQ(static_cast<int>(names.size()), 7 + 4 * 7);
+
+    SpsaTuner::Parameter p;
+    ASSERT_TRUE(SpsaTuner::find_parameter("EarlyMid.corner_bonus", base, p));
+    ASSERT_EQ(static_cast<int>(p.value), 30);
+    SpsaTuner::Candidate c = base;
+    p.apply(c, 44);
+    ASSERT_EQ(c.weights[1].corner_bonus, 44);
+    ASSERT_EQ(c.weights[0].corner_bonus, 25);
+
+    ASSERT_TRUE(SpsaTuner::find_parameter("tt_weight", base, p));
+    p.apply(c, 1234);
+    ASSERT_EQ(c.config.tt_weight, 1234);
+    ASSERT_TRUE(!SpsaTuner::find_parameter("no_such_field", base, p));
+}
+
+void test_ordering_fields() {
+    std::cout << "\n[TEST] Registered ordering fields reach the search\n";
+    std::cout << "--------------------------------------------------\n";
+
+    SpsaTuner::Candidate base;
+    base.config.max_depth = 7;
+    base.config.use_iterative_deepening = true;  // TT moves to order by
+    base.config.use_killer_moves = true;
+    Board board;
+    for (int move : {19, 18, 17, 34, 20, 26}) board.apply_move_no_history(move);
+    const auto reference = MinimaxEngine(base.config).find_best_move(board);
+
+    const std::pair<const char*, double> changes[] = {
+        {"tt_weight", 0}, {"killer_weight", 0}, {"pos_weight_mul", 0}, {"flip_mul", 32}, {"history_weight", 200}};
+    for (const auto& [name, value] : changes) {
+        SpsaTuner::Parameter p;
+        ASSERT_TRUE(SpsaTuner::find_parameter(name, base, p));
+        SpsaTuner::Candidate c = base;
+        p.apply(c, value);
+        const auto result = MinimaxEngine(c.config).find_best_move(board);
+        std::cout << "  " << name << " = " << value << ": " << result.nodes_searched << " nodes (default "
+                  << reference.nodes_searched << ")\n";
+        ASSERT_TRUE(result.nodes_searched != reference.nodes_searched || result.best_move != reference.best_move);
+    }
+}
+
+void test_iterations_and_resume() {
+    std::cout << "\n[TEST] Iterations are deterministic and resumable\n";
+    std::cout << "-------------------------------------------------\n";
+
+    SpsaTuner::Candidate base;
+    const std::string checkpoint = "test_spsa_checkpoint.txt";
+    std::remove(checkpoint.c_str());
+
+    // Uninterrupted run
+    SpsaTuner full(make_parameters(base), base, small_config());
+    Timer timer;
+    bool moved = false;
+    for (int i = 0; i < 4; ++i) {
+        auto r = full.step();
+        ASSERT_EQ(r.plus_wins + r.minus_wins + r.draws, 4);
+        if (r.plus_wins != r.minus_wins) moved = true;
+    }
+    std::cout << "  4 iterations in " << timer.elapsed_ms() << " ms\n";
+    for (const auto& p : full.parameters()) {
+        std::cout << "  " << p.name << " = " << p.value << "\n";
+        ASSERT_GE(p.value, p.min_value);
+        ASSERT_TRUE(p.value <= p.max_value);
+    }
+    if (moved) {
+        ASSERT_TRUE(values_of(full) != values_of(SpsaTuner(make_parameters(base), base, small_config())));
+    }
+
+    // Two iterations, checkpoint, then a fresh tuner resumes via run()
+    SpsaTuner first(make_parameters(base), base, small_config());
+    first.step();
+    first.step();
+    ASSERT_TRUE(first.save_checkpoint(checkpoint));
+
+    SpsaTuner::Config resume_config = small_config();
+    resume_config.checkpoint_file = checkpoint;
+    resume_config.num_threads = 1;
+    SpsaTuner resumed(make_parameters(base), base, resume_config);
+    resumed.run();
+    ASSERT_EQ(resumed.iteration(), 4);
+    ASSERT_TRUE(values_of(resumed) == values_of(full));
+
+    // A checkpoint for another parameter set is rejected
+    std::vector<SpsaTuner::Parameter> other;
+    SpsaTuner::Parameter p;
+    SpsaTuner::find_parameter("flip_mul", base, p);
+    other.push_back(p);
+    SpsaTuner mismatched(other, base, small_config());
+    ASSERT_TRUE(!mismatched.load_checkpoint(checkpoint));
+    ASSERT_EQ(mismatched.iteration(), 0);
+
+    std::remove(checkpoint.c_str());
+}
+
+int main() {
+    std::cout << "========================================\n";
+    std::cout << "SPSA Tuner Test\n";
+    std::cout << "========================================\n";
+
+    test_scoped_weights();
+    test_registry();
+    test_ordering_fields();
+    test_iterations_and_resume();
+
+    print_summary();
+
+    return tests_failed > 0 ? 1 : 0;
+}
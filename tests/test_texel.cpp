@@ -0,0 +1,214 @@
+/*
+ * test_texel.cpp - Texel tuner tests
+ * COMP390 Honours Year Project
+ *
+ * - extract_features reproduces EvaluatorWeek4::evaluate under any table
+ * - Weight tables and feature caches round-trip through files
+ * - Analytic gradient matches finite differences
+ * - Tuning lowers the loss, identically for 1 and 3 threads
+ */
+
+#include "test_utils.hpp"
+#include "ai/Evaluator_Week4.hpp"
+#include "research/tuning/TexelTuner.hpp"
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <random>
+
+using namespace reversi::ai;
+using reversi::core::Board;
+using reversi::research::TexelTuner;
+using namespace test;
+
+namespace {
+
+/**
+ * @brief Positions from random games, labelled with the final result
+ */
+std::vector<TexelTuner::Sample> random_game_samples(int games, uint32_t seed) {
+    std::mt19937 rng(seed);
+    std::vector<TexelTuner::Sample> samples;
+    std::vector<int> moves;
+    for (int g = 0; g < games; ++g) {
+        Board board;
+        std::vector<std::pair<Board, int>> history;  // position, side to move
+        while (!board.is_terminal()) {
+            board.get_legal_moves(moves);
+            if (moves.empty()) {
+                board.pass();
+                continue;
+            }
+            history.push_back({board, board.side_to_move()});
+            board.make_move(moves[rng() % moves.size()]);
+        }
+        int black_diff = board.count_player() - board.count_opponent();
+        if (board.side_to_move() != 0) black_diff = -black_diff;
+        for (const auto& [pos, side] : history) {
+            int diff = side == 0 ? black_diff : -black_diff;
+            samples.push_back({pos, TexelTuner::target_from_score(diff)});
+        }
+    }
+    return samples;
+}
+
+int dot(const EvaluatorWeek4::Features& f, const PhaseWeightConfig& w) {
+    int sum = 0;
+    for (int i = 0; i < PhaseWeights::NUM_FIELDS; ++i) sum += f[i] * (w.*PhaseWeights::FIELDS[i]);
+    return sum;
+}
+
+} // namespace
+
+void test_features_match_evaluate() {
+    std::cout << "\n[TEST] Features reproduce EvaluatorWeek4::evaluate\n";
+    std::cout << "---------------------------------------------------\n";
+
+    auto samples = random_game_samples(20, 7);
+    PhaseWeightTable odd = PhaseWeights::default_table();
+    for (auto& w : odd) {
+        w.mobility_weight += 3;
+        w.corner_bonus -= 7;
+        w.frontier_penalty += 2;
+    }
+
+    int mismatches = 0;
+    for (const auto& s : samples) {
+        auto f = EvaluatorWeek4::extract_features(s.board);
+        int phase = static_cast<int>(PhaseWeights::detect_phase(s.board));
+        if (EvaluatorWeek4::evaluate(s.board) != dot(f, PhaseWeights::default_table()[phase])) ++mismatches;
+        PhaseWeights::ScopedTable scope(odd);
+        if (EvaluatorWeek4::evaluate(s.board) != dot(f, odd[phase])) ++mismatches;
+    }
+    std::cout << "  " << samples.size() << " positions checked\n";
+    ASSERT_EQ(mismatches, 0);
+}
+
+void test_file_round_trips() {
+    std::cout << "\n[TEST] Weight table and feature cache files\n";
+    std::cout << "-------------------------------------------\n";
+
+    const std::string table_file = "test_texel_weights.txt";
+    PhaseWeightTable table = PhaseWeights::default_table();
+    table[2].stability_weight = 123;
+    table[3].position_weight_scale = -4;
+    ASSERT_TRUE(PhaseWeights::save_table(table_file, table));
+    PhaseWeightTable loaded{};
+    ASSERT_TRUE(PhaseWeights::load_table(table_file, loaded));
+    ASSERT_TRUE(loaded == table);
+
+    // Installed tables are seen by every thread; scoped tables still win
+    Board board;
+    board.make_move(19);
+    int baseline = EvaluatorWeek4::evaluate(board);
+    table[0].piece_count_weight += 10;
+    PhaseWeights::set_default_table(table);
+    int installed = EvaluatorWeek4::evaluate(board);
+    ASSERT_TRUE(installed != baseline);
+    {
+        PhaseWeights::ScopedTable scope(PhaseWeights::default_table());
+        ASSERT_EQ(EvaluatorWeek4::evaluate(board), baseline);
+    }
+    PhaseWeights::reset_default_table();
+    ASSERT_EQ(EvaluatorWeek4::evaluate(board), baseline);
+
+    // A truncated file is rejected and leaves the output untouched
+    {
+        std::ofstream out(table_file);
+        out << "# reversi-phase-weights v1\nOpening 1 2 3 4 5 6 7\n";
+    }
+    PhaseWeightTable untouched = PhaseWeights::default_table();
+    ASSERT_TRUE(!PhaseWeights::load_table(table_file, untouched));
+    ASSERT_TRUE(untouched == PhaseWeights::default_table());
+    std::remove(table_file.c_str());
+
+    const std::string cache_file = "test_texel_cache.bin";
+    auto data = TexelTuner::build_features(random_game_samples(10, 3), 2);
+    ASSERT_TRUE(data.save(cache_file));
+    TexelTuner::FeatureMatrix reloaded;
+    ASSERT_TRUE(reloaded.load(cache_file));
+    ASSERT_EQ(reloaded.size(), data.size());
+    ASSERT_TRUE(reloaded.phase_begin == data.phase_begin);
+    ASSERT_TRUE(reloaded.columns == data.columns);
+    ASSERT_TRUE(reloaded.targets == data.targets);
+    std::remove(cache_file.c_str());
+    ASSERT_TRUE(!reloaded.load(cache_file));
+}
+
+void test_gradient() {
+    std::cout << "\n[TEST] Gradient matches finite differences\n";
+    std::cout << "------------------------------------------\n";
+
+    auto data = TexelTuner::build_features(random_game_samples(40, 11), 1);
+    auto w = TexelTuner::to_weights(PhaseWeights::default_table());
+    const double k = 0.5;
+    TexelTuner::Weights grad{};
+    TexelTuner::loss(data, w, k, 1, &grad);
+
+    int checked = 0, bad = 0;
+    for (int p = 0; p < TexelTuner::NUM_PHASES; ++p) {
+        for (int f = 0; f < TexelTuner::NUM_FEATURES; ++f) {
+            const double h = 0.05;
+            auto plus = w, minus = w;
+            plus[p][f] += h;
+            minus[p][f] -= h;
+            double numeric = (TexelTuner::loss(data, plus, k, 1) - TexelTuner::loss(data, minus, k, 1)) / (2 * h);
+            double tolerance = 1e-3 * std::max(1e-3, std::abs(numeric)) + 1e-5;
+            if (std::abs(numeric - grad[p][f]) > tolerance * 20) {
+                std::cout << "  phase " << p << " feature " << f << ": analytic " << grad[p][f]
+                          << " numeric " << numeric << "\n";
+                ++bad;
+            }
+            ++checked;
+        }
+    }
+    std::cout << "  " << checked << " partial derivatives checked\n";
+    ASSERT_EQ(bad, 0);
+}
+
+void test_tuning_reduces_loss() {
+    std::cout << "\n[TEST] Tuning lowers the loss\n";
+    std::cout << "-----------------------------\n";
+
+    auto data = TexelTuner::build_features(random_game_samples(300, 5), 3);
+    std::cout << "  " << data.size() << " positions\n";
+
+    TexelTuner::Config config;
+    config.epochs = 60;
+    config.learning_rate = 0.5;
+    config.num_threads = 1;
+    config.report_every = 0;
+
+    Timer timer;
+    auto r1 = TexelTuner::tune(data, PhaseWeights::default_table(), config);
+    std::cout << "  K = " << r1.k << ", loss " << r1.initial_loss << " -> " << r1.final_loss
+              << " (rounded " << r1.rounded_loss << ") in " << timer.elapsed_ms() << " ms\n";
+    ASSERT_GT(r1.k, 0.0);
+    ASSERT_LT(r1.final_loss, r1.initial_loss);
+    ASSERT_LT(r1.rounded_loss, r1.initial_loss);
+    for (const auto& w : r1.table) {
+        ASSERT_GE(w.potential_mobility_weight, 0);
+        ASSERT_GE(w.stability_weight, 0);
+    }
+
+    // Same data split across threads: same fitted table
+    config.num_threads = 3;
+    auto r3 = TexelTuner::tune(data, PhaseWeights::default_table(), config);
+    ASSERT_TRUE(std::abs(r3.final_loss - r1.final_loss) < 1e-6);
+}
+
+int main() {
+    std::cout << "========================================\n";
+    std::cout << "Texel Tuner Test\n";
+    std::cout << "========================================\n";
+
+    test_features_match_evaluate();
+    test_file_round_trips();
+    test_gradient();
+    test_tuning_reduces_loss();
+
+    print_summary();
+
+    return tests_failed > 0 ? 1 : 0;
+}
@@ -0,0 +1,219 @@
+/*
+ * test_tournament.cpp - Tournament scheduler and ML Elo tests
+ * COMP390 Honours Year Project
+ *
+ * - Maximum-likelihood Elo: two-player case matches the logistic formula,
+ *   symmetric results give equal ratings, error bars shrink with games,
+ *   zero and perfect scores stay finite
+ * - Schedule covers every pairing x opening x colour exactly once
+ * - Opening set is distinct and reproducible
+ * - An interrupted run resumes from the results file and ends with the
+ *   same games as an uninterrupted run (also across thread counts)
+ */
+
+#include "test_utils.hpp"
+#include "ai/MinimaxEngine.hpp"
+#include "research/benchmark/Tournament.hpp"
+#include <iostream>
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <set>
+#include <tuple>
+
+using namespace reversi::ai;
+using reversi::research::Tournament;
+using reversi::research::Statistics;
+using namespace test;
+
+namespace {
+
+std::vector<Tournament::EngineSpec> depth_ladder() {
+    std::vector<Tournament::EngineSpec> specs;
+    for (int depth : {1, 2, 3}) {
+        specs.emplace_back("Minimax-d" + std::to_string(depth),
+                           [] { return std::make_unique<MinimaxEngine>(); },
+                           SearchLimits(depth, 0));
+    }
+    return specs;
+}
+
+Tournament::Config small_config(const std::string& file, int threads) {
+    Tournament::Config config;
+    config.num_openings = 4;
+    config.opening_plies = 6;
+    config.seed = 777;
+    config.num_threads = threads;
+    config.results_file = file;
+    return config;
+}
+
+bool same_records(const std::vector<Tournament::GameRecord>& a,
+                  const std::vector<Tournament::GameRecord>& b) {
+    if (a.size() != b.size()) return false;
+    for (size_t i = 0; i < a.size(); ++i) {
+        if (a[i].game != b[i].game || a[i].a_points2 != b[i].a_points2 ||
+            a[i].disc_diff != b[i].disc_diff || a[i].move_count != b[i].move_count) {
+            return false;
+        }
+    }
+    return true;
+}
+
+} // namespace
+
+void test_ml_elo() {
+    std::cout << "\n[TEST] Maximum-likelihood Elo\n";
+    std::cout << "-----------------------------\n";
+
+    // Two players, 75% score, no prior: difference = logistic Elo of 0.75
+    std::vector<std::vector<double>> points = {{0, 75}, {25, 0}};
+    std::vector<std::vector<double>> games = {{0, 100}, {100, 0}};
+    auto two = Statistics::maximum_likelihood_elo(points, games, 0.0);
+    double diff = two[0].elo - two[1].elo;
+    std::cout << "  75% over 100 games: diff " << diff << " (expected "
+              << Statistics::score_to_elo(0.75) << "), +/- " << two[0].elo_ci95 << "\n";
+    ASSERT_LT(std::abs(diff - Statistics::score_to_elo(0.75)), 0.01);
+    ASSERT_LT(std::abs(two[0].elo + two[1].elo), 1e-6);
+
+    // More games: tighter interval
+    std::vector<std::vector<double>> points4 = {{0, 300}, {100, 0}};
+    std::vector<std::vector<double>> games4 = {{0, 400}, {400, 0}};
+    auto more = Statistics::maximum_likelihood_elo(points4, games4, 0.0);
+    ASSERT_LT(more[0].elo_ci95, two[0].elo_ci95);
+
+    // Three-player cycle with equal results: all ratings equal
+    std::vector<std::vector<double>> cyc_points = {{0, 6, 4}, {4, 0, 6}, {6, 4, 0}};
+    std::vector<std::vector<double>> cyc_games = {{0, 10, 10}, {10, 0, 10}, {10, 10, 0}};
+    auto cyc = Statistics::maximum_likelihood_elo(cyc_points, cyc_games);
+    ASSERT_LT(std::abs(cyc[0].elo - cyc[1].elo), 1e-6);
+    ASSERT_LT(std::abs(cyc[1].elo - cyc[2].elo), 1e-6);
+    ASSERT_GT(cyc[0].elo_ci95, 0.0);
+
+    // Perfect score stays finite thanks to the prior
+    std::vector<std::vector<double>> perfect = {{0, 10}, {0, 0}};
+    std::vector<std::vector<double>> g10 = {{0, 10}, {10, 0}};
+    auto p = Statistics::maximum_likelihood_elo(perfect, g10, 1.0);
+    ASSERT_TRUE(std::isfinite(p[0].elo));
+    ASSERT_GT(p[0].elo, p[1].elo);
+
+    // ... and without a prior: no -inf/NaN for the zero score
+    std::vector<std::vector<double>> shutout = {{0, 10, 5}, {0, 0, 0}, {5, 10, 0}};
+    std::vector<std::vector<double>> g3 = {{0, 10, 10}, {10, 0, 10}, {10, 10, 0}};
+    auto z = Statistics::maximum_likelihood_elo(shutout, g3, 0.0);
+    for (const auto& e : z) {
+        ASSERT_TRUE(std::isfinite(e.elo) && std::isfinite(e.elo_ci95));
+    }
+    ASSERT_LT(z[1].elo, z[0].elo);
+    ASSERT_LT(std::abs(z[0].elo - z[2].elo), 1e-6);
+}
+
+void test_schedule() {
+    std::cout << "\n[TEST] Balanced schedule and opening set\n";
+    std::cout << "---------------------------------------\n";
+
+    Tournament rr(depth_ladder(), small_config("", 1));
+    ASSERT_EQ(static_cast<int>(rr.pairings().size()), 3);
+    ASSERT_EQ(static_cast<int>(rr.openings().size()), 4);
+    ASSERT_EQ(rr.scheduled_games(), 3 * 4 * 2);
+
+    std::set<std::tuple<int, int, int, bool>> seen;
+    for (int g = 0; g < rr.scheduled_games(); ++g) {
+        auto r = rr.schedule(g);
+        ASSERT_TRUE(r.engine_a < r.engine_b);
+        seen.insert({r.engine_a, r.engine_b, r.opening, r.a_is_black});
+    }
+    ASSERT_EQ(static_cast<int>(seen.size()), rr.scheduled_games());
+
+    auto set1 = Tournament::make_opening_set(777, 20, 6);
+    auto set2 = Tournament::make_opening_set(777, 20, 6);
+    std::set<uint64_t> hashes;
+    for (size_t i = 0; i < set1.size(); ++i) {
+        ASSERT_EQ(set1[i].hash(), set2[i].hash());
+        hashes.insert(set1[i].hash());
+    }
+    ASSERT_EQ(static_cast<int>(hashes.size()), 20);
+
+    Tournament::Config gauntlet_config = small_config("", 1);
+    gauntlet_config.format = Tournament::Format::GAUNTLET;
+    Tournament gauntlet(depth_ladder(), gauntlet_config);
+    ASSERT_EQ(static_cast<int>(gauntlet.pairings().size()), 2);
+    for (const auto& pairing : gauntlet.pairings()) {
+        ASSERT_EQ(pairing.first, 0);
+    }
+}
+
+void test_resume() {
+    std::cout << "\n[TEST] Interrupted run resumes to the same result\n";
+    std::cout << "-------------------------------------------------\n";
+
+    const std::string full_file = "test_tournament_full.txt";
+    const std::string resume_file = "test_tournament_resume.txt";
+    std::remove(full_file.c_str());
+    std::remove(resume_file.c_str());
+
+    Timer timer;
+    auto full = Tournament(depth_ladder(), small_config(full_file, 1)).run();
+    std::cout << "  Full run: " << full.games.size() << " games in "
+              << timer.elapsed_ms() << " ms\n";
+    ASSERT_TRUE(full.complete);
+    ASSERT_EQ(static_cast<int>(full.games.size()), 24);
+    ASSERT_EQ(full.resumed_games, 0);
+
+    // Stop after 10 games, append a torn line, then resume with 3 threads
+    Tournament::Config partial_config = small_config(resume_file, 2);
+    partial_config.max_new_games = 10;
+    auto partial = Tournament(depth_ladder(), partial_config).run();
+    ASSERT_EQ(partial.played_games, 10);
+    ASSERT_TRUE(!partial.complete);
+    {
+        std::ofstream torn(resume_file, std::ios::app);
+        torn << "17 0 2";  // Interrupted mid-write
+    }
+
+    auto resumed = Tournament(depth_ladder(), small_config(resume_file, 3)).run();
+    ASSERT_EQ(resumed.resumed_games, 10);
+    ASSERT_EQ(resumed.played_games, 14);
+    ASSERT_TRUE(resumed.complete);
+    ASSERT_TRUE(same_records(full.games, resumed.games));
+    
+    // Reloading the repaired file finds every game again
+    auto reloaded = Tournament(depth_ladder(), small_config(resume_file, 1)).run();
+    ASSERT_EQ(reloaded.resumed_games, 24);
+    ASSERT_EQ(reloaded.played_games, 0);
+
+    // A results file from a different tournament is refused
+    Tournament::Config other = small_config(resume_file, 1);
+    other.seed = 778;
+    auto refused = Tournament(depth_ladder(), other).run();
+    ASSERT_TRUE(!refused.error.empty());
+    ASSERT_EQ(static_cast<int>(refused.games.size()), 0);
+
+    // Deeper search should not rate below depth 1
+    resumed.print(std::cout);
+    double d1 = 0.0, d3 = 0.0;
+    for (const auto& s : resumed.standings) {
+        if (s.name == "Minimax-d1") d1 = s.elo;
+        if (s.name == "Minimax-d3") d3 = s.elo;
+        ASSERT_EQ(s.games, 16);
+        ASSERT_TRUE(s.name == "Minimax-d" + std::to_string(s.engine + 1));  // Cross-table rows
+    }
+    ASSERT_GT(d3, d1);
+
+    std::remove(full_file.c_str());
+    std::remove(resume_file.c_str());
+}
+
+int main() {
+    std::cout << "========================================\n";
+    std::cout << "Tournament Scheduler Test\n";
+    std::cout << "========================================\n";
+
+    test_ml_elo();
+    test_schedule();
+    test_resume();
+
+    print_summary();
+
+    return tests_failed > 0 ? 1 : 0;
+}
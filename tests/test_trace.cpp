@@ -0,0 +1,188 @@
+/*
+ * test_trace.cpp - Scoped tracing and Chrome trace export
+ * COMP390 Honours Year Project
+ *
+ * - Scopes record only while tracing is enabled; hot scopes are sampled
+ * - Per-thread buffers, wrap-around keeps the newest events
+ * - Finished threads hand their buffers on, keeping their events
+ * - Chrome trace-event JSON output
+ * - Trace macros compile at every REVERSI_TRACE_LEVEL
+ */
+
+#include "test_utils.hpp"
+#include "core/Trace.hpp"
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <thread>
+#include <vector>
+
+using namespace reversi::core;
+using namespace test;
+
+namespace {
+
+size_t count_occurrences(const std::string& text, const std::string& needle) {
+    size_t count = 0;
+    for (size_t pos = text.find(needle); pos != std::string::npos; pos = text.find(needle, pos + 1)) ++count;
+    return count;
+}
+
+} // namespace
+
+void test_scopes() {
+    std::cout << "\n[TEST] Scoped events\n";
+    std::cout << "--------------------\n";
+
+    Tracer::clear();
+    Tracer::set_enabled(false);
+    { TraceScope scope("test", "disabled"); }
+    ASSERT_EQ(Tracer::recorded(), 0ULL);
+
+    Tracer::set_enabled(true);
+    {
+        TraceScope outer("test", "outer");
+        TraceScope inner("test", "inner");
+        volatile int x = 0;
+        for (int i = 0; i < 1000; ++i) x = x + i;
+    }
+    Tracer::set_enabled(false);
+
+    auto events = Tracer::snapshot();
+    ASSERT_EQ(events.size(), static_cast<size_t>(2));
+    ASSERT_EQ(std::string(events[0].name), std::string("outer"));  // Sorted by start
+    ASSERT_EQ(std::string(events[1].name), std::string("inner"));
+    ASSERT_GE(events[0].duration_ns, events[1].duration_ns);
+    ASSERT_GE(events[1].start_ns, events[0].start_ns);
+
+    // Hot scopes: one event per sample interval, weighted
+    Tracer::clear();
+    Tracer::set_hot_sample_interval(8);
+    Tracer::set_enabled(true);
+    for (int i = 0; i < 80; ++i) TraceScope scope("test", "hot", TraceScope::Hot{});
+    Tracer::set_enabled(false);
+    events = Tracer::snapshot();
+    ASSERT_EQ(events.size(), static_cast<size_t>(10));
+    ASSERT_EQ(events[0].weight, 8u);
+    Tracer::set_hot_sample_interval(1);
+
+    // Macros: no events when compiled out, one per scope otherwise
+    Tracer::clear();
+    Tracer::set_enabled(true);
+    {
+        REVERSI_TRACE("test", "coarse");
+        REVERSI_TRACE_HOT("test", "hot");
+    }
+    Tracer::set_enabled(false);
+    const uint64_t expected = (REVERSI_TRACE_LEVEL >= 1 ? 1 : 0) + (REVERSI_TRACE_LEVEL >= 2 ? 1 : 0);
+    ASSERT_EQ(Tracer::recorded(), expected);
+}
+
+void test_threads_and_wrap() {
+    std::cout << "\n[TEST] Per-thread buffers\n";
+    std::cout << "-------------------------\n";
+
+    Tracer::clear();
+    Tracer::set_enabled(true);
+    const int per_thread = 1000;
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 3; ++t) {
+        threads.emplace_back([] {
+            for (int i = 0; i < per_thread; ++i) TraceScope scope("test", "worker");
+        });
+    }
+    for (auto& t : threads) t.join();
+
+    // Overflow this thread's buffer: only the newest BUFFER_EVENTS survive
+    const size_t overflow = Tracer::BUFFER_EVENTS + 100;
+    for (size_t i = 0; i < overflow; ++i) Tracer::record("test", "main", static_cast<int64_t>(i), static_cast<int64_t>(i) + 1);
+    Tracer::set_enabled(false);
+
+    ASSERT_EQ(Tracer::recorded(), static_cast<uint64_t>(3 * per_thread + overflow));
+    auto events = Tracer::snapshot();
+    ASSERT_EQ(events.size(), static_cast<size_t>(3 * per_thread + Tracer::BUFFER_EVENTS));
+
+    int64_t oldest_main = -1;
+    std::vector<uint32_t> worker_ids;
+    for (const auto& e : events) {
+        if (std::string(e.name) == "main" && oldest_main < 0) oldest_main = e.start_ns;
+        if (std::string(e.name) == "worker" &&
+            std::find(worker_ids.begin(), worker_ids.end(), e.thread) == worker_ids.end()) {
+            worker_ids.push_back(e.thread);
+        }
+    }
+    ASSERT_EQ(oldest_main, 100);
+    ASSERT_EQ(worker_ids.size(), static_cast<size_t>(3));
+}
+
+void test_buffer_reuse() {
+    std::cout << "\n[TEST] Finished threads' buffers are reused\n";
+    std::cout << "-------------------------------------------\n";
+
+    Tracer::clear();
+    Tracer::set_enabled(true);
+    const size_t before = Tracer::buffer_count();
+    const int workers = 20;
+    for (int t = 0; t < workers; ++t) {
+        std::thread([] {
+            for (int i = 0; i < 10; ++i) TraceScope scope("test", "short_lived");
+        }).join();
+    }
+    Tracer::set_enabled(false);
+
+    std::vector<uint32_t> ids;
+    for (const auto& e : Tracer::snapshot()) {
+        if (std::find(ids.begin(), ids.end(), e.thread) == ids.end()) ids.push_back(e.thread);
+    }
+    std::cout << "  " << workers << " threads, " << Tracer::buffer_count() - before << " new buffer(s)\n";
+    ASSERT_LE(Tracer::buffer_count(), before + 1);
+    ASSERT_EQ(Tracer::recorded(), static_cast<uint64_t>(10 * workers));
+    ASSERT_EQ(Tracer::snapshot().size(), static_cast<size_t>(10 * workers));
+    ASSERT_EQ(ids.size(), static_cast<size_t>(workers));  // Still told apart in the export
+    Tracer::clear();
+}
+
+void test_chrome_json() {
+    std::cout << "\n[TEST] Chrome trace JSON\n";
+    std::cout << "------------------------\n";
+
+    Tracer::clear();
+    Tracer::record("search", "tt_probe", 1000, 1500);
+    Tracer::record("search", "quote\"name", 2000, 4000);
+
+    const std::string path = "test_trace_tmp.json";
+    ASSERT_TRUE(Tracer::write_chrome_json(path));
+    std::ifstream in(path);
+    std::stringstream ss;
+    ss << in.rdbuf();
+    const std::string text = ss.str();
+    std::remove(path.c_str());
+
+    ASSERT_TRUE(text.find("\"traceEvents\"") != std::string::npos);
+    ASSERT_EQ(count_occurrences(text, "\"ph\": \"X\""), static_cast<size_t>(2));
+    ASSERT_TRUE(text.find("\"name\": \"tt_probe\", \"cat\": \"search\", \"ph\": \"X\", \"ts\": 1.000, \"dur\": 0.500") !=
+                std::string::npos);
+    ASSERT_TRUE(text.find("quote\\\"name") != std::string::npos);
+    ASSERT_TRUE(text.find("\"thread_name\"") != std::string::npos);
+    ASSERT_EQ(count_occurrences(text, "{"), count_occurrences(text, "}"));
+
+    ASSERT_TRUE(!Tracer::write_chrome_json("/nonexistent_dir/trace.json"));
+    Tracer::clear();
+}
+
+int main() {
+    std::cout << "========================================\n";
+    std::cout << "Trace Test (REVERSI_TRACE_LEVEL=" << REVERSI_TRACE_LEVEL << ")\n";
+    std::cout << "========================================\n";
+
+    test_scopes();
+    test_threads_and_wrap();
+    test_buffer_reuse();
+    test_chrome_json();
+
+    print_summary();
+
+    return tests_failed > 0 ? 1 : 0;
+}
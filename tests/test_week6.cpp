@@ -252,9 +252,6 @@ void test_combined_optimizations() {
     config_all.use_aspiration = true;
     config_all.aspiration_window = 50;
     config_all.use_killer_moves = true;
-    config_all.killer_weight = 0;
-    config_all.tt_weight = 6000;
-    config_all.history_weight = 0;
     std::cout << "[CONFIG_ALL] pvs_margin=" << config_all.pvs_research_margin
               << " asp_w=" << config_all.aspiration_window
               << " killer_w=" << config_all.killer_weight